@@ -2,10 +2,13 @@ import os
 import regex as re
 import keyboard
 import argparse
+import json
 
 menu = []
 active_choice = 0
 scene_serializer_lines = ""
+binary_schema = []
+reflection_tables = []
 
 def find_serializable_variables(header_file_path, all_public):
     
@@ -38,10 +41,6 @@ def find_serializable_variables(header_file_path, all_public):
                     in_public_section = True
                 continue
 
-            if non_serializable == True and all_public == False:
-                non_serializable = False;
-                continue
-
             if 'NON_SERIALIZED' in line and all_public == False:
                 non_serializable = True
                 continue
@@ -53,7 +52,10 @@ def find_serializable_variables(header_file_path, all_public):
             if match:
                 var_type = match.group(1)
                 var_name = match.group(2)
-                serializable_vars.append((var_type, var_name, True))
+                # Non-serialized fields are still reflected, with a flag
+                serializable_vars.append((var_type, var_name, not non_serializable))
+
+            non_serializable = False
 
     return serializable_vars
 
@@ -210,109 +212,23 @@ def create_header_code(Component):
 
     return header_code
 
-def create_serialization_code(file, Component, serializable_vars, indentation = 0):
-
-    name, parent, is_parent, is_abstract = file
-
-    component = Component.lower()
-
-    serialization_code = [
-        '    if (auto const ' + component + ' = std::dynamic_pointer_cast<class ' + Component + '>(component); ' + component + ' != nullptr)',
-        '    {'
-    ]
-
-    if parent == 'Component':
-        serialization_code += [
-        '        out << YAML::BeginMap;'
-        ]
-
-    if is_parent == True:
-        serialization_code += [
-        '        // # Put new ' + Component  + ' kid here',
-        '        {',
-        '            out << YAML::Key << "ComponentName" << YAML::Value << "' + Component + 'Component";',
-        '            out << YAML::Key << "guid" << YAML::Value << ' + component + '->guid;',
-        '            out << YAML::Key << "custom_name" << YAML::Value << ' + component + '->custom_name;'
-        ]
-    else:
-        serialization_code += [
-        '        out << YAML::Key << "ComponentName" << YAML::Value << "' + Component + 'Component";',
-        '        out << YAML::Key << "guid" << YAML::Value << ' + component + '->guid;',
-        '        out << YAML::Key << "custom_name" << YAML::Value << ' + component + '->custom_name;'
-        ]
-
-    if is_parent == True:
-        serialization_code += [
-        '        }'
-        ]
-
-    for var_type, var_name, is_checked in serializable_vars:
-
-        if is_checked == False:
-            continue
+def add_to_binary_schema(Component, serializable_vars):
+    fields = [[var_type, var_name] for var_type, var_name, is_checked in serializable_vars if is_checked]
+    binary_schema.append({'name': Component + 'Component', 'fields': fields})
 
-        serialization_code += [
-        '        out << YAML::Key << "' + var_name + '" << YAML::Value << ' + component + '->' + var_name + ';',
-    ]    
+# Binary scene files store fields in the order of the schema, so they can only be read with the same schema.
+# NOTE: Keep in sync with SceneConverter.py
+def compute_binary_schema_hash(schema):
+    text = ''
+    for component in sorted(schema, key=lambda x: x['name']):
+        text += component['name'] + ':' + ','.join(var_type + ' ' + var_name for var_type, var_name in component['fields']) + ';'
 
-    if parent == 'Component':
-        serialization_code += [
-        '        out << YAML::EndMap;',
-        ]
-
-    serialization_code += [
-        '    }',
-    ]
-
-    #if parent != 'Component':
-    serialization_code += [
-    '    else'
-    ]
-
-    for i in range(len(serialization_code)):
-        for j in range(indentation):
-            serialization_code[i] = '    ' + serialization_code[i]
-
-    return serialization_code
-
-def create_deserialization_code(Component, serializable_vars):
-
-    deserialization_code = [
-        '    if (component_name == "' + Component + 'Component")',
-        '    {',
-        '        if (first_pass)',
-        '        {',
-        '            auto const deserialized_component = ' + Component + '::create();',
-        '            deserialized_component->guid = component["guid"].as<std::string>();',
-        '            deserialized_component->custom_name = component["custom_name"].as<std::string>();',
-        '            deserialized_pool.emplace_back(deserialized_component);',
-        '        }',
-        '        else',
-        '        {',
-        '            auto const deserialized_component = std::dynamic_pointer_cast<class ' + Component + '>(get_from_pool(component["guid"].as<std::string>()));'
-    ]
-
-    for var_type, var_name, is_checked in serializable_vars:
-        
-        if is_checked == False:
-            continue
-
-        deserialization_code += [
-            '            if (component["'+ var_name + '"].IsDefined())',
-            '            {',
-            '                deserialized_component->' + var_name + ' = component["' + var_name + '"].as<' + var_type + '>();',
-            '            }',
-        ]
-
-    deserialization_code += [
-        '            deserialized_entity->add_component(deserialized_component);',
-        '            deserialized_component->reprepare();',
-        '        }',
-        '    }',
-        '        else'
-    ]
+    hash = 0x811c9dc5
+    for byte in text.encode('utf-8'):
+        hash ^= byte
+        hash = (hash * 0x01000193) & 0xFFFFFFFF
 
-    return deserialization_code
+    return hash
 
 def pick_variables(serializable_vars):
     
@@ -392,35 +308,60 @@ def scan_all_files(inherits_from = 'Component'):
 
     return files_to_serialize
 
-def clean_up(files_to_serilize, Component, is_parent):
-
-    if args.pick_files:
-        component = Component.lower()
-        for file in files_to_serilize:
-            new_name, new_parent, new_is_parent, new_is_abstract = file
-            new_Component = os.path.basename(new_name)[:-2]
-            if new_parent == Component:
-                clean_up(files_to_serilize, new_Component, new_is_parent)
-        
-        if is_parent:
-            remove_lines_between('if (auto const ' + component + ' = std::dynamic_pointer_cast<class ' + Component + '>(component); ' + component + ' != nullptr)', 'else', True)
-        else:
-            remove_lines_between('if (auto const ' + component + ' = std::dynamic_pointer_cast<class ' + Component + '>(component); ' + component + ' != nullptr)', 'else')
-        remove_lines_between('if (component_name == "' + Component + 'Component")', 'else')
+def create_reflection_table_code(Component, reflected_vars, is_abstract):
 
-def add_serialization(file, pick_vars, pick_files, indentation = 0):
+    table_code = [
+        'template<>',
+        'struct ComponentReflection<class ' + Component + '>',
+        '{',
+        '    static constexpr char const* name = "' + Component + 'Component";',
+        '    static constexpr u32 name_hash = AK::fnv1a_hash("' + Component + 'Component");',
+    ]
+
+    if is_abstract:
+        table_code[3:3] = ['    // Abstract, only used to serialize components without their own serialization']
+
+    if reflected_vars == []:
+        table_code += [
+        '    static constexpr std::tuple fields = {};',
+        ]
+    else:
+        table_code += [
+        '    static constexpr std::tuple fields = {',
+        ]
+
+        for var_type, var_name, is_checked in reflected_vars:
+            flags = '' if is_checked else '<FieldFlags::NonSerialized>'
+            table_code += [
+            '        make_field' + flags + '("' + var_name + '", &' + Component + '::' + var_name + '),',
+            ]
+
+        table_code += [
+        '    };',
+        ]
+
+    table_code += [
+        '};',
+        '',
+    ]
+
+    return table_code
+
+def add_serialization(file, pick_vars, pick_files):
 
     name, parent, is_parent, is_abstract = file
     name = name.replace("\\", "/")
+    Component = os.path.basename(name)[:-2]
 
     if pick_files:
         yn = input('Serialize ' + name + '? y/n/e ')
         if yn == 'n':
+            # Still needs a table to be listed in ENUMERATE_COMPONENTS, but without any fields
+            reflection_tables.append((name, Component, [], is_abstract))
             return
         elif yn == 'e':
             exit()
 
-    Component = os.path.basename(name)[:-2]
     header_file_path = args.engine_dir + '/src/' + Component + '.h'
     serializable_vars = find_serializable_variables(header_file_path, pick_vars)
     
@@ -429,33 +370,19 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
 
     if pick_vars == True:
         serializable_vars = pick_variables(serializable_vars)
-    
-    is_already_serialized = check_includes(name)
-
-    create_serialization_code(file, Component, serializable_vars)
-
-    if is_already_serialized == False:
-        add_lines_at_target('// # Put new header here', create_header_code(name))
-    else:
-        clean_up(files_to_serialize, Component, is_parent)
-        
-    place_to_add_serialization = '// # Put new serialization here'
-    shift = -5
-    if parent != 'Component':
-        place_to_add_serialization = '// # Put new ' + parent + ' kid here'
-        shift = 1
-        
-    add_lines_at_target(place_to_add_serialization, create_serialization_code(file, Component, serializable_vars, indentation), shift)
-    print('Succesful added serialization for ' + Component + '!')
 
     additional_variables = recursively_search_serializable_variables(header_file_path)
 
-    print("Additional variables from parents added to deserialization code: ")
+    print("Additional variables from parents: ")
     print(additional_variables)
 
+    # Fields of the component come before the fields of its parents, both in YAML and binary files
+    reflection_tables.append((name, Component, serializable_vars + additional_variables, is_abstract))
+    print('Succesful added reflection table for ' + Component + '!')
+
     if is_abstract == False:
-        add_lines_at_target('// # Put new deserialization here', create_deserialization_code(Component, serializable_vars + additional_variables), -3)
-        print('Succesful added deserialization for ' + Component + '!')
+        add_to_binary_schema(Component, serializable_vars + additional_variables)
+        print('Succesful added binary schema for ' + Component + '!')
 
     components_to_remove = []
 
@@ -463,7 +390,7 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
         new_name, new_parent, new_is_parent, new_is_abstract = file
         if new_parent == Component:
             components_to_remove.append(new_name)
-            add_serialization(file, pick_vars, pick_files, indentation + 1)
+            add_serialization(file, pick_vars, pick_files)
 
     for trash in components_to_remove:
         index = 0
@@ -473,6 +400,38 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
             else:
                 index += 1
 
+def write_reflection_tables():
+    includes = set(create_header_code(name)[0] for name, Component, reflected_vars, is_abstract in reflection_tables)
+    includes = sorted(includes | {'#include "AK/AK.h"', '#include "ComponentReflection.h"'})
+
+    lines = [
+        '#pragma once',
+        '',
+        '// Generated by EngineHeaderTool, don\'t edit by hand.',
+        '',
+        '#include <tuple>',
+        '',
+    ]
+
+    lines += includes
+    lines += ['']
+
+    abstract_components = [Component for name, Component, reflected_vars, is_abstract in reflection_tables if is_abstract]
+
+    # Bases are always listed before the components derived from them
+    lines += ['#define ENUMERATE_ABSTRACT_COMPONENTS']
+    for Component in abstract_components:
+        readable = re.sub(r'(?<=[a-z])(?=[A-Z])', ' ', Component)
+        lines[-1] += ' \\'
+        lines += ['    ENUMERATE_COMPONENT(' + Component + ', "' + readable + '")']
+    lines += ['']
+
+    for name, Component, reflected_vars, is_abstract in reflection_tables:
+        lines += create_reflection_table_code(Component, reflected_vars, is_abstract)
+
+    with open(args.engine_dir + '/src/ComponentReflectionTables.h', 'w') as file:
+        file.writelines(line + '\n' for line in lines)
+
 def add_to_component_list(file):
     name, parent, is_parent, is_abstract = file
     name = name.replace("\\", "/")
@@ -506,28 +465,6 @@ sorted_files = sorted(files_to_serialize, key=lambda x: x[1] != "Component")
 for i in range(len(files_to_serialize)):
     print(files_to_serialize[i])
 
-remove_lines_between('// # Auto serialization start', '// # Put new serialization here')
-code = [
-    '    // # Auto serialization start',
-    '    {',
-    '        // NOTE: This only returns unmangled name while using the MSVC compiler',
-    '        std::string const name = typeid(*component).name();',
-    '        std::cout << "Error. Serialization of component " << name.substr(6) << " failed." << "\\n";',
-    '    }',
-    '    // # Put new serialization here'
-]
-add_lines_at_target('auto_serialize_component', code, 2)
-
-remove_lines_between('// # Auto deserialization start', '// # Put new deserialization here')
-code = [
-    '    // # Auto deserialization start',
-    '    {',
-    '        std::cout << "Error. Deserialization of component " << component_name << " failed." << "\\n";',
-    '    }',
-    '    // # Put new deserialization here'
-]
-add_lines_at_target('auto_deserialize_component', code, 4)
-
 remove_lines_between('// # Auto component list start', '// # Auto component list end', False, '/src/ComponentList.h')
 add_lines_at_target('// # Put new component here', ['    // # Auto component list start'], 0, '/src/ComponentList.h')
 add_lines_at_target('// # Put new component here', ['#define ENUMERATE_COMPONENTS \\'], 0, '/src/ComponentList.h')
@@ -539,6 +476,20 @@ for file in files_to_serialize:
 
 add_lines_at_target('// # Put new component here', ['    // # Auto component list end'], 0, '/src/ComponentList.h')
 
+write_reflection_tables()
+
+remove_lines_between('// # Auto binary schema hash start', '// # Auto binary schema hash end')
+code = [
+    '    // # Auto binary schema hash start',
+    '    return 0x' + format(compute_binary_schema_hash(binary_schema), '08x') + ';',
+    '    // # Auto binary schema hash end'
+]
+add_lines_at_target('SceneSerializer::get_binary_schema_hash', code, 2)
+
+# Used by SceneConverter.py to convert scenes between YAML and binary
+with open(args.engine_dir + '/EngineHeaderTool/BinarySchema.json', 'w') as file:
+    json.dump(binary_schema, file, indent=4)
+
 with open(args.engine_dir + '/src/SceneSerializer.cpp', 'w') as file:
     file.truncate(0)
     file.writelines(scene_serializer_lines)
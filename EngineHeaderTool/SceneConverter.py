@@ -0,0 +1,455 @@
+import os
+import re
+import json
+import glob
+import struct
+import argparse
+import yaml
+
+# Converts scene and prefab files between the YAML format and the binary format described in src/BinarySerialization.h.
+# YAML files stay the editable source, binary files are generated from them and loaded by the engine when they are up to date.
+# The layout of component fields comes from BinarySchema.json, which is written by EngineHeaderTool.py.
+
+BINARY_SCENE_VERSION = 1
+INVALID_INDEX = 0xFFFFFFFF
+
+HEADER_FORMAT = '<4s10I'
+ENTITY_FORMAT = '<3I3f3f3f2I'
+COMPONENT_FORMAT = '<6I'
+
+ENUM_TYPES = {'ColliderType2D', 'FactoryType', 'FloeButtonType', 'ParticleType', 'ShipType', 'SpawnType'}
+INTEGER_TYPES = {'i32': 'i', 'u32': 'I', 'u16': 'H', 'i16': 'h', 'u8': 'B', 'i8': 'b', 'int': 'i'}
+VECTOR_SIZES = {'glm::vec2': 2, 'glm::vec3': 3, 'glm::vec4': 4}
+
+# Fields of structs, in the order of BinaryCodec specializations in src/BinarySerializationExtensions.h
+STRUCT_FIELDS = {
+    'DXWave': ['glm::vec2', 'glm::vec2', 'float', 'float', 'float', 'float'],
+    'ConstantBufferWater': ['glm::vec4', 'glm::vec4', 'float', 'float', 'float', 'float', 'float', 'float'],
+    'SpawnEvent': ['std::vector<ShipType>', 'SpawnType'],
+    'FloaterSettings': ['float', 'float', 'float', 'float', 'float'],
+    'DialogueObject': ['bool', 'std::string', 'std::string', 'std::string', 'std::string'],
+}
+
+
+def fnv1a_hash(text):
+    hash = 0x811c9dc5
+    for byte in text.encode('utf-8'):
+        hash ^= byte
+        hash = (hash * 0x01000193) & 0xFFFFFFFF
+    return hash
+
+
+# NOTE: Keep in sync with compute_binary_schema_hash in EngineHeaderTool.py
+def compute_binary_schema_hash(schema):
+    text = ''
+    for component in sorted(schema, key=lambda x: x['name']):
+        text += component['name'] + ':' + ','.join(var_type + ' ' + var_name for var_type, var_name in component['fields']) + ';'
+    return fnv1a_hash(text)
+
+
+def vector_element_type(var_type):
+    match = re.fullmatch(r'std::vector<(.+)>', var_type)
+    return match.group(1) if match else None
+
+
+def reference_type(var_type):
+    match = re.fullmatch(r'std::(weak|shared)_ptr<(.+)>', var_type)
+    if match and match.group(2) not in ('Material', 'Shader'):
+        return match.group(2)
+    return None
+
+
+def parse_bool(value):
+    return str(value).lower() in ('true', 'yes', 'on', 'y')
+
+
+def format_float(value):
+    # Same precision as yaml-cpp uses for floats
+    text = '%.9g' % value
+    return text
+
+
+class BinaryWriter:
+    def __init__(self):
+        self.strings = []
+        self.string_indices = {}
+        self.entities = []
+        self.components = []
+        self.blob = bytearray()
+
+    def add_string(self, text):
+        text = '' if text is None else str(text)
+        if text not in self.string_indices:
+            self.string_indices[text] = len(self.strings)
+            self.strings.append(text)
+        return self.string_indices[text]
+
+    def write(self, var_type, value):
+        element_type = vector_element_type(var_type)
+
+        if element_type is not None:
+            values = value or []
+            self.blob += struct.pack('<I', len(values))
+            for element in values:
+                self.write(element_type, element)
+        elif reference_type(var_type) is not None:
+            guid = value.get('guid', 'nullptr') if isinstance(value, dict) else 'nullptr'
+            self.blob += struct.pack('<I', INVALID_INDEX if guid in ('nullptr', '', None) else self.add_string(guid))
+        elif var_type == 'std::shared_ptr<Material>':
+            shader = value['Shader']
+            self.write('std::string', shader['VertexPath'])
+            self.write('std::string', shader['FragmentPath'])
+            self.write('std::string', shader['GeometryPath'])
+            self.write('glm::vec4', value['Color'])
+            self.write('i32', value['RenderOrder'])
+            self.write('bool', value['NeedsForward'])
+            self.write('bool', value['CastsShadows'])
+            self.write('bool', value.get('IsBillboard', 'false'))
+        elif var_type in STRUCT_FIELDS:
+            for field_type, field_value in zip(STRUCT_FIELDS[var_type], value):
+                self.write(field_type, field_value)
+        elif var_type in VECTOR_SIZES:
+            self.blob += struct.pack('<%df' % VECTOR_SIZES[var_type], *[float(x) for x in value])
+        elif var_type == 'float':
+            self.blob += struct.pack('<f', float(value))
+        elif var_type == 'bool':
+            self.blob += struct.pack('<?', parse_bool(value))
+        elif var_type in INTEGER_TYPES:
+            self.blob += struct.pack('<' + INTEGER_TYPES[var_type], int(value))
+        elif var_type in ENUM_TYPES:
+            self.blob += struct.pack('<i', int(value))
+        elif var_type == 'std::string':
+            self.blob += struct.pack('<I', self.add_string(value))
+        else:
+            raise ValueError('Unsupported type ' + var_type)
+
+    def add_entity(self, entity, schema):
+        transform = entity['TransformComponent']
+        parent_guid = transform['Parent']['guid']
+
+        record = [
+            self.add_string(entity['guid']),
+            self.add_string(entity['Name']),
+            INVALID_INDEX if parent_guid == '' else self.add_string(parent_guid),
+            [float(x) for x in transform['Translation']],
+            [float(x) for x in transform['Rotation']],
+            [float(x) for x in transform['Scale']],
+            len(self.components),
+            0,
+        ]
+
+        for component in entity.get('Components') or []:
+            name = component['ComponentName']
+
+            if name not in schema:
+                print('Skipping component ' + name + ' that is not in the schema')
+                continue
+
+            component_record = [
+                fnv1a_hash(name),
+                self.add_string(name),
+                self.add_string(component['guid']),
+                self.add_string(component['custom_name']),
+                len(self.blob),
+                0,
+            ]
+
+            mask_offset = len(self.blob)
+            self.blob += struct.pack('<Q', 0)
+            mask = 0
+
+            for index, (var_type, var_name) in enumerate(schema[name]):
+                if var_name not in component:
+                    continue
+                mask |= 1 << index
+                self.write(var_type, component[var_name])
+
+            struct.pack_into('<Q', self.blob, mask_offset, mask)
+            component_record[5] = len(self.blob) - component_record[4]
+            self.components.append(component_record)
+            record[7] += 1
+
+        self.entities.append(record)
+
+    def finish(self, schema_hash):
+        data = bytearray(struct.calcsize(HEADER_FORMAT))
+
+        string_table_offset = len(data)
+        for text in self.strings:
+            encoded = text.encode('utf-8')
+            data += struct.pack('<I', len(encoded)) + encoded
+
+        data += bytes((4 - len(data) % 4) % 4)
+
+        entity_table_offset = len(data)
+        for guid, name, parent, position, rotation, scale, first, count in self.entities:
+            data += struct.pack(ENTITY_FORMAT, guid, name, parent, *position, *rotation, *scale, first, count)
+
+        component_table_offset = len(data)
+        for record in self.components:
+            data += struct.pack(COMPONENT_FORMAT, *record)
+
+        blob_offset = len(data)
+        data += self.blob
+
+        struct.pack_into(HEADER_FORMAT, data, 0, b'ESCN', BINARY_SCENE_VERSION, schema_hash, len(self.strings), len(self.entities),
+                         len(self.components), string_table_offset, entity_table_offset, component_table_offset, blob_offset,
+                         len(self.blob))
+        return bytes(data)
+
+
+class BinaryReader:
+    def __init__(self, data, schema_hash):
+        (magic, version, file_schema_hash, string_count, entity_count, component_count, string_table_offset, entity_table_offset,
+         component_table_offset, blob_offset, blob_size) = struct.unpack_from(HEADER_FORMAT, data, 0)
+
+        if magic != b'ESCN':
+            raise ValueError('Not a binary scene file')
+        if version != BINARY_SCENE_VERSION or file_schema_hash != schema_hash:
+            raise ValueError('Binary scene file was written with a different schema')
+
+        self.data = data
+        self.strings = []
+        offset = string_table_offset
+        for _ in range(string_count):
+            (length,) = struct.unpack_from('<I', data, offset)
+            offset += 4
+            self.strings.append(data[offset:offset + length].decode('utf-8'))
+            offset += length
+
+        entity_size = struct.calcsize(ENTITY_FORMAT)
+        self.entities = [struct.unpack_from(ENTITY_FORMAT, data, entity_table_offset + i * entity_size) for i in range(entity_count)]
+
+        component_size = struct.calcsize(COMPONENT_FORMAT)
+        self.components = [struct.unpack_from(COMPONENT_FORMAT, data, component_table_offset + i * component_size)
+                           for i in range(component_count)]
+
+        self.blob = data[blob_offset:blob_offset + blob_size]
+        self.cursor = 0
+
+    def get_string(self, index):
+        return '' if index == INVALID_INDEX else self.strings[index]
+
+    def unpack(self, format):
+        values = struct.unpack_from(format, self.blob, self.cursor)
+        self.cursor += struct.calcsize(format)
+        return values
+
+    def read(self, var_type):
+        element_type = vector_element_type(var_type)
+
+        if element_type is not None:
+            (count,) = self.unpack('<I')
+            return [self.read(element_type) for _ in range(count)]
+        if reference_type(var_type) is not None:
+            (index,) = self.unpack('<I')
+            return {'guid': 'nullptr' if index == INVALID_INDEX else self.get_string(index)}
+        if var_type == 'std::shared_ptr<Material>':
+            shader = {'VertexPath': self.read('std::string'), 'FragmentPath': self.read('std::string'),
+                      'GeometryPath': self.read('std::string')}
+            return {'Shader': shader, 'Color': self.read('glm::vec4'), 'RenderOrder': self.read('i32'),
+                    'NeedsForward': self.read('bool'), 'CastsShadows': self.read('bool'), 'IsBillboard': self.read('bool')}
+        if var_type in STRUCT_FIELDS:
+            return [self.read(field_type) for field_type in STRUCT_FIELDS[var_type]]
+        if var_type in VECTOR_SIZES:
+            return list(self.unpack('<%df' % VECTOR_SIZES[var_type]))
+        if var_type == 'float':
+            return self.unpack('<f')[0]
+        if var_type == 'bool':
+            return self.unpack('<?')[0]
+        if var_type in INTEGER_TYPES:
+            return self.unpack('<' + INTEGER_TYPES[var_type])[0]
+        if var_type in ENUM_TYPES:
+            return self.unpack('<i')[0]
+        if var_type == 'std::string':
+            return self.get_string(self.unpack('<I')[0])
+        raise ValueError('Unsupported type ' + var_type)
+
+    def read_entities(self, schema):
+        entities = []
+
+        for guid, name, parent, px, py, pz, rx, ry, rz, sx, sy, sz, first, count in self.entities:
+            components = []
+
+            for type_hash, type_name, component_guid, custom_name, blob_offset, blob_size in self.components[first:first + count]:
+                component_name = self.get_string(type_name)
+                component = {'ComponentName': component_name, 'guid': self.get_string(component_guid),
+                             'custom_name': self.get_string(custom_name)}
+
+                self.cursor = blob_offset
+                (mask,) = self.unpack('<Q')
+
+                for index, (var_type, var_name) in enumerate(schema[component_name]):
+                    if mask & (1 << index):
+                        component[var_name] = (var_type, self.read(var_type))
+
+                components.append(component)
+
+            entities.append({'guid': self.get_string(guid), 'Name': self.get_string(name), 'Parent': self.get_string(parent),
+                             'Translation': [px, py, pz], 'Rotation': [rx, ry, rz], 'Scale': [sx, sy, sz],
+                             'Components': components})
+
+        return entities
+
+
+# Emits YAML laid out the same way as yaml-cpp does in SceneSerializer
+class YamlEmitter:
+    def __init__(self):
+        self.lines = []
+
+    @staticmethod
+    def scalar(value):
+        if isinstance(value, bool):
+            return 'true' if value else 'false'
+        if isinstance(value, float):
+            return format_float(value)
+        if isinstance(value, int):
+            return str(value)
+
+        text = str(value)
+        needs_quotes = (text == '' or text != text.strip() or re.search(r'[:#\[\]{},&*!|>\'"%@`?\n]', text) is not None
+                        or text.lower() in ('true', 'false', 'yes', 'no', 'on', 'off', 'null', '~', 'y', 'n')
+                        or re.fullmatch(r'[-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?', text) is not None or text[0] in '-?')
+        if not needs_quotes:
+            return text
+        return '"' + text.replace('\\', '\\\\').replace('"', '\\"').replace('\n', '\\n') + '"'
+
+    @staticmethod
+    def flow(value):
+        if isinstance(value, list):
+            return '[' + ', '.join(YamlEmitter.flow(x) for x in value) + ']'
+        return YamlEmitter.scalar(value)
+
+    def value(self, indent, key, var_type, value):
+        prefix = ' ' * indent + key + ':'
+        element_type = vector_element_type(var_type)
+
+        if element_type is not None:
+            if not value:
+                self.lines.append(prefix)
+                self.lines.append(' ' * (indent + 2) + '[]')
+                return
+            self.lines.append(prefix)
+            for element in value:
+                if reference_type(element_type) is not None:
+                    self.lines.append(' ' * (indent + 2) + '- guid: ' + self.scalar(element['guid']))
+                else:
+                    self.lines.append(' ' * (indent + 2) + '- ' + self.flow(element))
+        elif reference_type(var_type) is not None:
+            self.lines.append(prefix)
+            self.lines.append(' ' * (indent + 2) + 'guid: ' + self.scalar(value['guid']))
+        elif var_type == 'std::shared_ptr<Material>':
+            self.lines.append(prefix)
+            self.lines.append(' ' * (indent + 2) + 'Shader:')
+            for shader_key in ('VertexPath', 'FragmentPath', 'GeometryPath'):
+                self.lines.append(' ' * (indent + 4) + shader_key + ': ' + self.scalar(value['Shader'][shader_key]))
+            for material_key in ('Color', 'RenderOrder', 'NeedsForward', 'CastsShadows', 'IsBillboard'):
+                self.lines.append(' ' * (indent + 2) + material_key + ': ' + self.flow(value[material_key]))
+        else:
+            self.lines.append(prefix + ' ' + self.flow(value))
+
+    def emit(self, entities):
+        self.lines = ['Scene: Untitled', 'Entities:']
+
+        for entity in entities:
+            self.lines.append('  - Entity: ' + self.scalar(entity['Name']))
+            self.lines.append('    guid: ' + self.scalar(entity['guid']))
+            self.lines.append('    Name: ' + self.scalar(entity['Name']))
+            self.lines.append('    TransformComponent:')
+            for key in ('Translation', 'Rotation', 'Scale'):
+                self.lines.append('      ' + key + ': ' + self.flow(entity[key]))
+            self.lines.append('      Parent:')
+            self.lines.append('        guid: ' + self.scalar(entity['Parent']))
+
+            if not entity['Components']:
+                self.lines.append('    Components:')
+                self.lines.append('      []')
+                continue
+
+            self.lines.append('    Components:')
+            for component in entity['Components']:
+                self.lines.append('      - ComponentName: ' + self.scalar(component['ComponentName']))
+                self.lines.append('        guid: ' + self.scalar(component['guid']))
+                self.lines.append('        custom_name: ' + self.scalar(component['custom_name']))
+                for key, field in component.items():
+                    if key in ('ComponentName', 'guid', 'custom_name'):
+                        continue
+                    var_type, value = field
+                    self.value(8, key, var_type, value)
+
+        return '\n'.join(self.lines) + '\n'
+
+
+def load_schema(schema_path):
+    with open(schema_path, 'r') as file:
+        schema_list = json.load(file)
+    schema = {component['name']: [tuple(field) for field in component['fields']] for component in schema_list}
+    return schema, compute_binary_schema_hash(schema_list)
+
+
+def yaml_to_binary(text, schema, schema_hash):
+    # BaseLoader keeps every scalar as a string, so nothing is guessed, just like in yaml-cpp
+    data = yaml.load(text, Loader=yaml.BaseLoader)
+    writer = BinaryWriter()
+
+    for entity in data.get('Entities') or []:
+        writer.add_entity(entity, schema)
+
+    return writer.finish(schema_hash)
+
+
+def binary_to_yaml(data, schema, schema_hash):
+    reader = BinaryReader(data, schema_hash)
+    return YamlEmitter().emit(reader.read_entities(schema))
+
+
+def collect_files(paths, extension):
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            files += sorted(glob.glob(os.path.join(path, '*' + extension)))
+        else:
+            files.append(path)
+    return files
+
+
+parser = argparse.ArgumentParser(description='Converts scenes and prefabs between YAML and binary')
+parser.add_argument('-d', '--engine_dir', action='store', default='..', help='root directory of the engine')
+parser.add_argument('-y', '--to_yaml', action='store_true', help='convert binary files back to YAML instead')
+parser.add_argument('-v', '--verify', action='store_true', help='check that YAML -> binary -> YAML -> binary gives the same binary')
+parser.add_argument('paths', nargs='*', help='files or directories, res/scenes and res/prefabs by default')
+
+args = parser.parse_args()
+
+schema, schema_hash = load_schema(os.path.join(args.engine_dir, 'EngineHeaderTool', 'BinarySchema.json'))
+paths = args.paths or [os.path.join(args.engine_dir, 'res', 'scenes'), os.path.join(args.engine_dir, 'res', 'prefabs')]
+failed = False
+
+if args.to_yaml:
+    for binary_path in collect_files(paths, '.bin'):
+        with open(binary_path, 'rb') as file:
+            text = binary_to_yaml(file.read(), schema, schema_hash)
+        with open(os.path.splitext(binary_path)[0] + '.txt', 'w', newline='\n') as file:
+            file.write(text)
+        print('Converted ' + binary_path)
+else:
+    for yaml_path in collect_files(paths, '.txt'):
+        with open(yaml_path, 'r', encoding='utf-8') as file:
+            text = file.read()
+
+        binary = yaml_to_binary(text, schema, schema_hash)
+
+        if args.verify:
+            round_trip = yaml_to_binary(binary_to_yaml(binary, schema, schema_hash), schema, schema_hash)
+            if round_trip != binary:
+                print('Round trip failed for ' + yaml_path)
+                failed = True
+                continue
+
+        with open(os.path.splitext(yaml_path)[0] + '.bin', 'wb') as file:
+            file.write(binary)
+
+        print('Converted ' + yaml_path + ' (' + str(len(text)) + ' -> ' + str(len(binary)) + ' bytes)')
+
+if failed:
+    exit(1)
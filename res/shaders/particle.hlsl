@@ -4,10 +4,21 @@ cbuffer object_buffer : register(b0)
 {
     float4x4 projection_view_model;
     float4x4 world;
+    float4x4 projection_view;
 };
 
 cbuffer ConstantBufferParticle : register(b4)
 {
+    float4 camera_right;
+    float4 camera_up;
+};
+
+struct ParticleInstance
+{
+    float3 position;
+    float rotation;
+    float2 size;
+    float2 padding;
     float4 color;
 };
 
@@ -23,17 +34,34 @@ struct VS_Output
     float4 pos : SV_POSITION;
     float2 UV : TEXCOORD;
     float3 normal : NORMAL;
+    float4 color : COLOR;
 };
 
-Texture2D ObjTexture;
+Texture2D ObjTexture : register(t0);
 SamplerState ObjSamplerState;
 
-VS_Output vs_main(VS_Input input)
+// Every particle of an emitter, in world space
+StructuredBuffer<ParticleInstance> particles : register(t1);
+
+VS_Output vs_main(VS_Input input, uint instance_id : SV_InstanceID)
 {
+    ParticleInstance particle = particles[instance_id];
+
+    // The sprite is scaled, rotated around its center and turned towards the camera
+    float rotation_sin;
+    float rotation_cos;
+    sincos(particle.rotation, rotation_sin, rotation_cos);
+
+    float2 corner = input.pos.xy * particle.size;
+    corner = float2(corner.x * rotation_cos - corner.y * rotation_sin, corner.x * rotation_sin + corner.y * rotation_cos);
+
+    float3 world_position = particle.position + camera_right.xyz * corner.x + camera_up.xyz * corner.y;
+
     VS_Output output;
-    output.pos = mul(projection_view_model,float4(input.pos.xyz, 1.0f));
+    output.pos = mul(projection_view, float4(world_position, 1.0f));
     output.normal = input.normal;
     output.UV = input.UV;
+    output.color = particle.color;
     return output;
 }
 
@@ -46,7 +74,7 @@ float4 ps_main(VS_Output input) : SV_TARGET
 
     if (final_color.a > bias)
     {
-        final_color *= color;
+        final_color *= input.color;
     }
 
     return float4(exposure_tonemapping(gamma_correction(final_color.xyz)), final_color.a);
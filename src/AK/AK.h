@@ -1,12 +1,14 @@
 #pragma once
 
 #include <codecvt>
+#include <cstring>
 #include <iomanip>
 #include <locale>
 #include <memory>
 #include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include <glm/glm.hpp>
 
@@ -185,6 +187,77 @@ inline u32 murmur_hash(u8 const* key, size_t const len, u32 const seed)
     return h;
 }
 
+// Stable across compilers and runs, so it can be stored in files. Usable in constant expressions.
+constexpr u32 fnv1a_hash(std::string_view const str)
+{
+    u32 hash = 0x811c9dc5;
+    for (char const c : str)
+    {
+        hash ^= static_cast<u8>(c);
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+// 64-bit version of fnv1a_hash(), for keys where 32-bit hashes collide too easily.
+constexpr u64 fnv1a_hash64(std::string_view const str)
+{
+    u64 hash = 0xcbf29ce484222325;
+    for (char const c : str)
+    {
+        hash ^= static_cast<u8>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+// MurmurHash64A. Reads 8 bytes at a time, so it's a lot faster than fnv1a_hash64() on large buffers like vertices.
+inline u64 murmur_hash64(void const* data, size_t const len, u64 const seed)
+{
+    u64 constexpr m = 0xc6a4a7935bd1e995;
+    i32 constexpr r = 47;
+
+    u64 h = seed ^ (len * m);
+
+    u8 const* key = static_cast<u8 const*>(data);
+    u8 const* const end = key + (len & ~static_cast<size_t>(7));
+
+    for (; key != end; key += 8)
+    {
+        u64 k = 0;
+        std::memcpy(&k, key, sizeof(k));
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+    }
+
+    size_t const remaining = len & 7;
+    if (remaining != 0)
+    {
+        for (size_t i = remaining; i > 0; --i)
+        {
+            h ^= static_cast<u64>(key[i - 1]) << (8 * (i - 1));
+        }
+
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+// Mixes value into seed. The order in which values are combined matters.
+constexpr u64 hash_combine(u64 const seed, u64 const value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
 template<typename T>
 void swap_and_erase(std::vector<T>& vector, T element)
 {
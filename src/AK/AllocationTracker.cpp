@@ -0,0 +1,219 @@
+#include "AllocationTracker.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace AK
+{
+
+namespace
+{
+
+size_t constexpr subsystem_count = static_cast<size_t>(Subsystem::Count);
+
+// These are constant-initialized, so allocations made before main() are counted too
+std::array<std::atomic<u64>, subsystem_count> total_counts = {};
+std::array<std::atomic<u64>, subsystem_count> total_bytes = {};
+
+std::array<AllocationStats, subsystem_count> frame_start = {};
+std::array<AllocationStats, subsystem_count> last_frame = {};
+
+thread_local Subsystem current_subsystem = Subsystem::Other;
+thread_local AllocationStats thread_total = {};
+
+}
+
+void AllocationTracker::begin_frame()
+{
+    for (size_t i = 0; i < subsystem_count; ++i)
+    {
+        AllocationStats const total = {total_counts[i].load(std::memory_order_relaxed), total_bytes[i].load(std::memory_order_relaxed)};
+
+        last_frame[i].count = total.count - frame_start[i].count;
+        last_frame[i].bytes = total.bytes - frame_start[i].bytes;
+        frame_start[i] = total;
+    }
+}
+
+AllocationStats AllocationTracker::get_last_frame()
+{
+    AllocationStats stats = {};
+
+    for (auto const& subsystem_stats : last_frame)
+    {
+        stats.count += subsystem_stats.count;
+        stats.bytes += subsystem_stats.bytes;
+    }
+
+    return stats;
+}
+
+AllocationStats AllocationTracker::get_last_frame(Subsystem const subsystem)
+{
+    return last_frame[static_cast<size_t>(subsystem)];
+}
+
+AllocationStats AllocationTracker::get_total()
+{
+    AllocationStats stats = {};
+
+    for (size_t i = 0; i < subsystem_count; ++i)
+    {
+        stats.count += total_counts[i].load(std::memory_order_relaxed);
+        stats.bytes += total_bytes[i].load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+AllocationStats AllocationTracker::get_thread_total()
+{
+    return thread_total;
+}
+
+#if defined(_WIN32)
+
+u64 AllocationTracker::get_resident_bytes()
+{
+    PROCESS_MEMORY_COUNTERS counters = {};
+
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.WorkingSetSize;
+}
+
+u64 AllocationTracker::get_peak_resident_bytes()
+{
+    PROCESS_MEMORY_COUNTERS counters = {};
+
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.PeakWorkingSetSize;
+}
+
+#else
+
+u64 AllocationTracker::get_resident_bytes()
+{
+    FILE* const statm = std::fopen("/proc/self/statm", "r");
+
+    if (statm == nullptr)
+        return 0;
+
+    unsigned long long total_pages = 0;
+    unsigned long long resident_pages = 0;
+    int const read_count = std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages);
+    std::fclose(statm);
+
+    if (read_count != 2)
+        return 0;
+
+    return resident_pages * static_cast<u64>(sysconf(_SC_PAGESIZE));
+}
+
+u64 AllocationTracker::get_peak_resident_bytes()
+{
+    rusage usage = {};
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    // Reported in kilobytes
+    return static_cast<u64>(usage.ru_maxrss) * 1024;
+}
+
+#endif
+
+char const* AllocationTracker::get_subsystem_name(Subsystem const subsystem)
+{
+    switch (subsystem)
+    {
+    case Subsystem::Other:
+        return "Other";
+    case Subsystem::Scene:
+        return "Scene";
+    case Subsystem::Physics:
+        return "Physics";
+    case Subsystem::Renderer:
+        return "Renderer";
+    case Subsystem::Editor:
+        return "Editor";
+    default:
+        return "Unknown";
+    }
+}
+
+void AllocationTracker::record_allocation(size_t const size)
+{
+    auto const index = static_cast<size_t>(current_subsystem);
+    total_counts[index].fetch_add(1, std::memory_order_relaxed);
+    total_bytes[index].fetch_add(size, std::memory_order_relaxed);
+    thread_total.count += 1;
+    thread_total.bytes += size;
+}
+
+AllocationScope::AllocationScope(Subsystem const subsystem) : m_previous_subsystem(current_subsystem)
+{
+    current_subsystem = subsystem;
+}
+
+AllocationScope::~AllocationScope()
+{
+    current_subsystem = m_previous_subsystem;
+}
+
+}
+
+// Replacing the global operator new is the only way to see allocations made by the standard containers and thirdparty code.
+// Aligned and nothrow variants are left alone, the default nothrow ones forward to these anyway.
+void* operator new(size_t const size)
+{
+    AK::AllocationTracker::record_allocation(size);
+
+    // malloc(0) is allowed to return nullptr, operator new isn't
+    if (void* const pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t const size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* const pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* const pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* const pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* const pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Types.h"
+
+namespace AK
+{
+
+enum class Subsystem : u8
+{
+    Other,
+    Scene,
+    Physics,
+    Renderer,
+    Editor,
+    Count,
+};
+
+struct AllocationStats
+{
+    u64 count = 0;
+    u64 bytes = 0;
+};
+
+// Counts every heap allocation made through the global operator new. Allocations are attributed to the subsystem
+// set with AllocationScope on the allocating thread, everything else ends up in Subsystem::Other.
+class AllocationTracker
+{
+public:
+    // Called once per frame by the Engine. Finishes the current frame and starts counting the next one.
+    static void begin_frame();
+
+    [[nodiscard]] static AllocationStats get_last_frame();
+    [[nodiscard]] static AllocationStats get_last_frame(Subsystem const subsystem);
+
+    // Allocations made since the application started. Subtract two of these to measure a piece of code.
+    [[nodiscard]] static AllocationStats get_total();
+
+    // Allocations made by the calling thread since it started, so measurements don't count the ones of other threads.
+    [[nodiscard]] static AllocationStats get_thread_total();
+
+    // Memory of the whole process that is currently in RAM, as reported by the OS. Unlike the counters above,
+    // this includes memory-mapped files and allocations that don't go through operator new.
+    [[nodiscard]] static u64 get_resident_bytes();
+    [[nodiscard]] static u64 get_peak_resident_bytes();
+
+    [[nodiscard]] static char const* get_subsystem_name(Subsystem const subsystem);
+
+    static void record_allocation(size_t const size);
+};
+
+class AllocationScope
+{
+public:
+    explicit AllocationScope(Subsystem const subsystem);
+    ~AllocationScope();
+
+    AllocationScope(AllocationScope const&) = delete;
+    AllocationScope& operator=(AllocationScope const&) = delete;
+
+private:
+    Subsystem m_previous_subsystem;
+};
+
+}
@@ -0,0 +1,38 @@
+#include "FileStamp.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace AK
+{
+
+std::optional<FileStamp> FileStamp::get(std::string const& file_path)
+{
+    std::error_code error;
+    auto const write_time = std::filesystem::last_write_time(file_path, error);
+
+    if (error)
+        return std::nullopt;
+
+    u64 const size = std::filesystem::file_size(file_path, error);
+
+    if (error)
+        return std::nullopt;
+
+    return FileStamp {size, static_cast<i64>(write_time.time_since_epoch().count())};
+}
+
+bool overwrite_file(std::string const& file_path, u64 const offset, std::span<u8 const> const bytes)
+{
+    // Opened for reading as well, so the file isn't truncated
+    std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+
+    if (!file.is_open())
+        return false;
+
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+}
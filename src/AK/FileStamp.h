@@ -0,0 +1,29 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Size and last write time of a file on disk. Cooked files keep the stamps of the files they were cooked from, so checking
+// them only takes a stat of every source. Only sources whose stamp differs have to be read and hashed again.
+struct FileStamp
+{
+    u64 size = 0;
+    i64 write_time = 0;
+
+    // Returns nothing for files that aren't on disk, ex. when they are only packed into an archive.
+    [[nodiscard]] static std::optional<FileStamp> get(std::string const& file_path);
+
+    [[nodiscard]] bool operator==(FileStamp const& other) const = default;
+};
+
+// Overwrites bytes of a file in place, ex. stamps of a cooked file whose sources were touched but not changed.
+// The file can be mapped meanwhile, mapped files share write access.
+bool overwrite_file(std::string const& file_path, u64 const offset, std::span<u8 const> const bytes);
+
+}
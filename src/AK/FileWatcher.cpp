@@ -0,0 +1,400 @@
+#include "FileWatcher.h"
+
+#include <filesystem>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <array>
+#include <string_view>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+namespace AK
+{
+
+#if defined(_WIN32)
+
+struct FileWatcher::DirectoryChanges
+{
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    OVERLAPPED overlapped = {};
+    bool is_reading = false;
+
+    // Changes past the size of the buffer are lost, and reported as an empty read. Has to be DWORD aligned.
+    alignas(DWORD) std::array<std::byte, 64 * 1024> buffer = {};
+};
+
+#endif
+
+FileWatcher::FileWatcher() = default;
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+bool FileWatcher::start(std::string const& directory, std::chrono::milliseconds const poll_interval)
+{
+    stop();
+
+    std::error_code error;
+
+    if (!std::filesystem::is_directory(directory, error))
+        return false;
+
+    m_directory = directory;
+    m_poll_interval = poll_interval;
+
+#if defined(__linux__)
+    m_inotify_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (m_inotify_descriptor >= 0)
+    {
+        // Fails with more directories than the watch limit of the user, some changes would be missed then
+        if (add_watches(m_directory, false))
+        {
+            m_is_native = true;
+            m_thread = std::jthread([this](std::stop_token const& stop_token) { run_inotify(stop_token); });
+            return true;
+        }
+
+        close(m_inotify_descriptor);
+        m_inotify_descriptor = -1;
+        m_watched_directories.clear();
+    }
+#elif defined(_WIN32)
+    std::wstring const wide_directory = std::filesystem::path(m_directory).wstring();
+    m_directory_changes = std::make_unique<DirectoryChanges>();
+    m_directory_changes->directory = CreateFileW(wide_directory.c_str(), FILE_LIST_DIRECTORY,
+                                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                                 FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    m_directory_changes->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    // Read once before returning, changes made right after start() are collected from then on
+    if (m_directory_changes->directory != INVALID_HANDLE_VALUE && m_directory_changes->overlapped.hEvent != nullptr
+        && read_directory_changes())
+    {
+        m_is_native = true;
+        m_thread = std::jthread([this](std::stop_token const& stop_token) { run_directory_changes(stop_token); });
+        return true;
+    }
+
+    close_directory_changes();
+#endif
+
+    m_is_native = false;
+
+    // Files that exist now aren't changes, only the ones that differ from them later are
+    std::unordered_map<std::string, FileState> files = {};
+    scan(files);
+
+    m_thread = std::jthread(
+        [this, files = std::move(files)](std::stop_token const& stop_token) mutable { run_polling(stop_token, std::move(files)); });
+
+    return true;
+}
+
+void FileWatcher::stop()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.request_stop();
+        m_stop_requested.notify_all();
+        m_thread.join();
+    }
+
+#if defined(__linux__)
+    if (m_inotify_descriptor >= 0)
+    {
+        close(m_inotify_descriptor);
+        m_inotify_descriptor = -1;
+    }
+
+    m_watched_directories.clear();
+#elif defined(_WIN32)
+    close_directory_changes();
+#endif
+
+    std::lock_guard lock(m_mutex);
+    m_changes.clear();
+    m_changed_paths.clear();
+}
+
+bool FileWatcher::is_running() const
+{
+    return m_thread.joinable();
+}
+
+bool FileWatcher::is_native() const
+{
+    return m_is_native;
+}
+
+std::vector<std::string> FileWatcher::take_changes()
+{
+    std::lock_guard lock(m_mutex);
+    m_changed_paths.clear();
+    return std::exchange(m_changes, {});
+}
+
+void FileWatcher::run_polling(std::stop_token const& stop_token, std::unordered_map<std::string, FileState> files)
+{
+    std::unordered_map<std::string, FileState> current_files = {};
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            static_cast<void>(m_stop_requested.wait_for(lock, stop_token, m_poll_interval, [] { return false; }));
+        }
+
+        if (stop_token.stop_requested())
+            return;
+
+        current_files.clear();
+        scan(current_files);
+
+        for (auto const& [path, state] : current_files)
+        {
+            auto const it = files.find(path);
+
+            if (it == files.end() || it->second.write_time != state.write_time || it->second.size != state.size)
+                push_change(path);
+        }
+
+        for (auto const& [path, state] : files)
+        {
+            if (!current_files.contains(path))
+                push_change(path);
+        }
+
+        std::swap(files, current_files);
+    }
+}
+
+void FileWatcher::scan(std::unordered_map<std::string, FileState>& files) const
+{
+    std::error_code error;
+
+    // Files can be removed while they are listed, those are simply skipped
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(m_directory, error))
+    {
+        if (!entry.is_regular_file(error))
+            continue;
+
+        FileState state = {};
+        state.write_time = entry.last_write_time(error).time_since_epoch().count();
+        state.size = entry.file_size(error);
+        files.insert_or_assign(entry.path().generic_string(), state);
+    }
+}
+
+void FileWatcher::push_change(std::string path)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_changed_paths.emplace(path).second)
+        m_changes.emplace_back(std::move(path));
+}
+
+#if defined(__linux__)
+
+void FileWatcher::run_inotify(std::stop_token const& stop_token)
+{
+    alignas(inotify_event) char buffer[4096];
+    pollfd descriptor = {m_inotify_descriptor, POLLIN, 0};
+
+    // Wakes up regularly to notice that it should stop
+    while (!stop_token.stop_requested())
+    {
+        if (poll(&descriptor, 1, 100) <= 0)
+            continue;
+
+        ssize_t length = 0;
+
+        while ((length = read(m_inotify_descriptor, buffer, sizeof(buffer))) > 0)
+        {
+            for (ssize_t offset = 0; offset < length;)
+            {
+                auto const* event = reinterpret_cast<inotify_event const*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                if ((event->mask & IN_IGNORED) != 0)
+                {
+                    m_watched_directories.erase(event->wd);
+                    continue;
+                }
+
+                auto const it = m_watched_directories.find(event->wd);
+
+                if (it == m_watched_directories.end() || event->len == 0)
+                    continue;
+
+                std::string const path = it->second + "/" + event->name;
+
+                // Files in new directories are reported too, they could have been written before the directory was watched
+                if ((event->mask & IN_ISDIR) != 0)
+                {
+                    if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+                        static_cast<void>(add_watches(path, true));
+
+                    continue;
+                }
+
+                // Files are reported once they are written and closed, not when they are created empty
+                if ((event->mask & IN_CREATE) == 0)
+                    push_change(path);
+            }
+        }
+    }
+}
+
+bool FileWatcher::add_watches(std::string const& directory, bool const report_files)
+{
+    u32 constexpr mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    i32 const watch_descriptor = inotify_add_watch(m_inotify_descriptor, directory.c_str(), mask);
+
+    if (watch_descriptor < 0)
+        return false;
+
+    m_watched_directories.insert_or_assign(watch_descriptor, directory);
+
+    bool is_watched = true;
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        std::string const path = directory + "/" + entry.path().filename().string();
+
+        if (entry.is_directory(error))
+            is_watched = add_watches(path, report_files) && is_watched;
+        else if (report_files && entry.is_regular_file(error))
+            push_change(path);
+    }
+
+    return is_watched;
+}
+
+#elif defined(_WIN32)
+
+void FileWatcher::run_directory_changes(std::stop_token const& stop_token)
+{
+    auto& changes = *m_directory_changes;
+    std::vector<std::byte> events = {};
+
+    // Wakes up regularly to notice that it should stop
+    while (!stop_token.stop_requested())
+    {
+        if (WaitForSingleObject(changes.overlapped.hEvent, 100) != WAIT_OBJECT_0)
+            continue;
+
+        DWORD length = 0;
+        bool const is_read = GetOverlappedResult(changes.directory, &changes.overlapped, &length, FALSE) != 0;
+        changes.is_reading = false;
+
+        // Copied, so the next read can start collecting changes while these are reported
+        events.assign(changes.buffer.begin(), changes.buffer.begin() + (is_read ? length : 0));
+
+        // The directory was removed or renamed, polling notices if it comes back
+        if (!read_directory_changes())
+        {
+            m_is_native = false;
+
+            std::unordered_map<std::string, FileState> files = {};
+            scan(files);
+            run_polling(stop_token, std::move(files));
+            return;
+        }
+
+        // Too many changes to fit in the buffer, every file is reported so none is missed
+        if (events.empty())
+        {
+            push_files(m_directory);
+            continue;
+        }
+
+        for (size_t offset = 0;;)
+        {
+            auto const* information = reinterpret_cast<FILE_NOTIFY_INFORMATION const*>(events.data() + offset);
+            std::wstring_view const name(information->FileName, information->FileNameLength / sizeof(WCHAR));
+            std::string const path = m_directory + "/" + std::filesystem::path(name).generic_string();
+            std::error_code error;
+
+            // Files in new directories are reported too, directories themselves are modified whenever a file in them is
+            if (std::filesystem::is_directory(path, error))
+            {
+                if (information->Action == FILE_ACTION_ADDED || information->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                    push_files(path);
+            }
+            else
+            {
+                push_change(path);
+            }
+
+            if (information->NextEntryOffset == 0)
+                break;
+
+            offset += information->NextEntryOffset;
+        }
+    }
+}
+
+bool FileWatcher::read_directory_changes()
+{
+    DWORD constexpr filter =
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+    auto& changes = *m_directory_changes;
+
+    changes.is_reading = ReadDirectoryChangesW(changes.directory, changes.buffer.data(), static_cast<DWORD>(changes.buffer.size()), TRUE,
+                                               filter, nullptr, &changes.overlapped, nullptr)
+                      != 0;
+
+    return changes.is_reading;
+}
+
+void FileWatcher::close_directory_changes()
+{
+    if (m_directory_changes == nullptr)
+        return;
+
+    auto& changes = *m_directory_changes;
+
+    // The buffer is written until the read is cancelled
+    if (changes.is_reading)
+    {
+        DWORD length = 0;
+        CancelIoEx(changes.directory, &changes.overlapped);
+        GetOverlappedResult(changes.directory, &changes.overlapped, &length, TRUE);
+    }
+
+    if (changes.directory != INVALID_HANDLE_VALUE)
+        CloseHandle(changes.directory);
+
+    if (changes.overlapped.hEvent != nullptr)
+        CloseHandle(changes.overlapped.hEvent);
+
+    m_directory_changes = nullptr;
+}
+
+void FileWatcher::push_files(std::string const& directory)
+{
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        if (entry.is_regular_file(error))
+            push_change(entry.path().generic_string());
+    }
+}
+
+#endif
+
+}
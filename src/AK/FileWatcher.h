@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Notices files created, modified, renamed or removed in a directory and every directory in it, on a background thread.
+// On Linux the OS reports changes through inotify, files are only reported after they are closed. On Windows it reports them
+// through ReadDirectoryChangesW, files are reported while they are written. Everywhere else, and when neither can be used,
+// the directory is scanned every poll interval and write times and sizes are compared.
+// Reported paths are the path of the directory joined with the path of the file in it, with forward slashes.
+class FileWatcher
+{
+public:
+    // Defined where the types of every member are complete
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(FileWatcher const&) = delete;
+    FileWatcher& operator=(FileWatcher const&) = delete;
+
+    bool start(std::string const& directory, std::chrono::milliseconds const poll_interval = std::chrono::milliseconds(250));
+    void stop();
+
+    [[nodiscard]] bool is_running() const;
+
+    // Whether changes are reported by the OS, instead of polling. Can turn false while running, ex. if the directory is removed.
+    [[nodiscard]] bool is_native() const;
+
+    // Paths changed since the last call, each one once, in the order they first changed. Can be called from any thread.
+    [[nodiscard]] std::vector<std::string> take_changes();
+
+private:
+    struct FileState
+    {
+        i64 write_time = 0;
+        u64 size = 0;
+    };
+
+    void run_polling(std::stop_token const& stop_token, std::unordered_map<std::string, FileState> files);
+    void scan(std::unordered_map<std::string, FileState>& files) const;
+
+    void push_change(std::string path);
+
+    std::string m_directory = {};
+    std::chrono::milliseconds m_poll_interval = {};
+    // Read from other threads, the watcher thread clears it when it falls back to polling
+    std::atomic<bool> m_is_native = false;
+
+#if defined(__linux__)
+    void run_inotify(std::stop_token const& stop_token);
+    // Watches the directory and every directory in it. Returns false if any of them couldn't be watched.
+    bool add_watches(std::string const& directory, bool const report_files);
+
+    i32 m_inotify_descriptor = -1;
+    std::unordered_map<i32, std::string> m_watched_directories = {};
+#elif defined(_WIN32)
+    // Windows types stay out of the header
+    struct DirectoryChanges;
+
+    void run_directory_changes(std::stop_token const& stop_token);
+    // Changes are collected from the first read on, later reads return the ones collected since the previous one.
+    bool read_directory_changes();
+    void close_directory_changes();
+    void push_files(std::string const& directory);
+
+    std::unique_ptr<DirectoryChanges> m_directory_changes = {};
+#endif
+
+    std::mutex m_mutex = {};
+    std::condition_variable_any m_stop_requested = {};
+    std::vector<std::string> m_changes = {};
+    std::unordered_set<std::string> m_changed_paths = {};
+
+    // Last, so it's stopped before anything it uses is destroyed
+    std::jthread m_thread = {};
+};
+
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Open addressing hash map with linear probing. Entries are stored densely, like in SlotMap, and buckets only hold
+// their indices and a part of their hash, so probing touches a single small array. Removal moves the last entry
+// into the freed place, so the order of the entries is NOT preserved, and removes the bucket without tombstones.
+// Hash has to return u64 and doesn't have to be cryptographically strong, but its low bits have to be well distributed.
+template<typename Key, typename Value, typename Hash>
+class FlatHashMap
+{
+public:
+    struct Entry
+    {
+        Key key;
+        Value value;
+    };
+
+    [[nodiscard]] Value* find(Key const& key)
+    {
+        return find(key, Hash {}(key));
+    }
+
+    [[nodiscard]] Value const* find(Key const& key) const
+    {
+        return const_cast<FlatHashMap*>(this)->find(key);
+    }
+
+    // For keys which hash is already known, like interned paths
+    [[nodiscard]] Value* find(Key const& key, u64 const hash)
+    {
+        u32 const bucket_index = find_bucket(key, hash);
+        if (bucket_index == invalid_index)
+            return nullptr;
+
+        return &m_entries[m_buckets[bucket_index].entry_index].value;
+    }
+
+    [[nodiscard]] bool contains(Key const& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    Value& insert_or_assign(Key const& key, Value value)
+    {
+        return insert_or_assign(key, std::move(value), Hash {}(key));
+    }
+
+    Value& insert_or_assign(Key const& key, Value value, u64 const hash)
+    {
+        if (Value* existing = find(key, hash); existing != nullptr)
+        {
+            *existing = std::move(value);
+            return *existing;
+        }
+
+        // Load factor is kept under 3/4
+        if ((m_entries.size() + 1) * 4 > m_buckets.size() * 3)
+            rehash(m_buckets.empty() ? 16 : m_buckets.size() * 2);
+
+        u32 const entry_index = static_cast<u32>(m_entries.size());
+        m_entries.push_back({key, std::move(value)});
+        m_hashes.emplace_back(hash);
+
+        size_t const mask = m_buckets.size() - 1;
+        size_t bucket_index = hash & mask;
+        while (m_buckets[bucket_index].entry_index != invalid_index)
+        {
+            bucket_index = (bucket_index + 1) & mask;
+        }
+
+        m_buckets[bucket_index] = {entry_index, static_cast<u32>(hash)};
+
+        return m_entries.back().value;
+    }
+
+    bool erase(Key const& key)
+    {
+        u32 const bucket_index = find_bucket(key, Hash {}(key));
+        if (bucket_index == invalid_index)
+            return false;
+
+        erase_bucket(bucket_index);
+        return true;
+    }
+
+    // Predicate is called with every Entry, returns the number of erased entries.
+    template<typename Predicate>
+    size_t erase_if(Predicate const& predicate)
+    {
+        size_t erased_count = 0;
+
+        // Erasing moves the last entry into the freed place, it was already visited when going from the back
+        for (size_t i = m_entries.size(); i > 0; --i)
+        {
+            if (!predicate(std::as_const(m_entries[i - 1])))
+                continue;
+
+            erase_bucket(find_bucket_of_entry(static_cast<u32>(i - 1)));
+            erased_count += 1;
+        }
+
+        return erased_count;
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_hashes.clear();
+        m_buckets.assign(m_buckets.size(), {});
+    }
+
+    void reserve(size_t const capacity)
+    {
+        m_entries.reserve(capacity);
+        m_hashes.reserve(capacity);
+
+        size_t bucket_count = m_buckets.empty() ? 16 : m_buckets.size();
+        while (capacity * 4 > bucket_count * 3)
+        {
+            bucket_count *= 2;
+        }
+
+        if (bucket_count != m_buckets.size())
+            rehash(bucket_count);
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+    auto begin()
+    {
+        return m_entries.begin();
+    }
+
+    auto end()
+    {
+        return m_entries.end();
+    }
+
+    auto begin() const
+    {
+        return m_entries.begin();
+    }
+
+    auto end() const
+    {
+        return m_entries.end();
+    }
+
+private:
+    static u32 constexpr invalid_index = 0xFFFFFFFF;
+
+    struct Bucket
+    {
+        u32 entry_index = invalid_index;
+        // Low bits of the hash, most mismatches are rejected without touching the entries
+        u32 hash = 0;
+    };
+
+    [[nodiscard]] u32 find_bucket(Key const& key, u64 const hash) const
+    {
+        if (m_buckets.empty())
+            return invalid_index;
+
+        size_t const mask = m_buckets.size() - 1;
+        size_t bucket_index = hash & mask;
+
+        while (true)
+        {
+            Bucket const& bucket = m_buckets[bucket_index];
+
+            if (bucket.entry_index == invalid_index)
+                return invalid_index;
+
+            if (bucket.hash == static_cast<u32>(hash) && m_entries[bucket.entry_index].key == key)
+                return static_cast<u32>(bucket_index);
+
+            bucket_index = (bucket_index + 1) & mask;
+        }
+    }
+
+    [[nodiscard]] u32 find_bucket_of_entry(u32 const entry_index) const
+    {
+        size_t const mask = m_buckets.size() - 1;
+        size_t bucket_index = m_hashes[entry_index] & mask;
+
+        while (m_buckets[bucket_index].entry_index != entry_index)
+        {
+            bucket_index = (bucket_index + 1) & mask;
+        }
+
+        return static_cast<u32>(bucket_index);
+    }
+
+    void erase_bucket(u32 const erased_bucket_index)
+    {
+        size_t const mask = m_buckets.size() - 1;
+        u32 const entry_index = m_buckets[erased_bucket_index].entry_index;
+
+        // Backward shift: following buckets of the same probe sequence are moved into the hole,
+        // so lookups never stop early at an empty bucket
+        size_t hole = erased_bucket_index;
+        size_t bucket_index = erased_bucket_index;
+
+        while (true)
+        {
+            bucket_index = (bucket_index + 1) & mask;
+
+            Bucket const& bucket = m_buckets[bucket_index];
+            if (bucket.entry_index == invalid_index)
+                break;
+
+            // Distances from the home bucket, wrapped around the end of the array
+            size_t const home = m_hashes[bucket.entry_index] & mask;
+            if (((bucket_index - home) & mask) >= ((bucket_index - hole) & mask))
+            {
+                m_buckets[hole] = bucket;
+                hole = bucket_index;
+            }
+        }
+
+        m_buckets[hole] = {};
+
+        // NOTE: Swap with last and pop to avoid shifting other entries.
+        u32 const last_index = static_cast<u32>(m_entries.size() - 1);
+        if (entry_index != last_index)
+        {
+            m_buckets[find_bucket_of_entry(last_index)].entry_index = entry_index;
+            m_entries[entry_index] = std::move(m_entries[last_index]);
+            m_hashes[entry_index] = m_hashes[last_index];
+        }
+
+        m_entries.pop_back();
+        m_hashes.pop_back();
+    }
+
+    void rehash(size_t const bucket_count)
+    {
+        m_buckets.assign(bucket_count, {});
+
+        size_t const mask = bucket_count - 1;
+        for (u32 i = 0; i < m_entries.size(); ++i)
+        {
+            size_t bucket_index = m_hashes[i] & mask;
+            while (m_buckets[bucket_index].entry_index != invalid_index)
+            {
+                bucket_index = (bucket_index + 1) & mask;
+            }
+
+            m_buckets[bucket_index] = {i, static_cast<u32>(m_hashes[i])};
+        }
+    }
+
+    std::vector<Entry> m_entries = {};
+    // Full hashes of the entries, so buckets can be rebuilt without hashing the keys again
+    std::vector<u64> m_hashes = {};
+    // Size is always a power of two
+    std::vector<Bucket> m_buckets = {};
+};
+
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Weak reference to an object registered in HandleRegistry<T>. Unlike std::weak_ptr, copying and resolving a handle
+// doesn't touch any reference counts. Handles of destroyed objects are stale and resolve to nullptr.
+template<typename T>
+struct Handle
+{
+    static u32 constexpr invalid_index = 0xFFFFFFFF;
+
+    u32 index = invalid_index;
+    u32 generation = 0;
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return index != invalid_index;
+    }
+
+    void reset()
+    {
+        index = invalid_index;
+        generation = 0;
+    }
+
+    bool operator==(Handle const&) const = default;
+};
+
+// Maps handles to objects. Objects register themselves when constructed and unregister when destroyed, on any thread.
+// Adding and removing take a lock. Slots live in pages that are never moved and their fields are atomic, so resolving
+// is lock-free and can happen on any thread while others register objects.
+// Objects must not be destroyed while their handles are being resolved on another thread.
+template<typename T>
+class HandleRegistry
+{
+public:
+    HandleRegistry(HandleRegistry const&) = delete;
+    void operator=(HandleRegistry const&) = delete;
+
+    static HandleRegistry& get_instance()
+    {
+        // Never destroyed, because registered objects owned by other statics can outlive it at exit
+        static auto* instance = new HandleRegistry();
+        return *instance;
+    }
+
+    Handle<T> add(T* object)
+    {
+        std::lock_guard lock(m_mutex);
+
+        u32 index;
+
+        if (m_free_head != Handle<T>::invalid_index)
+        {
+            index = m_free_head;
+            m_free_head = get_slot(index).next_free;
+        }
+        else
+        {
+            index = m_slot_count.load(std::memory_order_relaxed);
+
+            u32 const page_index = index / slots_per_page;
+            assert(page_index < max_pages && "Too many objects registered at once.");
+
+            if (m_pages[page_index] == nullptr)
+                m_pages[page_index] = std::make_unique<Page>();
+
+            // Published after the page exists, so other threads never see an index without its page
+            m_slot_count.store(index + 1, std::memory_order_release);
+        }
+
+        Slot& slot = get_slot(index);
+        slot.next_free = Handle<T>::invalid_index;
+        slot.object.store(object, std::memory_order_release);
+
+        return {index, slot.generation.load(std::memory_order_relaxed)};
+    }
+
+    void remove(Handle<T> const handle)
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (!contains(handle))
+            return;
+
+        // Bumping the generation makes every existing handle to this slot stale
+        Slot& slot = get_slot(handle.index);
+        slot.generation.store(handle.generation + 1, std::memory_order_release);
+        slot.object.store(nullptr, std::memory_order_release);
+        slot.next_free = m_free_head;
+        m_free_head = handle.index;
+    }
+
+    // Returns nullptr for invalid and stale handles.
+    [[nodiscard]] T* resolve(Handle<T> const handle) const
+    {
+        if (handle.index >= m_slot_count.load(std::memory_order_acquire))
+            return nullptr;
+
+        Slot const& slot = get_slot(handle.index);
+
+        if (slot.generation.load(std::memory_order_acquire) != handle.generation)
+            return nullptr;
+
+        T* const object = slot.object.load(std::memory_order_acquire);
+
+        // The slot could have been removed and reused by another object after its generation was read,
+        // the reused slot has a newer generation
+        if (slot.generation.load(std::memory_order_acquire) != handle.generation)
+            return nullptr;
+
+        return object;
+    }
+
+    // For handles that are expected to be alive. Resolving a stale one asserts in debug builds.
+    [[nodiscard]] T* get(Handle<T> const handle) const
+    {
+        T* const object = resolve(handle);
+        assert((!handle.is_valid() || object != nullptr) && "Stale handle.");
+        return object;
+    }
+
+    [[nodiscard]] bool is_stale(Handle<T> const handle) const
+    {
+        return handle.is_valid() && !contains(handle);
+    }
+
+private:
+    HandleRegistry() = default;
+
+    struct Slot
+    {
+        std::atomic<T*> object = nullptr;
+        std::atomic<u32> generation = 0;
+
+        // Only used with the mutex locked
+        u32 next_free = Handle<T>::invalid_index;
+    };
+
+    static u32 constexpr slots_per_page = 4096;
+    static u32 constexpr max_pages = 1024;
+
+    using Page = std::array<Slot, slots_per_page>;
+
+    [[nodiscard]] bool contains(Handle<T> const handle) const
+    {
+        return resolve(handle) != nullptr;
+    }
+
+    [[nodiscard]] Slot& get_slot(u32 const index) const
+    {
+        return (*m_pages[index / slots_per_page])[index % slots_per_page];
+    }
+
+    std::mutex m_mutex = {};
+    std::array<std::unique_ptr<Page>, max_pages> m_pages = {};
+    std::atomic<u32> m_slot_count = 0;
+    u32 m_free_head = Handle<T>::invalid_index;
+};
+
+template<typename T>
+T* resolve(Handle<T> const handle)
+{
+    return HandleRegistry<T>::get_instance().resolve(handle);
+}
+
+}
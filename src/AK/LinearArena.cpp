@@ -0,0 +1,87 @@
+#include "LinearArena.h"
+
+#include <memory>
+#include <memory_resource>
+
+namespace AK
+{
+
+LinearArena::LinearArena(size_t const capacity) : m_buffer(std::make_unique<std::byte[]>(capacity)), m_capacity(capacity)
+{
+}
+
+LinearArena::~LinearArena()
+{
+    reset();
+}
+
+void LinearArena::reset()
+{
+    for (auto const& overflow : m_overflows)
+    {
+        std::pmr::new_delete_resource()->deallocate(overflow.pointer, overflow.bytes, overflow.alignment);
+    }
+
+    m_overflows.clear();
+    m_offset = 0;
+}
+
+size_t LinearArena::get_used() const
+{
+    return m_offset;
+}
+
+size_t LinearArena::get_capacity() const
+{
+    return m_capacity;
+}
+
+size_t LinearArena::get_high_water_mark() const
+{
+    return m_high_water_mark;
+}
+
+u32 LinearArena::get_overflow_count() const
+{
+    return m_overflow_count;
+}
+
+void* LinearArena::do_allocate(size_t const bytes, size_t const alignment)
+{
+    void* pointer = m_buffer.get() + m_offset;
+    size_t space = m_capacity - m_offset;
+
+    if (std::align(alignment, bytes, pointer, space) != nullptr)
+    {
+        m_offset = m_capacity - space + bytes;
+
+        if (m_offset > m_high_water_mark)
+            m_high_water_mark = m_offset;
+
+        return pointer;
+    }
+
+    // Overflowing means the capacity is too small for the current workload, it's counted so it can be tuned
+    m_overflow_count += 1;
+
+    void* const overflow_pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    m_overflows.emplace_back(overflow_pointer, bytes, alignment);
+    return overflow_pointer;
+}
+
+void LinearArena::do_deallocate(void*, size_t const, size_t const)
+{
+}
+
+bool LinearArena::do_is_equal(memory_resource const& other) const noexcept
+{
+    return this == &other;
+}
+
+LinearArena& frame_arena()
+{
+    static LinearArena arena(4 * 1024 * 1024);
+    return arena;
+}
+
+}
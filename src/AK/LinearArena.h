@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Bump allocator for short-lived allocations. Deallocation does nothing, memory is given back all at once with reset().
+// When the buffer runs out, allocations fall back to the heap and are freed on the next reset.
+// Not thread-safe, only the thread that resets the arena should allocate from it.
+class LinearArena final : public std::pmr::memory_resource
+{
+public:
+    explicit LinearArena(size_t const capacity);
+
+    LinearArena(LinearArena const&) = delete;
+    LinearArena& operator=(LinearArena const&) = delete;
+    virtual ~LinearArena() override;
+
+    void reset();
+
+    [[nodiscard]] size_t get_used() const;
+    [[nodiscard]] size_t get_capacity() const;
+    [[nodiscard]] size_t get_high_water_mark() const;
+    [[nodiscard]] u32 get_overflow_count() const;
+
+protected:
+    virtual void* do_allocate(size_t const bytes, size_t const alignment) override;
+    virtual void do_deallocate(void* pointer, size_t const bytes, size_t const alignment) override;
+    virtual bool do_is_equal(memory_resource const& other) const noexcept override;
+
+private:
+    struct Overflow
+    {
+        void* pointer = nullptr;
+        size_t bytes = 0;
+        size_t alignment = 0;
+    };
+
+    std::unique_ptr<std::byte[]> m_buffer = {};
+    size_t m_capacity = 0;
+    size_t m_offset = 0;
+    size_t m_high_water_mark = 0;
+
+    std::vector<Overflow> m_overflows = {};
+    u32 m_overflow_count = 0;
+};
+
+// Arena that is reset at the beginning of every frame. Use it through std::pmr containers for temporaries
+// that don't outlive the frame, ex. std::pmr::vector<T> temporaries(&AK::frame_arena());
+LinearArena& frame_arena();
+
+}
@@ -0,0 +1,216 @@
+#include "Lz4.h"
+
+#include <cstring>
+
+namespace AK
+{
+
+namespace
+{
+
+size_t constexpr min_match_length = 4;
+
+// The format requires the last bytes of a block to be literals, and the last match to start before them
+size_t constexpr last_literal_count = 5;
+size_t constexpr match_start_limit = 12;
+
+size_t constexpr max_offset = 65535;
+
+// Every byte of a length adds up to 255 bytes to a match, nothing else in a block grows faster
+size_t constexpr max_bytes_per_byte = 255;
+u32 constexpr hash_bits = 14;
+
+u32 read_u32(u8 const* data)
+{
+    u32 value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+u32 hash_sequence(u32 const sequence)
+{
+    return sequence * 2654435761u >> (32 - hash_bits);
+}
+
+// Lengths that don't fit in 4 bits of the token continue in bytes of 255, up to a byte that is smaller
+void write_length(std::vector<u8>& destination, size_t length)
+{
+    length -= 15;
+
+    while (length >= 255)
+    {
+        destination.emplace_back(static_cast<u8>(255));
+        length -= 255;
+    }
+
+    destination.emplace_back(static_cast<u8>(length));
+}
+
+void write_sequence(std::vector<u8>& destination, u8 const* literals, size_t const literal_length, size_t const offset,
+                    size_t const match_length)
+{
+    size_t const token_match_length = match_length != 0 ? match_length - min_match_length : 0;
+    size_t const token_literal_length = literal_length < 15 ? literal_length : 15;
+    u8 const token = static_cast<u8>(token_literal_length << 4 | (token_match_length < 15 ? token_match_length : 15));
+    destination.emplace_back(token);
+
+    if (literal_length >= 15)
+        write_length(destination, literal_length);
+
+    destination.insert(destination.end(), literals, literals + literal_length);
+
+    // The last sequence has only literals
+    if (match_length == 0)
+        return;
+
+    destination.emplace_back(static_cast<u8>(offset));
+    destination.emplace_back(static_cast<u8>(offset >> 8));
+
+    if (token_match_length >= 15)
+        write_length(destination, token_match_length);
+}
+
+bool read_length(std::span<u8 const> const source, size_t& position, size_t& length)
+{
+    u8 byte = 255;
+
+    while (byte == 255)
+    {
+        if (position >= source.size())
+            return false;
+
+        byte = source[position++];
+        length += byte;
+    }
+
+    return true;
+}
+
+}
+
+size_t Lz4::get_compress_bound(size_t const source_size)
+{
+    return source_size + source_size / 255 + 16;
+}
+
+size_t Lz4::get_decompress_bound(size_t const block_size)
+{
+    return block_size * max_bytes_per_byte;
+}
+
+std::vector<u8> Lz4::compress(std::span<u8 const> const source)
+{
+    std::vector<u8> destination = {};
+    destination.reserve(get_compress_bound(source.size()));
+
+    u8 const* data = source.data();
+    size_t const size = source.size();
+    size_t anchor = 0;
+
+    if (size > match_start_limit)
+    {
+        // Positions of the last sequence of 4 bytes with every hash. 0 is also a valid position, every match is checked anyway.
+        std::vector<u32> table(static_cast<size_t>(1) << hash_bits, 0);
+        size_t position = 0;
+
+        while (position + match_start_limit <= size)
+        {
+            u32 const sequence = read_u32(data + position);
+            u32 const hash = hash_sequence(sequence);
+            size_t match = table[hash];
+            table[hash] = static_cast<u32>(position);
+
+            if (match >= position || position - match > max_offset || read_u32(data + match) != sequence)
+            {
+                // Skips faster through data that doesn't repeat, like images that are already compressed
+                position += 1 + ((position - anchor) >> 6);
+                continue;
+            }
+
+            size_t length = min_match_length;
+
+            while (position + length < size - last_literal_count && data[match + length] == data[position + length])
+                ++length;
+
+            while (position > anchor && match > 0 && data[position - 1] == data[match - 1])
+            {
+                --position;
+                --match;
+                ++length;
+            }
+
+            write_sequence(destination, data + anchor, position - anchor, position - match, length);
+
+            position += length;
+            anchor = position;
+        }
+    }
+
+    write_sequence(destination, data + anchor, size - anchor, 0, 0);
+    return destination;
+}
+
+bool Lz4::decompress(std::span<u8 const> const source, std::span<u8> const destination)
+{
+    size_t input = 0;
+    size_t output = 0;
+
+    while (input < source.size())
+    {
+        u8 const token = source[input++];
+        size_t literal_length = token >> 4;
+
+        if (literal_length == 15 && !read_length(source, input, literal_length))
+            return false;
+
+        if (literal_length > source.size() - input || literal_length > destination.size() - output)
+            return false;
+
+        // Empty destinations have no data to copy to
+        if (literal_length > 0)
+            std::memcpy(destination.data() + output, source.data() + input, literal_length);
+
+        input += literal_length;
+        output += literal_length;
+
+        // The last sequence ends the block right after its literals
+        if (input == source.size())
+            break;
+
+        if (source.size() - input < 2)
+            return false;
+
+        size_t const offset = source[input] | static_cast<size_t>(source[input + 1]) << 8;
+        input += 2;
+
+        size_t match_length = token & 15;
+
+        if (match_length == 15 && !read_length(source, input, match_length))
+            return false;
+
+        match_length += min_match_length;
+
+        if (offset == 0 || offset > output || match_length > destination.size() - output)
+            return false;
+
+        u8* target = destination.data() + output;
+        u8 const* match = target - offset;
+
+        // Matches can overlap the bytes they produce, repeating the last offset bytes
+        if (offset >= match_length)
+        {
+            std::memcpy(target, match, match_length);
+        }
+        else
+        {
+            for (size_t i = 0; i < match_length; ++i)
+                target[i] = match[i];
+        }
+
+        output += match_length;
+    }
+
+    return output == destination.size();
+}
+
+}
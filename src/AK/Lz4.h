@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Compression in the LZ4 block format. Compressing is a single greedy pass, decompressing mostly copies bytes,
+// so it's a lot faster than reading the same bytes from the disk.
+// Blocks don't store their uncompressed size, it has to be known when decompressing them.
+class Lz4
+{
+public:
+    // Largest size a block of source_size bytes can be compressed to, when nothing in it repeats.
+    [[nodiscard]] static size_t get_compress_bound(size_t const source_size);
+
+    // Largest size a block of block_size bytes can be decompressed to. Larger sizes can only come from corrupted files.
+    [[nodiscard]] static size_t get_decompress_bound(size_t const block_size);
+
+    [[nodiscard]] static std::vector<u8> compress(std::span<u8 const> const source);
+
+    // Returns false if the block is corrupted or doesn't decompress to exactly destination.size() bytes.
+    // Never reads or writes outside of source and destination.
+    static bool decompress(std::span<u8 const> const source, std::span<u8> const destination);
+};
+
+}
@@ -0,0 +1,221 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AK
+{
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    close();
+
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_is_open = std::exchange(other.m_is_open, false);
+
+#if defined(_WIN32)
+    m_file_handle = std::exchange(other.m_file_handle, nullptr);
+    m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+#endif
+
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(std::string const& file_path)
+{
+    close();
+
+    // Files stay mapped for a long time, other programs can still replace or remove them. Windows doesn't allow
+    // shrinking a file while it's mapped though, so files that are edited in place have to be copied instead.
+    HANDLE const file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size = {};
+
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file_handle = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_is_open = true;
+
+    // Empty files can't be mapped, but they are still valid files
+    if (m_size == 0)
+        return true;
+
+    m_mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (m_mapping_handle == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<u8 const*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (m_data == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping_handle != nullptr)
+        CloseHandle(m_mapping_handle);
+
+    if (m_file_handle != nullptr)
+        CloseHandle(m_file_handle);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_is_open = false;
+    m_file_handle = nullptr;
+    m_mapping_handle = nullptr;
+}
+
+void MappedFile::prefetch(size_t const offset, size_t const size) const
+{
+    if (m_data == nullptr || offset >= m_size)
+        return;
+
+    // std::min() would collide with the min() macro of windows.h
+    WIN32_MEMORY_RANGE_ENTRY range = {const_cast<u8*>(m_data) + offset, size < m_size - offset ? size : m_size - offset};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+bool MappedFile::open(std::string const& file_path)
+{
+    close();
+
+    int const file = ::open(file_path.c_str(), O_RDONLY);
+
+    if (file == -1)
+        return false;
+
+    struct stat file_stat = {};
+
+    if (fstat(file, &file_stat) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(file_stat.st_size);
+    m_is_open = true;
+
+    // Empty files can't be mapped, but they are still valid files
+    if (m_size == 0)
+    {
+        ::close(file);
+        return true;
+    }
+
+    void* const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps its own reference to the file
+    ::close(file);
+
+    if (data == MAP_FAILED)
+    {
+        m_size = 0;
+        m_is_open = false;
+        return false;
+    }
+
+    m_data = static_cast<u8 const*>(data);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<u8*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_is_open = false;
+}
+
+void MappedFile::prefetch(size_t const offset, size_t const size) const
+{
+    if (m_data == nullptr || offset >= m_size)
+        return;
+
+    // madvise() only takes whole pages, the mapping itself starts at a page
+    auto const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t const page_offset = offset - offset % page_size;
+    size_t const end = offset + (size < m_size - offset ? size : m_size - offset);
+
+    madvise(const_cast<u8*>(m_data) + page_offset, end - page_offset, MADV_WILLNEED);
+}
+
+#endif
+
+void MappedFile::prefetch() const
+{
+    prefetch(0, m_size);
+}
+
+bool MappedFile::is_open() const
+{
+    return m_is_open;
+}
+
+size_t MappedFile::get_size() const
+{
+    return m_size;
+}
+
+std::span<u8 const> MappedFile::get_bytes() const
+{
+    return {m_data, m_size};
+}
+
+std::string_view MappedFile::get_text() const
+{
+    return {reinterpret_cast<char const*>(m_data), m_size};
+}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Read-only view of a whole file mapped into memory. Nothing is copied, pages are read from the disk when touched.
+// Views returned by get_bytes() and get_text() are valid as long as the file stays open.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(std::string const& file_path);
+    void close();
+
+    // Asks the OS to start reading the whole file in the background, so the first access doesn't wait for the disk.
+    void prefetch() const;
+
+    // Same as prefetch(), for a part of the file.
+    void prefetch(size_t const offset, size_t const size) const;
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] size_t get_size() const;
+    [[nodiscard]] std::span<u8 const> get_bytes() const;
+    [[nodiscard]] std::string_view get_text() const;
+
+private:
+    u8 const* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_is_open = false;
+
+#if defined(_WIN32)
+    void* m_file_handle = nullptr;
+    void* m_mapping_handle = nullptr;
+#endif
+};
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Hands out blocks of one size from chunks allocated up front. Freed blocks go to a free list and are reused,
+// chunks are never given back. There is one pool per block size and alignment, shared by every type that fits it.
+template<size_t BlockSize, size_t Alignment>
+class FixedBlockPool
+{
+public:
+    FixedBlockPool(FixedBlockPool const&) = delete;
+    void operator=(FixedBlockPool const&) = delete;
+
+    static FixedBlockPool& get_instance()
+    {
+        // Never destroyed, because pooled objects owned by other statics can outlive it at exit
+        static auto* instance = new FixedBlockPool();
+        return *instance;
+    }
+
+    void* allocate()
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (m_free_head == nullptr)
+            allocate_chunk();
+
+        FreeBlock* const block = m_free_head;
+        m_free_head = block->next;
+        m_blocks_in_use += 1;
+        return block;
+    }
+
+    void deallocate(void* pointer)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto* const block = static_cast<FreeBlock*>(pointer);
+        block->next = m_free_head;
+        m_free_head = block;
+        m_blocks_in_use -= 1;
+    }
+
+    [[nodiscard]] u32 get_blocks_in_use() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_blocks_in_use;
+    }
+
+private:
+    FixedBlockPool() = default;
+
+    struct FreeBlock
+    {
+        FreeBlock* next = nullptr;
+    };
+
+    static size_t constexpr block_alignment = Alignment > alignof(FreeBlock) ? Alignment : alignof(FreeBlock);
+    static size_t constexpr block_size = ((BlockSize > sizeof(FreeBlock) ? BlockSize : sizeof(FreeBlock)) + block_alignment - 1)
+                                       & ~(block_alignment - 1);
+    static u32 constexpr blocks_per_chunk = 64;
+
+    void allocate_chunk()
+    {
+        auto* const chunk = static_cast<std::byte*>(::operator new(block_size * blocks_per_chunk, std::align_val_t {block_alignment}));
+
+        for (u32 i = 0; i < blocks_per_chunk; ++i)
+        {
+            auto* const block = new (chunk + i * block_size) FreeBlock {m_free_head};
+            m_free_head = block;
+        }
+    }
+
+    mutable std::mutex m_mutex = {};
+    FreeBlock* m_free_head = nullptr;
+    u32 m_blocks_in_use = 0;
+};
+
+// Standard allocator backed by FixedBlockPool. Meant for types that are created and destroyed a lot,
+// ex. std::allocate_shared<Entity>(AK::PoolAllocator<Entity> {}, ...), which puts the control block in the pool too.
+// Array allocations go straight to the heap.
+template<typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(PoolAllocator<U> const&)
+    {
+    }
+
+    T* allocate(size_t const count)
+    {
+        if (count == 1)
+            return static_cast<T*>(FixedBlockPool<sizeof(T), alignof(T)>::get_instance().allocate());
+
+        return std::allocator<T> {}.allocate(count);
+    }
+
+    void deallocate(T* pointer, size_t const count)
+    {
+        if (count == 1)
+        {
+            FixedBlockPool<sizeof(T), alignof(T)>::get_instance().deallocate(pointer);
+            return;
+        }
+
+        std::allocator<T> {}.deallocate(pointer, count);
+    }
+
+    template<typename U>
+    bool operator==(PoolAllocator<U> const&) const
+    {
+        return true;
+    }
+};
+
+}
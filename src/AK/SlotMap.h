@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+struct SlotKey
+{
+    static u32 constexpr invalid_index = 0xFFFFFFFF;
+
+    u32 index = invalid_index;
+    u32 generation = 0;
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return index != invalid_index;
+    }
+
+    bool operator==(SlotKey const&) const = default;
+};
+
+// Values are stored densely, so iterating over them is as fast as iterating over a vector.
+// Insertion, removal and lookup by key are O(1). Removal moves the last value into the freed place,
+// so the order of the values is NOT preserved. Keys of removed values are never valid again.
+template<typename T>
+class SlotMap
+{
+public:
+    SlotKey insert(T value)
+    {
+        u32 slot_index;
+
+        if (m_free_head != SlotKey::invalid_index)
+        {
+            slot_index = m_free_head;
+            m_free_head = m_slots[slot_index].dense_index;
+        }
+        else
+        {
+            slot_index = static_cast<u32>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        Slot& slot = m_slots[slot_index];
+        slot.dense_index = static_cast<u32>(m_values.size());
+
+        m_values.emplace_back(std::move(value));
+        m_dense_to_slot.emplace_back(slot_index);
+
+        return {slot_index, slot.generation};
+    }
+
+    bool erase(SlotKey const key)
+    {
+        if (!contains(key))
+            return false;
+
+        Slot& slot = m_slots[key.index];
+        u32 const dense_index = slot.dense_index;
+        u32 const last_index = static_cast<u32>(m_values.size() - 1);
+
+        // NOTE: Swap with last and pop to avoid shifting other elements.
+        if (dense_index != last_index)
+        {
+            m_values[dense_index] = std::move(m_values[last_index]);
+            m_dense_to_slot[dense_index] = m_dense_to_slot[last_index];
+            m_slots[m_dense_to_slot[dense_index]].dense_index = dense_index;
+        }
+
+        m_values.pop_back();
+        m_dense_to_slot.pop_back();
+
+        // Free slots store the index of the next free slot in place of the dense index
+        slot.generation += 1;
+        slot.dense_index = m_free_head;
+        m_free_head = key.index;
+
+        return true;
+    }
+
+    [[nodiscard]] bool contains(SlotKey const key) const
+    {
+        return key.index < m_slots.size() && m_slots[key.index].generation == key.generation;
+    }
+
+    [[nodiscard]] T* get(SlotKey const key)
+    {
+        if (!contains(key))
+            return nullptr;
+
+        return &m_values[m_slots[key.index].dense_index];
+    }
+
+    [[nodiscard]] T const* get(SlotKey const key) const
+    {
+        if (!contains(key))
+            return nullptr;
+
+        return &m_values[m_slots[key.index].dense_index];
+    }
+
+    void clear()
+    {
+        // Erasing from the back doesn't move any values
+        while (!m_dense_to_slot.empty())
+        {
+            u32 const slot_index = m_dense_to_slot.back();
+            static_cast<void>(erase({slot_index, m_slots[slot_index].generation}));
+        }
+    }
+
+    void reserve(size_t const capacity)
+    {
+        m_values.reserve(capacity);
+        m_dense_to_slot.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_values.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    [[nodiscard]] T& operator[](size_t const dense_index)
+    {
+        return m_values[dense_index];
+    }
+
+    [[nodiscard]] T const& operator[](size_t const dense_index) const
+    {
+        return m_values[dense_index];
+    }
+
+    auto begin()
+    {
+        return m_values.begin();
+    }
+
+    auto end()
+    {
+        return m_values.end();
+    }
+
+    auto begin() const
+    {
+        return m_values.begin();
+    }
+
+    auto end() const
+    {
+        return m_values.end();
+    }
+
+private:
+    struct Slot
+    {
+        u32 dense_index = SlotKey::invalid_index;
+        u32 generation = 0;
+    };
+
+    std::vector<T> m_values = {};
+    std::vector<u32> m_dense_to_slot = {};
+    std::vector<Slot> m_slots = {};
+    u32 m_free_head = SlotKey::invalid_index;
+};
+
+}
@@ -0,0 +1,197 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <numeric>
+
+namespace AK
+{
+
+TaskGraph::TaskId TaskGraph::add_task(std::string name, std::function<bool()> job, std::vector<TaskId> const& dependencies,
+                                      bool const is_on_main_thread)
+{
+    auto const id = static_cast<TaskId>(m_tasks.size());
+
+    Task task = {};
+    task.job = std::move(job);
+
+    for (auto const dependency : dependencies)
+    {
+        if (dependency >= id)
+            continue;
+
+        m_tasks[dependency].dependents.emplace_back(id);
+        task.dependency_count += 1;
+    }
+
+    m_tasks.emplace_back(std::move(task));
+
+    TaskTiming timing = {};
+    timing.name = std::move(name);
+    timing.is_on_main_thread = is_on_main_thread;
+    m_timeline.emplace_back(std::move(timing));
+
+    return id;
+}
+
+bool TaskGraph::run(bool const use_workers, u32 const thread_count)
+{
+    m_run_begin = std::chrono::steady_clock::now();
+
+    std::unique_ptr<ThreadPool> thread_pool = nullptr;
+
+    if (use_workers)
+        thread_pool = std::make_unique<ThreadPool>(thread_count);
+
+    std::unique_lock lock(m_mutex);
+
+    m_thread_pool = thread_pool.get();
+    m_ready_main_tasks.clear();
+    m_finished_count = 0;
+
+    for (TaskId id = 0; id < m_tasks.size(); ++id)
+    {
+        m_tasks[id].remaining_dependency_count = m_tasks[id].dependency_count;
+        m_tasks[id].has_failed_dependency = false;
+        m_timeline[id].begin_ms = 0.0;
+        m_timeline[id].end_ms = 0.0;
+        m_timeline[id].is_succeeded = false;
+    }
+
+    for (TaskId id = 0; id < m_tasks.size(); ++id)
+    {
+        if (m_tasks[id].dependency_count == 0)
+            make_ready(id);
+    }
+
+    while (m_finished_count < m_tasks.size())
+    {
+        if (m_ready_main_tasks.empty())
+        {
+            m_task_finished.wait(lock);
+            continue;
+        }
+
+        TaskId const id = *m_ready_main_tasks.begin();
+        m_ready_main_tasks.erase(m_ready_main_tasks.begin());
+
+        lock.unlock();
+        bool const is_succeeded = execute(id);
+        lock.lock();
+
+        finish(id, is_succeeded);
+    }
+
+    m_thread_pool = nullptr;
+    lock.unlock();
+
+    m_total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_run_begin).count();
+
+    return std::ranges::all_of(m_timeline, &TaskTiming::is_succeeded);
+}
+
+std::vector<TaskTiming> const& TaskGraph::get_timeline() const
+{
+    return m_timeline;
+}
+
+double TaskGraph::get_total_ms() const
+{
+    return m_total_ms;
+}
+
+std::string TaskGraph::get_report(std::string const& title) const
+{
+    std::vector<size_t> order(m_timeline.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, {}, [&](size_t const index) { return m_timeline[index].begin_ms; });
+
+    size_t name_width = 0;
+
+    for (auto const& timing : m_timeline)
+        name_width = std::max(name_width, timing.name.size());
+
+    // Every task is drawn as a bar on a shared time axis, so tasks running at the same time are easy to see
+    size_t constexpr bar_width = 40;
+    double const ms_per_column = std::max(m_total_ms, 0.001) / static_cast<double>(bar_width);
+
+    std::string report = std::format("{}: {} tasks in {:.2f} ms\n", title, m_timeline.size(), m_total_ms);
+
+    for (auto const index : order)
+    {
+        auto const& timing = m_timeline[index];
+
+        auto const first_column = std::min(static_cast<size_t>(timing.begin_ms / ms_per_column), bar_width - 1);
+        auto const last_column = std::clamp(static_cast<size_t>(timing.end_ms / ms_per_column), first_column, bar_width - 1);
+
+        std::string bar(bar_width, ' ');
+        std::fill(bar.begin() + first_column, bar.begin() + last_column + 1, timing.is_on_main_thread ? '#' : '=');
+
+        report += std::format("  {:<{}}  {:8.2f} - {:8.2f} ms  {:8.2f} ms  {:<6}  |{}|{}\n", timing.name, name_width, timing.begin_ms,
+                              timing.end_ms, timing.end_ms - timing.begin_ms, timing.is_on_main_thread ? "main" : "worker", bar,
+                              timing.is_succeeded ? "" : " failed");
+    }
+
+    return report;
+}
+
+bool TaskGraph::execute(TaskId const id)
+{
+    auto const begin = std::chrono::steady_clock::now();
+    bool const is_succeeded = m_tasks[id].job();
+    auto const end = std::chrono::steady_clock::now();
+
+    // Only this task writes its timing while the graph runs
+    m_timeline[id].begin_ms = std::chrono::duration<double, std::milli>(begin - m_run_begin).count();
+    m_timeline[id].end_ms = std::chrono::duration<double, std::milli>(end - m_run_begin).count();
+
+    return is_succeeded;
+}
+
+void TaskGraph::make_ready(TaskId const id)
+{
+    if (m_tasks[id].has_failed_dependency)
+    {
+        double const skip_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_run_begin).count();
+        m_timeline[id].begin_ms = skip_ms;
+        m_timeline[id].end_ms = skip_ms;
+
+        finish(id, false);
+        return;
+    }
+
+    if (m_thread_pool == nullptr || m_timeline[id].is_on_main_thread)
+    {
+        m_ready_main_tasks.emplace(id);
+        m_task_finished.notify_all();
+        return;
+    }
+
+    m_thread_pool->enqueue([this, id] {
+        bool const is_succeeded = execute(id);
+
+        std::lock_guard lock(m_mutex);
+        finish(id, is_succeeded);
+    });
+}
+
+void TaskGraph::finish(TaskId const id, bool const is_succeeded)
+{
+    m_timeline[id].is_succeeded = is_succeeded;
+    m_finished_count += 1;
+
+    for (auto const dependent : m_tasks[id].dependents)
+    {
+        auto& task = m_tasks[dependent];
+        task.has_failed_dependency = task.has_failed_dependency || !is_succeeded;
+        task.remaining_dependency_count -= 1;
+
+        if (task.remaining_dependency_count == 0)
+            make_ready(dependent);
+    }
+
+    m_task_finished.notify_all();
+}
+
+}
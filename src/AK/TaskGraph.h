@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace AK
+{
+
+struct TaskTiming
+{
+    std::string name = {};
+
+    // Since the graph started running
+    double begin_ms = 0.0;
+    double end_ms = 0.0;
+
+    bool is_on_main_thread = false;
+
+    // False for tasks that failed, and for tasks that were skipped because a task they depend on failed
+    bool is_succeeded = false;
+};
+
+// Tasks that depend on each other, every task runs as soon as all tasks it depends on are done.
+// Tasks run on worker threads, except the ones that have to run on the thread calling run(), like the ones using the window
+// or the graphics API. The calling thread runs those in the order they were added, and waits for the workers in between.
+// A task that fails skips every task depending on it. Every run records when each task began and ended.
+class TaskGraph
+{
+public:
+    using TaskId = u32;
+
+    // Tasks can only depend on tasks added before them. A task succeeds when its job returns true.
+    TaskId add_task(std::string name, std::function<bool()> job, std::vector<TaskId> const& dependencies = {},
+                    bool const is_on_main_thread = false);
+
+    // Runs every task once and returns whether all of them succeeded. Without workers, everything runs on the calling thread
+    // in the order it was added, which is what the graph takes without it.
+    bool run(bool const use_workers = true, u32 const thread_count = 0);
+
+    [[nodiscard]] std::vector<TaskTiming> const& get_timeline() const;
+    [[nodiscard]] double get_total_ms() const;
+
+    // Timeline of the last run with a line for every task, in the order they began.
+    [[nodiscard]] std::string get_report(std::string const& title) const;
+
+private:
+    struct Task
+    {
+        std::function<bool()> job = {};
+        std::vector<TaskId> dependents = {};
+        u32 dependency_count = 0;
+
+        // Reset by every run
+        u32 remaining_dependency_count = 0;
+        bool has_failed_dependency = false;
+    };
+
+    bool execute(TaskId const id);
+
+    // Called with the mutex locked
+    void make_ready(TaskId const id);
+    void finish(TaskId const id, bool const is_succeeded);
+
+    std::vector<Task> m_tasks = {};
+    std::vector<TaskTiming> m_timeline = {};
+    double m_total_ms = 0.0;
+
+    std::chrono::steady_clock::time_point m_run_begin = {};
+    ThreadPool* m_thread_pool = nullptr;
+
+    std::mutex m_mutex = {};
+    std::condition_variable m_task_finished = {};
+    std::set<TaskId> m_ready_main_tasks = {};
+    u32 m_finished_count = 0;
+};
+
+}
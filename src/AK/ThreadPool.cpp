@@ -0,0 +1,77 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace AK
+{
+
+ThreadPool::ThreadPool(u32 const thread_count)
+{
+    u32 const count = thread_count != 0 ? thread_count : std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    m_threads.reserve(count);
+
+    for (u32 i = 0; i < count; ++i)
+        m_threads.emplace_back([this](std::stop_token const& stop_token) { run_worker(stop_token); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    for (auto& thread : m_threads)
+        thread.request_stop();
+
+    m_job_available.notify_all();
+    m_threads.clear();
+}
+
+void ThreadPool::enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_jobs.emplace_back(std::move(job));
+    }
+
+    m_job_available.notify_one();
+}
+
+void ThreadPool::wait_idle()
+{
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_jobs.empty() && m_running_jobs == 0; });
+}
+
+u32 ThreadPool::get_thread_count() const
+{
+    return static_cast<u32>(m_threads.size());
+}
+
+void ThreadPool::run_worker(std::stop_token const& stop_token)
+{
+    while (true)
+    {
+        std::function<void()> job = {};
+
+        {
+            std::unique_lock lock(m_mutex);
+
+            if (!m_job_available.wait(lock, stop_token, [this] { return !m_jobs.empty(); }))
+                return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_running_jobs += 1;
+        }
+
+        job();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_running_jobs -= 1;
+
+            if (m_jobs.empty() && m_running_jobs == 0)
+                m_idle.notify_all();
+        }
+    }
+}
+
+}
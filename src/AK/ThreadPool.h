@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Fixed set of worker threads running jobs in the order they were enqueued.
+// Jobs still in the queue when the pool is destroyed are dropped, the ones already running are waited for.
+class ThreadPool
+{
+public:
+    // With 0 threads, one thread is used for every hardware thread except the main one.
+    explicit ThreadPool(u32 const thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    void enqueue(std::function<void()> job);
+
+    // Blocks until the queue is empty and no job is running.
+    void wait_idle();
+
+    [[nodiscard]] u32 get_thread_count() const;
+
+private:
+    void run_worker(std::stop_token const& stop_token);
+
+    std::vector<std::jthread> m_threads = {};
+
+    std::mutex m_mutex = {};
+    std::condition_variable_any m_job_available = {};
+    std::condition_variable m_idle = {};
+    std::deque<std::function<void()>> m_jobs = {};
+    u32 m_running_jobs = 0;
+};
+
+}
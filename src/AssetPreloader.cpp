@@ -2,9 +2,6 @@
 
 #include "Debug.h"
 
-#include <fstream>
-#include <sstream>
-
 std::shared_ptr<AssetPreloader> AssetPreloader::create()
 {
     return std::make_shared<AssetPreloader>(AK::Badge<AssetPreloader> {});
@@ -14,34 +11,104 @@ AssetPreloader::AssetPreloader(AK::Badge<AssetPreloader>)
 {
 }
 
-std::optional<std::string> AssetPreloader::get_text_asset(std::string const& asset_path)
+std::optional<std::string_view> AssetPreloader::get_text_asset(std::string const& asset_path) const
 {
-    if (!preloaded_text_assets.contains(asset_path))
+    auto const it = m_preloaded_assets.find(asset_path);
+
+    if (it == m_preloaded_assets.end())
     {
         return {};
     }
 
-    return preloaded_text_assets.at(asset_path);
+    return it->second.get_text();
 }
 
-void AssetPreloader::preload_text_asset(std::string const& asset_path)
+std::optional<std::span<u8 const>> AssetPreloader::get_binary_asset(std::string const& asset_path) const
 {
-    if (preloaded_text_assets.contains(asset_path))
+    auto const it = m_preloaded_assets.find(asset_path);
+
+    if (it == m_preloaded_assets.end())
     {
-        return;
+        return {};
     }
 
-    std::ifstream asset_file(asset_path);
+    return it->second.get_bytes();
+}
+
+bool AssetPreloader::preload_asset(std::string const& asset_path)
+{
+    if (m_preloaded_assets.contains(asset_path))
+    {
+        return true;
+    }
+
+    auto asset_file = open_asset(asset_path);
+
+    if (!asset_file.has_value())
+    {
+        Debug::log("Could not open an asset file: " + asset_path + "\n", DebugType::Error);
+        return false;
+    }
+
+    m_preloaded_assets.emplace(asset_path, std::move(*asset_file));
+    return true;
+}
+
+std::optional<VirtualFile> AssetPreloader::open_asset(std::string const& asset_path)
+{
+    VirtualFile asset_file = {};
 
-    if (!asset_file.is_open())
+    if (!asset_file.open(asset_path))
     {
-        Debug::log("Could not open a scene file: " + asset_path + "\n", DebugType::Error);
-        return;
+        return {};
     }
 
-    std::stringstream stream;
-    stream << asset_file.rdbuf();
-    asset_file.close();
+#if EDITOR
+    // The editor reloads files when they are saved, so they can't stay mapped. Editors that save files in place
+    // aren't allowed to shrink mapped files on Windows.
+    asset_file.copy_to_memory();
+#else
+    // Mapping alone doesn't read anything, so the file is prefetched to not wait for the disk on first use
+    asset_file.prefetch();
+#endif
+
+    return asset_file;
+}
+
+bool AssetPreloader::add_asset(std::string const& asset_path, VirtualFile asset_file)
+{
+    return m_preloaded_assets.emplace(asset_path, std::move(asset_file)).second;
+}
+
+bool AssetPreloader::unload_asset(std::string const& asset_path)
+{
+    return m_preloaded_assets.erase(asset_path) > 0;
+}
+
+u32 AssetPreloader::reload_assets(std::vector<std::string> const& changed_paths)
+{
+    u32 reloaded_count = 0;
+
+    for (auto const& changed_path : changed_paths)
+    {
+        std::string const normalized_path = VirtualFileSystem::normalize_path(changed_path);
+        std::vector<std::string> asset_paths = {};
+
+        // Assets are preloaded by the paths they were requested with, which can be written differently
+        for (auto const& [asset_path, asset_file] : m_preloaded_assets)
+        {
+            if (VirtualFileSystem::normalize_path(asset_path) == normalized_path)
+                asset_paths.emplace_back(asset_path);
+        }
+
+        for (auto const& asset_path : asset_paths)
+        {
+            unload_asset(asset_path);
+
+            if (VirtualFileSystem::get_instance().exists(asset_path) && preload_asset(asset_path))
+                ++reloaded_count;
+        }
+    }
 
-    preloaded_text_assets.emplace(asset_path, stream.str());
+    return reloaded_count;
 }
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "AK/Badge.h"
+#include "VirtualFileSystem.h"
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+// Keeps files that are needed often mapped into memory. Returned views point straight into the mapped files or archives,
+// so nothing is copied. They stay valid as long as the preloader is alive.
+// The editor copies loose files instead, so they can be edited and reloaded while it runs.
 class AssetPreloader
 {
 public:
@@ -14,8 +21,25 @@ public:
 
     explicit AssetPreloader(AK::Badge<AssetPreloader>);
 
-    std::optional<std::string> get_text_asset(std::string const& asset_path);
-    void preload_text_asset(std::string const& asset_path);
+    [[nodiscard]] std::optional<std::string_view> get_text_asset(std::string const& asset_path) const;
+    [[nodiscard]] std::optional<std::span<u8 const>> get_binary_asset(std::string const& asset_path) const;
 
-    std::unordered_map<std::string, std::string> preloaded_text_assets = {};
+    bool preload_asset(std::string const& asset_path);
+
+    // Opens and prefetches an asset without preloading it, so files can be read ahead on other threads.
+    // Can be called from any thread, unlike everything else here.
+    [[nodiscard]] static std::optional<VirtualFile> open_asset(std::string const& asset_path);
+
+    // Keeps an asset opened by open_asset() preloaded. Returns false if it was preloaded already.
+    bool add_asset(std::string const& asset_path, VirtualFile asset_file);
+
+    // Returns whether the asset was preloaded.
+    bool unload_asset(std::string const& asset_path);
+
+    // Maps preloaded assets read from any of the files again, views returned before point at the old content.
+    // Assets whose files were removed are unloaded. Returns how many assets were preloaded again.
+    u32 reload_assets(std::vector<std::string> const& changed_paths);
+
+private:
+    std::unordered_map<std::string, VirtualFile> m_preloaded_assets = {};
 };
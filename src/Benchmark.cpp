@@ -0,0 +1,2293 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <glm/common.hpp>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "AK/AK.h"
+#include "AK/AllocationTracker.h"
+#include "AK/FileWatcher.h"
+#include "AK/LinearArena.h"
+#include "AK/MappedFile.h"
+#include "AK/PoolAllocator.h"
+#include "AK/ScopeGuard.h"
+#include "AK/TaskGraph.h"
+#include "Camera.h"
+#include "AssetPreloader.h"
+#include "Collider2D.h"
+#include "Debug.h"
+#include "Engine.h"
+#include "Entity.h"
+#include "EntityPool.h"
+#include "Globals.h"
+#include "MainScene.h"
+#include "MeshOptimizer.h"
+#include "Model.h"
+#include "PackArchive.h"
+#include "Particle.h"
+#include "ParticleSystem.h"
+#include "PhysicsEngine.h"
+#include "Renderer.h"
+#include "ResourceManager.h"
+#include "SceneSerializer.h"
+#include "ShaderCache.h"
+#include "TextureCompression.h"
+#include "TextureLoader.h"
+#include "VertexCompression.h"
+#include "VirtualFileSystem.h"
+
+namespace
+{
+
+template<typename Callback>
+double measure_ms(Callback const& callback)
+{
+    auto const begin = std::chrono::high_resolution_clock::now();
+    callback();
+    auto const end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+template<typename Callback>
+u64 measure_allocations(Callback const& callback)
+{
+    u64 const begin = AK::AllocationTracker::get_total().count;
+    callback();
+    return AK::AllocationTracker::get_total().count - begin;
+}
+
+// Checks can't count allocations of other threads, ex. async loading and hot reloading
+template<typename Callback>
+u64 measure_thread_allocations(Callback const& callback)
+{
+    u64 const begin = AK::AllocationTracker::get_thread_total().count;
+    callback();
+    return AK::AllocationTracker::get_thread_total().count - begin;
+}
+
+// Every failed check is reported, so a run shows all of them at once
+bool check(bool const condition, std::string_view const description)
+{
+    if (!condition)
+        Debug::log(std::format("Check failed: {}.", description), DebugType::Error);
+
+    return condition;
+}
+
+// Peak signal to noise ratio, compression artifacts are hard to see above 35 dB
+double get_psnr(std::span<u8 const> const original, std::span<u8 const> const decompressed)
+{
+    double squared_error = 0.0;
+
+    for (size_t i = 0; i < decompressed.size(); ++i)
+    {
+        double const difference = static_cast<double>(decompressed[i]) - static_cast<double>(original[i]);
+        squared_error += difference * difference;
+    }
+
+    double const mean_squared_error = squared_error / static_cast<double>(std::max<size_t>(decompressed.size(), 1));
+    return mean_squared_error > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mean_squared_error) : 99.0;
+}
+
+using Triangle = std::array<std::array<u8, sizeof(Vertex)>, 3>;
+
+// Triangles by the attributes of their vertices, sorted. Every triangle starts at its smallest vertex, so the winding is kept
+// and reordering or renumbering vertices doesn't change the result.
+std::vector<Triangle> get_sorted_triangles(std::vector<Vertex> const& vertices, std::vector<u32> const& indices)
+{
+    std::vector<Triangle> triangles(indices.size() / 3);
+
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        for (size_t corner = 0; corner < 3; ++corner)
+            std::memcpy(triangles[i][corner].data(), &vertices[indices[i * 3 + corner]], sizeof(Vertex));
+
+        std::ranges::rotate(triangles[i], std::ranges::min_element(triangles[i]));
+    }
+
+    std::ranges::sort(triangles);
+    return triangles;
+}
+
+// Copies res/shaders into the directory, returns a variant for every entry point of the copies
+std::vector<ShaderVariant> copy_shaders(std::string const& source_directory)
+{
+    std::vector<ShaderVariant> variants = {};
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::directory_iterator(Engine::asset_directory + "/shaders", error))
+    {
+        std::string const extension = entry.path().extension().string();
+
+        if (!entry.is_regular_file(error) || (extension != ".hlsl" && extension != ".h"))
+            continue;
+
+        std::string const path = source_directory + "/" + entry.path().filename().string();
+        std::filesystem::copy_file(entry.path(), path, error);
+
+        AK::MappedFile file = {};
+
+        if (!file.open(path))
+            continue;
+
+        if (file.get_text().find("vs_main") != std::string_view::npos)
+            variants.push_back({path, "vs_main", "vs_5_0"});
+
+        if (file.get_text().find("ps_main") != std::string_view::npos)
+            variants.push_back({path, "ps_main", "ps_5_0"});
+    }
+
+    return variants;
+}
+
+// Stands in for D3DCompileFromFile, with a cost close to compiling a small shader
+ShaderCompiler get_stub_compiler(std::atomic<u32>& call_count)
+{
+    return [&call_count](ShaderVariant const& variant, std::vector<u8>& bytecode, std::string&) {
+        ++call_count;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        std::string const text = variant.path + variant.entry_point + variant.target;
+        bytecode.assign(text.begin(), text.end());
+        return true;
+    };
+}
+
+std::shared_ptr<Entity> spawn_particle()
+{
+    // Mirrors how ParticleSystem spawned every particle as an entity with a sprite, before it simulated them in bulk
+    auto const particle_parent = Entity::create("1", "PARTICLE_PARENT");
+    auto const particle = Entity::create("1", "PARTICLE_");
+    particle_parent->is_serialized = false;
+    particle->is_serialized = false;
+    particle->transform->set_parent(particle_parent->transform);
+
+    auto const shader = ResourceManager::get_instance().load_shader("./res/shaders/particle.hlsl", "./res/shaders/particle.hlsl");
+    particle->add_component(Particle::create(nullptr, "./res/textures/particle.png", shader));
+
+    return particle_parent;
+}
+
+void destroy_deserialized(std::shared_ptr<SceneSerializer> const& serializer)
+{
+    // Destroying a root destroys its children as well
+    std::vector<std::shared_ptr<Entity>> roots = {};
+    for (auto const& entity : serializer->get_deserialized_entities())
+    {
+        if (!entity->transform->has_parent())
+            roots.emplace_back(entity);
+    }
+
+    for (auto const& root : roots)
+    {
+        root->destroy_immediate();
+    }
+}
+
+double load_and_destroy(std::string const& file_path)
+{
+    auto const serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    SceneSerializer::set_instance(serializer);
+
+    double const load_ms = measure_ms([&] { static_cast<void>(serializer->deserialize_this_entity(file_path)); });
+
+    destroy_deserialized(serializer);
+    SceneSerializer::set_instance(nullptr);
+
+    return load_ms;
+}
+
+struct AsyncLoadTimes
+{
+    double return_ms = 0.0;
+    double ready_ms = 0.0;
+};
+
+// Loads a file like load_and_destroy(), with models loaded by ResourceManager in the background.
+// Measures how long it takes until the load returns, and until every resource it requested is ready.
+AsyncLoadTimes load_async_and_destroy(std::string const& file_path)
+{
+    auto const serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    SceneSerializer::set_instance(serializer);
+
+    AsyncLoadTimes times = {};
+    times.ready_ms = measure_ms([&] {
+        times.return_ms = measure_ms([&] { static_cast<void>(serializer->deserialize_this_entity(file_path)); });
+        ResourceManager::get_instance().finish_async_loads();
+    });
+
+    destroy_deserialized(serializer);
+    SceneSerializer::set_instance(nullptr);
+
+    return times;
+}
+
+// Loads a file like load_and_destroy(), but returns the loaded entities written back to YAML.
+// Guids are new on every load, so they are replaced with numbers in the order they appear.
+std::string load_to_normalized_yaml(std::string const& file_path)
+{
+    std::string const output_path = "./.editor/benchmark_entity.txt";
+
+    auto const serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    SceneSerializer::set_instance(serializer);
+
+    if (auto const root = serializer->deserialize_this_entity(file_path); root != nullptr)
+        serializer->serialize_this_entity(root, output_path);
+
+    destroy_deserialized(serializer);
+    SceneSerializer::set_instance(nullptr);
+
+    std::ifstream file(output_path);
+    std::unordered_map<std::string, size_t> guid_numbers = {};
+    std::string normalized = {};
+    std::string line = {};
+
+    while (std::getline(file, line))
+    {
+        if (size_t const guid_offset = line.find("guid: "); guid_offset != std::string::npos)
+        {
+            std::string const guid = line.substr(guid_offset + 6);
+            auto const [it, inserted] = guid_numbers.emplace(guid, guid_numbers.size());
+            line.replace(guid_offset + 6, guid.size(), std::to_string(it->second));
+        }
+
+        normalized += line;
+        normalized += "\n";
+    }
+
+    file.close();
+    std::filesystem::remove(output_path);
+
+    return normalized;
+}
+
+// Reads every byte, so lazily mapped pages are actually loaded
+u64 touch_bytes(std::string_view const data)
+{
+    u64 sum = 0;
+    for (char const c : data)
+    {
+        sum += static_cast<u8>(c);
+    }
+
+    return sum;
+}
+
+double to_mb(i64 const bytes)
+{
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+}
+
+void Benchmark::run_entity_churn(u32 const iterations, u32 const ships_per_iteration, u32 const particles_per_iteration)
+{
+    auto const scene = MainScene::get_instance();
+
+    if (scene == nullptr)
+    {
+        Debug::log("Entity churn benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::vector<std::shared_ptr<Entity>> spawned = {};
+    spawned.reserve(ships_per_iteration + particles_per_iteration);
+
+    double spawn_ms = 0.0;
+    u64 spawn_allocations = 0;
+    double destroy_immediate_ms = 0.0;
+    double destroy_deferred_ms = 0.0;
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        bool const deferred = i % 2 == 1;
+
+        spawn_allocations += measure_allocations([&] {
+            spawn_ms += measure_ms([&] {
+                for (u32 j = 0; j < ships_per_iteration; ++j)
+                {
+                    auto const ship = SceneSerializer::load_prefab("ShipSmall");
+
+                    if (ship != nullptr)
+                        spawned.emplace_back(ship);
+                }
+
+                for (u32 j = 0; j < particles_per_iteration; ++j)
+                {
+                    spawned.emplace_back(spawn_particle());
+                }
+            });
+        });
+
+        double const destroy_ms = measure_ms([&] {
+            for (auto const& entity : spawned)
+            {
+                if (deferred)
+                    entity->destroy();
+                else
+                    entity->destroy_immediate();
+            }
+
+            if (deferred)
+                scene->play_back_commands();
+        });
+
+        if (deferred)
+            destroy_deferred_ms += destroy_ms;
+        else
+            destroy_immediate_ms += destroy_ms;
+
+        spawned.clear();
+    }
+
+    u32 const immediate_iterations = iterations - iterations / 2;
+    u32 const deferred_iterations = iterations / 2;
+
+    Debug::log(std::format("Entity churn: {} iterations of {} ships and {} particles, {} entities left in the scene.", iterations,
+                           ships_per_iteration, particles_per_iteration, scene->entities.size()));
+    Debug::log(std::format("Entity churn: spawn {:.3f} ms and {} heap allocations per iteration.", spawn_ms / iterations,
+                           spawn_allocations / iterations));
+
+    if (immediate_iterations > 0)
+        Debug::log(std::format("Entity churn: immediate destroy {:.3f} ms per iteration.", destroy_immediate_ms / immediate_iterations));
+
+    if (deferred_iterations > 0)
+        Debug::log(std::format("Entity churn: deferred destroy {:.3f} ms per iteration.", destroy_deferred_ms / deferred_iterations));
+}
+
+void Benchmark::run_entity_pooling(u32 const iterations, u32 const particles_per_iteration)
+{
+    auto const scene = MainScene::get_instance();
+
+    if (scene == nullptr)
+    {
+        Debug::log("Entity pooling benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::string const pool_key = "BENCHMARK_PARTICLE";
+    auto& pool = EntityPool::get_instance();
+
+    std::vector<std::shared_ptr<Entity>> spawned = {};
+    spawned.reserve(particles_per_iteration);
+
+    double unpooled_ms = 0.0;
+    double pooled_ms = 0.0;
+    u64 unpooled_allocations = 0;
+    u64 pooled_allocations = 0;
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        unpooled_allocations += measure_allocations([&] {
+            unpooled_ms += measure_ms([&] {
+                for (u32 j = 0; j < particles_per_iteration; ++j)
+                {
+                    spawned.emplace_back(spawn_particle());
+                }
+
+                for (auto const& entity : spawned)
+                {
+                    entity->destroy_immediate();
+                }
+            });
+        });
+
+        spawned.clear();
+
+        pooled_allocations += measure_allocations([&] {
+            pooled_ms += measure_ms([&] {
+                for (u32 j = 0; j < particles_per_iteration; ++j)
+                {
+                    spawned.emplace_back(pool.acquire(pool_key, spawn_particle));
+                }
+
+                for (auto const& entity : spawned)
+                {
+                    pool.release_immediate(entity);
+                }
+            });
+        });
+
+        // Last batch is kept to remove the dormant entities from the scene afterwards
+        if (i + 1 < iterations)
+            spawned.clear();
+    }
+
+    auto const stats = pool.get_stats(pool_key);
+
+    for (auto const& entity : spawned)
+    {
+        entity->destroy_immediate();
+    }
+
+    Debug::log(std::format("Entity pooling: {} iterations of {} particles.", iterations, particles_per_iteration));
+    Debug::log(std::format("Entity pooling: create and destroy {:.3f} ms and {} heap allocations per iteration.", unpooled_ms / iterations,
+                           unpooled_allocations / iterations));
+    Debug::log(std::format("Entity pooling: acquire and release {:.3f} ms and {} heap allocations per iteration, {} hits, {} misses.",
+                           pooled_ms / iterations, pooled_allocations / iterations, stats.hits, stats.misses));
+}
+
+void Benchmark::run_transforms_and_collisions(u32 const iterations)
+{
+    auto const scene = MainScene::get_instance();
+
+    if (scene == nullptr)
+    {
+        Debug::log("Transforms and collisions benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::vector<std::shared_ptr<Collider2D>> colliders = {};
+
+    for (auto const& entity : scene->entities)
+    {
+        for (auto const& collider : entity->get_components<Collider2D>())
+        {
+            colliders.emplace_back(collider);
+        }
+    }
+
+    double const transforms_ms = measure_ms([&] {
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            // Setting the local position marks the transform and its children dirty
+            for (auto const& entity : scene->entities)
+            {
+                entity->transform->set_local_position(entity->transform->get_local_position());
+            }
+
+            for (auto const& entity : scene->entities)
+            {
+                static_cast<void>(entity->transform->get_model_matrix());
+            }
+        }
+    });
+
+    u32 overlaps = 0;
+
+    double const collisions_ms = measure_ms([&] {
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            for (u32 j = 0; j < colliders.size(); ++j)
+            {
+                for (u32 k = j + 1; k < colliders.size(); ++k)
+                {
+                    glm::vec2 mtv = {};
+
+                    if (PhysicsEngine::compute_penetration(colliders[j], colliders[k], mtv))
+                        overlaps += 1;
+                }
+            }
+        }
+    });
+
+    Debug::log(std::format("Transforms and collisions: {} iterations, {} entities, {} colliders, {} overlaps per iteration.", iterations,
+                           scene->entities.size(), colliders.size(), overlaps / iterations));
+    Debug::log(std::format("Transforms and collisions: world matrices {:.3f} ms per iteration.", transforms_ms / iterations));
+    Debug::log(std::format("Transforms and collisions: collider pairs {:.3f} ms per iteration.", collisions_ms / iterations));
+}
+
+void Benchmark::run_scene_loading(u32 const iterations)
+{
+    if (MainScene::get_instance() == nullptr)
+    {
+        Debug::log("Scene loading benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::vector<std::string> file_paths = {"./res/scenes/MainScene.txt"};
+    for (u32 i = 0; i <= 6; ++i)
+    {
+        file_paths.emplace_back(std::format("./res/prefabs/Level_{}.txt", i));
+    }
+
+    bool const was_binary_enabled = SceneSerializer::is_binary_enabled();
+
+    for (auto const& file_path : file_paths)
+    {
+        bool const has_binary = std::filesystem::exists(SceneSerializer::get_binary_path(file_path));
+
+        double yaml_ms = 0.0;
+        double binary_ms = 0.0;
+
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            SceneSerializer::set_binary_enabled(false);
+            yaml_ms += load_and_destroy(file_path);
+
+            if (has_binary)
+            {
+                SceneSerializer::set_binary_enabled(true);
+                binary_ms += load_and_destroy(file_path);
+            }
+        }
+
+        if (has_binary)
+        {
+            Debug::log(std::format("Scene loading: {} YAML {:.3f} ms, binary {:.3f} ms ({:.1f}x).", file_path, yaml_ms / iterations,
+                                   binary_ms / iterations, yaml_ms / binary_ms));
+        }
+        else
+        {
+            Debug::log(std::format("Scene loading: {} YAML {:.3f} ms, no binary file. Run EngineHeaderTool/SceneConverter.py first.",
+                                   file_path, yaml_ms / iterations));
+        }
+    }
+
+    SceneSerializer::set_binary_enabled(was_binary_enabled);
+}
+
+void Benchmark::run_asset_loading(u32 const iterations)
+{
+    std::vector<std::string> file_paths = {};
+    for (u32 i = 0; i <= 6; ++i)
+    {
+        std::string const file_path = std::format("./res/prefabs/Level_{}.txt", i);
+        file_paths.emplace_back(file_path);
+
+        if (std::string const binary_path = SceneSerializer::get_binary_path(file_path); std::filesystem::exists(binary_path))
+            file_paths.emplace_back(binary_path);
+    }
+
+    u64 checksum = 0;
+
+    // Peak resident memory never goes down, so mapping runs first to not hide behind the peak of copying
+    double mapped_ms = 0.0;
+    i64 mapped_resident = 0;
+    u64 const peak_before_mapping = AK::AllocationTracker::get_peak_resident_bytes();
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        std::vector<AK::MappedFile> files(file_paths.size());
+        u64 const resident_before = AK::AllocationTracker::get_resident_bytes();
+
+        mapped_ms += measure_ms([&] {
+            for (size_t j = 0; j < file_paths.size(); ++j)
+            {
+                if (files[j].open(file_paths[j]))
+                    checksum += touch_bytes(files[j].get_text());
+            }
+        });
+
+        mapped_resident = static_cast<i64>(AK::AllocationTracker::get_resident_bytes()) - static_cast<i64>(resident_before);
+    }
+
+    auto const mapped_peak_growth = static_cast<i64>(AK::AllocationTracker::get_peak_resident_bytes() - peak_before_mapping);
+
+    double copied_ms = 0.0;
+    i64 copied_resident = 0;
+    u64 const peak_before_copying = AK::AllocationTracker::get_peak_resident_bytes();
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        std::vector<std::string> files(file_paths.size());
+        u64 const resident_before = AK::AllocationTracker::get_resident_bytes();
+
+        copied_ms += measure_ms([&] {
+            for (size_t j = 0; j < file_paths.size(); ++j)
+            {
+                std::ifstream file(file_paths[j], std::ios::binary);
+                std::stringstream stream;
+                stream << file.rdbuf();
+                files[j] = stream.str();
+                checksum += touch_bytes(files[j]);
+            }
+        });
+
+        copied_resident = static_cast<i64>(AK::AllocationTracker::get_resident_bytes()) - static_cast<i64>(resident_before);
+    }
+
+    auto const copied_peak_growth = static_cast<i64>(AK::AllocationTracker::get_peak_resident_bytes() - peak_before_copying);
+
+    Debug::log(std::format("Asset loading: {} files, copied {:.3f} ms, mapped {:.3f} ms (checksum {}).", file_paths.size(),
+                           copied_ms / iterations, mapped_ms / iterations, checksum));
+    Debug::log(std::format("Asset loading: resident growth copied {:.2f} MB, mapped {:.2f} MB.", to_mb(copied_resident),
+                           to_mb(mapped_resident)));
+    Debug::log(std::format("Asset loading: peak resident growth copied {:.2f} MB, mapped {:.2f} MB.", to_mb(copied_peak_growth),
+                           to_mb(mapped_peak_growth)));
+}
+
+void Benchmark::run_prefab_instantiation(u32 const ship_count, u32 const batch_size)
+{
+    if (MainScene::get_instance() == nullptr)
+    {
+        Debug::log("Prefab instantiation benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::vector<std::shared_ptr<Entity>> spawned = {};
+    spawned.reserve(batch_size);
+
+    auto const spawn_ships = [&](double& spawn_ms, u64& spawn_allocations) {
+        for (u32 i = 0; i < ship_count; i += batch_size)
+        {
+            spawn_allocations += measure_allocations([&] {
+                spawn_ms += measure_ms([&] {
+                    for (u32 j = i; j < std::min(i + batch_size, ship_count); ++j)
+                    {
+                        if (auto const ship = SceneSerializer::load_prefab("ShipSmall"); ship != nullptr)
+                            spawned.emplace_back(ship);
+                    }
+                });
+            });
+
+            for (auto const& ship : spawned)
+            {
+                ship->destroy_immediate();
+            }
+
+            spawned.clear();
+        }
+    };
+
+    bool const was_cache_enabled = SceneSerializer::is_prefab_cache_enabled();
+
+    double parsed_ms = 0.0;
+    u64 parsed_allocations = 0;
+    SceneSerializer::set_prefab_cache_enabled(false);
+    spawn_ships(parsed_ms, parsed_allocations);
+
+    // Includes creating the template on the first spawn
+    double cached_ms = 0.0;
+    u64 cached_allocations = 0;
+    SceneSerializer::set_prefab_cache_enabled(true);
+    SceneSerializer::clear_prefab_cache();
+    spawn_ships(cached_ms, cached_allocations);
+
+    SceneSerializer::set_prefab_cache_enabled(was_cache_enabled);
+
+    Debug::log(std::format("Prefab instantiation: {} ships, parsed {:.3f} ms ({:.4f} ms per ship), cached {:.3f} ms ({:.4f} ms per ship).",
+                           ship_count, parsed_ms, parsed_ms / ship_count, cached_ms, cached_ms / ship_count));
+    Debug::log(std::format("Prefab instantiation: heap allocations per ship parsed {}, cached {}.", parsed_allocations / ship_count,
+                           cached_allocations / ship_count));
+}
+
+void Benchmark::run_parallel_parsing(u32 const iterations)
+{
+    if (MainScene::get_instance() == nullptr)
+    {
+        Debug::log("Parallel parsing benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::string file_path = {};
+    uintmax_t file_size = 0;
+    for (u32 i = 0; i <= 6; ++i)
+    {
+        std::string const level_path = std::format("./res/prefabs/Level_{}.txt", i);
+        std::error_code error = {};
+
+        if (uintmax_t const level_size = std::filesystem::file_size(level_path, error); !error && level_size > file_size)
+        {
+            file_path = level_path;
+            file_size = level_size;
+        }
+    }
+
+    if (file_path.empty())
+    {
+        Debug::log("Parallel parsing benchmark couldn't find any level prefab.", DebugType::Error);
+        return;
+    }
+
+    bool const was_binary_enabled = SceneSerializer::is_binary_enabled();
+    bool const was_parallel_parsing_enabled = SceneSerializer::is_parallel_parsing_enabled();
+    SceneSerializer::set_binary_enabled(false);
+
+    double serial_ms = 0.0;
+    double parallel_ms = 0.0;
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        SceneSerializer::set_parallel_parsing_enabled(false);
+        serial_ms += load_and_destroy(file_path);
+
+        SceneSerializer::set_parallel_parsing_enabled(true);
+        parallel_ms += load_and_destroy(file_path);
+    }
+
+    SceneSerializer::set_parallel_parsing_enabled(false);
+    std::string const serial_yaml = load_to_normalized_yaml(file_path);
+    SceneSerializer::set_parallel_parsing_enabled(true);
+    std::string const parallel_yaml = load_to_normalized_yaml(file_path);
+
+    SceneSerializer::set_binary_enabled(was_binary_enabled);
+    SceneSerializer::set_parallel_parsing_enabled(was_parallel_parsing_enabled);
+
+    Debug::log(std::format("Parallel parsing: {} serial {:.3f} ms, parallel {:.3f} ms ({:.1f}x).", file_path, serial_ms / iterations,
+                           parallel_ms / iterations, serial_ms / parallel_ms));
+
+    if (serial_yaml == parallel_yaml)
+        Debug::log("Parallel parsing: loaded entities are identical.");
+    else
+        Debug::log("Parallel parsing: loaded entities differ between serial and parallel parsing.", DebugType::Error);
+}
+
+void Benchmark::run_incremental_save(u32 const iterations)
+{
+    auto const scene = MainScene::get_instance();
+
+    if (scene->is_running)
+    {
+        Debug::log("Incremental save: stop the game first, running scenes are always saved whole.", DebugType::Warning);
+        return;
+    }
+
+    std::shared_ptr<Entity> edited_entity = nullptr;
+    u32 entity_count = 0;
+
+    for (auto const& entity : scene->entities)
+    {
+        if (!entity->is_serialized)
+            continue;
+
+        if (edited_entity == nullptr)
+            edited_entity = entity;
+
+        entity_count += 1;
+    }
+
+    if (edited_entity == nullptr)
+    {
+        Debug::log("Incremental save: the scene is empty.", DebugType::Warning);
+        return;
+    }
+
+    std::string const full_path = "./.editor/benchmark_scene_full.txt";
+    std::string const incremental_path = "./.editor/benchmark_scene_incremental.txt";
+
+    auto const serializer = std::make_shared<SceneSerializer>(scene);
+    SceneSerializer::set_instance(serializer);
+
+    bool const was_incremental_save_enabled = SceneSerializer::is_incremental_save_enabled();
+
+    // Same as the first save after loading the scene, every entity is emitted
+    SceneSerializer::set_incremental_save_enabled(true);
+    serializer->serialize(incremental_path);
+
+    glm::vec3 const original_position = edited_entity->transform->get_local_position();
+
+    double full_ms = 0.0;
+    double incremental_ms = 0.0;
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        // Single field edit, like moving the entity with the gizmo. Not marked dirty, the transform tracks it, so saved files
+        // differ if it doesn't.
+        edited_entity->transform->set_local_position(original_position + glm::vec3(static_cast<float>(i + 1), 0.0f, 0.0f));
+
+        SceneSerializer::set_incremental_save_enabled(false);
+        full_ms += measure_ms([&] { serializer->serialize(full_path); });
+
+        SceneSerializer::set_incremental_save_enabled(true);
+        incremental_ms += measure_ms([&] { serializer->serialize(incremental_path); });
+    }
+
+    edited_entity->transform->set_local_position(original_position);
+
+    SceneSerializer::set_incremental_save_enabled(was_incremental_save_enabled);
+    SceneSerializer::set_instance(nullptr);
+
+    auto const read_file = [](std::string const& file_path) {
+        std::ifstream file(file_path);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    };
+
+    Debug::log(std::format("Incremental save: {} entities, full {:.3f} ms, incremental {:.3f} ms ({:.1f}x).", entity_count,
+                           full_ms / iterations, incremental_ms / iterations, full_ms / incremental_ms));
+
+    if (read_file(full_path) == read_file(incremental_path))
+        Debug::log("Incremental save: saved files are identical.");
+    else
+        Debug::log("Incremental save: saved files differ between full and incremental save.", DebugType::Error);
+}
+
+void Benchmark::run_async_loading(u32 const iterations)
+{
+    if (MainScene::get_instance() == nullptr)
+    {
+        Debug::log("Async loading benchmark requires a loaded scene.", DebugType::Error);
+        return;
+    }
+
+    std::vector<std::string> file_paths = {"./res/scenes/MainScene.txt"};
+    for (u32 i = 0; i <= 6; ++i)
+    {
+        file_paths.emplace_back(std::format("./res/prefabs/Level_{}.txt", i));
+    }
+
+    bool const was_async_loading_enabled = ResourceManager::is_async_loading_enabled();
+
+    for (auto const& file_path : file_paths)
+    {
+        double sync_ms = 0.0;
+        AsyncLoadTimes async_times = {};
+
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            ResourceManager::set_async_loading_enabled(false);
+            sync_ms += load_and_destroy(file_path);
+
+            ResourceManager::set_async_loading_enabled(true);
+            AsyncLoadTimes const times = load_async_and_destroy(file_path);
+            async_times.return_ms += times.return_ms;
+            async_times.ready_ms += times.ready_ms;
+        }
+
+        Debug::log(std::format("Async loading: {} sync {:.3f} ms, async returns after {:.3f} ms ({:.1f}x), ready after {:.3f} ms.",
+                               file_path, sync_ms / iterations, async_times.return_ms / iterations, sync_ms / async_times.return_ms,
+                               async_times.ready_ms / iterations));
+    }
+
+    ResourceManager::set_async_loading_enabled(was_async_loading_enabled);
+}
+
+bool Benchmark::run_resource_collection(u32 const rounds)
+{
+    if (MainScene::get_instance() == nullptr)
+    {
+        Debug::log("Resource collection benchmark requires a loaded scene.", DebugType::Error);
+        return false;
+    }
+
+    auto& resource_manager = ResourceManager::get_instance();
+
+    // Resources of the current scene stay loaded, only growth on top of them is measured
+    resource_manager.collect();
+    u64 const baseline_bytes = resource_manager.get_memory_usage();
+
+    u64 first_round_bytes = 0;
+    u64 first_round_resident = 0;
+    u64 last_round_bytes = 0;
+    u64 last_round_resident = 0;
+
+    for (u32 i = 0; i < rounds; ++i)
+    {
+        u64 peak_bytes = 0;
+        u64 freed_bytes = 0;
+
+        for (u32 level = 0; level <= 6; ++level)
+        {
+            static_cast<void>(load_and_destroy(std::format("./res/prefabs/Level_{}.txt", level)));
+            peak_bytes = std::max(peak_bytes, resource_manager.get_memory_usage());
+            freed_bytes += resource_manager.collect();
+        }
+
+        last_round_bytes = resource_manager.get_memory_usage();
+        last_round_resident = AK::AllocationTracker::get_resident_bytes();
+
+        if (i == 0)
+        {
+            first_round_bytes = last_round_bytes;
+            first_round_resident = last_round_resident;
+        }
+
+        Debug::log(std::format("Resource collection: round {}, peak {:.2f} MB, collected {:.2f} MB, {:.2f} MB left, resident {:.2f} MB.",
+                               i, to_mb(static_cast<i64>(peak_bytes)), to_mb(static_cast<i64>(freed_bytes)),
+                               to_mb(static_cast<i64>(last_round_bytes)), to_mb(static_cast<i64>(last_round_resident))));
+    }
+
+    bool const is_collected = check(last_round_bytes <= baseline_bytes,
+                                    std::format("resource collection left {:.2f} MB of resources of the levels loaded",
+                                                to_mb(static_cast<i64>(last_round_bytes) - static_cast<i64>(baseline_bytes))));
+
+    // Allocators keep some freed memory around, so only growth beyond the first round counts
+    bool const is_flat = check(last_round_bytes <= first_round_bytes
+                                   && last_round_resident <= first_round_resident + first_round_resident / 10,
+                               std::format("resource collection let memory grow from {:.2f} MB to {:.2f} MB resident over {} rounds",
+                                           to_mb(static_cast<i64>(first_round_resident)), to_mb(static_cast<i64>(last_round_resident)),
+                                           rounds));
+
+    if (is_collected && is_flat)
+        Debug::log("Resource collection: memory stayed flat.");
+
+    resource_manager.log_memory_report();
+
+    return is_collected && is_flat;
+}
+
+void Benchmark::run_resource_lookups(u32 const particle_count)
+{
+    std::string const shader_path = "./res/shaders/particle.hlsl";
+    std::string const texture_path = "./res/textures/particle.png";
+
+    // Same resources as Particle::create_sprite()
+    std::vector<Vertex> const vertices = {
+        {glm::vec3(-1.0f, -1.0f, 0.0f), {}, {0.0f, 0.0f}},
+        {glm::vec3(1.0f, -1.0f, 0.0f), {}, {1.0f, 0.0f}},
+        {glm::vec3(1.0f, 1.0f, 0.0f), {}, {1.0f, 1.0f}},
+        {glm::vec3(-1.0f, 1.0f, 0.0f), {}, {0.0f, 1.0f}},
+    };
+    std::vector<u32> const indices = {0, 1, 2, 0, 2, 3};
+
+    TextureSettings texture_settings = {};
+    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
+    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+
+    auto& resource_manager = ResourceManager::get_instance();
+
+    auto const spawn = [&] {
+        auto const shader = resource_manager.load_shader(shader_path, shader_path);
+        std::vector const textures = {resource_manager.load_texture(texture_path, TextureType::Diffuse, texture_settings)};
+        return resource_manager.load_mesh(0, texture_path, vertices, indices, textures, DrawType::Triangles, default_material);
+    };
+
+    // Everything is loaded by the first spawn, the rest only hits the cache
+    auto const first_mesh = spawn();
+    std::shared_ptr<Mesh> mesh = nullptr;
+
+    double const interned_ms = measure_ms([&] {
+        for (u32 i = 0; i < particle_count; ++i)
+        {
+            mesh = spawn();
+        }
+    });
+
+    if (mesh != first_mesh)
+        Debug::log("Resource lookups: spawning the same particle created a different mesh.", DebugType::Error);
+
+    // Keys as ResourceManager used to build them, concatenated in a stringstream and looked up in string maps
+    std::unordered_map<std::string, u16> names_to_shaders = {{shader_path + shader_path, 0}};
+    std::unordered_map<std::string, u16> names_to_textures = {{texture_path, 0}};
+    std::unordered_map<std::string, u16> names_to_meshes = {{texture_path + "0" + texture_path, 0}};
+    u64 found_count = 0;
+
+    double const stringstream_ms = measure_ms([&] {
+        for (u32 i = 0; i < particle_count; ++i)
+        {
+            std::stringstream shader_stream;
+            shader_stream << shader_path << shader_path;
+            found_count += names_to_shaders.contains(shader_stream.str());
+
+            found_count += names_to_textures.contains(texture_path);
+
+            std::stringstream mesh_stream;
+            mesh_stream << texture_path << 0 << texture_path;
+            found_count += names_to_meshes.contains(mesh_stream.str());
+        }
+    });
+
+    Debug::log(std::format("Resource lookups: {} particle spawns, interned keys {:.3f} ms, stringstream keys {:.3f} ms ({:.1f}x), {} hits.",
+                           particle_count, interned_ms, stringstream_ms, stringstream_ms / interned_ms, found_count));
+}
+
+void Benchmark::run_model_loading(u32 const iterations)
+{
+    std::vector<std::string> model_paths = {};
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::recursive_directory_iterator("./res/models", error))
+    {
+        if (entry.path().extension() == ".gltf")
+            model_paths.emplace_back(entry.path().generic_string());
+    }
+
+    std::ranges::sort(model_paths);
+
+    bool const was_mesh_cooking_enabled = Model::is_mesh_cooking_enabled();
+    double total_assimp_ms = 0.0;
+    double total_cooked_ms = 0.0;
+
+    for (auto const& model_path : model_paths)
+    {
+        // Cooks the model if it isn't cooked yet, so only reading the cooked file is measured
+        Model::set_mesh_cooking_enabled(true);
+        static_cast<void>(Model::read_model_data(model_path));
+
+        std::shared_ptr<ModelData const> assimp_data = nullptr;
+        std::shared_ptr<ModelData const> cooked_data = nullptr;
+        double assimp_ms = 0.0;
+        double cooked_ms = 0.0;
+
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            Model::set_mesh_cooking_enabled(false);
+            assimp_ms += measure_ms([&] { assimp_data = Model::read_model_data(model_path); });
+
+            Model::set_mesh_cooking_enabled(true);
+            cooked_ms += measure_ms([&] { cooked_data = Model::read_model_data(model_path); });
+        }
+
+        total_assimp_ms += assimp_ms / iterations;
+        total_cooked_ms += cooked_ms / iterations;
+
+        if (assimp_data == nullptr || cooked_data == nullptr)
+        {
+            Debug::log(std::format("Model loading: {} could not be read.", model_path), DebugType::Error);
+            continue;
+        }
+
+        bool const is_same = std::ranges::equal(assimp_data->meshes, cooked_data->meshes, [](auto const& a, auto const& b) {
+            return a.indices == b.indices && a.lods == b.lods && a.diffuse_texture_paths == b.diffuse_texture_paths
+                && a.specular_texture_paths == b.specular_texture_paths && a.vertices.size() == b.vertices.size()
+                && std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Vertex)) == 0;
+        });
+
+        if (!is_same)
+            Debug::log(std::format("Model loading: cooked {} differs from the one read with Assimp.", model_path), DebugType::Error);
+
+        Debug::log(std::format("Model loading: {} Assimp {:.3f} ms, cooked {:.3f} ms ({:.1f}x).", model_path, assimp_ms / iterations,
+                               cooked_ms / iterations, assimp_ms / cooked_ms));
+    }
+
+    Model::set_mesh_cooking_enabled(was_mesh_cooking_enabled);
+
+    Debug::log(std::format("Model loading: {} models, Assimp {:.3f} ms, cooked {:.3f} ms ({:.1f}x).", model_paths.size(), total_assimp_ms,
+                           total_cooked_ms, total_assimp_ms / total_cooked_ms));
+}
+
+bool Benchmark::check_mesh_optimization()
+{
+    // A grid of quads with its own vertex for every corner of every triangle, in a scattered order, so every step has work
+    u32 constexpr quads_per_side = 32;
+    u32 constexpr quad_count = quads_per_side * quads_per_side;
+    std::array<glm::vec2, 6> const corners = {{{0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}}};
+    std::vector<Vertex> vertices = {};
+    std::vector<u32> indices = {};
+
+    for (u32 i = 0; i < quad_count; ++i)
+    {
+        // 389 is prime, so every quad is visited once
+        u32 const quad = i * 389 % quad_count;
+        auto const x = static_cast<float>(quad % quads_per_side);
+        auto const y = static_cast<float>(quad / quads_per_side);
+
+        for (auto const& corner : corners)
+        {
+            glm::vec3 const position = {x + corner.x, 0.0f, y + corner.y};
+            indices.emplace_back(static_cast<u32>(vertices.size()));
+            vertices.push_back({position, {0.0f, 1.0f, 0.0f}, glm::vec2(position.x, position.z) / static_cast<float>(quads_per_side)});
+        }
+    }
+
+    std::vector<Triangle> const triangles = get_sorted_triangles(vertices, indices);
+    MeshStatistics const before = MeshOptimizer::analyze(vertices, indices);
+
+    MeshOptimizer::optimize(vertices, indices);
+    MeshStatistics const after = MeshOptimizer::analyze(vertices, indices);
+
+    // Every check runs even after one failed
+    bool is_passed = check(std::ranges::all_of(indices, [&](u32 const index) { return index < vertices.size(); }),
+                           "an optimized mesh only refers to its own vertices");
+    // Triangles can only be compared when the indices are valid
+    is_passed = is_passed
+             && check(get_sorted_triangles(vertices, indices) == triangles, "an optimized mesh keeps every triangle and its winding");
+    is_passed = check(vertices.size() == (quads_per_side + 1) * (quads_per_side + 1),
+                      std::format("welding left {} of {} vertices of a grid", vertices.size(), before.vertex_count))
+             && is_passed;
+    is_passed = check(after.acmr < before.acmr,
+                      std::format("optimizing a grid changed its ACMR from {:.3f} to {:.3f}", before.acmr, after.acmr))
+             && is_passed;
+
+    return is_passed;
+}
+
+void Benchmark::run_mesh_optimization()
+{
+    check_mesh_optimization();
+
+    std::vector<std::string> model_paths = {};
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::recursive_directory_iterator("./res/models", error))
+    {
+        if (entry.path().extension() == ".gltf")
+            model_paths.emplace_back(entry.path().generic_string());
+    }
+
+    std::ranges::sort(model_paths);
+
+    bool const was_mesh_cooking_enabled = Model::is_mesh_cooking_enabled();
+    bool const was_mesh_optimization_enabled = Model::is_mesh_optimization_enabled();
+    bool const was_lod_generation_enabled = Model::is_lod_generation_enabled();
+    Model::set_mesh_cooking_enabled(false);
+    Model::set_mesh_optimization_enabled(false);
+    Model::set_lod_generation_enabled(false);
+
+    MeshStatistics total_before = {};
+    MeshStatistics total_after = {};
+    double total_ms = 0.0;
+
+    auto const add_statistics = [](MeshStatistics& total, MeshStatistics const& statistics) {
+        // Cache misses, averaged over all triangles at the end
+        total.acmr += statistics.acmr * static_cast<float>(statistics.index_count / 3);
+        total.vertex_count += statistics.vertex_count;
+        total.index_count += statistics.index_count;
+        total.vertex_bytes += statistics.vertex_bytes;
+        total.index_bytes += statistics.index_bytes;
+    };
+
+    for (auto const& model_path : model_paths)
+    {
+        auto const data = Model::read_model_data(model_path);
+
+        if (data == nullptr)
+        {
+            Debug::log(std::format("Mesh optimization: {} could not be read.", model_path), DebugType::Error);
+            continue;
+        }
+
+        for (size_t i = 0; i < data->meshes.size(); ++i)
+        {
+            std::vector<Vertex> vertices = data->meshes[i].vertices;
+            std::vector<u32> indices = data->meshes[i].indices;
+
+            MeshStatistics before = MeshOptimizer::analyze(vertices, indices);
+            // Meshes always used 32-bit indices before
+            before.index_bytes = indices.size() * sizeof(u32);
+
+            total_ms += measure_ms([&] { MeshOptimizer::optimize(vertices, indices); });
+            MeshStatistics const after = MeshOptimizer::analyze(vertices, indices);
+
+            check(get_sorted_triangles(vertices, indices) == get_sorted_triangles(data->meshes[i].vertices, data->meshes[i].indices),
+                  std::format("optimizing {} mesh {} keeps every triangle and its winding", model_path, i));
+
+            Debug::log(std::format("Mesh optimization: {} mesh {}, {} -> {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, "
+                                   "{:.1f} -> {:.1f} KB.",
+                                   model_path, i, before.vertex_count, after.vertex_count, before.acmr, after.acmr, before.atvr, after.atvr,
+                                   static_cast<double>(before.vertex_bytes + before.index_bytes) / 1024.0,
+                                   static_cast<double>(after.vertex_bytes + after.index_bytes) / 1024.0));
+
+            add_statistics(total_before, before);
+            add_statistics(total_after, after);
+        }
+    }
+
+    Model::set_mesh_cooking_enabled(was_mesh_cooking_enabled);
+    Model::set_mesh_optimization_enabled(was_mesh_optimization_enabled);
+    Model::set_lod_generation_enabled(was_lod_generation_enabled);
+
+    float const triangle_count = static_cast<float>(std::max(total_before.index_count / 3, 1u));
+
+    Debug::log(std::format("Mesh optimization: {} models, {} -> {} vertices, ACMR {:.3f} -> {:.3f}, vertices {:.2f} -> {:.2f} MB, "
+                           "indices {:.2f} -> {:.2f} MB, optimized in {:.3f} ms.",
+                           model_paths.size(), total_before.vertex_count, total_after.vertex_count, total_before.acmr / triangle_count,
+                           total_after.acmr / triangle_count, to_mb(static_cast<i64>(total_before.vertex_bytes)),
+                           to_mb(static_cast<i64>(total_after.vertex_bytes)), to_mb(static_cast<i64>(total_before.index_bytes)),
+                           to_mb(static_cast<i64>(total_after.index_bytes)), total_ms));
+}
+
+void Benchmark::run_vertex_compression()
+{
+    std::vector<std::string> model_paths = {};
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::recursive_directory_iterator("./res/models", error))
+    {
+        if (entry.path().extension() == ".gltf")
+            model_paths.emplace_back(entry.path().generic_string());
+    }
+
+    std::ranges::sort(model_paths);
+
+    std::array<u32, static_cast<size_t>(VertexFormat::Count)> total_format_counts = {};
+    u64 total_full_bytes = 0;
+    u64 total_compressed_bytes = 0;
+    u64 total_cpu_bytes = 0;
+    float total_normal_error = 0.0f;
+    float total_texture_coordinate_error = 0.0f;
+
+    for (auto const& model_path : model_paths)
+    {
+        auto const data = Model::read_model_data(model_path);
+
+        if (data == nullptr)
+        {
+            Debug::log(std::format("Vertex compression: {} could not be read.", model_path), DebugType::Error);
+            continue;
+        }
+
+        std::array<u32, static_cast<size_t>(VertexFormat::Count)> format_counts = {};
+        u64 full_bytes = 0;
+        u64 compressed_bytes = 0;
+        float normal_error = 0.0f;
+        float texture_coordinate_error = 0.0f;
+
+        for (auto const& mesh : data->meshes)
+        {
+            VertexFormat const format = VertexCompression::choose_format(mesh.vertices);
+            format_counts[static_cast<size_t>(format)] += 1;
+
+            full_bytes += mesh.vertices.size() * sizeof(Vertex);
+            compressed_bytes += mesh.vertices.size() * VertexCompression::get_vertex_size(format);
+
+            // Meshes used to keep both arrays after uploading them
+            total_cpu_bytes += mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(u32);
+
+            if (format == VertexFormat::Full)
+                continue;
+
+            std::vector<CompactVertex> const compact_vertices = VertexCompression::compress(mesh.vertices, format);
+
+            for (size_t i = 0; i < mesh.vertices.size(); ++i)
+            {
+                Vertex const decompressed = VertexCompression::decompress(compact_vertices[i], format);
+                glm::vec3 const normal_difference = glm::abs(decompressed.normal - mesh.vertices[i].normal);
+                glm::vec2 const texture_coordinate_difference =
+                    glm::abs(decompressed.texture_coordinates - mesh.vertices[i].texture_coordinates);
+
+                normal_error = std::max({normal_error, normal_difference.x, normal_difference.y, normal_difference.z});
+                texture_coordinate_error =
+                    std::max({texture_coordinate_error, texture_coordinate_difference.x, texture_coordinate_difference.y});
+            }
+        }
+
+        Debug::log(std::format("Vertex compression: {} {} full, {} half UV, {} unit UV meshes, {:.1f} -> {:.1f} KB, "
+                               "max normal error {:.4f}, max UV error {:.6f}.",
+                               model_path, format_counts[0], format_counts[1], format_counts[2], static_cast<double>(full_bytes) / 1024.0,
+                               static_cast<double>(compressed_bytes) / 1024.0, normal_error, texture_coordinate_error));
+
+        for (size_t i = 0; i < format_counts.size(); ++i)
+            total_format_counts[i] += format_counts[i];
+
+        total_full_bytes += full_bytes;
+        total_compressed_bytes += compressed_bytes;
+        total_normal_error = std::max(total_normal_error, normal_error);
+        total_texture_coordinate_error = std::max(total_texture_coordinate_error, texture_coordinate_error);
+    }
+
+    Debug::log(std::format("Vertex compression: {} models, {} full, {} half UV, {} unit UV meshes, vertices {:.2f} -> {:.2f} MB, "
+                           "{:.2f} MB of CPU copies freed, max normal error {:.4f}, max UV error {:.6f}.",
+                           model_paths.size(), total_format_counts[0], total_format_counts[1], total_format_counts[2],
+                           to_mb(static_cast<i64>(total_full_bytes)), to_mb(static_cast<i64>(total_compressed_bytes)),
+                           to_mb(static_cast<i64>(total_cpu_bytes)), total_normal_error, total_texture_coordinate_error));
+}
+
+void Benchmark::run_lods()
+{
+    if (MainScene::get_instance() == nullptr || Camera::get_main_camera() == nullptr)
+    {
+        Debug::log("LOD benchmark requires a loaded scene with a camera.", DebugType::Error);
+        return;
+    }
+
+    std::shared_ptr<Camera> const camera = Camera::get_main_camera();
+    glm::vec3 const camera_position = camera->get_position();
+    float const screen_scale = camera->height / (2.0f * std::tan(camera->fov * 0.5f));
+
+    bool const were_lods_enabled = Model::are_lods_enabled();
+    bool const was_async_loading_enabled = ResourceManager::is_async_loading_enabled();
+    ResourceManager::set_async_loading_enabled(false);
+
+    // Levels of detail are chosen the way the Renderer does it every frame
+    auto const count_triangles = [&](bool const lods_enabled) {
+        Model::set_lods_enabled(lods_enabled);
+        u64 triangle_count = 0;
+
+        for (auto const& entity : MainScene::get_instance()->entities)
+        {
+            for (auto const& model : entity->get_components<Model>())
+            {
+                model->select_lod(camera_position, screen_scale);
+                triangle_count += model->get_triangle_count();
+            }
+        }
+
+        return triangle_count;
+    };
+
+    u64 total_full = 0;
+    u64 total_lod = 0;
+
+    for (u32 i = 0; i <= 6; ++i)
+    {
+        std::string const file_path = std::format("./res/prefabs/Level_{}.txt", i);
+
+        auto const serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+        SceneSerializer::set_instance(serializer);
+        static_cast<void>(serializer->deserialize_this_entity(file_path));
+
+        u64 const full = count_triangles(false);
+        u64 const lod = count_triangles(true);
+
+        destroy_deserialized(serializer);
+        SceneSerializer::set_instance(nullptr);
+
+        total_full += full;
+        total_lod += lod;
+
+        Debug::log(std::format("LODs: {} {} triangles in full, {} with LODs ({:.1f}%).", file_path, full, lod,
+                               100.0 * static_cast<double>(lod) / static_cast<double>(std::max<u64>(full, 1))));
+    }
+
+    Model::set_lods_enabled(were_lods_enabled);
+    ResourceManager::set_async_loading_enabled(was_async_loading_enabled);
+
+    Debug::log(std::format("LODs: all levels {} triangles in full, {} with LODs ({:.1f}%), camera at ({:.1f}, {:.1f}, {:.1f}).",
+                           total_full, total_lod,
+                           100.0 * static_cast<double>(total_lod) / static_cast<double>(std::max<u64>(total_full, 1)), camera_position.x,
+                           camera_position.y, camera_position.z));
+}
+
+bool Benchmark::check_texture_compression()
+{
+    bool is_passed = true;
+
+    // Levels halve down to 1x1 along the longer side, odd dimensions round down
+    is_passed = check(TextureCompression::get_level_count(16, 16) == 5, "a 16x16 image has 5 levels") && is_passed;
+    is_passed = check(TextureCompression::get_level_count(64, 32) == 7, "a 64x32 image has 7 levels") && is_passed;
+    is_passed = check(TextureCompression::get_level_count(100, 60) == 7, "a 100x60 image has 7 levels") && is_passed;
+    is_passed = check(TextureCompression::get_level_count(1, 1) == 1, "a 1x1 image has 1 level") && is_passed;
+    is_passed = check(TextureCompression::get_level_dimension(100, 3) == 12, "level 3 of 100 texels is 12 texels") && is_passed;
+    is_passed = check(TextureCompression::get_level_dimension(60, 6) == 1, "levels past the shorter side are 1 texel") && is_passed;
+
+    // Blocks are 8 bytes for BC1 and 16 for BC3, levels that aren't made of whole blocks round up
+    is_passed = check(TextureCompression::get_level_size(TextureFormat::BC1, 64, 64) == 2048, "a 64x64 BC1 level is 2048 bytes")
+                && is_passed;
+    is_passed = check(TextureCompression::get_level_size(TextureFormat::BC3, 64, 64) == 4096, "a 64x64 BC3 level is 4096 bytes")
+                && is_passed;
+    is_passed = check(TextureCompression::get_level_size(TextureFormat::BC1, 6, 6) == 32, "a 6x6 BC1 level is 4 blocks") && is_passed;
+    is_passed = check(TextureCompression::get_level_size(TextureFormat::BC1, 1, 1) == 8, "a 1x1 BC1 level is 1 block") && is_passed;
+
+    // A single color stays the same in every level, also when dimensions are odd
+    {
+        std::vector<u8> const gray(100 * 60 * 4, 128);
+        std::vector<u8> const levels = TextureCompression::generate_mipmaps(gray, 100, 60, 7);
+
+        is_passed = check(levels.size() == TextureCompression::get_image_size(TextureFormat::RGBA8, 100, 60, 7),
+                          "mipmaps of a 100x60 image hold every level")
+                    && is_passed;
+        is_passed = check(std::ranges::all_of(levels, [](u8 const value) { return std::abs(value - 128) <= 1; }),
+                          "mipmaps of a single color keep the color")
+                    && is_passed;
+    }
+
+    // Texels alternating between black and white average to half of the linear intensity, not of the sRGB value
+    {
+        u32 constexpr size = 16;
+        std::vector<u8> checkerboard(size * size * 4, 255);
+
+        for (u32 i = 0; i < size * size; ++i)
+        {
+            if ((i % size + i / size) % 2 == 0)
+                std::fill_n(&checkerboard[i * 4], 3, 0);
+        }
+
+        std::vector<u8> const levels = TextureCompression::generate_mipmaps(checkerboard, size, size, 5);
+        bool is_filtered_correctly = levels.size() == TextureCompression::get_image_size(TextureFormat::RGBA8, size, size, 5);
+
+        for (size_t i = size * size * 4; i < levels.size(); ++i)
+        {
+            u8 const expected = i % 4 == 3 ? 255 : 188;
+            is_filtered_correctly = is_filtered_correctly && std::abs(levels[i] - expected) <= 1;
+        }
+
+        is_passed = check(is_filtered_correctly, "mipmaps of a checkerboard are filtered in linear space") && is_passed;
+    }
+
+    // Two colors that 5:6:5 bits hold exactly are the endpoints of a block, and decode to themselves
+    {
+        std::array<u8, 64> texels = {};
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            bool const is_yellow = i % 3 == 0;
+            texels[i * 4] = is_yellow ? 255 : 0;
+            texels[i * 4 + 1] = is_yellow ? 255 : 0;
+            texels[i * 4 + 2] = is_yellow ? 0 : 255;
+            texels[i * 4 + 3] = 255;
+        }
+
+        std::array<u8, 8> block = {};
+        std::array<u8, 64> decoded = {};
+        TextureCompression::encode_bc1_block(texels.data(), block.data());
+        TextureCompression::decode_bc1_block(block.data(), decoded.data());
+
+        is_passed = check(decoded == texels, "a BC1 block of two colors decodes to itself") && is_passed;
+    }
+
+    // A single color fits the endpoints of a block, only rounding it to 5:6:5 bits changes it
+    {
+        std::array<u8, 64> texels = {};
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            texels[i * 4] = 200;
+            texels[i * 4 + 1] = 100;
+            texels[i * 4 + 2] = 50;
+            texels[i * 4 + 3] = static_cast<u8>(i * 17);
+        }
+
+        std::array<u8, 16> block = {};
+        std::array<u8, 64> decoded = {};
+        TextureCompression::encode_bc3_block(texels.data(), block.data());
+        TextureCompression::decode_bc3_block(block.data(), decoded.data());
+
+        bool is_encoded_correctly = true;
+
+        for (u32 i = 0; i < 64; ++i)
+        {
+            i32 const tolerance = i % 4 == 3 ? 18 : i % 4 == 1 ? 2 : 4;
+            is_encoded_correctly = is_encoded_correctly && std::abs(decoded[i] - texels[i]) <= tolerance;
+        }
+
+        is_passed = check(is_encoded_correctly, "a BC3 block of a single color with a ramp of alpha decodes to itself") && is_passed;
+    }
+
+    // Smooth gradients are what blocks approximate best, both formats keep them above 35 dB
+    {
+        u32 constexpr size = 64;
+
+        for (TextureFormat const format : {TextureFormat::BC1, TextureFormat::BC3})
+        {
+            std::vector<u8> gradient(size * size * 4);
+
+            for (u32 y = 0; y < size; ++y)
+            {
+                for (u32 x = 0; x < size; ++x)
+                {
+                    u8* texel = &gradient[(y * size + x) * 4];
+                    texel[0] = static_cast<u8>(x * 4);
+                    texel[1] = static_cast<u8>(y * 4);
+                    texel[2] = static_cast<u8>((x + y) * 2);
+                    texel[3] = format == TextureFormat::BC1 ? 255 : static_cast<u8>(255 - x * 2);
+                }
+            }
+
+            u32 const level_count = TextureCompression::get_level_count(size, size);
+            std::vector<u8> const levels = TextureCompression::generate_mipmaps(gradient, size, size, level_count);
+            std::vector<u8> const blocks = TextureCompression::compress(levels, size, size, level_count, format);
+            std::vector<u8> const decompressed = TextureCompression::decompress(blocks, size, size, format);
+            std::string_view const format_name = format == TextureFormat::BC1 ? "BC1" : "BC3";
+
+            is_passed = check(blocks.size() == TextureCompression::get_image_size(format, size, size, level_count),
+                              std::format("a compressed {} mip chain holds every level", format_name))
+                        && is_passed;
+            is_passed = check(decompressed.size() == gradient.size() && get_psnr(gradient, decompressed) >= 35.0,
+                              std::format("a gradient compressed to {} keeps 35 dB PSNR", format_name))
+                        && is_passed;
+        }
+    }
+
+    return is_passed;
+}
+
+void Benchmark::run_texture_cooking(u32 const iterations)
+{
+    check_texture_compression();
+
+    std::vector<std::string> image_paths = {};
+    std::error_code error;
+
+    for (auto const& directory : {"./res/textures", "./res/models"})
+    {
+        for (auto const& entry : std::filesystem::recursive_directory_iterator(directory, error))
+        {
+            std::string const path = entry.path().generic_string();
+            std::filesystem::path const extension = entry.path().extension();
+
+            // Skybox faces are cubemaps, UI is never compressed
+            if ((extension == ".png" || extension == ".jpg") && path.find("/skybox/") == std::string::npos
+                && path.find("/UI/") == std::string::npos)
+                image_paths.emplace_back(path);
+        }
+    }
+
+    std::ranges::sort(image_paths);
+
+    bool const was_texture_cooking_enabled = TextureLoader::is_texture_cooking_enabled();
+    TextureSettings const settings = {};
+
+    double total_decode_ms = 0.0;
+    double total_mipmaps_ms = 0.0;
+    double total_cooked_ms = 0.0;
+    double total_encode_ms = 0.0;
+    u64 total_original_bytes = 0;
+    u64 total_mipmaps_bytes = 0;
+    u64 total_cooked_bytes = 0;
+    std::array<u32, 3> format_counts = {};
+    std::string largest_path = {};
+    DecodedImage largest_image = {};
+
+    auto const get_format_name = [](TextureFormat const format) {
+        return format == TextureFormat::RGBA8 ? "RGBA8" : format == TextureFormat::BC1 ? "BC1" : "BC3";
+    };
+
+    auto const get_size = [](DecodedImage const& image) {
+        return TextureCompression::get_image_size(image.format, static_cast<u32>(image.width), static_cast<u32>(image.height),
+                                                  image.level_count);
+    };
+
+    for (auto const& image_path : image_paths)
+    {
+        // Cooks the image if it isn't cooked yet, so only reading the cooked file is measured
+        TextureLoader::set_texture_cooking_enabled(true);
+        static_cast<void>(TextureLoader::read_image(image_path, TextureType::Diffuse, settings));
+
+        DecodedImage decoded = {};
+        DecodedImage mipmaps = {};
+        DecodedImage cooked = {};
+        double decode_ms = 0.0;
+        double mipmaps_ms = 0.0;
+        double cooked_ms = 0.0;
+        u64 cooked_hash = 0;
+
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            decode_ms += measure_ms([&] { decoded = TextureLoader::decode_image(image_path, settings.flip_vertically); });
+
+            TextureLoader::set_texture_cooking_enabled(false);
+            mipmaps_ms += measure_ms([&] { mipmaps = TextureLoader::read_image(image_path, TextureType::Diffuse, settings); });
+
+            // Cooked levels are mapped, hashing them reads them from the disk like uploading them does
+            TextureLoader::set_texture_cooking_enabled(true);
+            cooked_ms += measure_ms([&] {
+                cooked = TextureLoader::read_image(image_path, TextureType::Diffuse, settings);
+
+                if (cooked.pixels != nullptr)
+                    cooked_hash = AK::murmur_hash64(cooked.pixels.get(), get_size(cooked), 0);
+            });
+        }
+
+        if (decoded.pixels == nullptr || mipmaps.pixels == nullptr || cooked.pixels == nullptr)
+        {
+            Debug::log(std::format("Texture cooking: {} could not be read.", image_path), DebugType::Error);
+            continue;
+        }
+
+        auto const width = static_cast<u32>(cooked.width);
+        auto const height = static_cast<u32>(cooked.height);
+        u32 const level_count = TextureCompression::get_level_count(width, height);
+        std::span const levels(mipmaps.pixels.get(), TextureCompression::get_image_size(TextureFormat::RGBA8, width, height, level_count));
+        std::span const blocks(cooked.pixels.get(), get_size(cooked));
+
+        std::vector<u8> encoded = {};
+        double const encode_ms =
+            measure_ms([&] { encoded = TextureCompression::compress(levels, width, height, level_count, cooked.format); });
+
+        if (cooked.level_count != level_count || mipmaps.level_count != level_count || mipmaps.format != TextureFormat::RGBA8
+            || !std::ranges::equal(levels.first(static_cast<size_t>(width) * height * 4),
+                                   std::span(decoded.pixels.get(), static_cast<size_t>(width) * height * 4))
+            || cooked_hash != AK::murmur_hash64(encoded.data(), encoded.size(), 0))
+        {
+            Debug::log(std::format("Texture cooking: cooked {} differs from the one built at runtime.", image_path), DebugType::Error);
+        }
+
+        // Of the largest level
+        std::vector<u8> const decompressed = TextureCompression::decompress(blocks, width, height, cooked.format);
+        double const psnr = get_psnr(levels, decompressed);
+
+        if (psnr < 30.0)
+            Debug::log(std::format("Texture cooking: {} is compressed with {:.1f} dB PSNR.", image_path, psnr), DebugType::Error);
+
+        u64 const original_bytes = TextureCompression::get_level_size(TextureFormat::RGBA8, width, height);
+        u64 const mipmaps_bytes = levels.size();
+        u64 const cooked_bytes = blocks.size();
+
+        Debug::log(std::format("Texture cooking: {} {}x{} {}, decode {:.3f} ms, with mipmaps {:.3f} ms, cooked {:.3f} ms ({:.1f}x), "
+                               "encode {:.1f} ms, {:.1f} -> {:.1f} KB with mipmaps, {:.1f} dB.",
+                               image_path, width, height, get_format_name(cooked.format),
+                               decode_ms / iterations, mipmaps_ms / iterations, cooked_ms / iterations, mipmaps_ms / cooked_ms, encode_ms,
+                               static_cast<double>(original_bytes) / 1024.0, static_cast<double>(cooked_bytes) / 1024.0, psnr));
+
+        total_decode_ms += decode_ms / iterations;
+        total_mipmaps_ms += mipmaps_ms / iterations;
+        total_cooked_ms += cooked_ms / iterations;
+        total_encode_ms += encode_ms;
+        total_original_bytes += original_bytes;
+        total_mipmaps_bytes += mipmaps_bytes;
+        total_cooked_bytes += cooked_bytes;
+        format_counts[static_cast<size_t>(cooked.format)] += 1;
+
+        if (largest_image.pixels == nullptr || cooked_bytes > get_size(largest_image))
+        {
+            largest_path = image_path;
+            largest_image = cooked;
+        }
+    }
+
+    TextureLoader::set_texture_cooking_enabled(was_texture_cooking_enabled);
+
+    // Memory of every level of the largest texture
+    for (u32 level = 0; level < largest_image.level_count; ++level)
+    {
+        u32 const level_width = TextureCompression::get_level_dimension(static_cast<u32>(largest_image.width), level);
+        u32 const level_height = TextureCompression::get_level_dimension(static_cast<u32>(largest_image.height), level);
+        u64 const original_bytes = TextureCompression::get_level_size(TextureFormat::RGBA8, level_width, level_height);
+        u64 const cooked_bytes = TextureCompression::get_level_size(largest_image.format, level_width, level_height);
+
+        Debug::log(std::format("Texture cooking: {} level {} {}x{}, RGBA8 {:.1f} KB, {} {:.1f} KB.", largest_path, level, level_width,
+                               level_height, static_cast<double>(original_bytes) / 1024.0, get_format_name(largest_image.format),
+                               static_cast<double>(cooked_bytes) / 1024.0));
+    }
+
+    Debug::log(std::format("Texture cooking: {} images, {} RGBA8, {} BC1, {} BC3, decode {:.3f} ms, with mipmaps {:.3f} ms, "
+                           "cooked {:.3f} ms ({:.1f}x), encode {:.1f} ms.",
+                           image_paths.size(), format_counts[0], format_counts[1], format_counts[2], total_decode_ms, total_mipmaps_ms,
+                           total_cooked_ms, total_mipmaps_ms / total_cooked_ms, total_encode_ms));
+    Debug::log(std::format("Texture cooking: VRAM {:.2f} MB without mipmaps, {:.2f} MB with RGBA8 mipmaps, {:.2f} MB cooked.",
+                           to_mb(static_cast<i64>(total_original_bytes)), to_mb(static_cast<i64>(total_mipmaps_bytes)),
+                           to_mb(static_cast<i64>(total_cooked_bytes))));
+}
+
+void Benchmark::run_asset_packing(u32 const iterations)
+{
+    std::string const directory = Engine::asset_directory;
+    std::array<std::string, 2> const archive_paths = {"./res_benchmark.pak", "./res_benchmark_lz4.pak"};
+
+    std::vector<std::string> file_paths = {};
+    u64 loose_bytes = 0;
+    std::error_code error;
+
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        if (entry.is_regular_file(error) && entry.path().extension() != ".tmp")
+        {
+            file_paths.emplace_back(entry.path().generic_string());
+            loose_bytes += entry.file_size(error);
+        }
+    }
+
+    ScopeGuard remove_archives = [&] {
+        for (auto const& archive_path : archive_paths)
+            std::filesystem::remove(archive_path, error);
+    };
+
+    for (size_t i = 0; i < archive_paths.size(); ++i)
+    {
+        bool is_built = false;
+        double const build_ms = measure_ms([&] { is_built = PackArchive::build(directory, archive_paths[i], i == 1); });
+
+        if (!is_built)
+        {
+            Debug::log(std::format("Asset packing: could not pack {} into {}.", directory, archive_paths[i]), DebugType::Error);
+            return;
+        }
+
+        Debug::log(std::format("Asset packing: {} files packed into {} in {:.1f} ms, {:.2f} MB -> {:.2f} MB.", file_paths.size(),
+                               archive_paths[i], build_ms, to_mb(static_cast<i64>(loose_bytes)),
+                               to_mb(static_cast<i64>(std::filesystem::file_size(archive_paths[i], error)))));
+    }
+
+    // Every file is read the way the engine starts, with a new file system that mounts the archive first.
+    // Every byte is hashed, so mapped pages are actually read and packed files can be compared with loose ones.
+    std::array<std::pair<std::string_view, std::string>, 3> const sources = {{
+        {"loose", {}},
+        {"archive", archive_paths[0]},
+        {"LZ4 archive", archive_paths[1]},
+    }};
+
+    std::vector<u64> loose_hashes = {};
+
+    for (auto const& [name, archive_path] : sources)
+    {
+        double first_ms = 0.0;
+        double total_ms = 0.0;
+        u64 disk_open_count = 0;
+        u32 missing_count = 0;
+        u32 mismatch_count = 0;
+
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            VirtualFileSystem file_system = {};
+            std::vector<u64> hashes(file_paths.size(), 0);
+            bool is_mounted = true;
+            missing_count = 0;
+
+            double const ms = measure_ms([&] {
+                if (!archive_path.empty())
+                {
+                    file_system.set_loose_files_enabled(false);
+                    is_mounted = file_system.mount_archive(directory, archive_path);
+                }
+
+                for (size_t j = 0; j < file_paths.size(); ++j)
+                {
+                    if (VirtualFile file = {}; file_system.open(file_paths[j], file))
+                        hashes[j] = AK::murmur_hash64(file.get_bytes().data(), file.get_size(), 0);
+                    else
+                        ++missing_count;
+                }
+            });
+
+            if (!is_mounted)
+            {
+                Debug::log(std::format("Asset packing: could not mount {}.", archive_path), DebugType::Error);
+                return;
+            }
+
+            first_ms = i == 0 ? ms : first_ms;
+            total_ms += ms;
+            disk_open_count = file_system.get_disk_open_count();
+
+            if (loose_hashes.empty())
+                loose_hashes = hashes;
+
+            mismatch_count = 0;
+
+            for (size_t j = 0; j < file_paths.size(); ++j)
+                mismatch_count += hashes[j] != loose_hashes[j] ? 1 : 0;
+        }
+
+        Debug::log(std::format("Asset packing: {} {} files, first start {:.2f} ms, average {:.2f} ms, {} files opened from the disk.",
+                               name, file_paths.size(), first_ms, total_ms / iterations, disk_open_count));
+
+        if (missing_count > 0 || mismatch_count > 0)
+        {
+            Debug::log(std::format("Asset packing: {} could not read {} files and read {} files differently than the loose ones.", name,
+                                   missing_count, mismatch_count),
+                       DebugType::Error);
+        }
+    }
+}
+
+bool Benchmark::check_shader_cache()
+{
+    std::string const directory = "./shader_cache_check";
+    std::string const source_directory = directory + "/shaders";
+    std::string const cache_directory = directory + "/compiled";
+    std::error_code error;
+
+    ScopeGuard remove_directory = [&] { std::filesystem::remove_all(directory, error); };
+
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::create_directories(source_directory, error);
+
+    std::vector<ShaderVariant> const variants = copy_shaders(source_directory);
+
+    if (!check(!variants.empty(), std::format("shaders are found in {}/shaders", Engine::asset_directory)))
+        return false;
+
+    std::atomic<u32> compiler_call_count = 0;
+    ShaderCompiler const compiler = get_stub_compiler(compiler_call_count);
+    std::vector<std::vector<u8>> cold_bytecode(variants.size());
+
+    {
+        ShaderCache cache(cache_directory, compiler);
+        cache.compile(variants);
+
+        for (size_t i = 0; i < variants.size(); ++i)
+            cold_bytecode[i] = cache.get_bytecode(variants[i]);
+    }
+
+    // A new cache reads the manifest like the engine does when it starts
+    auto const check_step = [&](std::string_view const name, u32 const expected_compiled_count, bool const expect_hashing) {
+        ShaderCache cache(cache_directory, compiler);
+        cache.compile(variants);
+
+        u32 mismatch_count = 0;
+
+        for (size_t i = 0; i < variants.size(); ++i)
+            mismatch_count += cache.get_bytecode(variants[i]) != cold_bytecode[i] ? 1 : 0;
+
+        ShaderCacheStats const stats = cache.get_stats();
+        bool is_passed = check(stats.compiled_count == expected_compiled_count,
+                               std::format("a {} shader cache compiled {} variants, not {}", name, stats.compiled_count,
+                                           expected_compiled_count));
+        is_passed = check((stats.hashed_file_count > 0) == expect_hashing,
+                          std::format("a {} shader cache hashed {} files, expected {}", name, stats.hashed_file_count,
+                                      expect_hashing ? "some" : "none"))
+                 && is_passed;
+        is_passed = check(mismatch_count == 0,
+                          std::format("a {} shader cache returned different bytecode for {} variants", name, mismatch_count))
+                 && is_passed;
+        return is_passed;
+    };
+
+    // Every check runs even after one failed
+    bool is_passed = check_step("warm", 0, false);
+
+    std::string const included_path = source_directory + "/common_functions.hlsl";
+    auto const write_time = std::filesystem::last_write_time(included_path, error);
+    std::filesystem::last_write_time(included_path, write_time + std::chrono::seconds(2), error);
+
+    is_passed = check_step("touched include", 0, true) && is_passed;
+
+    // Only variants that include the changed file, directly or not, are compiled again
+    u32 dependent_count = 0;
+
+    {
+        ShaderCache cache(cache_directory, compiler);
+
+        for (auto const& variant : variants)
+        {
+            auto const dependencies = cache.get_dependencies(variant);
+            bool const is_dependent = std::ranges::any_of(dependencies, [&](ShaderDependency const& dependency) {
+                return dependency.path == std::filesystem::path(included_path).lexically_normal().generic_string();
+            });
+
+            dependent_count += is_dependent ? 1 : 0;
+        }
+    }
+
+    {
+        std::ofstream file(included_path, std::ios::app);
+        file << "\n// Changed by the shader cache check\n";
+    }
+
+    {
+        ShaderCache cache(cache_directory, compiler);
+        cache.compile(variants);
+        u32 const compiled_count = cache.get_stats().compiled_count;
+
+        is_passed = check(dependent_count > 0, "some variants depend on common_functions.hlsl") && is_passed;
+        is_passed = check(compiled_count == dependent_count,
+                          std::format("changing an include compiled {} variants, {} depend on it", compiled_count, dependent_count))
+                 && is_passed;
+    }
+
+    // Compiled files of the changed variants and of a removed shader are stale, so is a file the manifest doesn't know
+    std::string const removed_path = variants.back().path;
+    auto const removed_variant_count = static_cast<size_t>(std::ranges::count(variants, removed_path, &ShaderVariant::path));
+    std::filesystem::remove(removed_path, error);
+    std::ofstream(cache_directory + "/stray.cso") << "stray";
+
+    {
+        ShaderCache cache(cache_directory, compiler);
+        size_t const entry_count = cache.get_variants().size();
+        static_cast<void>(cache.prune());
+
+        size_t remaining_file_count = 0;
+
+        for (auto const& entry : std::filesystem::directory_iterator(cache_directory, error))
+            remaining_file_count += entry.is_regular_file(error) ? 1 : 0;
+
+        // Variants with the same content share a compiled file, so there can be fewer files than variants, never more
+        is_passed = check(remaining_file_count <= cache.get_variants().size() + 1,
+                          std::format("pruning left {} files for {} variants", remaining_file_count, cache.get_variants().size()))
+                 && is_passed;
+        is_passed = check(cache.get_variants().size() == entry_count - removed_variant_count,
+                          std::format("pruning left {} of {} variants, {} were removed", cache.get_variants().size(), entry_count,
+                                      removed_variant_count))
+                 && is_passed;
+        is_passed = check(!std::filesystem::exists(cache_directory + "/stray.cso", error),
+                          "pruning removes files the manifest doesn't know")
+                 && is_passed;
+    }
+
+    return is_passed;
+}
+
+void Benchmark::run_shader_cache(u32 const thread_count)
+{
+    check_shader_cache();
+
+    std::string const directory = "./shader_cache_benchmark";
+    std::string const source_directory = directory + "/shaders";
+    std::string const cache_directory = directory + "/compiled";
+    std::error_code error;
+
+    ScopeGuard remove_directory = [&] { std::filesystem::remove_all(directory, error); };
+
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::create_directories(source_directory, error);
+
+    std::vector<ShaderVariant> const variants = copy_shaders(source_directory);
+
+    if (variants.empty())
+    {
+        Debug::log(std::format("Shader cache: no shaders found in {}/shaders.", Engine::asset_directory), DebugType::Error);
+        return;
+    }
+
+    std::atomic<u32> compiler_call_count = 0;
+    ShaderCompiler const compiler = get_stub_compiler(compiler_call_count);
+
+    auto const log_step = [&](std::string_view const name, double const ms, ShaderCacheStats const& stats) {
+        Debug::log(std::format("Shader cache: {} {} variants in {:.2f} ms, {} compiled, {} cached, {} failed, {} files hashed.", name,
+                               variants.size(), ms, stats.compiled_count, stats.hit_count, stats.failed_count, stats.hashed_file_count));
+    };
+
+    {
+        ShaderCache cache(cache_directory + "_serial", compiler);
+        double const ms = measure_ms([&] {
+            for (auto const& variant : variants)
+                static_cast<void>(cache.get_bytecode(variant));
+        });
+
+        log_step("cold, one by one", ms, cache.get_stats());
+    }
+
+    // A new cache reads the manifest like the engine does when it starts
+    auto const measure_step = [&](std::string_view const name) {
+        ShaderCache cache(cache_directory, compiler);
+        double const ms = measure_ms([&] { cache.compile(variants, thread_count); });
+        log_step(name, ms, cache.get_stats());
+    };
+
+    measure_step("cold, in parallel");
+    measure_step("warm");
+
+    std::string const included_path = source_directory + "/common_functions.hlsl";
+    auto const write_time = std::filesystem::last_write_time(included_path, error);
+    std::filesystem::last_write_time(included_path, write_time + std::chrono::seconds(2), error);
+
+    measure_step("touched include");
+
+    {
+        std::ofstream file(included_path, std::ios::app);
+        file << "\n// Changed by the shader cache benchmark\n";
+    }
+
+    measure_step("changed include");
+
+    std::filesystem::remove(variants.back().path, error);
+
+    {
+        ShaderCache cache(cache_directory, compiler);
+        size_t const entry_count = cache.get_variants().size();
+
+        u32 removed_count = 0;
+        double const ms = measure_ms([&] { removed_count = cache.prune(); });
+
+        Debug::log(std::format("Shader cache: pruned {} variants and files in {:.2f} ms, {} of {} variants left.", removed_count, ms,
+                               cache.get_variants().size(), entry_count));
+    }
+
+    Debug::log(std::format("Shader cache: the stub compiler was called {} times.", compiler_call_count.load()));
+}
+
+void Benchmark::run_hot_reload(u32 const iterations)
+{
+    std::string const directory = "./hot_reload_benchmark";
+    std::error_code error;
+
+    ScopeGuard remove_directory = [&] { std::filesystem::remove_all(directory, error); };
+
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::create_directories(directory + "/nested", error);
+
+    AK::FileWatcher file_watcher = {};
+
+    if (!file_watcher.start(directory, std::chrono::milliseconds(50)))
+    {
+        Debug::log("Hot reload: could not watch " + directory + ".", DebugType::Error);
+        return;
+    }
+
+    std::vector<double> latencies_ms = {};
+    u32 missed_count = 0;
+
+    for (u32 i = 0; i < iterations; ++i)
+    {
+        std::string const path = std::format("{}/nested/file_{}.txt", directory, i % 4);
+        static_cast<void>(file_watcher.take_changes());
+
+        auto const begin = std::chrono::high_resolution_clock::now();
+
+        std::ofstream(path) << "Iteration " << i;
+
+        // Waits at most a second for every change
+        bool is_noticed = false;
+
+        while (!is_noticed && std::chrono::high_resolution_clock::now() - begin < std::chrono::seconds(1))
+        {
+            auto const changes = file_watcher.take_changes();
+            is_noticed = std::ranges::find(changes, path) != changes.end();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if (!is_noticed)
+        {
+            ++missed_count;
+            continue;
+        }
+
+        latencies_ms.emplace_back(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count());
+    }
+
+    file_watcher.stop();
+
+    if (!latencies_ms.empty())
+    {
+        std::ranges::sort(latencies_ms);
+        Debug::log(std::format("Hot reload: {} changes noticed {}, median {:.2f} ms, max {:.2f} ms.", latencies_ms.size(),
+                               file_watcher.is_native() ? "through OS notifications" : "by polling every 50 ms",
+                               latencies_ms[latencies_ms.size() / 2], latencies_ms.back()));
+    }
+
+    if (missed_count > 0)
+        Debug::log(std::format("Hot reload: {} of {} changes weren't noticed.", missed_count, iterations), DebugType::Error);
+
+    // Shaders are loaded again without compiling, nothing changed in them
+    std::vector<std::string> const changed_paths = {Engine::asset_directory + "/shaders/common_functions.hlsl"};
+    u32 reloaded_count = 0;
+
+    double const selective_ms = measure_ms([&] { reloaded_count = Renderer::get_instance()->reload_shaders(changed_paths); });
+    double const full_ms = measure_ms([&] { Renderer::get_instance()->reload_shaders(); });
+
+    Debug::log(std::format("Hot reload: {} shaders depend on {}, reloaded in {:.2f} ms, all shaders reloaded in {:.2f} ms.", reloaded_count,
+                           changed_paths.front(), selective_ms, full_ms));
+}
+
+void Benchmark::run_startup(u32 const iterations)
+{
+    Debug::log(Engine::startup_report);
+
+    std::array<double, 2> median_ms = {};
+    i64 preloaded_bytes = 0;
+
+    for (auto const use_workers : {false, true})
+    {
+        std::vector<double> times_ms = {};
+
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            std::array<std::optional<VirtualFile>, Engine::preloaded_scenes.size()> files = {};
+            AK::TaskGraph graph = {};
+
+            for (size_t j = 0; j < files.size(); ++j)
+            {
+                graph.add_task(Engine::preloaded_scenes[j], [&files, j] {
+                    files[j] = AssetPreloader::open_asset(Engine::preloaded_scenes[j]);
+                    return files[j].has_value();
+                });
+            }
+
+            bool const is_succeeded = graph.run(use_workers);
+            times_ms.emplace_back(graph.get_total_ms());
+
+            if (!is_succeeded)
+            {
+                Debug::log("Startup: not every preloaded scene could be opened.", DebugType::Error);
+                return;
+            }
+
+            preloaded_bytes = 0;
+
+            for (auto const& file : files)
+                preloaded_bytes += static_cast<i64>(file->get_size());
+        }
+
+        std::ranges::sort(times_ms);
+        median_ms[use_workers ? 1 : 0] = times_ms[times_ms.size() / 2];
+    }
+
+    Debug::log(std::format("Startup: {} scenes ({:.2f} MB) preloaded in {:.2f} ms on one thread, {:.2f} ms on workers.",
+                           Engine::preloaded_scenes.size(), to_mb(preloaded_bytes), median_ms[0], median_ms[1]));
+}
+
+void Benchmark::run_particles(u32 const particle_count, u32 const frames)
+{
+    if (particle_count == 0 || particle_count > ParticleSystem::max_particle_count)
+    {
+        Debug::log(std::format("Particles: the particle count has to be between 1 and {}.", ParticleSystem::max_particle_count),
+                   DebugType::Error);
+        return;
+    }
+
+    float constexpr delta_time = 1.0f / 60.0f;
+    std::vector<ParticleInstance> instances(particle_count);
+
+    std::array const particle_types = {ParticleType::Default, ParticleType::Prompt, ParticleType::Snow, ParticleType::Fish};
+    std::array const particle_type_names = {"default", "prompt", "snow", "fish"};
+
+    for (size_t i = 0; i < particle_types.size(); ++i)
+    {
+        auto const particle_system = ParticleSystem::create();
+        particle_system->particle_type = particle_types[i];
+
+        // Nothing dies while it is measured
+        ParticleSpawnData data = {};
+        data.lifetime = static_cast<float>(frames) * delta_time * 2.0f;
+        data.start_velocity = {0.1f, 0.5f, 0.1f};
+        data.start_color_1 = particle_system->start_color_1;
+        data.end_color_1 = particle_system->end_color_1;
+
+        double const emit_ms = measure_ms([&] {
+            for (u32 j = 0; j < particle_count; ++j)
+                static_cast<void>(particle_system->emit(data, {}));
+        });
+
+        double simulate_ms = 0.0;
+        double write_ms = 0.0;
+
+        u64 const allocations = measure_allocations([&] {
+            for (u32 frame = 0; frame < frames; ++frame)
+            {
+                simulate_ms += measure_ms([&] { particle_system->simulate(delta_time, static_cast<float>(frame) * delta_time); });
+                write_ms += measure_ms([&] { static_cast<void>(particle_system->write_instances(instances)); });
+            }
+        });
+
+        double const frame_ms = (simulate_ms + write_ms) / frames;
+
+        Debug::log(std::format("Particles: {} {} particles emitted in {:.2f} ms, simulated in {:.3f} ms and written in {:.3f} ms "
+                               "per frame, {:.2f} ns per particle, {} allocations in {} frames.",
+                               particle_system->get_particles().count, particle_type_names[i], emit_ms, simulate_ms / frames,
+                               write_ms / frames, frame_ms * 1000000.0 / particle_count, allocations, frames));
+    }
+
+    // Particles die all the time and are emitted again, in the slots of the dead ones
+    {
+        auto const particle_system = ParticleSystem::create();
+
+        ParticleSpawnData data = {};
+        data.start_velocity = {0.1f, 0.5f, 0.1f};
+
+        for (u32 j = 0; j < particle_count; ++j)
+        {
+            data.lifetime = AK::random_float(0.5f, 1.5f);
+            static_cast<void>(particle_system->emit(data, {}));
+        }
+
+        u32 emitted_count = 0;
+        double churn_ms = 0.0;
+
+        u64 const allocations = measure_allocations([&] {
+            churn_ms = measure_ms([&] {
+                for (u32 frame = 0; frame < frames; ++frame)
+                {
+                    particle_system->simulate(delta_time, static_cast<float>(frame) * delta_time);
+
+                    while (particle_system->get_particles().count < particle_count)
+                    {
+                        data.lifetime = AK::random_float(0.5f, 1.5f);
+                        static_cast<void>(particle_system->emit(data, {}));
+                        emitted_count += 1;
+                    }
+                }
+            });
+        });
+
+        Debug::log(std::format("Particles: {} particles kept alive for {} frames, {} died and were emitted again, "
+                               "{:.3f} ms per frame, {} allocations.",
+                               particle_count, frames, emitted_count, churn_ms / frames, allocations));
+    }
+
+    // Entities are too slow to spawn this many of them, a few show the cost of each one
+    if (MainScene::get_instance() == nullptr)
+        return;
+
+    u32 const entity_count = std::min(particle_count, 1000u);
+    std::vector<std::shared_ptr<Entity>> spawned = {};
+    spawned.reserve(entity_count);
+
+    double const entity_ms = measure_ms([&] {
+        for (u32 j = 0; j < entity_count; ++j)
+            spawned.emplace_back(spawn_particle());
+
+        for (auto const& entity : spawned)
+            entity->destroy_immediate();
+    });
+
+    Debug::log(std::format("Particles: spawning and destroying a particle as an entity took {:.2f} ns per particle.",
+                           entity_ms * 1000000.0 / entity_count));
+}
+
+bool Benchmark::check_allocations(u32 const frames)
+{
+    bool is_passed = true;
+
+    // Arenas only go to the heap when they run out
+    {
+        AK::LinearArena arena(64 * 1024);
+
+        for (u32 frame = 0; frame < 2; ++frame)
+        {
+            arena.reset();
+
+            u64 const allocations = measure_thread_allocations([&] {
+                std::pmr::vector<u32> temporaries(&arena);
+                for (u32 i = 0; i < 1000; ++i)
+                    temporaries.emplace_back(i);
+            });
+
+            is_passed = check(allocations == 0, std::format("a frame arena made {} heap allocations before running out", allocations))
+                     && is_passed;
+        }
+
+        static_cast<void>(arena.allocate(128 * 1024));
+        is_passed = check(arena.get_overflow_count() == 1, "a frame arena counts allocations that don't fit") && is_passed;
+
+        arena.reset();
+        is_passed = check(arena.get_used() == 0, "a frame arena is empty after a reset") && is_passed;
+    }
+
+    // Released blocks are reused by the next allocations of the same size
+    {
+        struct Block
+        {
+            std::array<u64, 8> data = {};
+        };
+
+        static_cast<void>(std::allocate_shared<Block>(AK::PoolAllocator<Block> {}));
+
+        u64 const allocations = measure_thread_allocations([] {
+            for (u32 i = 0; i < 100; ++i)
+                static_cast<void>(std::allocate_shared<Block>(AK::PoolAllocator<Block> {}));
+        });
+
+        is_passed = check(allocations == 0, std::format("a pool allocator made {} heap allocations for released blocks", allocations))
+                 && is_passed;
+    }
+
+    // Simulating and drawing particles that are alive reuses the particle buffer every frame
+    {
+        float constexpr delta_time = 1.0f / 60.0f;
+        u32 constexpr particle_count = 1000;
+
+        auto const particle_system = ParticleSystem::create();
+        std::vector<ParticleInstance> instances(particle_count);
+
+        ParticleSpawnData data = {};
+        data.lifetime = static_cast<float>(frames) * delta_time * 2.0f;
+        data.start_velocity = {0.1f, 0.5f, 0.1f};
+
+        for (u32 i = 0; i < particle_count; ++i)
+            static_cast<void>(particle_system->emit(data, {}));
+
+        u64 const allocations = measure_thread_allocations([&] {
+            for (u32 frame = 0; frame < frames; ++frame)
+            {
+                particle_system->simulate(delta_time, static_cast<float>(frame) * delta_time);
+                static_cast<void>(particle_system->write_instances(instances));
+            }
+        });
+
+        is_passed = check(allocations == 0, std::format("simulating particles made {} heap allocations in {} frames", allocations, frames))
+                 && is_passed;
+    }
+
+    return is_passed;
+}
+
+bool Benchmark::run_checks()
+{
+    // Every check runs even after one failed
+    bool is_passed = true;
+    is_passed = check_allocations() && is_passed;
+    is_passed = check_mesh_optimization() && is_passed;
+    is_passed = check_texture_compression() && is_passed;
+    is_passed = check_shader_cache() && is_passed;
+    is_passed = run_resource_collection() && is_passed;
+
+    Debug::log(is_passed ? "Checks: all passed." : "Checks: some failed.", is_passed ? DebugType::Log : DebugType::Error);
+    return is_passed;
+}
+
+void Benchmark::log_frame_times(std::string_view const name, std::vector<double> frame_times_ms)
+{
+    if (frame_times_ms.empty())
+        return;
+
+    std::ranges::sort(frame_times_ms);
+
+    // Nearest-rank percentile
+    auto const percentile = [&frame_times_ms](double const p) {
+        auto const rank = static_cast<size_t>(std::ceil(p * static_cast<double>(frame_times_ms.size())));
+        return frame_times_ms[std::clamp<size_t>(rank, 1, frame_times_ms.size()) - 1];
+    };
+
+    Debug::log(std::format("{}: {} frames, p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms.", name, frame_times_ms.size(),
+                           percentile(0.5), percentile(0.95), percentile(0.99), frame_times_ms.back()));
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "AK/Types.h"
+
+// Benchmarks meant to be run from the editor on a loaded scene. Results are written to the Debug log.
+// Some of them are checks that return whether they passed, run_checks() runs all of them. The game runs the checks
+// instead of starting when it's launched with --run-checks, and exits with 1 if any of them failed.
+class Benchmark
+{
+public:
+    // Logs every failed check as an error and returns whether all of them passed.
+    static bool run_checks();
+
+    // Spawns and destroys small ships and particles, comparing immediate destruction with the deferred one.
+    static void run_entity_churn(u32 const iterations = 10, u32 const ships_per_iteration = 20, u32 const particles_per_iteration = 200);
+
+    // Spawns and releases particles through the entity pool, comparing it with creating and destroying them every time.
+    static void run_entity_pooling(u32 const iterations = 10, u32 const particles_per_iteration = 500);
+
+    // Recomputes world matrices of every transform in the scene and tests every pair of colliders for penetration.
+    // Gameplay is not affected, collisions are not resolved and no callbacks are called.
+    static void run_transforms_and_collisions(u32 const iterations = 100);
+
+    // Loads MainScene and every Level_N prefab from YAML and from the binary files written by SceneConverter.py.
+    // Files are injected into the current scene like prefabs and destroyed right after.
+    static void run_scene_loading(u32 const iterations = 5);
+
+    // Reads every Level_N prefab (YAML and binary) the way AssetPreloader used to, by copying it into a string,
+    // and by mapping it into memory. Reports load latency and how much the resident memory of the process grows.
+    static void run_asset_loading(u32 const iterations = 5);
+
+    // Spawns small ships through load_prefab, parsing the prefab every time and instantiating it from the prefab cache.
+    // Ships are destroyed after every batch, only spawning is measured.
+    static void run_prefab_instantiation(u32 const ship_count = 1000, u32 const batch_size = 50);
+
+    // Loads the largest Level_N prefab from YAML with parallel parsing of entities and without it.
+    // Checks that both produce the same entities by writing them back to YAML.
+    static void run_parallel_parsing(u32 const iterations = 5);
+
+    // Saves the current scene after moving a single entity, writing the whole scene and only the modified entity.
+    // Checks that both produce the same file. The entity is moved back afterwards.
+    static void run_incremental_save(u32 const iterations = 10);
+
+    // Loads MainScene and every Level_N prefab with models loaded synchronously and in the background by ResourceManager.
+    // Textures and meshes stay cached after the first load, so later loads mostly measure reading the model files.
+    static void run_async_loading(u32 const iterations = 5);
+
+    // Loads and destroys every Level_N prefab repeatedly, collecting unreferenced resources after every round.
+    // Fails if resources of the levels weren't collected, or if the memory used by ResourceManager or the resident memory
+    // keeps growing between rounds.
+    static bool run_resource_collection(u32 const rounds = 5);
+
+    // Looks up the shader, texture and mesh of a particle the way every particle spawn does, all of them cache hits.
+    // Compares interned keys with the stringstream keys ResourceManager used before.
+    static void run_resource_lookups(u32 const particle_count = 10000);
+
+    // Reads every glTF model in res/models with Assimp and from its cooked file, cooking the models that aren't cooked yet.
+    // Reports load times of every model and of all of them, and an error if both produce different meshes.
+    static void run_model_loading(u32 const iterations = 5);
+
+    // Checks that MeshOptimizer keeps every triangle of a grid with its winding, welds its vertices and lowers its ACMR.
+    static bool check_mesh_optimization();
+
+    // Checks mesh optimization, then imports every glTF model in res/models without optimizing it and runs MeshOptimizer
+    // on every mesh. Reports vertex counts, cache miss ratios and buffer sizes of every mesh before and after, and the totals,
+    // and a failed check if a mesh lost or changed a triangle.
+    static void run_mesh_optimization();
+
+    // Compresses the vertices of every glTF model in res/models the way meshes do when they are created.
+    // Reports the chosen formats, vertex buffer sizes and decoding errors of every model, and the memory saved by all of them
+    // together with the CPU copies meshes no longer keep.
+    static void run_vertex_compression();
+
+    // Loads every Level_N prefab into the current scene and counts the triangles of all models from the main camera,
+    // drawn in full and at the levels of detail the Renderer would choose.
+    static void run_lods();
+
+    // Checks level sizes, mipmaps and block compression of images with known results.
+    static bool check_texture_compression();
+
+    // Checks texture compression, then reads every image in res/textures and res/models as a diffuse texture: decoded,
+    // with mipmaps built at runtime and cooked, cooking the images that aren't cooked yet.
+    // Reports load times, compression quality and VRAM of every image and every level of the largest one, and the totals.
+    static void run_texture_cooking(u32 const iterations = 5);
+
+    // Packs res into an archive with and without compression, then reads every file of res loose and from both archives,
+    // mounting the archive first like the engine does when it starts. Reports start times and how many files were opened
+    // from the disk, and an error if a packed file differs from the loose one.
+    static void run_asset_packing(u32 const iterations = 5);
+
+    // Checks that a warm ShaderCache compiles nothing, touching an include only hashes it again, changing it compiles only
+    // the variants including it, and pruning removes compiled files of removed shaders and files the manifest doesn't know.
+    static bool check_shader_cache();
+
+    // Checks the shader cache, then compiles a copy of res/shaders with a stub compiler through ShaderCache: cold one by one
+    // and in parallel, warm, after only touching an included file and after changing it, then prunes the cache after
+    // removing a shader. Reports times, compiled variants and hashed files of every step.
+    static void run_shader_cache(u32 const thread_count = 0);
+
+    // Writes files into a temporary directory and measures how long the file watcher takes to notice them.
+    // Then reloads the shaders depending on a shader include the way HotReloader does, and all shaders like before.
+    static void run_hot_reload(u32 const iterations = 20);
+
+    // Logs the timeline of the tasks the engine ran at startup. Then preloads the scenes the engine preloads at startup
+    // through a task graph, on this thread only and on workers. Reports the median time of both.
+    static void run_startup(u32 const iterations = 5);
+
+    // Simulates particles of every particle type, and writes them for drawing like the renderer does every frame.
+    // Reports the time per frame and per particle, allocations in steady state, and spawning them as entities for comparison.
+    static void run_particles(u32 const particle_count = 100000, u32 const frames = 100);
+
+    // Checks that frame arenas, pool allocators and particles in steady state don't allocate from the heap.
+    static bool check_allocations(u32 const frames = 60);
+
+    // Logs p50, p95, p99 and the longest of frame times recorded during gameplay, like a level transition.
+    static void log_frame_times(std::string_view const name, std::vector<double> frame_times_ms);
+};
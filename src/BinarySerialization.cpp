@@ -0,0 +1,322 @@
+#include "BinarySerialization.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "AK/AK.h"
+#include "Debug.h"
+
+void BinaryWriter::begin_entity(std::string const& guid, std::string const& name, std::string const& parent_guid,
+                                glm::vec3 const& position, glm::vec3 const& rotation, glm::vec3 const& scale)
+{
+    BinaryEntityRecord record = {};
+    record.guid = add_string(guid);
+    record.name = add_string(name);
+    record.parent_guid = parent_guid.empty() ? binary_invalid_index : add_string(parent_guid);
+    record.position = position;
+    record.rotation = rotation;
+    record.scale = scale;
+    record.first_component = static_cast<u32>(m_components.size());
+    record.component_count = 0;
+
+    m_entities.emplace_back(record);
+}
+
+void BinaryWriter::begin_component(std::string_view const type_name, std::string const& guid, std::string const& custom_name)
+{
+    BinaryComponentRecord record = {};
+    record.type_hash = AK::fnv1a_hash(type_name);
+    record.type_name = add_string(type_name);
+    record.guid = add_string(guid);
+    record.custom_name = add_string(custom_name);
+    record.blob_offset = static_cast<u32>(m_blob.size());
+
+    m_components.emplace_back(record);
+    m_entities.back().component_count += 1;
+
+    // Patched in end_component(), when all fields are known
+    m_field_mask_offset = m_blob.size();
+    m_field_mask = 0;
+    m_field_index = 0;
+    write(m_field_mask);
+}
+
+void BinaryWriter::end_component()
+{
+    std::memcpy(m_blob.data() + m_field_mask_offset, &m_field_mask, sizeof(m_field_mask));
+
+    BinaryComponentRecord& record = m_components.back();
+    record.blob_size = static_cast<u32>(m_blob.size()) - record.blob_offset;
+}
+
+void BinaryWriter::write_bytes(void const* data, size_t const size)
+{
+    auto const* bytes = static_cast<u8 const*>(data);
+    m_blob.insert(m_blob.end(), bytes, bytes + size);
+}
+
+u32 BinaryWriter::add_string(std::string_view const str)
+{
+    std::string key(str);
+
+    if (auto const it = m_string_indices.find(key); it != m_string_indices.end())
+        return it->second;
+
+    auto const index = static_cast<u32>(m_strings.size());
+    m_strings.emplace_back(key);
+    m_string_indices.emplace(std::move(key), index);
+    return index;
+}
+
+std::vector<u8> BinaryWriter::finish(u32 const schema_hash) const
+{
+    std::vector<u8> data = {};
+
+    auto const append = [&data](void const* bytes, size_t const size) {
+        auto const* begin = static_cast<u8 const*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    };
+
+    BinarySceneHeader header = {};
+    header.schema_hash = schema_hash;
+    header.string_count = static_cast<u32>(m_strings.size());
+    header.entity_count = static_cast<u32>(m_entities.size());
+    header.component_count = static_cast<u32>(m_components.size());
+    append(&header, sizeof(header));
+
+    header.string_table_offset = static_cast<u32>(data.size());
+    for (auto const& str : m_strings)
+    {
+        auto const length = static_cast<u32>(str.size());
+        append(&length, sizeof(length));
+        append(str.data(), str.size());
+    }
+
+    // Tables are read in place, so they have to be aligned
+    data.resize((data.size() + 3) & ~static_cast<size_t>(3), 0);
+
+    header.entity_table_offset = static_cast<u32>(data.size());
+    append(m_entities.data(), m_entities.size() * sizeof(BinaryEntityRecord));
+
+    header.component_table_offset = static_cast<u32>(data.size());
+    append(m_components.data(), m_components.size() * sizeof(BinaryComponentRecord));
+
+    header.blob_offset = static_cast<u32>(data.size());
+    header.blob_size = static_cast<u32>(m_blob.size());
+    append(m_blob.data(), m_blob.size());
+
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    return data;
+}
+
+bool BinaryWriter::save(std::string const& file_path, u32 const schema_hash) const
+{
+    std::vector<u8> const data = finish(schema_hash);
+
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        Debug::log("Could not create a binary scene file: " + file_path, DebugType::Error);
+        return false;
+    }
+
+    file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+bool BinaryReader::open(std::span<u8 const> const data, u32 const expected_schema_hash)
+{
+    *this = {};
+
+    BinarySceneHeader header = {};
+
+    if (data.size() < sizeof(header))
+        return false;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, BinarySceneHeader {}.magic, sizeof(header.magic)) != 0)
+    {
+        Debug::log("Not a binary scene file.", DebugType::Error);
+        return false;
+    }
+
+    if (header.version != binary_scene_version || header.schema_hash != expected_schema_hash)
+    {
+        // Expected after components change, the YAML file is read instead
+        Debug::log("Binary scene file is out of date and has to be converted again.", DebugType::Warning);
+        return false;
+    }
+
+    auto const fits = [&data](u64 const offset, u64 const size) { return offset + size <= data.size(); };
+
+    if (!fits(header.entity_table_offset, static_cast<u64>(header.entity_count) * sizeof(BinaryEntityRecord))
+        || !fits(header.component_table_offset, static_cast<u64>(header.component_count) * sizeof(BinaryComponentRecord))
+        || !fits(header.blob_offset, header.blob_size) || header.entity_table_offset % alignof(BinaryEntityRecord) != 0
+        || header.component_table_offset % alignof(BinaryComponentRecord) != 0
+        || reinterpret_cast<uintptr_t>(data.data()) % alignof(BinaryEntityRecord) != 0)
+    {
+        Debug::log("Binary scene file is corrupted.", DebugType::Error);
+        return false;
+    }
+
+    m_strings.reserve(header.string_count);
+    size_t offset = header.string_table_offset;
+
+    for (u32 i = 0; i < header.string_count; ++i)
+    {
+        u32 length = 0;
+
+        if (!fits(offset, sizeof(length)))
+        {
+            Debug::log("Binary scene file is corrupted.", DebugType::Error);
+            return false;
+        }
+
+        std::memcpy(&length, data.data() + offset, sizeof(length));
+        offset += sizeof(length);
+
+        if (!fits(offset, length))
+        {
+            Debug::log("Binary scene file is corrupted.", DebugType::Error);
+            return false;
+        }
+
+        m_strings.emplace_back(reinterpret_cast<char const*>(data.data() + offset), length);
+        offset += length;
+    }
+
+    m_data = data;
+    m_entities = {reinterpret_cast<BinaryEntityRecord const*>(data.data() + header.entity_table_offset), header.entity_count};
+    m_components = {reinterpret_cast<BinaryComponentRecord const*>(data.data() + header.component_table_offset), header.component_count};
+    m_blob = data.subspan(header.blob_offset, header.blob_size);
+
+    for (auto const& entity : m_entities)
+    {
+        if (static_cast<u64>(entity.first_component) + entity.component_count > m_components.size())
+        {
+            Debug::log("Binary scene file is corrupted.", DebugType::Error);
+            return false;
+        }
+    }
+
+    for (auto const& component : m_components)
+    {
+        if (static_cast<u64>(component.blob_offset) + component.blob_size > m_blob.size())
+        {
+            Debug::log("Binary scene file is corrupted.", DebugType::Error);
+            return false;
+        }
+    }
+
+    m_components_by_guid.resize(m_strings.size());
+    m_entities_by_guid.resize(m_strings.size());
+
+    return true;
+}
+
+std::span<BinaryEntityRecord const> BinaryReader::get_entities() const
+{
+    return m_entities;
+}
+
+std::span<BinaryComponentRecord const> BinaryReader::get_components() const
+{
+    return m_components;
+}
+
+u32 BinaryReader::get_string_count() const
+{
+    return static_cast<u32>(m_strings.size());
+}
+
+std::string_view BinaryReader::get_string(u32 const index) const
+{
+    if (index >= m_strings.size())
+        return {};
+
+    return m_strings[index];
+}
+
+void BinaryReader::replace_string(u32 const index, std::string value)
+{
+    if (index >= m_strings.size())
+        return;
+
+    // Replacing the same string again reuses its storage, so templates deserialized many times don't grow
+    std::string& replaced_string = m_replaced_strings[index];
+    replaced_string = std::move(value);
+    m_strings[index] = replaced_string;
+}
+
+void BinaryReader::begin_component(BinaryComponentRecord const& record)
+{
+    m_cursor = record.blob_offset;
+    m_component_end = static_cast<size_t>(record.blob_offset) + record.blob_size;
+    m_field_mask = 0;
+    m_field_index = 0;
+
+    read(m_field_mask);
+}
+
+bool BinaryReader::read_bytes(void* data, size_t const size)
+{
+    if (m_failed || m_cursor + size > m_component_end)
+    {
+        m_failed = true;
+        return false;
+    }
+
+    std::memcpy(data, m_blob.data() + m_cursor, size);
+    m_cursor += size;
+    return true;
+}
+
+bool BinaryReader::has_failed() const
+{
+    return m_failed;
+}
+
+void BinaryReader::reset()
+{
+    std::ranges::fill(m_components_by_guid, nullptr);
+    std::ranges::fill(m_entities_by_guid, nullptr);
+
+    m_cursor = 0;
+    m_component_end = 0;
+    m_field_mask = 0;
+    m_field_index = 0;
+    m_failed = false;
+}
+
+void BinaryReader::register_component(u32 const guid_index, std::shared_ptr<Component> const& component)
+{
+    if (guid_index < m_components_by_guid.size())
+        m_components_by_guid[guid_index] = component;
+}
+
+void BinaryReader::register_entity(u32 const guid_index, std::shared_ptr<Entity> const& entity)
+{
+    if (guid_index < m_entities_by_guid.size())
+        m_entities_by_guid[guid_index] = entity;
+}
+
+std::shared_ptr<Component> BinaryReader::get_component(u32 const guid_index) const
+{
+    if (guid_index >= m_components_by_guid.size())
+        return nullptr;
+
+    return m_components_by_guid[guid_index];
+}
+
+std::shared_ptr<Entity> BinaryReader::get_entity(u32 const guid_index) const
+{
+    if (guid_index >= m_entities_by_guid.size())
+        return nullptr;
+
+    return m_entities_by_guid[guid_index];
+}
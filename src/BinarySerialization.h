@@ -0,0 +1,276 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "AK/Types.h"
+
+class Component;
+class Entity;
+
+// Binary scene format. Holds the same data as the YAML scene files, but can be read without any parsing.
+// Layout of a file, all offsets are counted from its beginning:
+//   BinarySceneHeader
+//   String table    - u32 length followed by the characters, for every string. Padded to 4 bytes.
+//   Entity table    - BinaryEntityRecord for every entity
+//   Component table - BinaryComponentRecord for every component, components of one entity are next to each other
+//   Blob            - Fields of every component, starting with a u64 mask of the fields that are present
+// Every string, including guids, is stored once and referenced by its index in the string table.
+// Offsets and numbers are stored in the native byte order, which is little-endian on every supported platform.
+
+u32 constexpr binary_scene_version = 1;
+u32 constexpr binary_invalid_index = 0xFFFFFFFF;
+
+struct BinarySceneHeader
+{
+    char magic[4] = {'E', 'S', 'C', 'N'};
+    u32 version = binary_scene_version;
+    u32 schema_hash = 0;
+    u32 string_count = 0;
+    u32 entity_count = 0;
+    u32 component_count = 0;
+    u32 string_table_offset = 0;
+    u32 entity_table_offset = 0;
+    u32 component_table_offset = 0;
+    u32 blob_offset = 0;
+    u32 blob_size = 0;
+};
+
+struct BinaryEntityRecord
+{
+    u32 guid = binary_invalid_index;
+    u32 name = binary_invalid_index;
+    u32 parent_guid = binary_invalid_index;
+    glm::vec3 position = {};
+    glm::vec3 rotation = {};
+    glm::vec3 scale = {};
+    u32 first_component = 0;
+    u32 component_count = 0;
+};
+
+struct BinaryComponentRecord
+{
+    u32 type_hash = 0;
+    u32 type_name = binary_invalid_index;
+    u32 guid = binary_invalid_index;
+    u32 custom_name = binary_invalid_index;
+    u32 blob_offset = 0;
+    u32 blob_size = 0;
+};
+
+static_assert(sizeof(BinarySceneHeader) == 44);
+static_assert(sizeof(BinaryEntityRecord) == 56);
+static_assert(sizeof(BinaryComponentRecord) == 24);
+
+class BinaryWriter;
+class BinaryReader;
+
+// Specialize to make a type serializable, the same way as YAML::convert.
+template<typename T>
+struct BinaryCodec;
+
+class BinaryWriter
+{
+public:
+    void begin_entity(std::string const& guid, std::string const& name, std::string const& parent_guid, glm::vec3 const& position,
+                      glm::vec3 const& rotation, glm::vec3 const& scale);
+
+    void begin_component(std::string_view const type_name, std::string const& guid, std::string const& custom_name);
+    void end_component();
+
+    template<typename T>
+    void write_field(T const& value)
+    {
+        m_field_mask |= 1ull << m_field_index;
+        m_field_index += 1;
+        write(value);
+    }
+
+    template<typename T>
+    void write(T const& value)
+    {
+        BinaryCodec<T>::write(*this, value);
+    }
+
+    void write_bytes(void const* data, size_t const size);
+
+    [[nodiscard]] u32 add_string(std::string_view const str);
+
+    [[nodiscard]] std::vector<u8> finish(u32 const schema_hash) const;
+    bool save(std::string const& file_path, u32 const schema_hash) const;
+
+private:
+    std::vector<std::string> m_strings = {};
+    std::unordered_map<std::string, u32> m_string_indices = {};
+
+    std::vector<BinaryEntityRecord> m_entities = {};
+    std::vector<BinaryComponentRecord> m_components = {};
+    std::vector<u8> m_blob = {};
+
+    size_t m_field_mask_offset = 0;
+    u64 m_field_mask = 0;
+    u32 m_field_index = 0;
+};
+
+// Reads directly from the memory of a binary scene file, which has to stay alive as long as the reader.
+class BinaryReader
+{
+public:
+    // Validates the header and the tables. Fails if the file was written with a different set of serialized fields.
+    bool open(std::span<u8 const> const data, u32 const expected_schema_hash);
+
+    [[nodiscard]] std::span<BinaryEntityRecord const> get_entities() const;
+    [[nodiscard]] std::span<BinaryComponentRecord const> get_components() const;
+
+    // Returns an empty string for binary_invalid_index.
+    [[nodiscard]] u32 get_string_count() const;
+    [[nodiscard]] std::string_view get_string(u32 const index) const;
+    void replace_string(u32 const index, std::string value);
+
+    void begin_component(BinaryComponentRecord const& record);
+
+    // Fields missing in the file are skipped and keep their default values.
+    template<typename T>
+    void read_field(T& value)
+    {
+        bool const is_present = (m_field_mask & (1ull << m_field_index)) != 0;
+        m_field_index += 1;
+
+        if (is_present)
+            read(value);
+    }
+
+    template<typename T>
+    void read(T& value)
+    {
+        BinaryCodec<T>::read(*this, value);
+    }
+
+    bool read_bytes(void* data, size_t const size);
+
+    [[nodiscard]] bool has_failed() const;
+
+    // Forgets the objects registered during the last deserialization and clears the failure,
+    // so an opened file can be deserialized again.
+    void reset();
+
+    // Objects created from this file, looked up by the index of their guid in the string table.
+    void register_component(u32 const guid_index, std::shared_ptr<Component> const& component);
+    void register_entity(u32 const guid_index, std::shared_ptr<Entity> const& entity);
+    [[nodiscard]] std::shared_ptr<Component> get_component(u32 const guid_index) const;
+    [[nodiscard]] std::shared_ptr<Entity> get_entity(u32 const guid_index) const;
+
+private:
+    std::span<u8 const> m_data = {};
+    std::span<BinaryEntityRecord const> m_entities = {};
+    std::span<BinaryComponentRecord const> m_components = {};
+    std::span<u8 const> m_blob = {};
+
+    std::vector<std::string_view> m_strings = {};
+    std::unordered_map<u32, std::string> m_replaced_strings = {};
+
+    std::vector<std::shared_ptr<Component>> m_components_by_guid = {};
+    std::vector<std::shared_ptr<Entity>> m_entities_by_guid = {};
+
+    size_t m_cursor = 0;
+    size_t m_component_end = 0;
+    u64 m_field_mask = 0;
+    u32 m_field_index = 0;
+    bool m_failed = false;
+};
+
+template<typename T>
+requires std::is_arithmetic_v<T> struct BinaryCodec<T>
+{
+    static void write(BinaryWriter& writer, T const value)
+    {
+        writer.write_bytes(&value, sizeof(T));
+    }
+
+    static void read(BinaryReader& reader, T& value)
+    {
+        reader.read_bytes(&value, sizeof(T));
+    }
+};
+
+// Enums are stored as i32, just like in the YAML files
+template<typename T>
+requires std::is_enum_v<T> struct BinaryCodec<T>
+{
+    static void write(BinaryWriter& writer, T const value)
+    {
+        writer.write(static_cast<i32>(value));
+    }
+
+    static void read(BinaryReader& reader, T& value)
+    {
+        i32 integral = 0;
+        reader.read(integral);
+        value = static_cast<T>(integral);
+    }
+};
+
+template<>
+struct BinaryCodec<std::string>
+{
+    static void write(BinaryWriter& writer, std::string const& value)
+    {
+        writer.write(writer.add_string(value));
+    }
+
+    static void read(BinaryReader& reader, std::string& value)
+    {
+        u32 index = binary_invalid_index;
+        reader.read(index);
+        value = reader.get_string(index);
+    }
+};
+
+template<glm::length_t L>
+struct BinaryCodec<glm::vec<L, float, glm::defaultp>>
+{
+    static void write(BinaryWriter& writer, glm::vec<L, float, glm::defaultp> const& value)
+    {
+        writer.write_bytes(&value, sizeof(value));
+    }
+
+    static void read(BinaryReader& reader, glm::vec<L, float, glm::defaultp>& value)
+    {
+        reader.read_bytes(&value, sizeof(value));
+    }
+};
+
+template<typename T>
+struct BinaryCodec<std::vector<T>>
+{
+    static void write(BinaryWriter& writer, std::vector<T> const& value)
+    {
+        writer.write(static_cast<u32>(value.size()));
+
+        for (auto const& element : value)
+            writer.write(element);
+    }
+
+    static void read(BinaryReader& reader, std::vector<T>& value)
+    {
+        u32 size = 0;
+        reader.read(size);
+
+        value.clear();
+
+        for (u32 i = 0; i < size && !reader.has_failed(); ++i)
+        {
+            T element = {};
+            reader.read(element);
+            value.emplace_back(std::move(element));
+        }
+    }
+};
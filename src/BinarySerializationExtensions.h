@@ -0,0 +1,251 @@
+#pragma once
+
+#include "BinarySerialization.h"
+#include "ConstantBufferTypes.h"
+#include "ResourceManager.h"
+
+#include "Collider2D.h"
+#include <type_traits>
+
+#include "DialogueObject.h"
+#include "FloatersManager.h"
+#include "SceneSerializer.h"
+#include <Game/Factory.h>
+#include <Game/ShipSpawner.h>
+
+// Binary counterparts of the conversions in yaml-cpp-extensions.h.
+// If you add a field to any of these types, update both files and bump binary_scene_version.
+
+template<>
+struct BinaryCodec<std::shared_ptr<Shader>>
+{
+    static void write(BinaryWriter& writer, std::shared_ptr<Shader> const& shader)
+    {
+        writer.write(shader->get_vertex_path());
+        writer.write(shader->get_fragment_path());
+        writer.write(shader->get_geometry_path());
+    }
+
+    static void read(BinaryReader& reader, std::shared_ptr<Shader>& shader)
+    {
+        std::string vertex_path = {};
+        std::string fragment_path = {};
+        std::string geometry_path = {};
+        reader.read(vertex_path);
+        reader.read(fragment_path);
+        reader.read(geometry_path);
+
+        if (reader.has_failed())
+            return;
+
+        if (geometry_path.empty())
+        {
+            shader = ResourceManager::get_instance().load_shader(vertex_path, fragment_path);
+        }
+        else
+        {
+            shader = ResourceManager::get_instance().load_shader(vertex_path, fragment_path, geometry_path);
+        }
+    }
+};
+
+template<>
+struct BinaryCodec<std::shared_ptr<Material>>
+{
+    static void write(BinaryWriter& writer, std::shared_ptr<Material> const& material)
+    {
+        writer.write(material->shader);
+        writer.write(material->color);
+        writer.write(material->get_render_order());
+        writer.write(material->needs_forward_rendering);
+        writer.write(material->casts_shadows);
+        writer.write(material->is_billboard);
+    }
+
+    static void read(BinaryReader& reader, std::shared_ptr<Material>& material)
+    {
+        std::shared_ptr<Shader> shader = {};
+        glm::vec4 color = {};
+        i32 render_order = 0;
+        bool forward_rendered = false;
+        bool casts_shadows = false;
+        bool is_billboard = false;
+        reader.read(shader);
+        reader.read(color);
+        reader.read(render_order);
+        reader.read(forward_rendered);
+        reader.read(casts_shadows);
+        reader.read(is_billboard);
+
+        if (reader.has_failed())
+            return;
+
+        material = Material::create(shader, render_order);
+        material->color = color;
+        material->needs_forward_rendering = forward_rendered;
+        material->casts_shadows = casts_shadows;
+        material->is_billboard = is_billboard;
+    }
+};
+
+// References are stored as the index of the guid in the string table, or binary_invalid_index for nullptr
+template<typename T>
+requires std::is_base_of_v<Component, T> struct BinaryCodec<std::weak_ptr<T>>
+{
+    static void write(BinaryWriter& writer, std::weak_ptr<T> const& value)
+    {
+        writer.write(value.expired() ? binary_invalid_index : writer.add_string(value.lock()->guid));
+    }
+
+    static void read(BinaryReader& reader, std::weak_ptr<T>& value)
+    {
+        u32 guid_index = binary_invalid_index;
+        reader.read(guid_index);
+
+        if (guid_index == binary_invalid_index)
+            return;
+
+        // Objects that are not in this file, but already in the scene, are found through the serializer
+        std::shared_ptr<Component> component = reader.get_component(guid_index);
+        if (component == nullptr)
+            component = SceneSerializer::get_instance()->get_from_pool(std::string(reader.get_string(guid_index)));
+
+        value = std::dynamic_pointer_cast<T>(component);
+    }
+};
+
+template<typename T>
+requires std::is_base_of_v<Entity, T> struct BinaryCodec<std::weak_ptr<T>>
+{
+    static void write(BinaryWriter& writer, std::weak_ptr<T> const& value)
+    {
+        writer.write(value.expired() ? binary_invalid_index : writer.add_string(value.lock()->guid));
+    }
+
+    static void read(BinaryReader& reader, std::weak_ptr<T>& value)
+    {
+        u32 guid_index = binary_invalid_index;
+        reader.read(guid_index);
+
+        if (guid_index == binary_invalid_index)
+            return;
+
+        std::shared_ptr<Entity> entity = reader.get_entity(guid_index);
+        if (entity == nullptr)
+            entity = SceneSerializer::get_instance()->get_entity_from_pool(std::string(reader.get_string(guid_index)));
+
+        value = std::dynamic_pointer_cast<T>(entity);
+    }
+};
+
+template<>
+struct BinaryCodec<DXWave>
+{
+    static void write(BinaryWriter& writer, DXWave const& wave)
+    {
+        writer.write(wave.direction);
+        writer.write(wave.padding);
+        writer.write(wave.speed);
+        writer.write(wave.steepness);
+        writer.write(wave.wave_length);
+        writer.write(wave.amplitude);
+    }
+
+    static void read(BinaryReader& reader, DXWave& wave)
+    {
+        reader.read(wave.direction);
+        reader.read(wave.padding);
+        reader.read(wave.speed);
+        reader.read(wave.steepness);
+        reader.read(wave.wave_length);
+        reader.read(wave.amplitude);
+    }
+};
+
+template<>
+struct BinaryCodec<ConstantBufferWater>
+{
+    static void write(BinaryWriter& writer, ConstantBufferWater const& cb)
+    {
+        writer.write(cb.top_color);
+        writer.write(cb.bottom_color);
+        writer.write(cb.normalmap_scroll_speed_0);
+        writer.write(cb.normalmap_scroll_speed_1);
+        writer.write(cb.normalmap_scale0);
+        writer.write(cb.normalmap_scale1);
+        writer.write(cb.combined_amplitude);
+        writer.write(cb.phong_contribution);
+    }
+
+    static void read(BinaryReader& reader, ConstantBufferWater& cb)
+    {
+        reader.read(cb.top_color);
+        reader.read(cb.bottom_color);
+        reader.read(cb.normalmap_scroll_speed_0);
+        reader.read(cb.normalmap_scroll_speed_1);
+        reader.read(cb.normalmap_scale0);
+        reader.read(cb.normalmap_scale1);
+        reader.read(cb.combined_amplitude);
+        reader.read(cb.phong_contribution);
+    }
+};
+
+template<>
+struct BinaryCodec<SpawnEvent>
+{
+    static void write(BinaryWriter& writer, SpawnEvent const& event)
+    {
+        writer.write(event.spawn_list);
+        writer.write(event.spawn_type);
+    }
+
+    static void read(BinaryReader& reader, SpawnEvent& event)
+    {
+        reader.read(event.spawn_list);
+        reader.read(event.spawn_type);
+    }
+};
+
+template<>
+struct BinaryCodec<FloaterSettings>
+{
+    static void write(BinaryWriter& writer, FloaterSettings const& settings)
+    {
+        writer.write(settings.sink_rate);
+        writer.write(settings.side_rotation_strength);
+        writer.write(settings.forward_rotation_strength);
+        writer.write(settings.side_floaters_offset);
+        writer.write(settings.forward_floaters_offset);
+    }
+
+    static void read(BinaryReader& reader, FloaterSettings& settings)
+    {
+        reader.read(settings.sink_rate);
+        reader.read(settings.side_rotation_strength);
+        reader.read(settings.forward_rotation_strength);
+        reader.read(settings.side_floaters_offset);
+        reader.read(settings.forward_floaters_offset);
+    }
+};
+
+template<>
+struct BinaryCodec<DialogueObject>
+{
+    static void write(BinaryWriter& writer, DialogueObject const& dialogue)
+    {
+        writer.write(dialogue.auto_end);
+        writer.write(dialogue.upper_line);
+        writer.write(dialogue.middle_line);
+        writer.write(dialogue.lower_line);
+        writer.write(dialogue.sound_path);
+    }
+
+    static void read(BinaryReader& reader, DialogueObject& dialogue)
+    {
+        reader.read(dialogue.auto_end);
+        reader.read(dialogue.upper_line);
+        reader.read(dialogue.middle_line);
+        reader.read(dialogue.lower_line);
+        reader.read(dialogue.sound_path);
+    }
+};
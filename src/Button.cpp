@@ -265,6 +265,7 @@ std::shared_ptr<Mesh> Button::create_sprite() const
     TextureSettings texture_settings = {};
     texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+    texture_settings.compress = false;
 
     if (!m_path.empty())
         diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(m_path, TextureType::Diffuse, texture_settings));
@@ -302,49 +302,40 @@ void Collider2D::apply_mtv(glm::vec2 const mtv) const
     entity->transform->set_position(AK::convert_2d_to_3d(new_position, entity->transform->get_position().y));
 }
 
-bool Collider2D::is_inside_trigger(std::string const& guid) const
+bool Collider2D::is_inside_trigger(AK::Handle<Component> const other) const
 {
-    return m_inside_trigger.contains(guid);
+    return std::ranges::find(m_inside_trigger, other) != m_inside_trigger.end();
 }
 
-std::weak_ptr<Collider2D> Collider2D::get_inside_trigger(std::string const& guid) const
+std::vector<AK::Handle<Component>> const& Collider2D::get_inside_trigger() const
 {
-    return m_inside_trigger.at(guid);
+    return m_inside_trigger;
 }
 
-std::vector<std::weak_ptr<Collider2D>> Collider2D::get_inside_trigger_vector() const
+void Collider2D::set_inside_trigger(std::span<AK::Handle<Component> const> const colliders)
 {
-    return m_inside_trigger_vector;
+    // Assigning keeps the capacity between frames
+    m_inside_trigger.assign(colliders.begin(), colliders.end());
 }
 
-void Collider2D::add_inside_trigger(std::string const& guid, std::shared_ptr<Collider2D> const& collider)
+std::vector<AK::Handle<Component>> const& Collider2D::get_all_overlapping_this_frame() const
 {
-    m_inside_trigger.emplace(guid, collider);
-    m_inside_trigger_vector.emplace_back(collider);
-}
-
-auto Collider2D::set_inside_trigger(std::unordered_map<std::string, std::weak_ptr<Collider2D>> const& map,
-                                    std::vector<std::weak_ptr<Collider2D>> const& vector) -> void
-{
-    m_inside_trigger = map;
-    m_inside_trigger_vector = vector;
+    return m_overlapped_this_frame;
 }
 
-std::vector<std::weak_ptr<Collider2D>> Collider2D::get_all_overlapping_this_frame() const
+bool Collider2D::is_overlapping_this_frame(AK::Handle<Component> const other) const
 {
-    return m_overlapped_this_frame;
+    return std::ranges::find(m_overlapped_this_frame, other) != m_overlapped_this_frame.end();
 }
 
 void Collider2D::add_overlapped_this_frame(std::shared_ptr<Collider2D> const& collider)
 {
-    m_overlapped_this_frame.emplace_back(collider);
-    m_overlapped_this_frame_map.emplace(collider->guid, collider);
+    m_overlapped_this_frame.emplace_back(collider->get_handle());
 }
 
 void Collider2D::clear_overlapped_this_frame()
 {
     m_overlapped_this_frame.clear();
-    m_overlapped_this_frame_map.clear();
 }
 
 void Collider2D::physics_update()
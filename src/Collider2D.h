@@ -7,6 +7,7 @@
 #include "glm/glm.hpp"
 
 #include <array>
+#include <span>
 #include <unordered_map>
 
 class DebugDrawing;
@@ -74,14 +75,13 @@ public:
     std::array<glm::vec2, 2> get_axes() const;
 
     // Internal functions meant to be used by the PhysicsEngine
-    bool is_inside_trigger(std::string const& guid) const;
-    std::weak_ptr<Collider2D> get_inside_trigger(std::string const& guid) const;
-    std::vector<std::weak_ptr<Collider2D>> get_inside_trigger_vector() const;
-    void add_inside_trigger(std::string const& guid, std::shared_ptr<Collider2D> const& collider);
-    void set_inside_trigger(std::unordered_map<std::string, std::weak_ptr<Collider2D>> const& map,
-                            std::vector<std::weak_ptr<Collider2D>> const& vector);
-
-    std::vector<std::weak_ptr<Collider2D>> get_all_overlapping_this_frame() const;
+    // Other colliders are held by handles, so checking them doesn't touch any reference counts.
+    bool is_inside_trigger(AK::Handle<Component> const other) const;
+    std::vector<AK::Handle<Component>> const& get_inside_trigger() const;
+    void set_inside_trigger(std::span<AK::Handle<Component> const> const colliders);
+
+    std::vector<AK::Handle<Component>> const& get_all_overlapping_this_frame() const;
+    bool is_overlapping_this_frame(AK::Handle<Component> const other) const;
     void add_overlapped_this_frame(std::shared_ptr<Collider2D> const& collider);
     void clear_overlapped_this_frame();
 
@@ -109,11 +109,9 @@ private:
     std::array<glm::vec2, 4> m_corners = {}; // For rectangle, calculated each frame
     std::array<glm::vec2, 2> m_axes = {}; // For rectangle, calculated each frame
 
-    std::unordered_map<std::string, std::weak_ptr<Collider2D>> m_inside_trigger = {};
-    std::vector<std::weak_ptr<Collider2D>> m_inside_trigger_vector = {};
-
-    std::vector<std::weak_ptr<Collider2D>> m_overlapped_this_frame = {};
-    std::unordered_map<std::string, std::weak_ptr<Collider2D>> m_overlapped_this_frame_map = {};
+    // Collider overlaps only a few others at once, so linear search is faster than hashing
+    std::vector<AK::Handle<Component>> m_inside_trigger = {};
+    std::vector<AK::Handle<Component>> m_overlapped_this_frame = {};
 
     std::shared_ptr<Entity> m_debug_drawing_entity = nullptr;
     std::shared_ptr<DebugDrawing> m_debug_drawing = nullptr;
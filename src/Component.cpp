@@ -11,6 +11,17 @@
 Component::Component()
 {
     guid = AK::generate_guid();
+    m_handle = AK::HandleRegistry<Component>::get_instance().add(this);
+}
+
+Component::~Component()
+{
+    AK::HandleRegistry<Component>::get_instance().remove(m_handle);
+}
+
+AK::Handle<Component> Component::get_handle() const
+{
+    return m_handle;
 }
 
 void Component::initialize()
@@ -49,6 +60,10 @@ void Component::on_destroyed()
 {
 }
 
+void Component::on_recycled()
+{
+}
+
 void Component::on_collision_enter(std::shared_ptr<Collider2D> const& other)
 {
 }
@@ -65,6 +80,11 @@ void Component::on_trigger_exit(std::shared_ptr<Collider2D> const& other)
 {
 }
 
+void Component::destroy()
+{
+    MainScene::get_instance()->destroy_deferred(shared_from_this());
+}
+
 void Component::destroy_immediate()
 {
     assert(entity != nullptr);
@@ -86,7 +106,10 @@ void Component::destroy_immediate()
     uninitialize();
 
     AK::swap_and_erase(entity->components, shared);
+    entity->increment_version();
     entity = nullptr;
+
+    MainScene::get_instance()->mark_referrers_dirty(guid);
 }
 
 void Component::draw_editor()
@@ -104,9 +127,9 @@ void Component::set_can_tick(bool const value)
     if (m_can_tick != value)
     {
         if (value)
-            MainScene::get_instance()->tickable_components.emplace_back(shared_from_this());
+            MainScene::get_instance()->add_tickable_component(shared_from_this());
         else
-            AK::swap_and_erase(MainScene::get_instance()->tickable_components, shared_from_this());
+            MainScene::get_instance()->remove_tickable_component(shared_from_this());
     }
 
     m_can_tick = value;
@@ -138,3 +161,8 @@ bool Component::enabled() const
 {
     return m_enabled;
 }
+
+bool Component::is_parallel_update_safe() const
+{
+    return false;
+}
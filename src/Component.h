@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 
+#include "AK/Handle.h"
 #include "Debug.h"
 #include "EngineDefines.h"
 #include "Serialization.h"
@@ -14,7 +15,12 @@ class Component : public std::enable_shared_from_this<Component>
 {
 public:
     Component();
-    virtual ~Component() = default;
+    virtual ~Component();
+
+    Component(Component const&) = delete;
+    Component& operator=(Component const&) = delete;
+
+    [[nodiscard]] AK::Handle<Component> get_handle() const;
 
     virtual void initialize();
     virtual void uninitialize();
@@ -28,6 +34,9 @@ public:
     virtual void on_disabled();
     virtual void on_destroyed();
 
+    // Called when the entity is reused by the EntityPool, before the component is enabled again. Awake is not called again.
+    virtual void on_recycled();
+
     virtual void on_collision_enter(std::shared_ptr<Collider2D> const& other);
     virtual void on_collision_exit(std::shared_ptr<Collider2D> const& other);
     virtual void on_trigger_enter(std::shared_ptr<Collider2D> const& other);
@@ -35,6 +44,9 @@ public:
 
     void destroy_immediate();
 
+    // Component will be destroyed at the next sync point of the scene. Safe to call during the update, including parallel updates.
+    void destroy();
+
     virtual void draw_editor();
 
     std::shared_ptr<Entity> entity;
@@ -48,11 +60,17 @@ public:
     void set_enabled(bool const value);
     bool enabled() const;
 
+    // Parallel-safe components of the same type are updated concurrently. Override only if update() doesn't make any
+    // structural changes to the scene (creating or destroying entities and components, reparenting) and writes only to its own entity.
+    virtual bool is_parallel_update_safe() const;
+
     std::string guid = "";
 
     std::string custom_name = "";
 
 private:
+    AK::Handle<Component> m_handle = {};
+
     bool m_enabled = true;
     bool m_can_tick = false;
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+#include "AK/AK.h"
+#include "AK/Types.h"
+
+enum class FieldFlags : u8
+{
+    None = 0,
+    NonSerialized = 1 << 0,
+};
+
+// Public field of a component, found by EngineHeaderTool.
+template<typename Class, typename T, FieldFlags Flags>
+struct FieldDescriptor
+{
+    using ValueType = T;
+
+    static constexpr bool is_serialized = (static_cast<u8>(Flags) & static_cast<u8>(FieldFlags::NonSerialized)) == 0;
+
+    char const* name = nullptr;
+    u32 name_hash = 0;
+    T Class::*member = nullptr;
+
+    [[nodiscard]] constexpr T& get(Class& object) const
+    {
+        return object.*member;
+    }
+
+    [[nodiscard]] constexpr T const& get(Class const& object) const
+    {
+        return object.*member;
+    }
+};
+
+template<FieldFlags Flags = FieldFlags::None, typename Class, typename T>
+consteval FieldDescriptor<Class, T, Flags> make_field(char const* name, T Class::*member)
+{
+    return {name, AK::fnv1a_hash(name), member};
+}
+
+// Specialized for every component in ComponentReflectionTables.h, which is generated by EngineHeaderTool.
+// Holds the name of the component and a tuple of its fields, followed by the fields of its bases.
+// Fields are stored in the order in which they are serialized.
+template<typename T>
+struct ComponentReflection;
+
+// Keys of the YAML map of every component, which can't be used by fields.
+inline constexpr std::array reserved_field_names = {"ComponentName", "guid", "custom_name"};
+
+// Fields are looked up by the hash of their name during deserialization, so the hashes have to be unique.
+template<typename T>
+consteval bool has_unique_field_hashes()
+{
+    return std::apply(
+        [](auto const&... field) {
+            std::array<u32, reserved_field_names.size() + sizeof...(field)> hashes = {
+                AK::fnv1a_hash(reserved_field_names[0]), AK::fnv1a_hash(reserved_field_names[1]),
+                AK::fnv1a_hash(reserved_field_names[2]), field.name_hash...};
+
+            std::ranges::sort(hashes);
+            return std::ranges::adjacent_find(hashes) == hashes.end();
+        },
+        ComponentReflection<T>::fields);
+}
@@ -0,0 +1,764 @@
+#pragma once
+
+// Generated by EngineHeaderTool, don't edit by hand.
+
+#include <tuple>
+
+#include "AK/AK.h"
+#include "Button.h"
+#include "Camera.h"
+#include "Collider2D.h"
+#include "ComponentReflection.h"
+#include "Cube.h"
+#include "Curve.h"
+#include "DebugInputController.h"
+#include "DialoguePromptController.h"
+#include "DirectionalLight.h"
+#include "Drawable.h"
+#include "ExampleDynamicText.h"
+#include "ExampleUIBar.h"
+#include "Floater.h"
+#include "FloatersManager.h"
+#include "FloeButton.h"
+#include "Game/Clock.h"
+#include "Game/Credits.h"
+#include "Game/Customer.h"
+#include "Game/CustomerManager.h"
+#include "Game/EndScreen.h"
+#include "Game/Factory.h"
+#include "Game/GameController.h"
+#include "Game/HovercraftWithoutKeeper.h"
+#include "Game/IceBound.h"
+#include "Game/LevelController.h"
+#include "Game/Lighthouse.h"
+#include "Game/LighthouseKeeper.h"
+#include "Game/LighthouseLight.h"
+#include "Game/Path.h"
+#include "Game/Player.h"
+#include "Game/Player/PlayerInput.h"
+#include "Game/Popup.h"
+#include "Game/Port.h"
+#include "Game/Ship.h"
+#include "Game/ShipEyes.h"
+#include "Game/ShipSpawner.h"
+#include "Game/Thanks.h"
+#include "Light.h"
+#include "Model.h"
+#include "NowPromptTrigger.h"
+#include "Panel.h"
+#include "ParticleSystem.h"
+#include "PointLight.h"
+#include "ScreenText.h"
+#include "Sound.h"
+#include "SoundListener.h"
+#include "Sphere.h"
+#include "SpotLight.h"
+#include "Sprite.h"
+#include "Water.h"
+
+#define ENUMERATE_ABSTRACT_COMPONENTS         \
+    ENUMERATE_COMPONENT(Drawable, "Drawable") \
+    ENUMERATE_COMPONENT(Light, "Light")
+
+template<>
+struct ComponentReflection<class Camera>
+{
+    static constexpr char const* name = "CameraComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("CameraComponent");
+    static constexpr std::tuple fields = {
+        make_field("width", &Camera::width),
+        make_field("height", &Camera::height),
+        make_field("fov", &Camera::fov),
+        make_field("near_plane", &Camera::near_plane),
+        make_field("far_plane", &Camera::far_plane),
+    };
+};
+
+template<>
+struct ComponentReflection<class Collider2D>
+{
+    static constexpr char const* name = "Collider2DComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("Collider2DComponent");
+    static constexpr std::tuple fields = {
+        make_field("offset", &Collider2D::offset),
+        make_field("is_trigger", &Collider2D::is_trigger),
+        make_field("is_static", &Collider2D::is_static),
+        make_field("collider_type", &Collider2D::collider_type),
+        make_field("width", &Collider2D::width),
+        make_field("height", &Collider2D::height),
+        make_field("radius", &Collider2D::radius),
+        make_field("drag", &Collider2D::drag),
+        make_field("velocity", &Collider2D::velocity),
+    };
+};
+
+template<>
+struct ComponentReflection<class Curve>
+{
+    static constexpr char const* name = "CurveComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("CurveComponent");
+    static constexpr std::tuple fields = {
+        make_field("points", &Curve::points),
+    };
+};
+
+template<>
+struct ComponentReflection<class Path>
+{
+    static constexpr char const* name = "PathComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PathComponent");
+    static constexpr std::tuple fields = {
+        make_field("points", &Path::points),
+    };
+};
+
+template<>
+struct ComponentReflection<class DebugInputController>
+{
+    static constexpr char const* name = "DebugInputControllerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("DebugInputControllerComponent");
+    static constexpr std::tuple fields = {
+        make_field("gamma", &DebugInputController::gamma),
+        make_field("exposure", &DebugInputController::exposure),
+    };
+};
+
+template<>
+struct ComponentReflection<class DialoguePromptController>
+{
+    static constexpr char const* name = "DialoguePromptControllerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("DialoguePromptControllerComponent");
+    static constexpr std::tuple fields = {
+        make_field("interp_speed", &DialoguePromptController::interp_speed),
+        make_field("dialogue_panel", &DialoguePromptController::dialogue_panel),
+        make_field("panel_parent", &DialoguePromptController::panel_parent),
+        make_field("keeper_sprite", &DialoguePromptController::keeper_sprite),
+        make_field("upper_text", &DialoguePromptController::upper_text),
+        make_field("middle_text", &DialoguePromptController::middle_text),
+        make_field("lower_text", &DialoguePromptController::lower_text),
+        make_field("dialogue_objects", &DialoguePromptController::dialogue_objects),
+    };
+};
+
+template<>
+struct ComponentReflection<class Drawable>
+{
+    // Abstract, only used to serialize components without their own serialization
+    static constexpr char const* name = "DrawableComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("DrawableComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("bounds", &Drawable::bounds),
+        make_field("material", &Drawable::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Button>
+{
+    static constexpr char const* name = "ButtonComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ButtonComponent");
+    static constexpr std::tuple fields = {
+        make_field("path_default", &Button::path_default),
+        make_field("path_hovered", &Button::path_hovered),
+        make_field("path_pressed", &Button::path_pressed),
+        make_field("top_left_corner", &Button::top_left_corner),
+        make_field("top_right_corner", &Button::top_right_corner),
+        make_field("bottom_left_corner", &Button::bottom_left_corner),
+        make_field("bottom_right_corner", &Button::bottom_right_corner),
+        make_field<FieldFlags::NonSerialized>("bounds", &Button::bounds),
+        make_field("material", &Button::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Model>
+{
+    static constexpr char const* name = "ModelComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ModelComponent");
+    static constexpr std::tuple fields = {
+        make_field("model_path", &Model::model_path),
+        make_field<FieldFlags::NonSerialized>("bounds", &Model::bounds),
+        make_field("material", &Model::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Cube>
+{
+    static constexpr char const* name = "CubeComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("CubeComponent");
+    static constexpr std::tuple fields = {
+        make_field("diffuse_texture_path", &Cube::diffuse_texture_path),
+        make_field("specular_texture_path", &Cube::specular_texture_path),
+        make_field("model_path", &Cube::model_path),
+        make_field<FieldFlags::NonSerialized>("bounds", &Cube::bounds),
+        make_field("material", &Cube::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Sphere>
+{
+    static constexpr char const* name = "SphereComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("SphereComponent");
+    static constexpr std::tuple fields = {
+        make_field("sector_count", &Sphere::sector_count),
+        make_field("stack_count", &Sphere::stack_count),
+        make_field("texture_path", &Sphere::texture_path),
+        make_field("radius", &Sphere::radius),
+        make_field("model_path", &Sphere::model_path),
+        make_field<FieldFlags::NonSerialized>("bounds", &Sphere::bounds),
+        make_field("material", &Sphere::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Sprite>
+{
+    static constexpr char const* name = "SpriteComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("SpriteComponent");
+    static constexpr std::tuple fields = {
+        make_field("diffuse_texture_path", &Sprite::diffuse_texture_path),
+        make_field("model_path", &Sprite::model_path),
+        make_field<FieldFlags::NonSerialized>("bounds", &Sprite::bounds),
+        make_field("material", &Sprite::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Water>
+{
+    static constexpr char const* name = "WaterComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("WaterComponent");
+    static constexpr std::tuple fields = {
+        make_field("waves", &Water::waves),
+        make_field("m_ps_buffer", &Water::m_ps_buffer),
+        make_field("tesselation_level", &Water::tesselation_level),
+        make_field("model_path", &Water::model_path),
+        make_field<FieldFlags::NonSerialized>("bounds", &Water::bounds),
+        make_field("material", &Water::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class Panel>
+{
+    static constexpr char const* name = "PanelComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PanelComponent");
+    static constexpr std::tuple fields = {
+        make_field("background_path", &Panel::background_path),
+        make_field<FieldFlags::NonSerialized>("bounds", &Panel::bounds),
+        make_field("material", &Panel::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class ScreenText>
+{
+    static constexpr char const* name = "ScreenTextComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ScreenTextComponent");
+    static constexpr std::tuple fields = {
+        make_field("text", &ScreenText::text),
+        make_field("position", &ScreenText::position),
+        make_field("font_size", &ScreenText::font_size),
+        make_field("color", &ScreenText::color),
+        make_field("flags", &ScreenText::flags),
+        make_field("font_name", &ScreenText::font_name),
+        make_field("bold", &ScreenText::bold),
+        make_field("button_ref", &ScreenText::button_ref),
+        make_field<FieldFlags::NonSerialized>("bounds", &ScreenText::bounds),
+        make_field("material", &ScreenText::material),
+    };
+};
+
+template<>
+struct ComponentReflection<class ExampleDynamicText>
+{
+    static constexpr char const* name = "ExampleDynamicTextComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ExampleDynamicTextComponent");
+    static constexpr std::tuple fields = {};
+};
+
+template<>
+struct ComponentReflection<class ExampleUIBar>
+{
+    static constexpr char const* name = "ExampleUIBarComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ExampleUIBarComponent");
+    static constexpr std::tuple fields = {
+        make_field("value", &ExampleUIBar::value),
+    };
+};
+
+template<>
+struct ComponentReflection<class Floater>
+{
+    static constexpr char const* name = "FloaterComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("FloaterComponent");
+    static constexpr std::tuple fields = {
+        make_field("sink", &Floater::sink),
+        make_field("side_floaters_offset", &Floater::side_floaters_offset),
+        make_field("side_roation_strength", &Floater::side_roation_strength),
+        make_field("forward_rotation_strength", &Floater::forward_rotation_strength),
+        make_field("forward_floaters_offest", &Floater::forward_floaters_offest),
+        make_field("water", &Floater::water),
+    };
+};
+
+template<>
+struct ComponentReflection<class FloatersManager>
+{
+    static constexpr char const* name = "FloatersManagerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("FloatersManagerComponent");
+    static constexpr std::tuple fields = {
+        make_field("big_boat_settings", &FloatersManager::big_boat_settings),
+        make_field("small_boat_settings", &FloatersManager::small_boat_settings),
+        make_field("medium_boat_settings", &FloatersManager::medium_boat_settings),
+        make_field("tool_boat_settings", &FloatersManager::tool_boat_settings),
+        make_field("pirate_boat_settings", &FloatersManager::pirate_boat_settings),
+        make_field("water", &FloatersManager::water),
+    };
+};
+
+template<>
+struct ComponentReflection<class FloeButton>
+{
+    static constexpr char const* name = "FloeButtonComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("FloeButtonComponent");
+    static constexpr std::tuple fields = {
+        make_field("floe_button_type", &FloeButton::floe_button_type),
+    };
+};
+
+template<>
+struct ComponentReflection<class Light>
+{
+    // Abstract, only used to serialize components without their own serialization
+    static constexpr char const* name = "LightComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("LightComponent");
+    static constexpr std::tuple fields = {
+        make_field("ambient", &Light::ambient),
+        make_field("diffuse", &Light::diffuse),
+        make_field("specular", &Light::specular),
+        make_field("m_near_plane", &Light::m_near_plane),
+        make_field("m_far_plane", &Light::m_far_plane),
+        make_field("m_blocker_search_num_samples", &Light::m_blocker_search_num_samples),
+        make_field("m_pcf_num_samples", &Light::m_pcf_num_samples),
+        make_field("m_light_world_size", &Light::m_light_world_size),
+        make_field("m_light_frustum_width", &Light::m_light_frustum_width),
+    };
+};
+
+template<>
+struct ComponentReflection<class DirectionalLight>
+{
+    static constexpr char const* name = "DirectionalLightComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("DirectionalLightComponent");
+    static constexpr std::tuple fields = {
+        make_field("ambient", &DirectionalLight::ambient),
+        make_field("diffuse", &DirectionalLight::diffuse),
+        make_field("specular", &DirectionalLight::specular),
+        make_field("m_near_plane", &DirectionalLight::m_near_plane),
+        make_field("m_far_plane", &DirectionalLight::m_far_plane),
+        make_field("m_blocker_search_num_samples", &DirectionalLight::m_blocker_search_num_samples),
+        make_field("m_pcf_num_samples", &DirectionalLight::m_pcf_num_samples),
+        make_field("m_light_world_size", &DirectionalLight::m_light_world_size),
+        make_field("m_light_frustum_width", &DirectionalLight::m_light_frustum_width),
+    };
+};
+
+template<>
+struct ComponentReflection<class PointLight>
+{
+    static constexpr char const* name = "PointLightComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PointLightComponent");
+    static constexpr std::tuple fields = {
+        make_field("constant", &PointLight::constant),
+        make_field("linear", &PointLight::linear),
+        make_field("quadratic", &PointLight::quadratic),
+        make_field("ambient", &PointLight::ambient),
+        make_field("diffuse", &PointLight::diffuse),
+        make_field("specular", &PointLight::specular),
+        make_field("m_near_plane", &PointLight::m_near_plane),
+        make_field("m_far_plane", &PointLight::m_far_plane),
+        make_field("m_blocker_search_num_samples", &PointLight::m_blocker_search_num_samples),
+        make_field("m_pcf_num_samples", &PointLight::m_pcf_num_samples),
+        make_field("m_light_world_size", &PointLight::m_light_world_size),
+        make_field("m_light_frustum_width", &PointLight::m_light_frustum_width),
+    };
+};
+
+template<>
+struct ComponentReflection<class SpotLight>
+{
+    static constexpr char const* name = "SpotLightComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("SpotLightComponent");
+    static constexpr std::tuple fields = {
+        make_field("constant", &SpotLight::constant),
+        make_field("linear", &SpotLight::linear),
+        make_field("quadratic", &SpotLight::quadratic),
+        make_field("scattering_factor", &SpotLight::scattering_factor),
+        make_field("cut_off", &SpotLight::cut_off),
+        make_field("outer_cut_off", &SpotLight::outer_cut_off),
+        make_field("ambient", &SpotLight::ambient),
+        make_field("diffuse", &SpotLight::diffuse),
+        make_field("specular", &SpotLight::specular),
+        make_field("m_near_plane", &SpotLight::m_near_plane),
+        make_field("m_far_plane", &SpotLight::m_far_plane),
+        make_field("m_blocker_search_num_samples", &SpotLight::m_blocker_search_num_samples),
+        make_field("m_pcf_num_samples", &SpotLight::m_pcf_num_samples),
+        make_field("m_light_world_size", &SpotLight::m_light_world_size),
+        make_field("m_light_frustum_width", &SpotLight::m_light_frustum_width),
+    };
+};
+
+template<>
+struct ComponentReflection<class NowPromptTrigger>
+{
+    static constexpr char const* name = "NowPromptTriggerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("NowPromptTriggerComponent");
+    static constexpr std::tuple fields = {};
+};
+
+template<>
+struct ComponentReflection<class ParticleSystem>
+{
+    static constexpr char const* name = "ParticleSystemComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ParticleSystemComponent");
+    static constexpr std::tuple fields = {
+        make_field("particle_type", &ParticleSystem::particle_type),
+        make_field("play_once", &ParticleSystem::play_once),
+        make_field("rotate_particles", &ParticleSystem::rotate_particles),
+        make_field("spawn_instantly", &ParticleSystem::spawn_instantly),
+        make_field("sprite_path", &ParticleSystem::sprite_path),
+        make_field("min_spawn_interval", &ParticleSystem::min_spawn_interval),
+        make_field("max_spawn_interval", &ParticleSystem::max_spawn_interval),
+        make_field("start_velocity_1", &ParticleSystem::start_velocity_1),
+        make_field("start_velocity_2", &ParticleSystem::start_velocity_2),
+        make_field("min_spawn_alpha", &ParticleSystem::min_spawn_alpha),
+        make_field("max_spawn_alpha", &ParticleSystem::max_spawn_alpha),
+        make_field("start_min_particle_size", &ParticleSystem::start_min_particle_size),
+        make_field("start_max_particle_size", &ParticleSystem::start_max_particle_size),
+        make_field("emitter_bounds", &ParticleSystem::emitter_bounds),
+        make_field("min_spawn_count", &ParticleSystem::min_spawn_count),
+        make_field("max_spawn_count", &ParticleSystem::max_spawn_count),
+        make_field("start_color_1", &ParticleSystem::start_color_1),
+        make_field("end_color_1", &ParticleSystem::end_color_1),
+        make_field("lifetime_1", &ParticleSystem::lifetime_1),
+        make_field("lifetime_2", &ParticleSystem::lifetime_2),
+        make_field("m_simulate_in_world_space", &ParticleSystem::m_simulate_in_world_space),
+    };
+};
+
+template<>
+struct ComponentReflection<class Sound>
+{
+    static constexpr char const* name = "SoundComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("SoundComponent");
+    static constexpr std::tuple fields = {
+        make_field("path", &Sound::path),
+        make_field("volume", &Sound::volume),
+        make_field("play_on_awake", &Sound::play_on_awake),
+        make_field("is_positional", &Sound::is_positional),
+    };
+};
+
+template<>
+struct ComponentReflection<class SoundListener>
+{
+    static constexpr char const* name = "SoundListenerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("SoundListenerComponent");
+    static constexpr std::tuple fields = {};
+};
+
+template<>
+struct ComponentReflection<class Clock>
+{
+    static constexpr char const* name = "ClockComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ClockComponent");
+    static constexpr std::tuple fields = {};
+};
+
+template<>
+struct ComponentReflection<class Credits>
+{
+    static constexpr char const* name = "CreditsComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("CreditsComponent");
+    static constexpr std::tuple fields = {
+        make_field("back_to_menu_button", &Credits::back_to_menu_button),
+    };
+};
+
+template<>
+struct ComponentReflection<class Customer>
+{
+    static constexpr char const* name = "CustomerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("CustomerComponent");
+    static constexpr std::tuple fields = {
+        make_field("collider", &Customer::collider),
+        make_field("left_hand", &Customer::left_hand),
+        make_field("right_hand", &Customer::right_hand),
+        make_field<FieldFlags::NonSerialized>("desired_height", &Customer::desired_height),
+    };
+};
+
+template<>
+struct ComponentReflection<class CustomerManager>
+{
+    static constexpr char const* name = "CustomerManagerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("CustomerManagerComponent");
+    static constexpr std::tuple fields = {
+        make_field("destinations_after_feeding", &CustomerManager::destinations_after_feeding),
+        make_field("destination_curve", &CustomerManager::destination_curve),
+        make_field("customer_prefab", &CustomerManager::customer_prefab),
+    };
+};
+
+template<>
+struct ComponentReflection<class Factory>
+{
+    static constexpr char const* name = "FactoryComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("FactoryComponent");
+    static constexpr std::tuple fields = {
+        make_field("type", &Factory::type),
+        make_field("lights", &Factory::lights),
+        make_field("factory_light", &Factory::factory_light),
+    };
+};
+
+template<>
+struct ComponentReflection<class GameController>
+{
+    static constexpr char const* name = "GameControllerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("GameControllerComponent");
+    static constexpr std::tuple fields = {
+        make_field("current_scene", &GameController::current_scene),
+        make_field("next_scene", &GameController::next_scene),
+        make_field("dialog_manager", &GameController::dialog_manager),
+    };
+};
+
+template<>
+struct ComponentReflection<class HovercraftWithoutKeeper>
+{
+    static constexpr char const* name = "HovercraftWithoutKeeperComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("HovercraftWithoutKeeperComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("speed", &HovercraftWithoutKeeper::speed),
+    };
+};
+
+template<>
+struct ComponentReflection<class IceBound>
+{
+    static constexpr char const* name = "IceBoundComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("IceBoundComponent");
+    static constexpr std::tuple fields = {};
+};
+
+template<>
+struct ComponentReflection<class LevelController>
+{
+    static constexpr char const* name = "LevelControllerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("LevelControllerComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("is_started", &LevelController::is_started),
+        make_field<FieldFlags::NonSerialized>("is_ended", &LevelController::is_ended),
+        make_field("map_time", &LevelController::map_time),
+        make_field("map_food", &LevelController::map_food),
+        make_field("maximum_lighthouse_level", &LevelController::maximum_lighthouse_level),
+        make_field<FieldFlags::NonSerialized>("time", &LevelController::time),
+        make_field("factories", &LevelController::factories),
+        make_field("port", &LevelController::port),
+        make_field("lighthouse", &LevelController::lighthouse),
+        make_field("customer_manager", &LevelController::customer_manager),
+        make_field("playfield_width", &LevelController::playfield_width),
+        make_field("playfield_additional_width", &LevelController::playfield_additional_width),
+        make_field("playfield_height", &LevelController::playfield_height),
+        make_field("playfield_y_shift", &LevelController::playfield_y_shift),
+        make_field("ships_limit_curve", &LevelController::ships_limit_curve),
+        make_field("ships_limit", &LevelController::ships_limit),
+        make_field("ships_speed_curve", &LevelController::ships_speed_curve),
+        make_field("ships_speed", &LevelController::ships_speed),
+        make_field("ships_range_curve", &LevelController::ships_range_curve),
+        make_field("ships_turn_curve", &LevelController::ships_turn_curve),
+        make_field("ships_additional_speed_curve", &LevelController::ships_additional_speed_curve),
+        make_field("pirates_in_control_curve", &LevelController::pirates_in_control_curve),
+        make_field("is_tutorial", &LevelController::is_tutorial),
+        make_field("starting_packages", &LevelController::starting_packages),
+        make_field<FieldFlags::NonSerialized>("tutorial_progress", &LevelController::tutorial_progress),
+        make_field("tutorial_level", &LevelController::tutorial_level),
+        make_field<FieldFlags::NonSerialized>("tutorial_spawn_path", &LevelController::tutorial_spawn_path),
+        make_field<FieldFlags::NonSerialized>("is_tutorial_dialogs_enabled", &LevelController::is_tutorial_dialogs_enabled),
+    };
+};
+
+template<>
+struct ComponentReflection<class Lighthouse>
+{
+    static constexpr char const* name = "LighthouseComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("LighthouseComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("enterable_distance", &Lighthouse::enterable_distance),
+        make_field("light", &Lighthouse::light),
+        make_field("water", &Lighthouse::water),
+        make_field("spawn_position", &Lighthouse::spawn_position),
+        make_field<FieldFlags::NonSerialized>("is_entering_lighthouse_allowed", &Lighthouse::is_entering_lighthouse_allowed),
+    };
+};
+
+template<>
+struct ComponentReflection<class LighthouseKeeper>
+{
+    static constexpr char const* name = "LighthouseKeeperComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("LighthouseKeeperComponent");
+    static constexpr std::tuple fields = {
+        make_field("maximum_speed", &LighthouseKeeper::maximum_speed),
+        make_field("acceleration", &LighthouseKeeper::acceleration),
+        make_field("deceleration", &LighthouseKeeper::deceleration),
+        make_field<FieldFlags::NonSerialized>("max_outside_port_ship_interact_distance",
+                                              &LighthouseKeeper::max_outside_port_ship_interact_distance),
+        make_field<FieldFlags::NonSerialized>("interact_with_factory_distance", &LighthouseKeeper::interact_with_factory_distance),
+        make_field("lighthouse", &LighthouseKeeper::lighthouse),
+        make_field("port", &LighthouseKeeper::port),
+        make_field("keeper_dust", &LighthouseKeeper::keeper_dust),
+        make_field("keeper_splash", &LighthouseKeeper::keeper_splash),
+        make_field("packages", &LighthouseKeeper::packages),
+    };
+};
+
+template<>
+struct ComponentReflection<class LighthouseLight>
+{
+    static constexpr char const* name = "LighthouseLightComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("LighthouseLightComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("controlled_ship", &LighthouseLight::controlled_ship),
+        make_field("spotlight", &LighthouseLight::spotlight),
+        make_field("spotlight_beam_width", &LighthouseLight::spotlight_beam_width),
+    };
+};
+
+template<>
+struct ComponentReflection<class Player>
+{
+    static constexpr char const* name = "PlayerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PlayerComponent");
+    static constexpr std::tuple fields = {
+        make_field("packages_text", &Player::packages_text),
+        make_field("flashes_text", &Player::flashes_text),
+        make_field("level_text", &Player::level_text),
+        make_field("clock_text", &Player::clock_text),
+        make_field<FieldFlags::NonSerialized>("food", &Player::food),
+        make_field<FieldFlags::NonSerialized>("flash", &Player::flash),
+        make_field<FieldFlags::NonSerialized>("flash_counter", &Player::flash_counter),
+        make_field<FieldFlags::NonSerialized>("packages", &Player::packages),
+        make_field<FieldFlags::NonSerialized>("lighthouse_level", &Player::lighthouse_level),
+        make_field<FieldFlags::NonSerialized>("destroyed_ships", &Player::destroyed_ships),
+        make_field<FieldFlags::NonSerialized>("range", &Player::range),
+        make_field<FieldFlags::NonSerialized>("additional_ship_speed", &Player::additional_ship_speed),
+        make_field<FieldFlags::NonSerialized>("turn_speed", &Player::turn_speed),
+        make_field<FieldFlags::NonSerialized>("pirates_in_control", &Player::pirates_in_control),
+    };
+};
+
+template<>
+struct ComponentReflection<class Popup>
+{
+    static constexpr char const* name = "PopupComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PopupComponent");
+    static constexpr std::tuple fields = {};
+};
+
+template<>
+struct ComponentReflection<class EndScreen>
+{
+    static constexpr char const* name = "EndScreenComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("EndScreenComponent");
+    static constexpr std::tuple fields = {
+        make_field("is_failed", &EndScreen::is_failed),
+        make_field("number_of_stars", &EndScreen::number_of_stars),
+        make_field("stars", &EndScreen::stars),
+        make_field("star_scale", &EndScreen::star_scale),
+        make_field("next_level_button", &EndScreen::next_level_button),
+        make_field("restart_button", &EndScreen::restart_button),
+        make_field("menu_button", &EndScreen::menu_button),
+    };
+};
+
+template<>
+struct ComponentReflection<class Port>
+{
+    static constexpr char const* name = "PortComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PortComponent");
+    static constexpr std::tuple fields = {
+        make_field("lights", &Port::lights),
+    };
+};
+
+template<>
+struct ComponentReflection<class Ship>
+{
+    static constexpr char const* name = "ShipComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ShipComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("minimum_speed", &Ship::minimum_speed),
+        make_field<FieldFlags::NonSerialized>("maximum_speed", &Ship::maximum_speed),
+        make_field("type", &Ship::type),
+        make_field("light", &Ship::light),
+        make_field("spawner", &Ship::spawner),
+        make_field("eyes", &Ship::eyes),
+        make_field("my_light", &Ship::my_light),
+        make_field<FieldFlags::NonSerialized>("is_destroyed", &Ship::is_destroyed),
+        make_field<FieldFlags::NonSerialized>("floater", &Ship::floater),
+        make_field<FieldFlags::NonSerialized>("behavioral_state", &Ship::behavioral_state),
+        make_field<FieldFlags::NonSerialized>("is_in_flash_collider", &Ship::is_in_flash_collider),
+    };
+};
+
+template<>
+struct ComponentReflection<class ShipEyes>
+{
+    static constexpr char const* name = "ShipEyesComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ShipEyesComponent");
+    static constexpr std::tuple fields = {
+        make_field<FieldFlags::NonSerialized>("see_obstacle", &ShipEyes::see_obstacle),
+    };
+};
+
+template<>
+struct ComponentReflection<class ShipSpawner>
+{
+    static constexpr char const* name = "ShipSpawnerComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ShipSpawnerComponent");
+    static constexpr std::tuple fields = {
+        make_field("paths", &ShipSpawner::paths),
+        make_field("floaters_manager", &ShipSpawner::floaters_manager),
+        make_field("light", &ShipSpawner::light),
+        make_field("last_chance_food_threshold", &ShipSpawner::last_chance_food_threshold),
+        make_field("last_chance_time_threshold", &ShipSpawner::last_chance_time_threshold),
+        make_field("main_event_spawn", &ShipSpawner::main_event_spawn),
+        make_field("backup_spawn", &ShipSpawner::backup_spawn),
+    };
+};
+
+template<>
+struct ComponentReflection<class Thanks>
+{
+    static constexpr char const* name = "ThanksComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("ThanksComponent");
+    static constexpr std::tuple fields = {
+        make_field("back_to_menu_button", &Thanks::back_to_menu_button),
+    };
+};
+
+template<>
+struct ComponentReflection<class PlayerInput>
+{
+    static constexpr char const* name = "PlayerInputComponent";
+    static constexpr u32 name_hash = AK::fnv1a_hash("PlayerInputComponent");
+    static constexpr std::tuple fields = {
+        make_field("player_speed", &PlayerInput::player_speed),
+        make_field("camera_speed", &PlayerInput::camera_speed),
+    };
+};
+
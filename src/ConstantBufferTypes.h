@@ -106,8 +106,20 @@ struct ConstantBufferPerObject
     i32 is_glowing;
 };
 
+// Particles are turned towards the camera in the vertex shader
 struct ConstantBufferParticle
 {
+    glm::vec4 camera_right;
+    glm::vec4 camera_up;
+};
+
+// Element of the structured buffer every particle of an emitter is drawn from
+struct ParticleInstance
+{
+    glm::vec3 position;
+    float rotation;
+    glm::vec2 size;
+    glm::vec2 padding;
     glm::vec4 color;
 };
 
@@ -0,0 +1,442 @@
+#include "CookedModel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "AK/AK.h"
+#include "AK/FileStamp.h"
+#include "Model.h"
+#include "Vertex.h"
+#include "VirtualFileSystem.h"
+
+namespace
+{
+
+void extend_bounds(glm::vec3& bounds_min, glm::vec3& bounds_max, glm::vec3 const& position)
+{
+    bounds_min = glm::vec3(std::min(bounds_min.x, position.x), std::min(bounds_min.y, position.y), std::min(bounds_min.z, position.z));
+    bounds_max = glm::vec3(std::max(bounds_max.x, position.x), std::max(bounds_max.y, position.y), std::max(bounds_max.z, position.z));
+}
+
+}
+
+std::string CookedModel::get_cooked_path(std::string const& model_path)
+{
+    return std::filesystem::path(model_path).replace_extension(".mesh").string();
+}
+
+std::vector<std::string> CookedModel::find_source_paths(std::string const& model_path)
+{
+    std::filesystem::path const path = model_path;
+    std::filesystem::path const directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+
+    // Listed files are sorted, so the hash is the same on every run and for loose and packed files
+    std::vector<std::string> source_paths = {};
+
+    for (auto& file_path : VirtualFileSystem::get_instance().list_files(directory.string()))
+    {
+        std::filesystem::path const entry_path = file_path;
+
+        if (entry_path.stem() != path.stem() || entry_path.filename() == path.filename() || entry_path.extension() == ".mesh")
+            continue;
+
+        source_paths.emplace_back(std::move(file_path));
+    }
+
+    source_paths.insert(source_paths.begin(), model_path);
+    return source_paths;
+}
+
+u64 CookedModel::hash_source(std::vector<std::string> const& source_paths)
+{
+    u64 hash = 0;
+
+    for (size_t i = 0; i < source_paths.size(); ++i)
+    {
+        VirtualFile file = {};
+
+        if (!file.open(source_paths[i]))
+        {
+            if (i == 0)
+                return 0;
+
+            continue;
+        }
+
+        std::span<u8 const> const bytes = file.get_bytes();
+        hash = AK::murmur_hash64(bytes.data(), bytes.size(), hash);
+    }
+
+    // 0 means the source couldn't be read
+    return hash != 0 ? hash : 1;
+}
+
+std::shared_ptr<ModelData const> CookedModel::load(std::string const& model_path, u32 const import_settings)
+{
+    VirtualFile file = {};
+
+    if (!file.open(get_cooked_path(model_path)))
+        return nullptr;
+
+    std::span<u8 const> const data = file.get_bytes();
+    CookedModelHeader header = {};
+
+    if (data.size() < sizeof(header))
+        return nullptr;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, CookedModelHeader {}.magic, sizeof(header.magic)) != 0)
+    {
+        std::cout << "Error. Not a cooked model file: " << get_cooked_path(model_path) << "\n";
+        return nullptr;
+    }
+
+    // Written by an older version of the engine or with different settings, the model is imported and cooked again
+    if (header.version != cooked_model_version || header.vertex_size != sizeof(Vertex) || header.import_settings != import_settings)
+        return nullptr;
+
+    auto const fits = [&data](u64 const offset, u64 const size) { return offset + size <= data.size(); };
+
+    if (!fits(header.material_table_offset, static_cast<u64>(header.material_count) * sizeof(CookedMaterial))
+        || !fits(header.texture_table_offset, static_cast<u64>(header.texture_count) * sizeof(u32))
+        || !fits(header.submesh_table_offset, static_cast<u64>(header.submesh_count) * sizeof(CookedSubmesh))
+        || !fits(header.lod_table_offset, static_cast<u64>(header.lod_count) * sizeof(CookedLod)) || header.lod_table_offset % 4 != 0
+        || !fits(header.source_table_offset, static_cast<u64>(header.source_count) * sizeof(CookedSource)) || header.source_count == 0
+        || !fits(header.vertex_offset, static_cast<u64>(header.vertex_count) * sizeof(Vertex))
+        || !fits(header.index_offset, static_cast<u64>(header.index_count) * sizeof(u32)) || header.material_table_offset % 4 != 0
+        || header.texture_table_offset % 4 != 0 || header.submesh_table_offset % 4 != 0 || header.vertex_offset % 4 != 0
+        || header.index_offset % 4 != 0 || reinterpret_cast<uintptr_t>(data.data()) % 4 != 0)
+    {
+        std::cout << "Error. Cooked model file is corrupted: " << get_cooked_path(model_path) << "\n";
+        return nullptr;
+    }
+
+    std::vector<std::string_view> strings = {};
+    strings.reserve(header.string_count);
+    size_t offset = header.string_table_offset;
+
+    for (u32 i = 0; i < header.string_count; ++i)
+    {
+        u32 length = 0;
+
+        if (!fits(offset, sizeof(length)))
+            return nullptr;
+
+        std::memcpy(&length, data.data() + offset, sizeof(length));
+        offset += sizeof(length);
+
+        if (!fits(offset, length))
+            return nullptr;
+
+        strings.emplace_back(reinterpret_cast<char const*>(data.data() + offset), length);
+        offset += length;
+    }
+
+    // Copied, so stamps of touched sources can be updated
+    std::vector<CookedSource> sources(header.source_count);
+    std::memcpy(sources.data(), data.data() + header.source_table_offset, sources.size() * sizeof(CookedSource));
+
+    if (std::ranges::any_of(sources, [&strings](CookedSource const& source) { return source.name >= strings.size(); }))
+    {
+        std::cout << "Error. Cooked model file is corrupted: " << get_cooked_path(model_path) << "\n";
+        return nullptr;
+    }
+
+    // Shipped builds can leave the model file out, the cooked file is all there is then
+    if (AK::FileStamp::get(model_path).has_value())
+    {
+        std::filesystem::path const directory = std::filesystem::path(model_path).parent_path();
+        bool is_unchanged = true;
+
+        for (auto& source : sources)
+        {
+            AK::FileStamp const stamp = AK::FileStamp::get((directory / strings[source.name]).string()).value_or(AK::FileStamp {});
+
+            if (stamp != AK::FileStamp {source.size, source.write_time})
+            {
+                is_unchanged = false;
+                source.size = stamp.size;
+                source.write_time = stamp.write_time;
+            }
+        }
+
+        // Sources are only read when they were changed or only touched, ex. by a checkout. The content tells which one it was.
+        if (!is_unchanged)
+        {
+            if (hash_source(find_source_paths(model_path)) != header.source_hash)
+                return nullptr;
+
+            // So the sources aren't read again the next time
+            if (!file.is_packed())
+            {
+                static_cast<void>(AK::overwrite_file(get_cooked_path(model_path), header.source_table_offset,
+                                                     {reinterpret_cast<u8 const*>(sources.data()), sources.size() * sizeof(CookedSource)}));
+            }
+        }
+    }
+
+    std::span const materials(reinterpret_cast<CookedMaterial const*>(data.data() + header.material_table_offset), header.material_count);
+    std::span const textures(reinterpret_cast<u32 const*>(data.data() + header.texture_table_offset), header.texture_count);
+    std::span const submeshes(reinterpret_cast<CookedSubmesh const*>(data.data() + header.submesh_table_offset), header.submesh_count);
+    std::span const lods(reinterpret_cast<CookedLod const*>(data.data() + header.lod_table_offset), header.lod_count);
+    auto const* vertices = reinterpret_cast<Vertex const*>(data.data() + header.vertex_offset);
+    auto const* indices = reinterpret_cast<u32 const*>(data.data() + header.index_offset);
+
+    auto const get_texture_paths = [&](u32 const first, u32 const count) {
+        std::vector<std::string> paths = {};
+        paths.reserve(count);
+
+        for (u32 i = first; i < first + count; ++i)
+        {
+            paths.emplace_back(strings[textures[i]]);
+        }
+
+        return paths;
+    };
+
+    auto model_data = std::make_shared<ModelData>();
+    model_data->meshes.resize(submeshes.size());
+
+    for (size_t i = 0; i < submeshes.size(); ++i)
+    {
+        CookedSubmesh const& submesh = submeshes[i];
+
+        if (static_cast<u64>(submesh.first_vertex) + submesh.vertex_count > header.vertex_count
+            || static_cast<u64>(submesh.first_index) + submesh.index_count > header.index_count || submesh.material >= materials.size()
+            || static_cast<u64>(submesh.first_lod) + submesh.lod_count > lods.size()
+            || std::ranges::any_of(lods.subspan(submesh.first_lod, submesh.lod_count), [&submesh](CookedLod const& lod) {
+                   return static_cast<u64>(lod.first_index) + lod.index_count > submesh.index_count;
+               }))
+        {
+            std::cout << "Error. Cooked model file is corrupted: " << get_cooked_path(model_path) << "\n";
+            return nullptr;
+        }
+
+        CookedMaterial const& material = materials[submesh.material];
+
+        if (static_cast<u64>(material.first_texture) + material.diffuse_texture_count + material.specular_texture_count > textures.size()
+            || std::ranges::any_of(textures.subspan(material.first_texture,
+                                                    material.diffuse_texture_count + material.specular_texture_count),
+                                   [&strings](u32 const string_index) { return string_index >= strings.size(); }))
+        {
+            std::cout << "Error. Cooked model file is corrupted: " << get_cooked_path(model_path) << "\n";
+            return nullptr;
+        }
+
+        // Vertices and indices are stored the way meshes use them, so they are copied straight from the mapped file
+        ModelMeshData& mesh = model_data->meshes[i];
+        mesh.vertices.assign(vertices + submesh.first_vertex, vertices + submesh.first_vertex + submesh.vertex_count);
+        mesh.indices.assign(indices + submesh.first_index, indices + submesh.first_index + submesh.index_count);
+        mesh.lods.reserve(submesh.lod_count);
+
+        for (auto const& lod : lods.subspan(submesh.first_lod, submesh.lod_count))
+            mesh.lods.push_back({lod.first_index, lod.index_count, lod.error});
+
+        mesh.diffuse_texture_paths = get_texture_paths(material.first_texture, material.diffuse_texture_count);
+        mesh.specular_texture_paths =
+            get_texture_paths(material.first_texture + material.diffuse_texture_count, material.specular_texture_count);
+    }
+
+    return model_data;
+}
+
+bool CookedModel::save(std::string const& model_path, ModelData const& data, u32 const import_settings)
+{
+    std::vector<std::string> strings = {};
+    std::unordered_map<std::string, u32> string_indices = {};
+
+    std::vector<CookedMaterial> materials = {};
+    std::vector<u32> textures = {};
+    std::vector<CookedSubmesh> submeshes = {};
+    submeshes.reserve(data.meshes.size());
+    std::vector<CookedLod> lods = {};
+
+    auto const add_string = [&](std::string const& str) {
+        auto const [it, inserted] = string_indices.try_emplace(str, static_cast<u32>(strings.size()));
+
+        if (inserted)
+            strings.emplace_back(str);
+
+        return it->second;
+    };
+
+    CookedModelHeader header = {};
+    header.import_settings = import_settings;
+    header.vertex_size = sizeof(Vertex);
+
+    // Stamped before they are hashed, sources changed in between are hashed again on the next load
+    std::vector<std::string> const source_paths = find_source_paths(model_path);
+    std::vector<CookedSource> sources = {};
+    sources.reserve(source_paths.size());
+
+    for (auto const& source_path : source_paths)
+    {
+        AK::FileStamp const stamp = AK::FileStamp::get(source_path).value_or(AK::FileStamp {});
+        sources.push_back({add_string(std::filesystem::path(source_path).filename().string()), 0, stamp.size, stamp.write_time});
+    }
+
+    header.source_hash = hash_source(source_paths);
+
+    for (auto const& mesh : data.meshes)
+    {
+        std::vector<u32> material_textures = {};
+        material_textures.reserve(mesh.diffuse_texture_paths.size() + mesh.specular_texture_paths.size());
+
+        for (auto const& path : mesh.diffuse_texture_paths)
+            material_textures.emplace_back(add_string(path));
+
+        for (auto const& path : mesh.specular_texture_paths)
+            material_textures.emplace_back(add_string(path));
+
+        // Meshes of one model mostly share a handful of materials
+        auto const material = std::ranges::find_if(materials, [&](CookedMaterial const& existing) {
+            return existing.diffuse_texture_count == mesh.diffuse_texture_paths.size()
+                && existing.specular_texture_count == mesh.specular_texture_paths.size()
+                && std::equal(material_textures.begin(), material_textures.end(), textures.begin() + existing.first_texture);
+        });
+
+        CookedSubmesh submesh = {};
+        submesh.material = static_cast<u32>(material - materials.begin());
+
+        if (material == materials.end())
+        {
+            materials.push_back({static_cast<u32>(textures.size()), static_cast<u32>(mesh.diffuse_texture_paths.size()),
+                                 static_cast<u32>(mesh.specular_texture_paths.size())});
+            textures.insert(textures.end(), material_textures.begin(), material_textures.end());
+        }
+
+        submesh.first_vertex = header.vertex_count;
+        submesh.vertex_count = static_cast<u32>(mesh.vertices.size());
+        submesh.first_index = header.index_count;
+        submesh.index_count = static_cast<u32>(mesh.indices.size());
+        submesh.first_lod = static_cast<u32>(lods.size());
+        submesh.lod_count = static_cast<u32>(mesh.lods.size());
+
+        for (auto const& lod : mesh.lods)
+            lods.push_back({lod.first_index, lod.index_count, lod.error});
+
+        if (!mesh.vertices.empty())
+        {
+            submesh.bounds_min = mesh.vertices[0].position;
+            submesh.bounds_max = mesh.vertices[0].position;
+        }
+
+        for (auto const& vertex : mesh.vertices)
+            extend_bounds(submesh.bounds_min, submesh.bounds_max, vertex.position);
+
+        if (submeshes.empty())
+        {
+            header.bounds_min = submesh.bounds_min;
+            header.bounds_max = submesh.bounds_max;
+        }
+
+        extend_bounds(header.bounds_min, header.bounds_max, submesh.bounds_min);
+        extend_bounds(header.bounds_min, header.bounds_max, submesh.bounds_max);
+
+        header.vertex_count += submesh.vertex_count;
+        header.index_count += submesh.index_count;
+        submeshes.emplace_back(submesh);
+    }
+
+    std::vector<u8> bytes = {};
+    bytes.reserve(sizeof(header) + static_cast<size_t>(header.vertex_count) * sizeof(Vertex) + header.index_count * sizeof(u32));
+
+    auto const append = [&bytes](void const* source, size_t const size) {
+        auto const* begin = static_cast<u8 const*>(source);
+        bytes.insert(bytes.end(), begin, begin + size);
+    };
+
+    header.string_count = static_cast<u32>(strings.size());
+    header.material_count = static_cast<u32>(materials.size());
+    header.texture_count = static_cast<u32>(textures.size());
+    header.submesh_count = static_cast<u32>(submeshes.size());
+    header.lod_count = static_cast<u32>(lods.size());
+    header.source_count = static_cast<u32>(sources.size());
+    append(&header, sizeof(header));
+
+    header.string_table_offset = static_cast<u32>(bytes.size());
+    for (auto const& str : strings)
+    {
+        auto const length = static_cast<u32>(str.size());
+        append(&length, sizeof(length));
+        append(str.data(), str.size());
+    }
+
+    // Tables are read in place, so they have to be aligned
+    bytes.resize((bytes.size() + 3) & ~static_cast<size_t>(3), 0);
+
+    header.source_table_offset = static_cast<u32>(bytes.size());
+    append(sources.data(), sources.size() * sizeof(CookedSource));
+
+    header.material_table_offset = static_cast<u32>(bytes.size());
+    append(materials.data(), materials.size() * sizeof(CookedMaterial));
+
+    header.texture_table_offset = static_cast<u32>(bytes.size());
+    append(textures.data(), textures.size() * sizeof(u32));
+
+    header.submesh_table_offset = static_cast<u32>(bytes.size());
+    append(submeshes.data(), submeshes.size() * sizeof(CookedSubmesh));
+
+    header.lod_table_offset = static_cast<u32>(bytes.size());
+    append(lods.data(), lods.size() * sizeof(CookedLod));
+
+    header.vertex_offset = static_cast<u32>(bytes.size());
+    for (auto const& mesh : data.meshes)
+        append(mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+
+    header.index_offset = static_cast<u32>(bytes.size());
+    for (auto const& mesh : data.meshes)
+        append(mesh.indices.data(), mesh.indices.size() * sizeof(u32));
+
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    // Models are read on worker threads, two of them can cook the same model at once
+    std::string const cooked_path = get_cooked_path(model_path);
+    std::string const temporary_path =
+        std::format("{}.{}.tmp", cooked_path, std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            std::cout << "Error. Could not create a cooked model file: " << temporary_path << "\n";
+            return false;
+        }
+
+        file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        if (!file.good())
+        {
+            file.close();
+
+            std::error_code error;
+            std::filesystem::remove(temporary_path, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, cooked_path, error);
+
+    // The cooked file can be mapped by another thread reading it right now, it's written again the next time
+    if (error)
+    {
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    return true;
+}
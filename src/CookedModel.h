@@ -0,0 +1,118 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AK/Types.h"
+
+struct ModelData;
+
+// Cooked model format. Holds what Model reads from a model file with Assimp, laid out so it can be used without any parsing.
+// Written next to the model file the first time the model is imported, and read instead of the model file from then on.
+// Layout of a file, all offsets are counted from its beginning:
+//   CookedModelHeader
+//   String table   - u32 length followed by the characters, for every texture path and source file name. Padded to 4 bytes.
+//   Source table   - CookedSource for every source file, the model file first
+//   Material table - CookedMaterial for every unique set of textures
+//   Texture table  - u32 string index for every texture of every material, diffuse textures first
+//   Submesh table  - CookedSubmesh for every mesh
+//   LOD table      - CookedLod for every level of detail of every submesh, none for submeshes without levels of detail
+//   Vertices       - Vertex for every vertex of every submesh
+//   Indices        - u32 for every index of every submesh, levels of detail of a submesh one after another
+// A cooked file is out of date when it was imported with different settings, or when the hash of its source files doesn't
+// match source_hash. Sources are only hashed again when their size or write time changed. Without the model file on disk,
+// ex. in an archive of a shipped build, the cooked file is used as it is.
+// Bump the version whenever Model imports models differently, so every cooked file is written again.
+
+u32 constexpr cooked_model_version = 4;
+
+struct CookedModelHeader
+{
+    char magic[4] = {'E', 'M', 'D', 'L'};
+    u32 version = cooked_model_version;
+    u64 source_hash = 0;
+    u32 vertex_size = 0;
+    u32 string_count = 0;
+    u32 material_count = 0;
+    u32 texture_count = 0;
+    u32 submesh_count = 0;
+    u32 vertex_count = 0;
+    u32 index_count = 0;
+    u32 string_table_offset = 0;
+    u32 material_table_offset = 0;
+    u32 texture_table_offset = 0;
+    u32 submesh_table_offset = 0;
+    u32 vertex_offset = 0;
+    u32 index_offset = 0;
+    u32 lod_count = 0;
+    u32 lod_table_offset = 0;
+    u32 import_settings = 0;
+    u32 source_count = 0;
+    u32 source_table_offset = 0;
+    glm::vec3 bounds_min = {};
+    glm::vec3 bounds_max = {};
+};
+
+// Source files are next to the model file
+struct CookedSource
+{
+    u32 name = 0;
+    u32 padding = 0;
+    u64 size = 0;
+    i64 write_time = 0;
+};
+
+struct CookedMaterial
+{
+    u32 first_texture = 0;
+    u32 diffuse_texture_count = 0;
+    u32 specular_texture_count = 0;
+};
+
+struct CookedSubmesh
+{
+    u32 first_vertex = 0;
+    u32 vertex_count = 0;
+    u32 first_index = 0;
+    u32 index_count = 0;
+    u32 material = 0;
+    u32 first_lod = 0;
+    u32 lod_count = 0;
+    glm::vec3 bounds_min = {};
+    glm::vec3 bounds_max = {};
+};
+
+// Same as MeshLod, first_index is counted from the first index of the submesh
+struct CookedLod
+{
+    u32 first_index = 0;
+    u32 index_count = 0;
+    float error = 0.0f;
+};
+
+static_assert(sizeof(CookedModelHeader) == 112);
+static_assert(sizeof(CookedSource) == 24);
+static_assert(sizeof(CookedMaterial) == 12);
+static_assert(sizeof(CookedSubmesh) == 52);
+static_assert(sizeof(CookedLod) == 12);
+
+class CookedModel
+{
+public:
+    // glTF buffers already use .bin, so cooked models use .mesh.
+    [[nodiscard]] static std::string get_cooked_path(std::string const& model_path);
+
+    // The model file first, then the files next to it that share its name, like glTF buffers or OBJ materials.
+    [[nodiscard]] static std::vector<std::string> find_source_paths(std::string const& model_path);
+
+    // Returns 0 if the model file can't be read.
+    [[nodiscard]] static u64 hash_source(std::vector<std::string> const& source_paths);
+
+    // Returns nullptr if the model has no cooked file, or it was cooked from different source files or with different settings.
+    [[nodiscard]] static std::shared_ptr<ModelData const> load(std::string const& model_path, u32 const import_settings);
+
+    // Safe to call for the same model from multiple threads, the file is written under a temporary name and renamed.
+    static bool save(std::string const& model_path, ModelData const& data, u32 const import_settings);
+};
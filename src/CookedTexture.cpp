@@ -0,0 +1,223 @@
+#include "CookedTexture.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include "AK/AK.h"
+#include "AK/FileStamp.h"
+#include "TextureCompression.h"
+#include "VirtualFileSystem.h"
+
+namespace
+{
+
+u32 constexpr dds_caps = 0x1;
+u32 constexpr dds_height = 0x2;
+u32 constexpr dds_width = 0x4;
+u32 constexpr dds_pitch = 0x8;
+u32 constexpr dds_pixel_format = 0x1000;
+u32 constexpr dds_mip_map_count = 0x20000;
+u32 constexpr dds_linear_size = 0x80000;
+
+u32 constexpr dds_four_cc = 0x4;
+u32 constexpr dds_four_cc_dx10 = '0' << 24 | '1' << 16 | 'X' << 8 | 'D';
+
+u32 constexpr dds_caps_complex = 0x8;
+u32 constexpr dds_caps_texture = 0x1000;
+u32 constexpr dds_caps_mip_map = 0x400000;
+
+u32 constexpr dxgi_format_r8g8b8a8_unorm_srgb = 29;
+u32 constexpr dxgi_format_bc1_unorm_srgb = 72;
+u32 constexpr dxgi_format_bc3_unorm_srgb = 78;
+
+AK::FileStamp get_source_stamp(CookedTextureHeader const& header)
+{
+    return {static_cast<u64>(header.source_size_high) << 32 | header.source_size_low,
+            static_cast<i64>(static_cast<u64>(header.source_write_time_high) << 32 | header.source_write_time_low)};
+}
+
+void set_source_stamp(CookedTextureHeader& header, AK::FileStamp const& stamp)
+{
+    header.source_size_low = static_cast<u32>(stamp.size);
+    header.source_size_high = static_cast<u32>(stamp.size >> 32);
+    header.source_write_time_low = static_cast<u32>(stamp.write_time);
+    header.source_write_time_high = static_cast<u32>(static_cast<u64>(stamp.write_time) >> 32);
+}
+
+}
+
+std::string CookedTexture::get_cooked_path(std::string const& image_path)
+{
+    return image_path + ".dds";
+}
+
+u64 CookedTexture::hash_source(std::string const& image_path)
+{
+    VirtualFile file = {};
+
+    if (!file.open(image_path))
+        return 0;
+
+    std::span<u8 const> const bytes = file.get_bytes();
+    u64 const hash = AK::murmur_hash64(bytes.data(), bytes.size(), 0);
+
+    // 0 means the source couldn't be read
+    return hash != 0 ? hash : 1;
+}
+
+DecodedImage CookedTexture::load(std::string const& image_path, u32 const settings)
+{
+    auto const file = std::make_shared<VirtualFile>();
+
+    if (!file->open(get_cooked_path(image_path)))
+        return {};
+
+    std::span<u8 const> const data = file->get_bytes();
+    CookedTextureHeader header = {};
+
+    if (data.size() < sizeof(header))
+        return {};
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, CookedTextureHeader {}.magic, sizeof(header.magic)) != 0
+        || std::memcmp(header.engine_magic, CookedTextureHeader {}.engine_magic, sizeof(header.engine_magic)) != 0)
+    {
+        std::cout << "Error. Not a cooked texture file: " << get_cooked_path(image_path) << "\n";
+        return {};
+    }
+
+    // Written by an older version of the engine or with different settings, the image is decoded and cooked again
+    if (header.version != cooked_texture_version || header.settings != settings)
+        return {};
+
+    auto const format = static_cast<TextureFormat>(header.format);
+
+    if (header.format > static_cast<u32>(TextureFormat::BC3) || header.dxgi_format != get_dxgi_format(format) || header.width == 0
+        || header.height == 0 || header.mip_map_count == 0
+        || header.mip_map_count > TextureCompression::get_level_count(header.width, header.height)
+        || sizeof(header) + TextureCompression::get_image_size(format, header.width, header.height, header.mip_map_count) > data.size())
+    {
+        std::cout << "Error. Cooked texture file is corrupted: " << get_cooked_path(image_path) << "\n";
+        return {};
+    }
+
+    // Shipped builds can leave the image out, the cooked file is all there is then.
+    // The image is only read when it was changed or only touched, ex. by a checkout. The content tells which one it was.
+    if (std::optional<AK::FileStamp> const stamp = AK::FileStamp::get(image_path); stamp.has_value() && *stamp != get_source_stamp(header))
+    {
+        u64 const cooked_source_hash = static_cast<u64>(header.source_hash_high) << 32 | header.source_hash_low;
+
+        if (hash_source(image_path) != cooked_source_hash)
+            return {};
+
+        // So the image isn't read again the next time
+        if (!file->is_packed())
+        {
+            set_source_stamp(header, *stamp);
+            static_cast<void>(AK::overwrite_file(get_cooked_path(image_path), 0, {reinterpret_cast<u8 const*>(&header), sizeof(header)}));
+        }
+    }
+
+    // Levels are uploaded from the mapped file, nothing is copied
+    DecodedImage image = {};
+    image.width = static_cast<i32>(header.width);
+    image.height = static_cast<i32>(header.height);
+    image.pixels = std::shared_ptr<u8 const>(file, data.data() + sizeof(header));
+    image.format = format;
+    image.level_count = header.mip_map_count;
+    return image;
+}
+
+bool CookedTexture::save(std::string const& image_path, DecodedImage const& image, u32 const settings)
+{
+    // Stamped before it's hashed, an image changed in between is hashed again on the next load
+    AK::FileStamp const stamp = AK::FileStamp::get(image_path).value_or(AK::FileStamp {});
+    u64 const source_hash = hash_source(image_path);
+
+    auto const width = static_cast<u32>(image.width);
+    auto const height = static_cast<u32>(image.height);
+    u64 const size = TextureCompression::get_image_size(image.format, width, height, image.level_count);
+
+    CookedTextureHeader header = {};
+    header.flags = dds_caps | dds_height | dds_width | dds_pixel_format | dds_mip_map_count;
+    header.flags |= image.format == TextureFormat::RGBA8 ? dds_pitch : dds_linear_size;
+    header.height = height;
+    header.width = width;
+    header.pitch_or_linear_size = image.format == TextureFormat::RGBA8
+                                    ? TextureCompression::get_row_pitch(image.format, width)
+                                    : static_cast<u32>(TextureCompression::get_level_size(image.format, width, height));
+    header.mip_map_count = image.level_count;
+    header.source_hash_low = static_cast<u32>(source_hash);
+    header.source_hash_high = static_cast<u32>(source_hash >> 32);
+    header.format = static_cast<u32>(image.format);
+    header.settings = settings;
+    set_source_stamp(header, stamp);
+    header.pixel_format.flags = dds_four_cc;
+    header.pixel_format.four_cc = dds_four_cc_dx10;
+    header.caps = dds_caps_texture | (image.level_count > 1 ? dds_caps_complex | dds_caps_mip_map : 0);
+    header.dxgi_format = get_dxgi_format(image.format);
+
+    // Textures are read on worker threads, two of them can cook the same texture at once
+    std::string const cooked_path = get_cooked_path(image_path);
+    std::string const temporary_path =
+        std::format("{}.{}.tmp", cooked_path, std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            std::cout << "Error. Could not create a cooked texture file: " << temporary_path << "\n";
+            return false;
+        }
+
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(image.pixels.get()), static_cast<std::streamsize>(size));
+
+        if (!file.good())
+        {
+            file.close();
+
+            std::error_code error;
+            std::filesystem::remove(temporary_path, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, cooked_path, error);
+
+    // The cooked file can be mapped by another thread reading it right now, it's written again the next time
+    if (error)
+    {
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    return true;
+}
+
+u32 CookedTexture::get_dxgi_format(TextureFormat const format)
+{
+    switch (format)
+    {
+    case TextureFormat::RGBA8:
+        return dxgi_format_r8g8b8a8_unorm_srgb;
+    case TextureFormat::BC1:
+        return dxgi_format_bc1_unorm_srgb;
+    case TextureFormat::BC3:
+        return dxgi_format_bc3_unorm_srgb;
+    default:
+        std::unreachable();
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+
+#include "AK/Types.h"
+#include "TextureLoader.h"
+
+// Cooked texture format. A DDS file with the DX10 header, holding every mipmap level of a texture in the format it's sampled in.
+// Written next to the image the first time the texture is loaded, and read instead of the image from then on.
+// Layout of a file:
+//   CookedTextureHeader - "DDS ", DDS_HEADER and DDS_HEADER_DXT10. Reserved fields of DDS_HEADER hold what the engine needs.
+//   Levels              - every mipmap level one after another, from the largest one, rows tightly packed
+// A cooked file is out of date when it was cooked with different settings, or its image was changed. The size and last write
+// time of the image are kept next to its hash, the image is only read and hashed again when they differ. Without the image on
+// disk, the cooked file is used as it is.
+// Bump the version whenever textures are cooked differently, so every cooked file is written again.
+
+u32 constexpr cooked_texture_version = 2;
+
+struct DDSPixelFormat
+{
+    u32 size = 32;
+    u32 flags = 0;
+    u32 four_cc = 0;
+    u32 rgb_bit_count = 0;
+    u32 r_bit_mask = 0;
+    u32 g_bit_mask = 0;
+    u32 b_bit_mask = 0;
+    u32 a_bit_mask = 0;
+};
+
+struct CookedTextureHeader
+{
+    char magic[4] = {'D', 'D', 'S', ' '};
+
+    // DDS_HEADER
+    u32 size = 124;
+    u32 flags = 0;
+    u32 height = 0;
+    u32 width = 0;
+    u32 pitch_or_linear_size = 0;
+    u32 depth = 0;
+    u32 mip_map_count = 0;
+    char engine_magic[4] = {'E', 'T', 'E', 'X'};
+    u32 version = cooked_texture_version;
+    // Split, so the header has no padding
+    u32 source_hash_low = 0;
+    u32 source_hash_high = 0;
+    u32 format = 0;
+    u32 settings = 0;
+    u32 source_size_low = 0;
+    u32 source_size_high = 0;
+    u32 source_write_time_low = 0;
+    u32 source_write_time_high = 0;
+    u32 reserved[1] = {};
+    DDSPixelFormat pixel_format = {};
+    u32 caps = 0;
+    u32 caps2 = 0;
+    u32 caps3 = 0;
+    u32 caps4 = 0;
+    u32 reserved2 = 0;
+
+    // DDS_HEADER_DXT10
+    u32 dxgi_format = 0;
+    u32 resource_dimension = 3;
+    u32 misc_flag = 0;
+    u32 array_size = 1;
+    u32 misc_flags2 = 0;
+};
+
+static_assert(sizeof(DDSPixelFormat) == 32);
+static_assert(sizeof(CookedTextureHeader) == 4 + 124 + 20);
+
+class CookedTexture
+{
+public:
+    // The image path is kept whole, so images that only differ in their extension don't share a cooked file.
+    [[nodiscard]] static std::string get_cooked_path(std::string const& image_path);
+
+    // Returns 0 if the image can't be read.
+    [[nodiscard]] static u64 hash_source(std::string const& image_path);
+
+    // Returns an image without pixels if the image has no cooked file, or it was cooked from a different image or with different settings.
+    // Pixels are read straight from the mapped file or archive, which stays mapped as long as they are referenced.
+    [[nodiscard]] static DecodedImage load(std::string const& image_path, u32 const settings);
+
+    // Safe to call for the same image from multiple threads, the file is written under a temporary name and renamed.
+    static bool save(std::string const& image_path, DecodedImage const& image, u32 const settings);
+
+    // DXGI_FORMAT of the format, sampled as sRGB.
+    [[nodiscard]] static u32 get_dxgi_format(TextureFormat const format);
+};
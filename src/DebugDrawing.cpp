@@ -96,7 +96,7 @@ void DebugDrawing::update()
     m_current_time += delta_time;
 
     if (m_current_time > m_lifetime)
-        entity->destroy_immediate();
+        entity->destroy();
 }
 
 void DebugDrawing::uninitialize()
@@ -20,6 +20,10 @@ BoundingBox Drawable::get_adjusted_bounding_box(glm::mat4 const& model_matrix) c
     return {};
 }
 
+void Drawable::select_lod(glm::vec3 const& camera_position, float const screen_scale)
+{
+}
+
 bool Drawable::is_particle() const
 {
     return false;
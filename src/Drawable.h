@@ -25,6 +25,10 @@ public:
     virtual void adjust_bounding_box();
     virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
+    // Called by the Renderer once per frame before anything is drawn. screen_scale is the size in pixels
+    // of something 1 unit large and 1 unit away from the camera.
+    virtual void select_lod(glm::vec3 const& camera_position, float const screen_scale);
+
     virtual bool is_particle() const;
 
     void set_glowing(bool const is_glowing);
@@ -14,8 +14,11 @@
 #include <glm/gtc/type_ptr.inl>
 #include <glm/gtx/string_cast.hpp>
 
+#include "AK/AllocationTracker.h"
+#include "AK/LinearArena.h"
 #include "AK/ScopeGuard.h"
 
+#include "Benchmark.h"
 #include "Button.h"
 #include "Camera.h"
 #include "Collider2D.h"
@@ -30,6 +33,7 @@
 #include "Ellipse.h"
 #include "Engine.h"
 #include "Entity.h"
+#include "EntityPool.h"
 #include "ExampleDynamicText.h"
 #include "ExampleUIBar.h"
 #include "Floater.h"
@@ -59,15 +63,18 @@
 #include "Game/Thanks.h"
 #include "Globals.h"
 #include "Grass.h"
+#include "HotReloader.h"
 #include "Input.h"
 #include "Light.h"
 #include "Model.h"
 #include "NowPromptTrigger.h"
+#include "PackArchive.h"
 #include "Panel.h"
 #include "Particle.h"
 #include "ParticleSystem.h"
 #include "PointLight.h"
 #include "RendererDX11.h"
+#include "ResourceManager.h"
 #include "SceneSerializer.h"
 #include "ScreenText.h"
 #include "Sound.h"
@@ -75,6 +82,7 @@
 #include "Sphere.h"
 #include "SpotLight.h"
 #include "Sprite.h"
+#include "VirtualFileSystem.h"
 #include "Water.h"
 // # Put new header here
 
@@ -121,6 +129,7 @@ std::shared_ptr<Editor> Editor::create()
     m_instance = editor;
 
     Input::input->on_set_cursor_pos_event.attach(&Editor::mouse_callback, editor);
+    HotReloader::get_instance().on_files_changed.attach(&Editor::update_assets, editor);
 
     return editor;
 }
@@ -197,6 +206,8 @@ void Editor::draw_debug_window(std::shared_ptr<EditorWindow> const& window)
     ImGui::Checkbox("Show newest logs", &m_always_newest_logs);
     ImGui::Text("Application average %.3f ms/frame", m_average_ms_per_frame);
     draw_scene_save();
+    draw_memory_stats();
+    draw_benchmarks();
 
     std::string const log_count = "Logs " + std::to_string(Debug::debug_messages.size());
     ImGui::Text(log_count.c_str());
@@ -267,6 +278,26 @@ void Editor::draw_content_browser(std::shared_ptr<EditorWindow> const& window)
 
     draw_scene_save();
 
+    // Loose files are packed, so cooked files should be written before packing. The mounted archive is unmapped while it's
+    // replaced, since mapped files can't be replaced on Windows, and mounted again whether packing worked or not.
+    if (ImGui::Button("Pack assets"))
+    {
+        auto& file_system = VirtualFileSystem::get_instance();
+        file_system.unmount(Engine::asset_directory);
+
+        if (PackArchive::build(Engine::asset_directory, Engine::asset_archive_path, m_compress_packed_assets))
+            Debug::log("Packed " + Engine::asset_directory + " into " + Engine::asset_archive_path + ".");
+        else
+            Debug::log("Could not pack " + Engine::asset_directory + " into " + Engine::asset_archive_path + ".", DebugType::Error);
+
+        static_cast<void>(file_system.mount_archive(Engine::asset_directory, Engine::asset_archive_path));
+    }
+
+    ImGui::SameLine();
+
+    // Compressed archives are smaller but every packed file has to be decompressed when it's read
+    ImGui::Checkbox("Compress", &m_compress_packed_assets);
+
     if (ImGui::CollapsingHeader("Models"))
     {
         for (auto const& asset : m_assets)
@@ -557,6 +588,7 @@ void Editor::draw_game(std::shared_ptr<EditorWindow> const& window)
     if (was_transform_changed)
     {
         entity->transform->set_model_matrix(global_model);
+        m_open_scene->mark_dirty(entity);
     }
 
     ImGui::End();
@@ -596,7 +628,7 @@ void Editor::draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window)
     auto const entities_copy = m_open_scene->entities;
     for (auto const& entity : entities_copy)
     {
-        if (!entity->transform->parent.expired())
+        if (entity->transform->has_parent())
             continue;
 
         draw_entity_recursively(entity->transform);
@@ -709,6 +741,7 @@ void Editor::entity_drag(std::shared_ptr<Entity> const& entity)
             if (auto const reparent_entity = MainScene::get_instance()->get_entity_by_guid(guid))
             {
                 reparent_entity->transform->set_parent(entity->transform);
+                m_open_scene->mark_dirty(reparent_entity);
             }
         }
 
@@ -727,6 +760,7 @@ void Editor::entity_drag(std::shared_ptr<Entity> const& entity)
             if (auto const reparent_entity = MainScene::get_instance()->get_entity_by_guid(guid))
             {
                 reparent_entity->transform->set_parent(nullptr);
+                m_open_scene->mark_dirty(reparent_entity);
             }
         }
         ImGui::EndDragDropTarget();
@@ -754,6 +788,11 @@ bool Editor::draw_entity_popup(std::shared_ptr<Entity> const& entity)
                 ImGui::CloseCurrentPopup();
             }
 
+            if (ImGui::IsItemEdited())
+            {
+                m_open_scene->mark_dirty(entity);
+            }
+
             ImGui::EndPopup();
         }
 
@@ -906,6 +945,37 @@ void Editor::load_assets()
     }
 }
 
+void Editor::update_assets(std::vector<std::string> const& changed_paths)
+{
+    for (auto const& changed_path : changed_paths)
+    {
+        std::string const normalized_path = VirtualFileSystem::normalize_path(changed_path);
+
+        std::erase_if(m_assets, [&](Asset const& asset) { return VirtualFileSystem::normalize_path(asset.path) == normalized_path; });
+
+        std::error_code error;
+
+        if (!std::filesystem::is_regular_file(changed_path, error))
+            continue;
+
+        std::string const extension = std::filesystem::path(changed_path).extension().string();
+
+        // Same directories and formats as load_assets()
+        auto const add_if_known = [&](std::string const& directory, auto const& known_formats, AssetType const type) {
+            std::string const normalized_directory = VirtualFileSystem::normalize_path(directory) + "/";
+
+            if (normalized_path.starts_with(normalized_directory) && std::ranges::find(known_formats, extension) != known_formats.end())
+                m_assets.emplace_back(changed_path, type);
+        };
+
+        add_if_known(m_content_path, m_known_model_formats, AssetType::Model);
+        add_if_known(m_scene_path, m_known_scene_formats, AssetType::Scene);
+        add_if_known(m_prefab_path, m_known_scene_formats, AssetType::Prefab);
+        add_if_known(m_textures_path, m_known_textures_formats, AssetType::Texture);
+        add_if_known(m_audio_path, m_known_audio_formats, AssetType::Audio);
+    }
+}
+
 void Editor::draw_inspector(std::shared_ptr<EditorWindow> const& window)
 {
     bool is_still_open = true;
@@ -1111,9 +1181,198 @@ void Editor::draw_inspector(std::shared_ptr<EditorWindow> const& window)
         ImGui::EndListBox();
     }
 
+    // Fields are drawn by the components themselves, so any interaction with the inspector marks the entity dirty,
+    // with its children, which components like Port edit too. Marking them when nothing has changed only means
+    // they are written again on the next save.
+    if ((ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsAnyItemActive())
+        || (ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows) && ImGui::IsMouseReleased(ImGuiMouseButton_Left)))
+    {
+        m_open_scene->mark_dirty_recursively(entity);
+    }
+
     ImGui::End();
 }
 
+void Editor::draw_benchmarks() const
+{
+    if (!ImGui::CollapsingHeader("Benchmarks"))
+        return;
+
+    if (ImGui::Button("Entity churn"))
+    {
+        Benchmark::run_entity_churn();
+    }
+
+    if (ImGui::Button("Transforms and collisions"))
+    {
+        Benchmark::run_transforms_and_collisions();
+    }
+
+    if (ImGui::Button("Entity pooling"))
+    {
+        Benchmark::run_entity_pooling();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Log pool stats"))
+    {
+        EntityPool::get_instance().log_stats();
+    }
+
+    if (ImGui::Button("Scene loading"))
+    {
+        Benchmark::run_scene_loading();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Asset loading"))
+    {
+        Benchmark::run_asset_loading();
+    }
+
+    if (ImGui::Button("Prefab instantiation"))
+    {
+        Benchmark::run_prefab_instantiation();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Parallel parsing"))
+    {
+        Benchmark::run_parallel_parsing();
+    }
+
+    if (ImGui::Button("Incremental save"))
+    {
+        Benchmark::run_incremental_save();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Async loading"))
+    {
+        Benchmark::run_async_loading();
+    }
+
+    if (ImGui::Button("Run checks"))
+    {
+        Benchmark::run_checks();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Resource collection"))
+    {
+        Benchmark::run_resource_collection();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Resource lookups"))
+    {
+        Benchmark::run_resource_lookups();
+    }
+
+    if (ImGui::Button("Model loading"))
+    {
+        Benchmark::run_model_loading();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Mesh optimization"))
+    {
+        Benchmark::run_mesh_optimization();
+    }
+
+    if (ImGui::Button("Vertex compression"))
+    {
+        Benchmark::run_vertex_compression();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("LODs"))
+    {
+        Benchmark::run_lods();
+    }
+
+    if (ImGui::Button("Texture cooking"))
+    {
+        Benchmark::run_texture_cooking();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Asset packing"))
+    {
+        Benchmark::run_asset_packing();
+    }
+
+    if (ImGui::Button("Shader cache"))
+    {
+        Benchmark::run_shader_cache();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Hot reload"))
+    {
+        Benchmark::run_hot_reload();
+    }
+
+    if (ImGui::Button("Startup"))
+    {
+        Benchmark::run_startup();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Particles"))
+    {
+        Benchmark::run_particles();
+    }
+}
+
+void Editor::draw_memory_stats() const
+{
+    if (!ImGui::CollapsingHeader("Memory"))
+        return;
+
+    auto const frame_allocations = AK::AllocationTracker::get_last_frame();
+    ImGui::Text("Heap allocations last frame: %llu (%llu bytes)", frame_allocations.count, frame_allocations.bytes);
+
+    for (u8 i = 0; i < static_cast<u8>(AK::Subsystem::Count); ++i)
+    {
+        auto const subsystem = static_cast<AK::Subsystem>(i);
+        auto const subsystem_allocations = AK::AllocationTracker::get_last_frame(subsystem);
+        ImGui::BulletText("%s: %llu (%llu bytes)", AK::AllocationTracker::get_subsystem_name(subsystem), subsystem_allocations.count,
+                          subsystem_allocations.bytes);
+    }
+
+    auto const& arena = AK::frame_arena();
+    ImGui::Text("Frame arena peak: %zu / %zu bytes, %u overflows", arena.get_high_water_mark(), arena.get_capacity(),
+                arena.get_overflow_count());
+
+    auto& resource_manager = ResourceManager::get_instance();
+    ImGui::Text("Resources: %.2f / %.2f MB", static_cast<double>(resource_manager.get_memory_usage()) / (1024.0 * 1024.0),
+                static_cast<double>(resource_manager.memory_budget_bytes) / (1024.0 * 1024.0));
+
+    if (ImGui::Button("Log resources"))
+    {
+        resource_manager.log_memory_report();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Collect resources"))
+    {
+        resource_manager.collect();
+    }
+}
+
 void Editor::draw_scene_save()
 {
     bool open_save_scene_popup = false;
@@ -1181,7 +1440,8 @@ void Editor::draw_scene_save()
 
             ImGui::CloseCurrentPopup();
 
-            Editor::load_assets();
+            if (!HotReloader::get_instance().is_running())
+                Editor::load_assets();
 
             scene_name = "scene";
         }
@@ -1192,7 +1452,8 @@ void Editor::draw_scene_save()
 
             ImGui::CloseCurrentPopup();
 
-            Editor::load_assets();
+            if (!HotReloader::get_instance().is_running())
+                Editor::load_assets();
 
             scene_name = "scene";
         }
@@ -1485,7 +1746,9 @@ void Editor::save_entity_as_prefab()
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
     scene_serializer->serialize_this_entity(m_selected_entity.lock(), m_prefab_path + m_selected_entity.lock()->name + ".txt");
 
-    load_assets();
+    // Otherwise the file watcher adds the prefab
+    if (!HotReloader::get_instance().is_running())
+        load_assets();
 }
 
 bool Editor::load_prefab(std::string const& name) const
@@ -187,6 +187,8 @@ private:
     void draw_inspector(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_save();
+    void draw_benchmarks() const;
+    void draw_memory_stats() const;
 
     void draw_entity_recursively(std::shared_ptr<Transform> const& transform);
     static void entity_drag(std::shared_ptr<Entity> const& entity);
@@ -195,6 +197,8 @@ private:
     void draw_window_menu_bar(std::shared_ptr<EditorWindow> const& window);
 
     void load_assets();
+    // Adds and removes only the changed files, called by HotReloader instead of listing every directory again.
+    void update_assets(std::vector<std::string> const& changed_paths);
     void set_style() const;
 
     void camera_input() const;
@@ -280,6 +284,7 @@ private:
     bool m_is_camera_options_locked = false;
 
     bool m_append_scene = false;
+    bool m_compress_packed_assets = false;
 
     inline static std::shared_ptr<Editor> m_instance = nullptr;
 
@@ -1,5 +1,9 @@
 #include "Engine.h"
 
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <format>
 #include <utility>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -7,17 +11,28 @@
 
 #include <miniaudio.h>
 
+#include "AK/AllocationTracker.h"
+#include "AK/LinearArena.h"
+#include "AK/TaskGraph.h"
 #include "AssetPreloader.h"
 #include "Editor.h"
+#include "Floater.h"
 #include "Game/Game.h"
+#include "Game/Ship.h"
+#include "Game/ShipSpawner.h"
 #include "Globals.h"
+#include "HotReloader.h"
 #include "Input.h"
 #include "MainScene.h"
 #include "PhysicsEngine.h"
+#include "PrefabStreamer.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
 #include "RendererGL.h"
+#include "ResourceManager.h"
 #include "SceneSerializer.h"
+#include "ShaderDX11.h"
+#include "VirtualFileSystem.h"
 #include "Window.h"
 
 #if EDITOR
@@ -30,50 +45,181 @@
 
 i32 Engine::initialize()
 {
-    if (auto const result = initialize_thirdparty_before_renderer(); result != 0)
-        return result;
+    m_startup_begin = std::chrono::steady_clock::now();
+
+    // Parts of the startup that don't depend on each other run at the same time. Everything using the window,
+    // the graphics API or ImGui runs on this thread, in the order it's added.
+    AK::TaskGraph startup = {};
+    i32 result = 0;
+
+    // Mounted before anything is loaded. Loose files still win over the archive in the editor, so assets can be edited.
+    auto const mount_task = startup.add_task(
+        "Mount assets",
+        [] {
+            if (VirtualFileSystem::get_instance().mount_archive(asset_directory, asset_archive_path))
+            {
+#if !EDITOR
+                VirtualFileSystem::get_instance().set_loose_files_enabled(false);
+#endif
+            }
 
-    switch (Renderer::renderer_api)
-    {
-    case Renderer::RendererApi::OpenGL:
-        static_cast<void>(RendererGL::create());
-        break;
-    case Renderer::RendererApi::DirectX11:
-        static_cast<void>(RendererDX11::create());
-        break;
-    default:
-        std::unreachable();
-    }
+            return true;
+        },
+        {}, true);
 
-    Renderer::get_instance()->set_vsync(enable_vsync);
+    std::vector<Font> fonts = {};
+    auto const fonts_task = startup.add_task("Add fonts", [&fonts] {
+        fonts = Renderer::add_font_resources();
+        return true;
+    });
 
-    PhysicsEngine::get_instance()->initialize();
+    // Shaders used by the previous run are compiled while the window is created, the renderer waits for them if needed
+    if (Renderer::renderer_api == Renderer::RendererApi::DirectX11)
+    {
+        startup.add_task(
+            "Warm up shader cache",
+            [] {
+                ShaderDX11::warm_up_shader_cache();
+                return true;
+            },
+            {mount_task});
+    }
 
-    if (auto const result = initialize_thirdparty_after_renderer(); result != 0)
-        return result;
+    // Stopping the game uninitializes it, running the game again initializes it again
+    startup.add_task("Initialize audio", [] { return initialize_miniaudio() == 0; });
 
+    // Opened on workers and only added to the preloader on this thread, it isn't thread-safe
     asset_preloader = AssetPreloader::create();
 
-    if (Renderer::renderer_api == Renderer::RendererApi::OpenGL)
-    {
-        InternalMeshData::initialize();
-    }
-    else if (Renderer::renderer_api == Renderer::RendererApi::DirectX11)
+    std::array<std::vector<std::pair<std::string, VirtualFile>>, preloaded_scenes.size()> preloaded_files = {};
+    std::vector<AK::TaskGraph::TaskId> preload_tasks = {};
+
+    for (size_t i = 0; i < preloaded_scenes.size(); ++i)
     {
-        InternalMeshData::initialize();
+        std::string const& scene_path = preloaded_scenes[i];
+        auto& files = preloaded_files[i];
+
+        preload_tasks.emplace_back(startup.add_task(
+            "Preload " + std::filesystem::path(scene_path).filename().string(),
+            [&scene_path, &files] {
+                if (auto file = AssetPreloader::open_asset(scene_path))
+                    files.emplace_back(scene_path, std::move(*file));
+
+                // Binary versions only exist after running SceneConverter.py
+                std::string const binary_path = SceneSerializer::get_binary_path(scene_path);
+
+                if (VirtualFileSystem::get_instance().exists(binary_path))
+                {
+                    if (auto file = AssetPreloader::open_asset(binary_path))
+                        files.emplace_back(binary_path, std::move(*file));
+                }
+
+                return true;
+            },
+            {mount_task}));
     }
 
-    // It shouldn't be done too early, that's why it's here
-    // and not eg. in Window class right after glfw window creation.
-    window->maximize_glfw_window();
+    auto const window_task = startup.add_task(
+        "Initialize window",
+        [&result] {
+            result = initialize_thirdparty_before_renderer();
+            return result == 0;
+        },
+        {mount_task}, true);
+
+    auto const renderer_task = startup.add_task(
+        "Create renderer",
+        [] {
+            switch (Renderer::renderer_api)
+            {
+            case Renderer::RendererApi::OpenGL:
+                static_cast<void>(RendererGL::create());
+                break;
+            case Renderer::RendererApi::DirectX11:
+                static_cast<void>(RendererDX11::create());
+                break;
+            default:
+                std::unreachable();
+            }
+
+            Renderer::get_instance()->set_vsync(enable_vsync);
+
+            PhysicsEngine::get_instance()->initialize();
+            return true;
+        },
+        {window_task}, true);
+
+    auto const imgui_task = startup.add_task(
+        "Initialize ImGui",
+        [&result] {
+            result = initialize_thirdparty_after_renderer();
+            return result == 0;
+        },
+        {renderer_task}, true);
+
+    auto const meshes_task = startup.add_task(
+        "Create internal meshes",
+        [] {
+            InternalMeshData::initialize();
+
+            // It shouldn't be done too early, that's why it's here
+            // and not eg. in Window class right after glfw window creation.
+            window->maximize_glfw_window();
+            return true;
+        },
+        {imgui_task}, true);
 
 #if EDITOR
-    m_editor = Editor::Editor::create();
+    auto const editor_task = startup.add_task(
+        "Create editor",
+        [] {
+            m_editor = Editor::Editor::create();
+            return true;
+        },
+        {meshes_task}, true);
+#else
+    auto const editor_task = meshes_task;
 #endif
 
-    Renderer::get_instance()->initialize();
-
-    return 0;
+    auto const renderer_initialize_task = startup.add_task(
+        "Initialize renderer",
+        [] {
+            Renderer::get_instance()->initialize();
+            return true;
+        },
+        {editor_task}, true);
+
+    startup.add_task(
+        "Load fonts",
+        [&fonts] {
+            Renderer::set_loaded_fonts(std::move(fonts));
+            return true;
+        },
+        {fonts_task, renderer_initialize_task}, true);
+
+    startup.add_task(
+        "Add preloaded files",
+        [&preloaded_files] {
+            for (size_t i = 0; i < preloaded_scenes.size(); ++i)
+            {
+                if (preloaded_files[i].empty())
+                    Debug::log("Could not open an asset file: " + preloaded_scenes[i] + "\n", DebugType::Error);
+
+                for (auto& [path, file] : preloaded_files[i])
+                    asset_preloader->add_asset(path, std::move(file));
+            }
+
+            return true;
+        },
+        preload_tasks, true);
+
+    // Failed tasks are marked in the report, only the ones setting the result stop the engine
+    startup.run();
+
+    startup_report = startup.get_report("Startup");
+    Debug::log(startup_report);
+
+    return result;
 }
 
 void Engine::create_game()
@@ -81,25 +227,15 @@ void Engine::create_game()
     auto const main_scene = std::make_shared<Scene>();
     MainScene::set_instance(main_scene);
 
-    asset_preloader->preload_text_asset("./res/scenes/MainScene.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_0.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_1.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_2.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_3.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_4.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_5.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_6.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipBig.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipMedium.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipPirates.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipSmall.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipTool.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Customer.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Keeper.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Buoy.txt");
+    // Ships are moved before floaters adjust them to the waves, spawners tick before what they spawn
+    main_scene->declare_update_dependency<ShipSpawner, Ship>();
+    main_scene->declare_update_dependency<Ship, Floater>();
 
 #if EDITOR
     m_editor->set_scene(main_scene);
+
+    // Only the editor reads loose files, shipped builds read packed ones
+    HotReloader::get_instance().start(asset_directory);
 #endif
 
     // Custom initialization code
@@ -151,6 +287,10 @@ void Engine::run()
         delta_time = current_frame - last_frame;
         last_frame = current_frame;
 
+        // Temporaries from the previous frame are no longer in use
+        AK::frame_arena().reset();
+        AK::AllocationTracker::begin_frame();
+
         glfwPollEvents();
         Input::input->update_keys();
 
@@ -173,19 +313,45 @@ void Engine::run()
         m_editor->set_docking_space();
         ImGuizmo::BeginFrame();
 
-        m_editor->handle_input();
-        m_editor->draw();
+        {
+            AK::AllocationScope editor_scope(AK::Subsystem::Editor);
+            m_editor->handle_input();
+            m_editor->draw();
+        }
+
+        {
+            AK::AllocationScope resources_scope(AK::Subsystem::Renderer);
+            HotReloader::get_instance().update();
+        }
 #endif
 
+        {
+            AK::AllocationScope resources_scope(AK::Subsystem::Renderer);
+            ResourceManager::get_instance().update();
+        }
+
         Renderer::get_instance()->begin_frame();
 
         if (m_is_game_running && !m_is_game_paused)
         {
-            PhysicsEngine::get_instance()->update_physics();
+            {
+                AK::AllocationScope streaming_scope(AK::Subsystem::Scene);
+                PrefabStreamer::get_instance().update();
+            }
+
+            {
+                AK::AllocationScope physics_scope(AK::Subsystem::Physics);
+                PhysicsEngine::get_instance()->update_physics();
+            }
+
+            AK::AllocationScope scene_scope(AK::Subsystem::Scene);
             MainScene::get_instance()->run_frame();
         }
 
-        Renderer::get_instance()->render();
+        {
+            AK::AllocationScope renderer_scope(AK::Subsystem::Renderer);
+            Renderer::get_instance()->render();
+        }
 
         Renderer::get_instance()->end_frame();
 
@@ -216,11 +382,26 @@ void Engine::run()
         }
 
         Renderer::get_instance()->present();
+
+        if (!m_is_first_frame_presented)
+        {
+            m_is_first_frame_presented = true;
+
+            double const first_frame_ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_startup_begin).count();
+            Debug::log(std::format("Startup: first frame presented {:.2f} ms after start.", first_frame_ms));
+        }
     }
 }
 
 void Engine::clean_up()
 {
+#if EDITOR
+    HotReloader::get_instance().stop();
+#endif
+
+    uninitialize_miniaudio();
+
     Renderer::get_instance()->uninitialize();
 
     switch (Renderer::renderer_api)
@@ -400,6 +581,9 @@ void Engine::setup_imgui(GLFWwindow* glfw_window)
 
 i32 Engine::initialize_miniaudio()
 {
+    if (m_is_audio_initialized)
+        return 0;
+
     ma_engine_config config = ma_engine_config_init();
     config.channels = 2;
     config.sampleRate = 48000;
@@ -410,10 +594,15 @@ i32 Engine::initialize_miniaudio()
 
     ma_device_set_master_volume(audio_engine.pDevice, 0.2f);
 
+    m_is_audio_initialized = true;
     return 0;
 }
 
 void Engine::uninitialize_miniaudio()
 {
+    if (!m_is_audio_initialized)
+        return;
+
     ma_engine_uninit(&audio_engine);
+    m_is_audio_initialized = false;
 }
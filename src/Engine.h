@@ -9,7 +9,10 @@
 
 #include <miniaudio.h>
 
+#include <array>
+#include <chrono>
 #include <memory>
+#include <string>
 
 #include "AK/Types.h"
 #include "EngineDefines.h"
@@ -47,6 +50,33 @@ public:
 
     inline static std::shared_ptr<AssetPreloader> asset_preloader;
 
+    // Packed from the asset directory by the editor, and mounted in its place when it exists
+    inline static std::string const asset_directory = "./res";
+    inline static std::string const asset_archive_path = "./res.pak";
+
+    // Mapped into memory at startup, so scenes and levels are loaded without waiting for the disk
+    inline static std::array<std::string, 16> const preloaded_scenes = {
+        "./res/scenes/MainScene.txt",
+        "./res/prefabs/Level_0.txt",
+        "./res/prefabs/Level_1.txt",
+        "./res/prefabs/Level_2.txt",
+        "./res/prefabs/Level_3.txt",
+        "./res/prefabs/Level_4.txt",
+        "./res/prefabs/Level_5.txt",
+        "./res/prefabs/Level_6.txt",
+        "./res/prefabs/ShipBig.txt",
+        "./res/prefabs/ShipMedium.txt",
+        "./res/prefabs/ShipPirates.txt",
+        "./res/prefabs/ShipSmall.txt",
+        "./res/prefabs/ShipTool.txt",
+        "./res/prefabs/Customer.txt",
+        "./res/prefabs/Keeper.txt",
+        "./res/prefabs/Buoy.txt",
+    };
+
+    // Timeline of the tasks run by initialize(), with when every one of them began and ended
+    inline static std::string startup_report = {};
+
 private:
     static i32 initialize_thirdparty_before_renderer();
     static i32 initialize_thirdparty_after_renderer();
@@ -64,5 +94,9 @@ private:
 
     inline static bool m_is_game_running = false;
     inline static bool m_is_game_paused = false;
+    inline static bool m_is_audio_initialized = false;
+
+    inline static std::chrono::steady_clock::time_point m_startup_begin = {};
+    inline static bool m_is_first_frame_presented = false;
     inline static std::shared_ptr<Editor::Editor> m_editor;
 };
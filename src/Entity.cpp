@@ -1,31 +1,38 @@
 #include "Entity.h"
 
 #include "AK/AK.h"
+#include "AK/PoolAllocator.h"
 #include "Engine.h"
 #include "MainScene.h"
 
 Entity::Entity(AK::Badge<Entity>, std::string const& name) : name(std::move(name))
 {
+    m_handle = AK::HandleRegistry<Entity>::get_instance().add(this);
+}
+
+Entity::~Entity()
+{
+    AK::HandleRegistry<Entity>::get_instance().remove(m_handle);
 }
 
 std::shared_ptr<Entity> Entity::create(std::string const& name)
 {
-    auto entity = std::make_shared<Entity>(AK::Badge<Entity> {}, name);
+    auto entity = std::allocate_shared<Entity>(AK::PoolAllocator<Entity> {}, AK::Badge<Entity> {}, name);
     entity->guid = AK::generate_guid();
     std::hash<std::string> constexpr hasher;
     entity->hashed_guid = hasher(entity->guid);
-    entity->transform = std::make_shared<Transform>(entity);
+    entity->transform = std::allocate_shared<Transform>(AK::PoolAllocator<Transform> {}, entity);
     MainScene::get_instance()->add_child(entity);
     return entity;
 }
 
 std::shared_ptr<Entity> Entity::create(std::string const& guid, std::string const& name)
 {
-    auto entity = std::make_shared<Entity>(AK::Badge<Entity> {}, name);
+    auto entity = std::allocate_shared<Entity>(AK::PoolAllocator<Entity> {}, AK::Badge<Entity> {}, name);
     entity->guid = guid;
     std::hash<std::string> constexpr hasher;
     entity->hashed_guid = hasher(entity->guid);
-    entity->transform = std::make_shared<Transform>(entity);
+    entity->transform = std::allocate_shared<Transform>(AK::PoolAllocator<Transform> {}, entity);
     MainScene::get_instance()->add_child(entity);
     return entity;
 }
@@ -33,14 +40,44 @@ std::shared_ptr<Entity> Entity::create(std::string const& guid, std::string cons
 // Entity that is not tied to any scene
 std::shared_ptr<Entity> Entity::create_internal(std::string const& name)
 {
-    auto entity = std::make_shared<Entity>(AK::Badge<Entity> {}, name);
+    auto entity = std::allocate_shared<Entity>(AK::PoolAllocator<Entity> {}, AK::Badge<Entity> {}, name);
     entity->guid = AK::generate_guid();
     std::hash<std::string> constexpr hasher;
     entity->hashed_guid = hasher(entity->guid);
-    entity->transform = std::make_shared<Transform>(entity);
+    entity->transform = std::allocate_shared<Transform>(AK::PoolAllocator<Transform> {}, entity);
     return entity;
 }
 
+void Entity::destroy()
+{
+    MainScene::get_instance()->destroy_deferred(shared_from_this());
+}
+
+void Entity::release_to_pool()
+{
+    MainScene::get_instance()->release_to_pool_deferred(shared_from_this());
+}
+
+bool Entity::is_pooled() const
+{
+    return !m_pool_key.empty();
+}
+
+AK::Handle<Entity> Entity::get_handle() const
+{
+    return m_handle;
+}
+
+u32 Entity::get_version() const
+{
+    return m_version;
+}
+
+void Entity::increment_version()
+{
+    m_version += 1;
+}
+
 void Entity::destroy_immediate()
 {
     for (u32 i = 0; i < components.size(); ++i)
@@ -79,7 +116,7 @@ void Entity::destroy_immediate()
         child->entity.lock()->destroy_immediate();
     }
 
-    if (!transform->parent.expired())
+    if (transform->has_parent())
     {
         transform->set_parent(nullptr);
     }
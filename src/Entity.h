@@ -1,6 +1,8 @@
 #pragma once
 
 #include "AK/Badge.h"
+#include "AK/Handle.h"
+#include "AK/SlotMap.h"
 #include "Component.h"
 #include "Drawable.h"
 #include "MainScene.h"
@@ -10,6 +12,11 @@ class Entity : public std::enable_shared_from_this<Entity>
 {
 public:
     explicit Entity(AK::Badge<Entity>, std::string const& name);
+    ~Entity();
+
+    Entity(Entity const&) = delete;
+    Entity& operator=(Entity const&) = delete;
+
     static std::shared_ptr<Entity> create(std::string const& name = "Entity");
     static std::shared_ptr<Entity> create(std::string const& guid, std::string const& name);
 
@@ -18,12 +25,29 @@ public:
 
     void destroy_immediate();
 
+    // Entity will be destroyed at the next sync point of the scene. Safe to call during the update, including parallel updates.
+    void destroy();
+
+    // Entity acquired from the EntityPool goes back to the pool at the next sync point of the scene, any other entity is destroyed.
+    // Safe to call during the update, including parallel updates.
+    void release_to_pool();
+
+    [[nodiscard]] bool is_pooled() const;
+
+    [[nodiscard]] AK::Handle<Entity> get_handle() const;
+
+    // Changes whenever a component is added or removed. Fields of components aren't tracked, whoever edits them
+    // marks the entity dirty in its scene.
+    [[nodiscard]] u32 get_version() const;
+    void increment_version();
+
     template<class T>
     std::shared_ptr<T> add_component()
     {
         auto component = std::make_shared<T>();
         components.emplace_back(component);
         component->entity = shared_from_this();
+        m_version += 1;
 
         MainScene::get_instance()->add_component_to_start(component);
 
@@ -62,6 +86,7 @@ public:
     {
         components.emplace_back(component);
         component->entity = shared_from_this();
+        m_version += 1;
 
         MainScene::get_instance()->add_component_to_start(component);
 
@@ -101,6 +126,7 @@ public:
         auto component = std::make_shared<T>(std::forward<TArgs>(args)...);
         components.emplace_back(component);
         component->entity = shared_from_this();
+        m_version += 1;
 
         MainScene::get_instance()->add_component_to_start(component);
 
@@ -141,6 +167,7 @@ public:
     {
         components.emplace_back(component);
         component->entity = shared_from_this();
+        m_version += 1;
 
         // Initialization for internal components
         component->initialize();
@@ -187,5 +214,12 @@ private:
     std::string m_parent_guid; // NOTE: Only for serialization
     bool m_is_being_deserialized = false;
 
+    AK::Handle<Entity> m_handle = {};
+    AK::SlotKey m_scene_slot = {};
+    u32 m_version = 0;
+    std::string m_pool_key = {};
+
+    friend class EntityPool;
+    friend class Scene;
     friend class SceneSerializer;
 };
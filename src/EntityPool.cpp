@@ -0,0 +1,152 @@
+#include "EntityPool.h"
+
+#include <format>
+
+#include "Debug.h"
+#include "Entity.h"
+#include "MainScene.h"
+#include "SceneSerializer.h"
+
+EntityPool& EntityPool::get_instance()
+{
+    static EntityPool instance;
+    return instance;
+}
+
+std::shared_ptr<Entity> EntityPool::acquire(std::string const& key, std::function<std::shared_ptr<Entity>()> const& factory)
+{
+    Pool& pool = m_pools[key];
+
+    while (!pool.available.empty())
+    {
+        PooledEntity pooled = std::move(pool.available.back());
+        pool.available.pop_back();
+
+        // Dormant entity could have been destroyed in the meantime, ex. together with its parent
+        if (!MainScene::get_instance()->contains(pooled.entity))
+            continue;
+
+        for (auto const& state : pooled.states)
+        {
+            if (state.component->entity == nullptr)
+                continue;
+
+            state.component->on_recycled();
+            state.component->set_enabled(state.enabled);
+            state.component->set_can_tick(state.can_tick);
+        }
+
+        pool.stats.hits += 1;
+        return pooled.entity;
+    }
+
+    pool.stats.misses += 1;
+
+    auto const entity = factory();
+
+    if (entity != nullptr)
+        entity->m_pool_key = key;
+
+    return entity;
+}
+
+std::shared_ptr<Entity> EntityPool::acquire_prefab(std::string const& prefab_name)
+{
+    return acquire(prefab_name, [&prefab_name] { return SceneSerializer::load_prefab(prefab_name); });
+}
+
+void EntityPool::prewarm(std::string const& key, u32 const count, std::function<std::shared_ptr<Entity>()> const& factory)
+{
+    if (!MainScene::get_instance()->is_running)
+    {
+        Debug::log("Entity pool can only be prewarmed in a running scene.", DebugType::Warning);
+        return;
+    }
+
+    std::vector<std::shared_ptr<Entity>> entities = {};
+    entities.reserve(count);
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        auto const entity = factory();
+
+        if (entity == nullptr)
+            continue;
+
+        entity->m_pool_key = key;
+        entities.emplace_back(entity);
+    }
+
+    for (auto const& entity : entities)
+    {
+        release_immediate(entity);
+    }
+
+    // Prewarming is not a part of the gameplay, so it shouldn't skew the hit ratio
+    m_pools[key].stats.releases -= static_cast<u32>(entities.size());
+}
+
+void EntityPool::release_immediate(std::shared_ptr<Entity> const& entity)
+{
+    if (entity->m_pool_key.empty())
+    {
+        entity->destroy_immediate();
+        return;
+    }
+
+    PooledEntity pooled = {};
+    pooled.entity = entity;
+    gather_component_states(entity, pooled.states);
+
+    for (auto const& state : pooled.states)
+    {
+        state.component->set_can_tick(false);
+        state.component->set_enabled(false);
+    }
+
+    Pool& pool = m_pools[entity->m_pool_key];
+    pool.stats.releases += 1;
+    pool.available.emplace_back(std::move(pooled));
+}
+
+EntityPoolStats EntityPool::get_stats(std::string const& key) const
+{
+    auto const it = m_pools.find(key);
+
+    if (it == m_pools.end())
+        return {};
+
+    EntityPoolStats stats = it->second.stats;
+    stats.available = static_cast<u32>(it->second.available.size());
+    return stats;
+}
+
+void EntityPool::log_stats() const
+{
+    for (auto const& [key, pool] : m_pools)
+    {
+        u32 const requests = pool.stats.hits + pool.stats.misses;
+        float const hit_ratio = requests > 0 ? static_cast<float>(pool.stats.hits) / static_cast<float>(requests) : 0.0f;
+
+        Debug::log(std::format("Entity pool {}: {} hits, {} misses ({:.1f}% hit ratio), {} releases, {} available.", key, pool.stats.hits,
+                               pool.stats.misses, hit_ratio * 100.0f, pool.stats.releases, pool.available.size()));
+    }
+}
+
+void EntityPool::clear()
+{
+    m_pools.clear();
+}
+
+void EntityPool::gather_component_states(std::shared_ptr<Entity> const& entity, std::vector<ComponentState>& states)
+{
+    for (auto const& component : entity->components)
+    {
+        states.emplace_back(component, component->enabled(), component->get_can_tick());
+    }
+
+    for (auto const& child : entity->transform->children)
+    {
+        gather_component_states(child->entity.lock(), states);
+    }
+}
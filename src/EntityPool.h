@@ -0,0 +1,79 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AK/Types.h"
+
+class Component;
+class Entity;
+
+struct EntityPoolStats
+{
+    u32 hits = 0;
+    u32 misses = 0;
+    u32 releases = 0;
+    u32 available = 0;
+};
+
+// How EntityPool works:
+//
+// 1. acquire() returns a dormant entity hierarchy from the pool under a given key (hit), or creates a new one with the factory (miss).
+// 2. Instead of being destroyed, the entity is released back to the pool with Entity::release_to_pool().
+//    Released entities stay in the scene, but every component in the hierarchy is disabled and can't tick.
+// 3. On reuse, every component gets on_recycled() and its enabled and tickable state from before the release is restored.
+//    Awake and Start are never called again, so components have to reset their per-use state in on_recycled().
+class EntityPool
+{
+public:
+    EntityPool(EntityPool const&) = delete;
+    void operator=(EntityPool const&) = delete;
+    ~EntityPool() = default;
+
+    static EntityPool& get_instance();
+
+    std::shared_ptr<Entity> acquire(std::string const& key, std::function<std::shared_ptr<Entity>()> const& factory);
+    std::shared_ptr<Entity> acquire_prefab(std::string const& prefab_name);
+
+    // Creates entities up front, so that the first acquires are hits. Needs a running scene, because entities are released
+    // right after they were created and Awake has to be called before that.
+    void prewarm(std::string const& key, u32 const count, std::function<std::shared_ptr<Entity>()> const& factory);
+
+    // Entity that wasn't acquired from the pool is destroyed instead.
+    void release_immediate(std::shared_ptr<Entity> const& entity);
+
+    [[nodiscard]] EntityPoolStats get_stats(std::string const& key) const;
+    void log_stats() const;
+
+    // Drops every dormant entity. Dormant entities are still a part of the scene, so they will be destroyed together with it.
+    void clear();
+
+private:
+    EntityPool() = default;
+
+    struct ComponentState
+    {
+        std::shared_ptr<Component> component = {};
+        bool enabled = false;
+        bool can_tick = false;
+    };
+
+    struct PooledEntity
+    {
+        std::shared_ptr<Entity> entity = {};
+        std::vector<ComponentState> states = {};
+    };
+
+    struct Pool
+    {
+        std::vector<PooledEntity> available = {};
+        EntityPoolStats stats = {};
+    };
+
+    static void gather_component_states(std::shared_ptr<Entity> const& entity, std::vector<ComponentState>& states);
+
+    std::unordered_map<std::string, Pool> m_pools = {};
+};
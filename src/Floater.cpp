@@ -84,3 +84,8 @@ void Floater::update()
 
     entity->transform->set_euler_angles(glm::vec3(euler.x, current_rotation.y, euler.z));
 }
+
+bool Floater::is_parallel_update_safe() const
+{
+    return true;
+}
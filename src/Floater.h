@@ -18,6 +18,7 @@ public:
 #endif
     virtual void awake() override;
     virtual void update() override;
+    virtual bool is_parallel_update_safe() const override;
 
     float sink = 0.01f;
 
@@ -131,7 +131,7 @@ void Customer::update()
             }
             if (entity->transform->get_position().y <= desired_height - 5.0f)
             {
-                entity->destroy_immediate();
+                entity->destroy();
                 return;
             }
         }
@@ -113,7 +113,7 @@ void EndScreen::update()
 
                 if (m_is_hiding)
                 {
-                    entity->destroy_immediate();
+                    entity->destroy();
                 }
             }
         }
@@ -1,6 +1,7 @@
 #include "GameController.h"
 
 #include "AK/Math.h"
+#include "Benchmark.h"
 #include "Clock.h"
 #include "DebugInputController.h"
 #include "Entity.h"
@@ -9,10 +10,12 @@
 #include "LevelController.h"
 #include "Path.h"
 #include "Player.h"
+#include "ResourceManager.h"
 #include "SceneSerializer.h"
 #include "ShipSpawner.h"
 
 #include <GLFW/glfw3.h>
+#include <utility>
 
 #if EDITOR
 #include <imgui.h>
@@ -95,7 +98,7 @@ void GameController::update()
 {
     if (Input::input->get_key_down(GLFW_KEY_F3))
     {
-        if (!m_move_to_next_scene)
+        if (!is_moving_to_next_scene())
         {
             GameController::get_instance()->dialog_manager.lock()->end_content();
             move_to_next_scene();
@@ -114,11 +117,31 @@ void GameController::update()
         restart_level();
     }
 
+    if (m_next_scene_load != nullptr)
+    {
+        m_transition_frame_times_ms.emplace_back(delta_time * 1000.0);
+
+        // A level that couldn't be streamed is loaded like before streaming instead, so the game doesn't get stuck
+        if (m_next_scene_load->has_failed())
+        {
+            Debug::log("Could not stream level " + m_next_scene_load->get_prefab_name() + ", loading it synchronously.",
+                       DebugType::Warning);
+        }
+        else if (!m_next_scene_load->is_ready())
+        {
+            return;
+        }
+
+        begin_move_to_next_scene();
+    }
+
     if (!m_move_to_next_scene)
     {
         return;
     }
 
+    m_transition_frame_times_ms.emplace_back(delta_time * 1000.0);
+
     if (m_move_to_next_scene_counter < 1.0f)
     {
         m_move_to_next_scene_counter += delta_time * 0.75f;
@@ -131,6 +154,9 @@ void GameController::update()
 
         current_scene.lock()->destroy_immediate();
 
+        // Resources used only by the previous level
+        ResourceManager::get_instance().collect();
+
         current_scene = next_scene;
         current_scene.lock()->transform->set_local_position({0.0f, 0.0f, 0.0f});
 
@@ -139,6 +165,9 @@ void GameController::update()
         m_move_to_next_scene_counter = 0.0f;
         m_move_to_next_scene = false;
 
+        Benchmark::log_frame_times("Level transition", std::move(m_transition_frame_times_ms));
+        m_transition_frame_times_ms.clear();
+
         if (m_level_number == 4)
         {
             dialog_manager.lock()->play_content(14);
@@ -162,16 +191,16 @@ void GameController::draw_editor()
 
 bool GameController::is_moving_to_next_scene() const
 {
-    return m_move_to_next_scene;
+    return m_move_to_next_scene || m_next_scene_load != nullptr;
 }
 
-void GameController::reset_scene()
+void GameController::reset_scene(std::shared_ptr<Entity> const& scene)
 {
     m_levels_order = m_levels_backup;
 
     m_level_number = 0;
 
-    next_scene = SceneSerializer::load_prefab(m_levels_order.back());
+    next_scene = scene;
     m_levels_order.pop_back();
 
     reset_level();
@@ -209,17 +238,34 @@ void GameController::update_scenes_position() const
 
 void GameController::move_to_next_scene()
 {
+    if (is_moving_to_next_scene())
+        return;
+
+    // After the last level the game starts again from the first one
+    std::string const& level = m_levels_order.empty() ? m_levels_backup.back() : m_levels_order.back();
+
+    m_transition_frame_times_ms.clear();
+    m_next_scene_load = PrefabStreamer::get_instance().load_prefab_async(level);
+}
+
+void GameController::begin_move_to_next_scene()
+{
+    auto const load = std::exchange(m_next_scene_load, nullptr);
+
+    // Current level is destroyed first, because the next one creates its own LevelController
     LevelController::get_instance()->lighthouse.lock()->turn_light(false);
     LevelController::get_instance()->destroy_mouse_prompt();
     LevelController::get_instance()->destroy_immediate();
 
+    auto const scene = load->is_ready() ? load->instantiate() : SceneSerializer::load_prefab(load->get_prefab_name());
+
     if (m_levels_order.empty())
     {
-        reset_scene();
+        reset_scene(scene);
         return;
     }
 
-    next_scene = SceneSerializer::load_prefab(m_levels_order.back());
+    next_scene = scene;
     m_levels_order.pop_back();
 
     reset_level();
@@ -5,6 +5,7 @@
 #include "Component.h"
 #include "CustomerManager.h"
 #include "DialoguePromptController.h"
+#include "PrefabStreamer.h"
 
 #include <glm/vec2.hpp>
 
@@ -40,7 +41,8 @@ public:
     std::weak_ptr<DialoguePromptController> dialog_manager = {};
 
 private:
-    void reset_scene();
+    void begin_move_to_next_scene();
+    void reset_scene(std::shared_ptr<Entity> const& scene);
     float ease_in_out_cubic(float const x) const;
 
     void update_scenes_position() const;
@@ -50,6 +52,10 @@ private:
     bool m_move_to_next_scene = false;
     float m_move_to_next_scene_counter = 0.0f;
 
+    // Next level is loaded in the background, the transition starts when it's ready
+    std::shared_ptr<PrefabLoadHandle> m_next_scene_load = {};
+    std::vector<double> m_transition_frame_times_ms = {};
+
     glm::vec2 m_current_position = {};
     glm::vec2 m_next_position = {};
     u32 m_level_number = 0;
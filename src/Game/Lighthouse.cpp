@@ -191,8 +191,8 @@ void Lighthouse::spawn_fake_packages(u32 const packages_count, std::shared_ptr<T
         if (i > 0)
         {
             package->transform->set_parent(last_package);
-            float const x = package->transform->parent.lock()->get_local_position().x;
-            float const z = package->transform->parent.lock()->get_local_position().z;
+            float const x = package->transform->get_parent()->get_local_position().x;
+            float const z = package->transform->get_parent()->get_local_position().z;
             package->transform->set_local_position(
                 glm::vec3(glm::linearRand(-0.015f, 0.015f) - x, 0.13f, glm::linearRand(-0.02f, 0.02f) - z));
         }
@@ -456,8 +456,8 @@ void LighthouseKeeper::add_package()
     if (packages.size() > 0)
     {
         package->transform->set_parent(packages.back().lock()->transform);
-        float x = package->transform->parent.lock()->get_local_position().x;
-        float z = package->transform->parent.lock()->get_local_position().z;
+        float x = package->transform->get_parent()->get_local_position().x;
+        float z = package->transform->get_parent()->get_local_position().z;
         package->transform->set_local_position(glm::vec3(glm::linearRand(-0.015f, 0.015f) - x, 0.13f, glm::linearRand(-0.02f, 0.02f) - z));
     }
     else
@@ -58,7 +58,7 @@ void Popup::update()
 
             if (m_is_hiding)
             {
-                entity->destroy_immediate();
+                entity->destroy();
             }
         }
     }
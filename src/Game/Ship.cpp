@@ -350,7 +350,7 @@ void Ship::destroyed_behavior()
     }
     else
     {
-        entity->destroy_immediate();
+        entity->destroy();
     }
 }
 
@@ -375,7 +375,7 @@ void Ship::collected_by_keeper_behavior()
     }
     else
     {
-        entity->destroy_immediate();
+        entity->destroy();
     }
 }
 
@@ -383,7 +383,7 @@ void Ship::update()
 {
     if (is_out_of_room())
     {
-        entity->destroy_immediate();
+        entity->destroy();
         return;
     }
 
@@ -0,0 +1,128 @@
+#include "HotReloader.h"
+
+#include <algorithm>
+#include <format>
+
+#include "AssetPreloader.h"
+#include "Debug.h"
+#include "Engine.h"
+#include "Renderer.h"
+#include "ResourceManager.h"
+#include "SceneSerializer.h"
+
+HotReloader& HotReloader::get_instance()
+{
+    static HotReloader instance;
+    return instance;
+}
+
+bool HotReloader::start(std::string const& directory)
+{
+    m_pending_changes.clear();
+
+    if (!m_file_watcher.start(directory))
+    {
+        Debug::log("Hot reload: could not watch " + directory + ".", DebugType::Error);
+        return false;
+    }
+
+    Debug::log(std::format("Hot reload: watching {} {}.", directory, m_file_watcher.is_native() ? "with OS notifications" : "by polling"));
+    return true;
+}
+
+void HotReloader::stop()
+{
+    m_file_watcher.stop();
+    m_pending_changes.clear();
+}
+
+bool HotReloader::is_running() const
+{
+    return m_file_watcher.is_running();
+}
+
+void HotReloader::update()
+{
+    // The frame that showed the last batch was presented since then
+    if (!m_is_last_batch_reported)
+    {
+        m_is_last_batch_reported = true;
+
+        auto const on_screen_ms =
+            std::chrono::duration<double, std::milli>(std::filesystem::file_time_type::clock::now() - m_last_batch_save_time).count();
+
+        Debug::log(std::format("Hot reload: {} files changed, reloaded {} shaders, {} textures, {} models and {} prefabs in {:.2f} ms, "
+                               "on screen {:.0f} ms after saving.",
+                               m_last_batch.changed_file_count, m_last_batch.shader_count, m_last_batch.texture_count,
+                               m_last_batch.model_count, m_last_batch.prefab_count, m_last_batch.reload_ms, on_screen_ms));
+    }
+
+    if (!m_file_watcher.is_running())
+        return;
+
+    auto const now = std::chrono::steady_clock::now();
+
+    for (auto& path : m_file_watcher.take_changes())
+    {
+        auto const it = std::ranges::find(m_pending_changes, path, &PendingChange::path);
+
+        if (it != m_pending_changes.end())
+            it->time = now;
+        else
+            m_pending_changes.emplace_back(PendingChange {std::move(path), now});
+    }
+
+    std::vector<std::string> changed_paths = {};
+    auto const settle_delay = std::chrono::duration<double, std::milli>(settle_delay_ms);
+
+    std::erase_if(m_pending_changes, [&](PendingChange& change) {
+        if (now - change.time < settle_delay)
+            return false;
+
+        changed_paths.emplace_back(std::move(change.path));
+        return true;
+    });
+
+    if (changed_paths.empty())
+        return;
+
+    // Removed files have no time, the latest save is the one that made the batch visible
+    std::filesystem::file_time_type save_time = {};
+
+    for (auto const& path : changed_paths)
+    {
+        std::error_code error;
+        auto const write_time = std::filesystem::last_write_time(path, error);
+
+        if (!error)
+            save_time = std::max(save_time, write_time);
+    }
+
+    m_last_batch = reload(changed_paths);
+    m_last_batch_save_time = save_time != std::filesystem::file_time_type {} ? save_time : std::filesystem::file_time_type::clock::now();
+    m_is_last_batch_reported = false;
+}
+
+HotReloadStats HotReloader::reload(std::vector<std::string> const& changed_paths)
+{
+    HotReloadStats stats = {};
+    stats.changed_file_count = static_cast<u32>(changed_paths.size());
+
+    auto const begin = std::chrono::high_resolution_clock::now();
+
+    on_files_changed(changed_paths);
+
+    stats.shader_count = Renderer::get_instance()->reload_shaders(changed_paths);
+    stats.texture_count = ResourceManager::get_instance().reload_textures(changed_paths);
+    stats.model_count = Renderer::get_instance()->reload_models(changed_paths);
+
+    if (Engine::asset_preloader != nullptr)
+        stats.prefab_count += Engine::asset_preloader->reload_assets(changed_paths);
+
+    stats.prefab_count += SceneSerializer::clear_prefab_cache(changed_paths);
+
+    auto const end = std::chrono::high_resolution_clock::now();
+    stats.reload_ms = std::chrono::duration<double, std::milli>(end - begin).count();
+
+    return stats;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "AK/FileWatcher.h"
+#include "AK/Types.h"
+#include "Event.h"
+
+struct HotReloadStats
+{
+    u32 changed_file_count = 0;
+    u32 shader_count = 0;
+    u32 texture_count = 0;
+    u32 model_count = 0;
+
+    // Preloaded scene and prefab files, and cached prefabs
+    u32 prefab_count = 0;
+
+    double reload_ms = 0.0;
+};
+
+// Reloads assets while the engine runs, when their files change on the disk.
+// Changes are noticed by AK::FileWatcher on a background thread, and applied in batches on the main thread by update(),
+// once a file didn't change for settle_delay_ms, so files that are still being written aren't read.
+// Only what was read from the changed files is reloaded: shaders including them, textures, models, and preloaded and cached prefabs.
+// Resources are swapped in place, so everything using them shows the new version on the next frame.
+class HotReloader
+{
+public:
+    HotReloader(HotReloader const&) = delete;
+    void operator=(HotReloader const&) = delete;
+
+    static HotReloader& get_instance();
+
+    bool start(std::string const& directory);
+    void stop();
+
+    [[nodiscard]] bool is_running() const;
+
+    // Called once per frame on the main thread. Logs how long every batch took from saving its files until the frame
+    // showing them was presented, on the frame after it.
+    void update();
+
+    // Reloads everything read from any of the files right away. Only call it from the main thread.
+    HotReloadStats reload(std::vector<std::string> const& changed_paths);
+
+    // Called with every batch of changed files before anything is reloaded, including files that were created or removed.
+    Event<void(std::vector<std::string> const&)> on_files_changed;
+
+    double settle_delay_ms = 50.0;
+
+private:
+    HotReloader() = default;
+
+    struct PendingChange
+    {
+        std::string path = {};
+        std::chrono::steady_clock::time_point time = {};
+    };
+
+    AK::FileWatcher m_file_watcher = {};
+    std::vector<PendingChange> m_pending_changes = {};
+
+    // Batch reloaded during the last frame, and the time its first file was saved
+    HotReloadStats m_last_batch = {};
+    std::filesystem::file_time_type m_last_batch_save_time = {};
+    bool m_is_last_batch_reported = true;
+};
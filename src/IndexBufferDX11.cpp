@@ -4,18 +4,13 @@
 
 IndexBufferDX11::IndexBufferDX11(ID3D11Device* device, u32 const* data, u32 const indices_count) : m_buffer_size(indices_count)
 {
-    // Load Index Data
-    D3D11_BUFFER_DESC index_buffer_desc = {};
-    index_buffer_desc.Usage = D3D11_USAGE_DEFAULT;
-    index_buffer_desc.ByteWidth = sizeof(u32) * indices_count;
-    index_buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-    D3D11_SUBRESOURCE_DATA index_buffer_data = {};
-    index_buffer_data.pSysMem = data;
-
-    HRESULT const hr = device->CreateBuffer(&index_buffer_desc, &index_buffer_data, &m_buffer);
+    create(device, data, sizeof(u32) * indices_count);
+}
 
-    assert(SUCCEEDED(hr));
+IndexBufferDX11::IndexBufferDX11(ID3D11Device* device, u16 const* data, u32 const indices_count)
+    : m_buffer_size(indices_count), m_format(DXGI_FORMAT_R16_UINT)
+{
+    create(device, data, sizeof(u16) * indices_count);
 }
 
 IndexBufferDX11::~IndexBufferDX11()
@@ -38,3 +33,24 @@ u32 IndexBufferDX11::buffer_size() const
 {
     return m_buffer_size;
 }
+
+DXGI_FORMAT IndexBufferDX11::get_format() const
+{
+    return m_format;
+}
+
+void IndexBufferDX11::create(ID3D11Device* device, void const* data, u32 const byte_width)
+{
+    // Load Index Data
+    D3D11_BUFFER_DESC index_buffer_desc = {};
+    index_buffer_desc.Usage = D3D11_USAGE_DEFAULT;
+    index_buffer_desc.ByteWidth = byte_width;
+    index_buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+    D3D11_SUBRESOURCE_DATA index_buffer_data = {};
+    index_buffer_data.pSysMem = data;
+
+    HRESULT const hr = device->CreateBuffer(&index_buffer_desc, &index_buffer_data, &m_buffer);
+
+    assert(SUCCEEDED(hr));
+}
@@ -8,6 +8,7 @@ class IndexBufferDX11
 {
 public:
     IndexBufferDX11(ID3D11Device* device, u32 const* data, u32 const indices_count);
+    IndexBufferDX11(ID3D11Device* device, u16 const* data, u32 const indices_count);
 
     ~IndexBufferDX11();
 
@@ -17,7 +18,12 @@ public:
 
     [[nodiscard]] u32 buffer_size() const;
 
+    [[nodiscard]] DXGI_FORMAT get_format() const;
+
 private:
+    void create(ID3D11Device* device, void const* data, u32 const byte_width);
+
     ID3D11Buffer* m_buffer = nullptr;
     u32 m_buffer_size = 0;
+    DXGI_FORMAT m_format = DXGI_FORMAT_R32_UINT;
 };
@@ -1,50 +1,170 @@
 #include "Mesh.h"
 
+#include <algorithm>
+#include <glm/common.hpp>
 #include <glm/gtc/epsilon.hpp>
 #include <iostream>
 
 #include "Globals.h"
+#include "MeshOptimizer.h"
 #include "Shader.h"
 #include "Texture.h"
 #include "Vertex.h"
+#include "VertexCompression.h"
 
 Mesh::Mesh(std::vector<Vertex> const& vertices, std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-           DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
+           DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+           bool const cpu_access, std::vector<MeshLod> const& lods)
     : material(material), m_vertices(vertices), m_indices(indices), m_textures(textures), m_draw_type(draw_type),
-      m_draw_function(draw_function)
+      m_draw_function(draw_function), m_vertex_count(static_cast<u32>(vertices.size())), m_index_count(static_cast<u32>(indices.size())),
+      m_vertex_format(VertexCompression::choose_format(vertices)), m_cpu_access(cpu_access), m_lods(lods)
 {
+    if (m_lods.empty())
+        m_lods.push_back({0, m_index_count, 0.0f});
+
+    if (vertices.empty())
+        return;
+
+    glm::vec3 lowest = vertices[0].position;
+    glm::vec3 highest = vertices[0].position;
+
+    for (auto const& vertex : vertices)
+    {
+        lowest = glm::min(lowest, vertex.position);
+        highest = glm::max(highest, vertex.position);
+    }
+
+    m_local_bounds = {lowest, highest};
 }
 
-void Mesh::calculate_bounding_box()
+u32 Mesh::get_index_size() const
+{
+    return MeshOptimizer::fits_16_bit_indices(m_vertex_count) ? sizeof(u16) : sizeof(u32);
+}
+
+u32 Mesh::get_lod_count() const
+{
+    return static_cast<u32>(m_lods.size());
+}
+
+MeshLod const& Mesh::get_lod(u32 const lod) const
+{
+    return m_lods[lod];
+}
+
+u32 Mesh::select_lod(float const projected_size, u32 const current_lod) const
 {
-    if (m_vertices.empty())
+    u32 lod = std::min(current_lod, get_lod_count() - 1);
+
+    // Finer as soon as the current level is visibly wrong
+    while (lod > 0 && m_lods[lod].error * projected_size > lod_pixel_error)
+        --lod;
+
+    // Coarser only with a margin
+    while (lod + 1 < get_lod_count() && m_lods[lod + 1].error * projected_size * (1.0f + lod_hysteresis) <= lod_pixel_error)
+        ++lod;
+
+    return lod;
+}
+
+void Mesh::draw_lod(u32 const lod) const
+{
+    if (lod == 0 || m_draw_function == DrawFunctionType::NotIndexed)
+    {
+        draw();
         return;
+    }
 
-    float lowest_x = m_vertices[0].position.x;
-    float lowest_y = m_vertices[0].position.y;
-    float lowest_z = m_vertices[0].position.z;
-    float highest_x = m_vertices[0].position.x;
-    float highest_y = m_vertices[0].position.y;
-    float highest_z = m_vertices[0].position.z;
+    MeshLod const& range = m_lods[lod];
+    draw(range.index_count, reinterpret_cast<void const*>(static_cast<uintptr_t>(range.first_index) * get_index_size()));
+}
 
-    for (auto const& vertex : m_vertices)
+u32 Mesh::get_triangle_count(u32 const lod) const
+{
+    u32 const count = m_draw_function == DrawFunctionType::NotIndexed ? m_vertex_count : m_lods[lod].index_count;
+
+    switch (m_draw_type)
     {
-        if (vertex.position.x < lowest_x)
-            lowest_x = vertex.position.x;
-        if (vertex.position.y < lowest_y)
-            lowest_y = vertex.position.y;
-        if (vertex.position.z < lowest_z)
-            lowest_z = vertex.position.z;
-
-        if (vertex.position.x > highest_x)
-            highest_x = vertex.position.x;
-        if (vertex.position.y > highest_y)
-            highest_y = vertex.position.y;
-        if (vertex.position.z > highest_z)
-            highest_z = vertex.position.z;
+    case DrawType::Triangles:
+        return count / 3;
+    case DrawType::TriangleStrip:
+    case DrawType::TriangleFan:
+        return count >= 3 ? count - 2 : 0;
+    default:
+        return 0;
     }
+}
+
+BoundingBox const& Mesh::get_local_bounds() const
+{
+    return m_local_bounds;
+}
+
+VertexFormat Mesh::get_vertex_format() const
+{
+    return m_vertex_format;
+}
+
+u32 Mesh::get_vertex_count() const
+{
+    return m_vertex_count;
+}
+
+u32 Mesh::get_index_count() const
+{
+    return m_index_count;
+}
+
+bool Mesh::has_cpu_access() const
+{
+    return m_cpu_access;
+}
+
+std::vector<Vertex> const& Mesh::get_vertices() const
+{
+    return m_vertices;
+}
+
+std::vector<u32> const& Mesh::get_indices() const
+{
+    return m_indices;
+}
+
+u64 Mesh::get_memory_size() const
+{
+    u64 const buffer_size = static_cast<u64>(m_vertex_count) * VertexCompression::get_vertex_size(m_vertex_format)
+                          + static_cast<u64>(m_index_count) * get_index_size();
+
+    return buffer_size + m_vertices.capacity() * sizeof(Vertex) + m_indices.capacity() * sizeof(u32);
+}
+
+void Mesh::release_cpu_copy()
+{
+    if (m_cpu_access)
+        return;
+
+    // Swapping with empty vectors frees the memory, clear() would keep it
+    std::vector<Vertex>().swap(m_vertices);
+    std::vector<u32>().swap(m_indices);
+}
+
+std::vector<u16> Mesh::get_16_bit_indices() const
+{
+    if (get_index_size() != sizeof(u16))
+        return {};
+
+    std::vector<u16> indices(m_indices.size());
+    std::ranges::transform(m_indices, indices.begin(), [](u32 const index) { return static_cast<u16>(index); });
+
+    return indices;
+}
+
+void Mesh::calculate_bounding_box()
+{
+    if (m_vertex_count == 0)
+        return;
 
-    this->bounds = {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+    this->bounds = m_local_bounds;
 }
 
 void Mesh::adjust_bounding_box(glm::mat4 const& model_matrix)
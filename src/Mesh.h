@@ -6,6 +6,7 @@
 #include "Bounds.h"
 #include "DrawType.h"
 #include "Drawable.h"
+#include "MeshLod.h"
 #include "Texture.h"
 #include "Vertex.h"
 
@@ -25,20 +26,76 @@ public:
     void adjust_bounding_box(glm::mat4 const& model_matrix);
     [[nodiscard]] BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
+    // Size of an index in the index buffer, meshes with few enough vertices use 16-bit indices.
+    [[nodiscard]] u32 get_index_size() const;
+
+    // Levels of detail are drawn when their error, projected to the screen, is below this many pixels.
+    static float constexpr lod_pixel_error = 1.0f;
+
+    // A coarser level is only chosen once its error stays below lod_pixel_error when the mesh is this much larger,
+    // so meshes at the distance where levels switch don't flicker between them.
+    static float constexpr lod_hysteresis = 0.25f;
+
+    [[nodiscard]] u32 get_lod_count() const;
+    [[nodiscard]] MeshLod const& get_lod(u32 const lod) const;
+
+    // Level of detail for a mesh that is projected_size pixels large on the screen, measured along the diagonal of its bounds.
+    [[nodiscard]] u32 select_lod(float const projected_size, u32 const current_lod) const;
+
+    void draw_lod(u32 const lod) const;
+
+    // Triangles drawn at the level of detail, 0 for lines and points.
+    [[nodiscard]] u32 get_triangle_count(u32 const lod) const;
+
+    // Bounds of the vertices, without any transform
+    [[nodiscard]] BoundingBox const& get_local_bounds() const;
+
+    [[nodiscard]] VertexFormat get_vertex_format() const;
+    [[nodiscard]] u32 get_vertex_count() const;
+    [[nodiscard]] u32 get_index_count() const;
+
+    // Vertices and indices stay in memory after they are uploaded only for meshes created with CPU access.
+    [[nodiscard]] bool has_cpu_access() const;
+    [[nodiscard]] std::vector<Vertex> const& get_vertices() const;
+    [[nodiscard]] std::vector<u32> const& get_indices() const;
+
+    // Vertex and index buffers, and the CPU copies if the mesh keeps them.
+    [[nodiscard]] u64 get_memory_size() const;
+
     BoundingBox bounds = {};
 
     std::shared_ptr<Material> material;
 
 protected:
     Mesh(std::vector<Vertex> const& vertices, std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-         DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function);
+         DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+         bool const cpu_access, std::vector<MeshLod> const& lods);
 
     [[nodiscard]] BoundingBox calculate_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
+    // Indices converted to 16 bits if get_index_size() allows it, empty otherwise.
+    [[nodiscard]] std::vector<u16> get_16_bit_indices() const;
+
+    // Called by the backends once the buffers are created.
+    void release_cpu_copy();
+
     std::vector<Vertex> m_vertices;
     std::vector<u32> m_indices;
     std::vector<std::shared_ptr<Texture>> m_textures;
 
     DrawType m_draw_type;
     DrawFunctionType m_draw_function;
+
+    u32 m_vertex_count = 0;
+    // Indices of every level of detail together
+    u32 m_index_count = 0;
+    VertexFormat m_vertex_format = VertexFormat::Full;
+    bool m_cpu_access = false;
+
+    // Always has at least the full mesh
+    std::vector<MeshLod> m_lods = {};
+
+private:
+    // Computed once, vertices may be gone by the time bounds are needed
+    BoundingBox m_local_bounds = {};
 };
@@ -4,13 +4,16 @@
 #include <iostream>
 
 #include "RendererDX11.h"
+#include "ShaderDX11.h"
+#include "VertexCompression.h"
 #include <TextureLoader.h>
 #include <TextureLoaderDX11.h>
 
 MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                    std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
-    : Mesh(vertices, indices, textures, draw_type, material, draw_function)
+                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function, bool const cpu_access,
+                   std::vector<MeshLod> const& lods)
+    : Mesh(vertices, indices, textures, draw_type, material, draw_function, cpu_access, lods)
 {
     switch (draw_type)
     {
@@ -45,12 +48,31 @@ MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices,
 
     ID3D11Device* device = RendererDX11::get_instance_dx11()->get_device();
 
-    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size());
-    m_index_buffer = std::make_shared<IndexBufferDX11>(device, indices.data(), indices.size());
+    if (m_vertex_format == VertexFormat::Full)
+    {
+        m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size());
+    }
+    else
+    {
+        std::vector<CompactVertex> const compact_vertices = VertexCompression::compress(vertices, m_vertex_format);
+        m_vertex_buffer =
+            std::make_shared<VertexBufferDX11>(device, compact_vertices.data(), compact_vertices.size(), sizeof(CompactVertex));
+    }
+
+    if (get_index_size() == sizeof(u16))
+    {
+        std::vector<u16> const narrow_indices = get_16_bit_indices();
+        m_index_buffer = std::make_shared<IndexBufferDX11>(device, narrow_indices.data(), narrow_indices.size());
+    }
+    else
+    {
+        m_index_buffer = std::make_shared<IndexBufferDX11>(device, indices.data(), indices.size());
+    }
+
+    release_cpu_copy();
 }
 
-MeshDX11::MeshDX11(MeshDX11&& mesh) noexcept
-    : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function)
+MeshDX11::MeshDX11(MeshDX11&& mesh) noexcept : Mesh(mesh)
 {
     m_vertex_buffer = mesh.m_vertex_buffer;
     mesh.m_vertex_buffer = nullptr;
@@ -68,49 +90,67 @@ MeshDX11::~MeshDX11()
     m_vertices.clear();
     m_indices.clear();
 
-    // FIXME: Managing lifetime of models and textures should be handled in ResourceManager
-    for (auto const& texture : m_textures)
-    {
-        if (texture->image_sampler_state)
-        {
-            texture->image_sampler_state->Release();
-        }
-
-        if (texture->shader_resource_view)
-        {
-            texture->shader_resource_view->Release();
-        }
-
-        if (texture->texture_2d)
-        {
-            texture->texture_2d->Release();
-        }
-    }
-
+    // Textures are shared with other meshes, TextureLoader releases them with the last reference
     m_textures.clear();
 }
 
 void MeshDX11::draw() const
+{
+    draw(m_lods[0].index_count, nullptr);
+}
+
+void MeshDX11::draw(u32 const size, void const* offset) const
 {
     bind_textures();
 
     auto const device_context = RendererDX11::get_instance_dx11()->get_device_context();
 
-    u32 constexpr offset = 0;
+    u32 constexpr vertex_offset = 0;
     device_context->IASetPrimitiveTopology(m_primitive_topology);
-    device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
-    device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
-    device_context->DrawIndexed(m_index_buffer->buffer_size(), 0, 0);
+    device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &vertex_offset);
+    device_context->IASetIndexBuffer(m_index_buffer->get(), m_index_buffer->get_format(), 0);
 
-    unbind_textures();
-}
+    // Shaders bind the input layout of full vertices, it's restored for whatever is drawn next
+    ShaderDX11 const* shader = ShaderDX11::get_bound_shader();
+    bool const is_compact = m_vertex_format != VertexFormat::Full && shader != nullptr;
 
-void MeshDX11::draw(u32 const size, void const* offset) const
-{
+    if (is_compact)
+        device_context->IASetInputLayout(shader->get_input_layout(m_vertex_format));
+
+    // Offsets are in bytes, like in OpenGL
+    u32 const first_index = static_cast<u32>(reinterpret_cast<uintptr_t>(offset) / get_index_size());
+    device_context->DrawIndexed(size, first_index, 0);
+
+    if (is_compact)
+        device_context->IASetInputLayout(shader->get_input_layout(VertexFormat::Full));
+
+    unbind_textures();
 }
 
 void MeshDX11::draw_instanced(i32 const size) const
 {
+    bind_textures();
+
+    auto const device_context = RendererDX11::get_instance_dx11()->get_device_context();
+
+    u32 constexpr vertex_offset = 0;
+    device_context->IASetPrimitiveTopology(m_primitive_topology);
+    device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &vertex_offset);
+    device_context->IASetIndexBuffer(m_index_buffer->get(), m_index_buffer->get_format(), 0);
+
+    ShaderDX11 const* shader = ShaderDX11::get_bound_shader();
+    bool const is_compact = m_vertex_format != VertexFormat::Full && shader != nullptr;
+
+    if (is_compact)
+        device_context->IASetInputLayout(shader->get_input_layout(m_vertex_format));
+
+    // Instances read their own data from buffers bound by the renderer, by their index
+    device_context->DrawIndexedInstanced(m_lods[0].index_count, static_cast<u32>(size), 0, 0, 0);
+
+    if (is_compact)
+        device_context->IASetInputLayout(shader->get_input_layout(VertexFormat::Full));
+
+    unbind_textures();
 }
 
 void MeshDX11::bind_textures() const
@@ -12,7 +12,7 @@ class MeshDX11 final : public Mesh
 public:
     MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
              std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-             DrawFunctionType const draw_function);
+             DrawFunctionType const draw_function, bool const cpu_access, std::vector<MeshLod> const& lods);
 
     MeshDX11(MeshDX11&& mesh) noexcept;
     ~MeshDX11() override;
@@ -6,19 +6,22 @@
 
 std::shared_ptr<Mesh> MeshFactory::create(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                                           std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                                          std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
+                                          std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+                                          bool const cpu_access, std::vector<MeshLod> const& lods)
 {
     switch (Renderer::renderer_api)
     {
     case Renderer::RendererApi::OpenGL:
     {
-        auto mesh = std::make_shared<MeshGL>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
+        auto mesh = std::make_shared<MeshGL>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function,
+                                             cpu_access, lods);
         return mesh;
     }
 
     case Renderer::RendererApi::DirectX11:
     {
-        auto mesh = std::make_shared<MeshDX11>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
+        auto mesh = std::make_shared<MeshDX11>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material,
+                                               draw_function, cpu_access, lods);
         return mesh;
     }
 
@@ -20,5 +20,6 @@ private:
     static std::shared_ptr<Mesh> create(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                                         std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
                                         std::shared_ptr<Material> const& material,
-                                        DrawFunctionType const draw_function = DrawFunctionType::Indexed);
+                                        DrawFunctionType const draw_function = DrawFunctionType::Indexed,
+                                        bool const cpu_access = false, std::vector<MeshLod> const& lods = {});
 };
@@ -5,11 +5,12 @@
 
 #include "Globals.h"
 #include "Texture.h"
+#include "VertexCompression.h"
 
 MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-               DrawFunctionType const draw_function)
-    : Mesh(vertices, indices, textures, draw_type, material, draw_function)
+               DrawFunctionType const draw_function, bool const cpu_access, std::vector<MeshLod> const& lods)
+    : Mesh(vertices, indices, textures, draw_type, material, draw_function, cpu_access, lods)
 {
     switch (draw_type)
     {
@@ -48,24 +49,69 @@ MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std:
     glBindVertexArray(m_VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+    if (m_vertex_format == VertexFormat::Full)
+    {
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    }
+    else
+    {
+        std::vector<CompactVertex> const compact_vertices = VertexCompression::compress(vertices, m_vertex_format);
+        glBufferData(GL_ARRAY_BUFFER, compact_vertices.size() * sizeof(CompactVertex), compact_vertices.data(), GL_STATIC_DRAW);
+    }
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32), indices.data(), GL_STATIC_DRAW);
+
+    if (get_index_size() == sizeof(u16))
+    {
+        std::vector<u16> const narrow_indices = get_16_bit_indices();
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, narrow_indices.size() * sizeof(u16), narrow_indices.data(), GL_STATIC_DRAW);
+        m_index_type = GL_UNSIGNED_SHORT;
+    }
+    else
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32), indices.data(), GL_STATIC_DRAW);
+        m_index_type = GL_UNSIGNED_INT;
+    }
 
     // FIXME: Not all shaders have all these attributes
 
-    // Vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    if (m_vertex_format == VertexFormat::Full)
+    {
+        // Vertex positions
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
 
-    // Vertex normals
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+        // Vertex normals
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
 
-    // Vertex texture coordinates
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texture_coordinates));
+        // Vertex texture coordinates
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texture_coordinates));
+    }
+    else
+    {
+        // Compact attributes are normalized by the vertex fetch, shaders still get floats
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)0);
+
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_BYTE, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, normal));
+
+        glEnableVertexAttribArray(2);
+
+        if (m_vertex_format == VertexFormat::CompactUnitUV)
+        {
+            glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex),
+                                  (void*)offsetof(CompactVertex, texture_coordinates));
+        }
+        else
+        {
+            glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex),
+                                  (void*)offsetof(CompactVertex, texture_coordinates));
+        }
+    }
 
     if (draw_type == DrawType::Patches)
     {
@@ -75,14 +121,16 @@ MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std:
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    release_cpu_copy();
 }
 
-MeshGL::MeshGL(MeshGL&& mesh) noexcept
-    : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function)
+MeshGL::MeshGL(MeshGL&& mesh) noexcept : Mesh(mesh)
 {
     m_VAO = mesh.m_VAO;
     m_VBO = mesh.m_VBO;
     m_EBO = mesh.m_EBO;
+    m_index_type = mesh.m_index_type;
 
     mesh.m_VAO = 0;
     mesh.m_VBO = 0;
@@ -95,13 +143,10 @@ MeshGL::MeshGL(MeshGL&& mesh) noexcept
 
 MeshGL::~MeshGL()
 {
-    for (auto const& texture : m_textures)
-    {
-        glDeleteTextures(1, &texture->id);
-    }
-
     m_vertices.clear();
     m_indices.clear();
+
+    // Textures are shared with other meshes, TextureLoader releases them with the last reference
     m_textures.clear();
 
     glDeleteBuffers(1, &m_EBO);
@@ -117,9 +162,9 @@ void MeshGL::draw() const
     glBindVertexArray(m_VAO);
 
     if (m_draw_function == DrawFunctionType::NotIndexed)
-        glDrawArrays(m_draw_typeGL, 0, static_cast<i32>(m_vertices.size()));
+        glDrawArrays(m_draw_typeGL, 0, static_cast<i32>(m_vertex_count));
     else
-        glDrawElements(m_draw_typeGL, static_cast<i32>(m_indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(m_draw_typeGL, static_cast<i32>(m_lods[0].index_count), m_index_type, 0);
 
     glBindVertexArray(0);
 
@@ -134,7 +179,7 @@ void MeshGL::draw(u32 const size, void const* offset) const
 
     if (m_draw_function == DrawFunctionType::Indexed)
     {
-        glDrawElements(m_draw_typeGL, size, GL_UNSIGNED_INT, offset);
+        glDrawElements(m_draw_typeGL, size, m_index_type, offset);
     }
     else
     {
@@ -152,7 +197,7 @@ void MeshGL::draw_instanced(i32 const size) const
     bind_textures();
 
     glBindVertexArray(m_VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_INT, (void*)0, size);
+    glDrawElementsInstanced(GL_TRIANGLES, m_lods[0].index_count, m_index_type, (void*)0, size);
 
     unbind_textures();
 }
@@ -9,7 +9,7 @@ class MeshGL final : public Mesh
 public:
     MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
            std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-           DrawFunctionType const draw_function);
+           DrawFunctionType const draw_function, bool const cpu_access, std::vector<MeshLod> const& lods);
 
     MeshGL(MeshGL&& mesh) noexcept;
     ~MeshGL() override;
@@ -23,6 +23,8 @@ public:
 
 private:
     u32 m_draw_typeGL = 0;
+    // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, depending on get_index_size()
+    u32 m_index_type = 0;
 
     u32 m_VAO = 0, m_VBO = 0, m_EBO = 0;
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "AK/Types.h"
+
+// Range of the index buffer of a mesh drawn at one level of detail. All levels share the vertices of the mesh,
+// level 0 is the full mesh and every next one has fewer triangles.
+struct MeshLod
+{
+    u32 first_index = 0;
+    u32 index_count = 0;
+
+    // Largest distance the surface moved while simplifying, relative to the diagonal of the bounds of the mesh
+    float error = 0.0f;
+
+    bool operator==(MeshLod const&) const = default;
+};
+
+static_assert(sizeof(MeshLod) == 12);
@@ -0,0 +1,410 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <numeric>
+
+#include "AK/AK.h"
+#include "AK/FlatHashMap.h"
+
+namespace
+{
+
+u32 constexpr invalid_index = 0xFFFFFFFF;
+
+// Vertices are compared byte by byte, so they can't have any padding
+static_assert(sizeof(Vertex) == 8 * sizeof(float));
+
+struct VertexKey
+{
+    Vertex const* vertex = nullptr;
+
+    bool operator==(VertexKey const& other) const
+    {
+        return std::memcmp(vertex, other.vertex, sizeof(Vertex)) == 0;
+    }
+};
+
+struct VertexKeyHash
+{
+    u64 operator()(VertexKey const& key) const
+    {
+        return AK::murmur_hash64(key.vertex, sizeof(Vertex), 0);
+    }
+};
+
+// FIFO post-transform cache. A vertex is cached if it was one of the last cache_size vertices that missed.
+class VertexCache
+{
+public:
+    explicit VertexCache(size_t const vertex_count) : m_timestamps(vertex_count, 0)
+    {
+    }
+
+    // Returns true on a cache miss
+    bool access(u32 const vertex)
+    {
+        if (m_time - m_timestamps[vertex] <= MeshOptimizer::cache_size)
+            return false;
+
+        m_timestamps[vertex] = m_time;
+        m_time += 1;
+        return true;
+    }
+
+    void clear()
+    {
+        m_time += MeshOptimizer::cache_size + 1;
+    }
+
+private:
+    std::vector<u32> m_timestamps = {};
+    u32 m_time = MeshOptimizer::cache_size + 1;
+};
+
+u32 count_cache_misses(std::vector<u32> const& indices, size_t const first_triangle, size_t const end_triangle, VertexCache& cache)
+{
+    u32 misses = 0;
+
+    for (size_t i = first_triangle * 3; i < end_triangle * 3; ++i)
+    {
+        misses += cache.access(indices[i]) ? 1 : 0;
+    }
+
+    return misses;
+}
+
+}
+
+void MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<u32>& indices)
+{
+    // Lines and points are left as they are
+    if (indices.empty() || indices.size() % 3 != 0)
+        return;
+
+    weld_vertices(vertices, indices);
+
+    std::vector<u32> const clusters = optimize_vertex_cache(indices, static_cast<u32>(vertices.size()));
+    optimize_overdraw(indices, vertices, clusters);
+
+    // Last, so vertices follow the final order of triangles
+    optimize_vertex_fetch(vertices, indices);
+}
+
+void MeshOptimizer::weld_vertices(std::vector<Vertex>& vertices, std::vector<u32>& indices)
+{
+    AK::FlatHashMap<VertexKey, u32, VertexKeyHash> unique_vertices = {};
+    unique_vertices.reserve(vertices.size());
+
+    std::vector<u32> remap(vertices.size(), invalid_index);
+    std::vector<Vertex> welded_vertices = {};
+    welded_vertices.reserve(vertices.size());
+
+    for (u32 i = 0; i < vertices.size(); ++i)
+    {
+        VertexKey const key = {&vertices[i]};
+
+        if (u32 const* existing = unique_vertices.find(key); existing != nullptr)
+        {
+            remap[i] = *existing;
+            continue;
+        }
+
+        remap[i] = static_cast<u32>(welded_vertices.size());
+        unique_vertices.insert_or_assign(key, remap[i]);
+        welded_vertices.emplace_back(vertices[i]);
+    }
+
+    if (welded_vertices.size() == vertices.size())
+        return;
+
+    for (auto& index : indices)
+    {
+        index = remap[index];
+    }
+
+    vertices = std::move(welded_vertices);
+}
+
+std::vector<u32> MeshOptimizer::optimize_vertex_cache(std::vector<u32>& indices, u32 const vertex_count)
+{
+    // Tipsify, from "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" by Sander, Nehab and Barczak
+    size_t const triangle_count = indices.size() / 3;
+    std::vector<u32> clusters = {};
+
+    if (triangle_count == 0)
+        return clusters;
+
+    // Triangles of every vertex, the ones of vertex v are in adjacency[adjacency_offsets[v]..adjacency_offsets[v + 1]]
+    std::vector<u32> adjacency_offsets(vertex_count + 1, 0);
+    for (auto const index : indices)
+    {
+        adjacency_offsets[index + 1] += 1;
+    }
+
+    std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+    std::vector<u32> adjacency(indices.size());
+    std::vector<u32> fill_offsets(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        adjacency[fill_offsets[indices[i]]++] = static_cast<u32>(i / 3);
+    }
+
+    std::vector<u32> live_triangles(vertex_count);
+    for (u32 i = 0; i < vertex_count; ++i)
+    {
+        live_triangles[i] = adjacency_offsets[i + 1] - adjacency_offsets[i];
+    }
+
+    std::vector<u32> cache_timestamps(vertex_count, 0);
+    std::vector<bool> is_emitted(triangle_count, false);
+    std::vector<u32> dead_ends = {};
+    std::vector<u32> candidates = {};
+
+    std::vector<u32> result = {};
+    result.reserve(indices.size());
+
+    u32 time = cache_size + 1;
+    u32 next_unvisited = 0;
+    u32 fanning_vertex = indices[0];
+
+    clusters.emplace_back(0);
+
+    while (fanning_vertex != invalid_index)
+    {
+        candidates.clear();
+
+        // Emits every remaining triangle around the fanning vertex
+        for (u32 i = adjacency_offsets[fanning_vertex]; i < adjacency_offsets[fanning_vertex + 1]; ++i)
+        {
+            u32 const triangle = adjacency[i];
+
+            if (is_emitted[triangle])
+                continue;
+
+            for (u32 k = 0; k < 3; ++k)
+            {
+                u32 const vertex = indices[triangle * 3 + k];
+
+                result.emplace_back(vertex);
+                dead_ends.emplace_back(vertex);
+                candidates.emplace_back(vertex);
+                live_triangles[vertex] -= 1;
+
+                if (time - cache_timestamps[vertex] > cache_size)
+                {
+                    cache_timestamps[vertex] = time;
+                    time += 1;
+                }
+            }
+
+            is_emitted[triangle] = true;
+        }
+
+        // Prefers the oldest vertex that stays in the cache while all of its triangles are emitted
+        fanning_vertex = invalid_index;
+        i64 best_priority = -1;
+
+        for (auto const vertex : candidates)
+        {
+            if (live_triangles[vertex] == 0)
+                continue;
+
+            i64 priority = 0;
+            if (time - cache_timestamps[vertex] + 2 * live_triangles[vertex] <= cache_size)
+                priority = time - cache_timestamps[vertex];
+
+            if (priority > best_priority)
+            {
+                best_priority = priority;
+                fanning_vertex = vertex;
+            }
+        }
+
+        if (fanning_vertex != invalid_index)
+            continue;
+
+        // Dead end, continues with a recently used vertex or the next one with triangles left
+        while (!dead_ends.empty() && fanning_vertex == invalid_index)
+        {
+            u32 const vertex = dead_ends.back();
+            dead_ends.pop_back();
+
+            if (live_triangles[vertex] > 0)
+                fanning_vertex = vertex;
+        }
+
+        while (next_unvisited < vertex_count && fanning_vertex == invalid_index)
+        {
+            if (live_triangles[next_unvisited] > 0)
+                fanning_vertex = next_unvisited;
+
+            next_unvisited += 1;
+        }
+
+        if (fanning_vertex != invalid_index)
+            clusters.emplace_back(static_cast<u32>(result.size() / 3));
+    }
+
+    indices = std::move(result);
+    return clusters;
+}
+
+void MeshOptimizer::optimize_overdraw(std::vector<u32>& indices, std::vector<Vertex> const& vertices, std::vector<u32> const& clusters)
+{
+    size_t const triangle_count = indices.size() / 3;
+
+    if (triangle_count == 0 || clusters.empty())
+        return;
+
+    // Splits clusters where the cache miss ratio of their beginning is already close to the one of the whole cluster
+    std::vector<u32> split_clusters = {};
+    VertexCache cache(vertices.size());
+
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        size_t const begin = clusters[i];
+        size_t const end = i + 1 < clusters.size() ? clusters[i + 1] : triangle_count;
+
+        cache.clear();
+        float const cluster_acmr = static_cast<float>(count_cache_misses(indices, begin, end, cache)) / static_cast<float>(end - begin);
+
+        cache.clear();
+        split_clusters.emplace_back(static_cast<u32>(begin));
+
+        u32 misses = 0;
+        size_t split_begin = begin;
+
+        for (size_t triangle = begin; triangle < end; ++triangle)
+        {
+            misses += count_cache_misses(indices, triangle, triangle + 1, cache);
+
+            float const acmr = static_cast<float>(misses) / static_cast<float>(triangle + 1 - split_begin);
+
+            if (triangle + 1 < end && acmr <= cluster_acmr * overdraw_threshold)
+            {
+                split_begin = triangle + 1;
+                split_clusters.emplace_back(static_cast<u32>(split_begin));
+                misses = 0;
+                cache.clear();
+            }
+        }
+    }
+
+    struct Cluster
+    {
+        u32 first_triangle = 0;
+        u32 triangle_count = 0;
+        glm::vec3 centroid = {};
+        glm::vec3 normal = {};
+        float sort_key = 0.0f;
+    };
+
+    std::vector<Cluster> sorted_clusters(split_clusters.size());
+    glm::vec3 mesh_centroid = {};
+    float mesh_area = 0.0f;
+
+    for (size_t i = 0; i < split_clusters.size(); ++i)
+    {
+        Cluster& cluster = sorted_clusters[i];
+        cluster.first_triangle = split_clusters[i];
+        u32 const end = i + 1 < split_clusters.size() ? split_clusters[i + 1] : static_cast<u32>(triangle_count);
+        cluster.triangle_count = end - cluster.first_triangle;
+
+        float cluster_area = 0.0f;
+
+        for (u32 triangle = cluster.first_triangle; triangle < cluster.first_triangle + cluster.triangle_count; ++triangle)
+        {
+            glm::vec3 const& a = vertices[indices[triangle * 3 + 0]].position;
+            glm::vec3 const& b = vertices[indices[triangle * 3 + 1]].position;
+            glm::vec3 const& c = vertices[indices[triangle * 3 + 2]].position;
+
+            // Length of the cross product is twice the area of the triangle, both are weighted by it
+            glm::vec3 const normal = glm::cross(b - a, c - a);
+            float const area = glm::length(normal);
+
+            cluster.centroid += (a + b + c) * (area / 3.0f);
+            cluster.normal += normal;
+            cluster_area += area;
+        }
+
+        mesh_centroid += cluster.centroid;
+        mesh_area += cluster_area;
+
+        if (cluster_area > 0.0f)
+            cluster.centroid /= cluster_area;
+    }
+
+    if (mesh_area > 0.0f)
+        mesh_centroid /= mesh_area;
+
+    for (auto& cluster : sorted_clusters)
+    {
+        float const normal_length = glm::length(cluster.normal);
+        cluster.sort_key = normal_length > 0.0f ? glm::dot(cluster.centroid - mesh_centroid, cluster.normal / normal_length) : 0.0f;
+    }
+
+    std::ranges::stable_sort(sorted_clusters, [](Cluster const& a, Cluster const& b) { return a.sort_key > b.sort_key; });
+
+    std::vector<u32> result = {};
+    result.reserve(indices.size());
+
+    for (auto const& cluster : sorted_clusters)
+    {
+        result.insert(result.end(), indices.begin() + cluster.first_triangle * 3,
+                      indices.begin() + (cluster.first_triangle + cluster.triangle_count) * 3);
+    }
+
+    indices = std::move(result);
+}
+
+void MeshOptimizer::optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<u32>& indices)
+{
+    std::vector<u32> remap(vertices.size(), invalid_index);
+    std::vector<Vertex> result = {};
+    result.reserve(vertices.size());
+
+    for (auto& index : indices)
+    {
+        if (remap[index] == invalid_index)
+        {
+            remap[index] = static_cast<u32>(result.size());
+            result.emplace_back(vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    vertices = std::move(result);
+}
+
+MeshStatistics MeshOptimizer::analyze(std::vector<Vertex> const& vertices, std::vector<u32> const& indices)
+{
+    MeshStatistics statistics = {};
+    statistics.vertex_count = static_cast<u32>(vertices.size());
+    statistics.index_count = static_cast<u32>(indices.size());
+    statistics.vertex_bytes = vertices.size() * sizeof(Vertex);
+    statistics.index_bytes = indices.size() * (fits_16_bit_indices(vertices.size()) ? sizeof(u16) : sizeof(u32));
+
+    if (indices.size() < 3)
+        return statistics;
+
+    VertexCache cache(vertices.size());
+    u32 const misses = count_cache_misses(indices, 0, indices.size() / 3, cache);
+
+    std::vector<bool> is_used(vertices.size(), false);
+    u32 used_count = 0;
+
+    for (auto const index : indices)
+    {
+        used_count += is_used[index] ? 0 : 1;
+        is_used[index] = true;
+    }
+
+    statistics.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    statistics.atvr = static_cast<float>(misses) / static_cast<float>(used_count);
+
+    return statistics;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include "AK/Types.h"
+#include "Vertex.h"
+
+struct MeshStatistics
+{
+    u32 vertex_count = 0;
+    u32 index_count = 0;
+
+    // Average cache miss ratio, vertex shader invocations per triangle. 0.5 is the best possible for large meshes, 3 the worst.
+    float acmr = 0.0f;
+    // Average transform to vertex ratio, vertex shader invocations per vertex. 1 is the best possible.
+    float atvr = 0.0f;
+
+    u64 vertex_bytes = 0;
+    u64 index_bytes = 0;
+};
+
+// Reorders meshes for the GPU without changing how they look. Only works with indexed triangle lists.
+// Steps can be used on their own, optimize() runs all of them in the right order.
+class MeshOptimizer
+{
+public:
+    // Post-transform cache size assumed by the optimization and the statistics. Real GPUs don't have a simple FIFO cache,
+    // but meshes ordered for a small one work well on all of them.
+    static u32 constexpr cache_size = 16;
+
+    // Clusters are split further as long as their cache miss ratio doesn't grow by more than this factor.
+    static float constexpr overdraw_threshold = 1.05f;
+
+    static void optimize(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+    // Merges vertices with exactly the same attributes.
+    static void weld_vertices(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+    // Reorders triangles with Tipsify. Returns the first triangle of every cluster, triangles that don't share
+    // a vertex with the previous ones, so optimize_overdraw() can move them without breaking the cache locality.
+    static std::vector<u32> optimize_vertex_cache(std::vector<u32>& indices, u32 const vertex_count);
+
+    // Splits the clusters further and sorts them so the ones facing away from the center of the mesh are drawn first,
+    // they are the most likely to hide the others.
+    static void optimize_overdraw(std::vector<u32>& indices, std::vector<Vertex> const& vertices, std::vector<u32> const& clusters);
+
+    // Orders vertices the way triangles use them and removes the unused ones.
+    static void optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+    [[nodiscard]] static MeshStatistics analyze(std::vector<Vertex> const& vertices, std::vector<u32> const& indices);
+
+    // Every index fits in 16 bits, which halves the size of the index buffer. 0xFFFF is left out, it cuts triangle strips.
+    [[nodiscard]] static bool fits_16_bit_indices(size_t const vertex_count)
+    {
+        return vertex_count < 0xFFFF;
+    }
+};
@@ -0,0 +1,464 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <limits>
+
+#include "AK/AK.h"
+#include "AK/FlatHashMap.h"
+#include "MeshOptimizer.h"
+
+namespace
+{
+
+struct PositionKey
+{
+    glm::vec3 const* position = nullptr;
+
+    bool operator==(PositionKey const& other) const
+    {
+        return std::memcmp(position, other.position, sizeof(glm::vec3)) == 0;
+    }
+};
+
+struct PositionKeyHash
+{
+    u64 operator()(PositionKey const& key) const
+    {
+        return AK::murmur_hash64(key.position, sizeof(glm::vec3), 0);
+    }
+};
+
+// Sum of squared distances to the planes of triangles, weighted by their area. Stored as the symmetric 4x4 matrix
+// of the quadric, together with the summed weight so the error can be turned back into a squared distance.
+struct Quadric
+{
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c = 0.0;
+    double weight = 0.0;
+
+    void add_plane(glm::vec3 const& normal, float const distance, float const area)
+    {
+        double const x = normal.x;
+        double const y = normal.y;
+        double const z = normal.z;
+        double const d = distance;
+
+        a00 += area * x * x;
+        a01 += area * x * y;
+        a02 += area * x * z;
+        a11 += area * y * y;
+        a12 += area * y * z;
+        a22 += area * z * z;
+        b0 += area * x * d;
+        b1 += area * y * d;
+        b2 += area * z * d;
+        c += area * d * d;
+        weight += area;
+    }
+
+    Quadric& operator+=(Quadric const& other)
+    {
+        a00 += other.a00;
+        a01 += other.a01;
+        a02 += other.a02;
+        a11 += other.a11;
+        a12 += other.a12;
+        a22 += other.a22;
+        b0 += other.b0;
+        b1 += other.b1;
+        b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+
+        return *this;
+    }
+
+    // Average squared distance of the point to the planes
+    [[nodiscard]] double evaluate(glm::vec3 const& point) const
+    {
+        double const x = point.x;
+        double const y = point.y;
+        double const z = point.z;
+
+        double const error = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                           + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+
+        return weight > 0.0 ? std::abs(error) / weight : 0.0;
+    }
+};
+
+struct EdgeKeyHash
+{
+    u64 operator()(u64 const key) const
+    {
+        return AK::murmur_hash64(&key, sizeof(key), 0);
+    }
+};
+
+struct Collapse
+{
+    u32 from = 0;
+    u32 to = 0;
+    double cost = 0.0;
+};
+
+u64 get_edge_key(u32 const a, u32 const b)
+{
+    return static_cast<u64>(std::min(a, b)) << 32 | std::max(a, b);
+}
+
+}
+
+std::vector<MeshLod> MeshSimplifier::generate_lods(std::vector<Vertex> const& vertices, std::vector<u32>& indices)
+{
+    std::vector<MeshLod> lods = {{0, static_cast<u32>(indices.size()), 0.0f}};
+
+    if (indices.size() % 3 != 0 || indices.size() / 3 < min_lod_triangle_count)
+        return lods;
+
+    std::vector<u32> previous_indices = indices;
+    float total_error = 0.0f;
+
+    while (lods.size() < max_lod_count)
+    {
+        auto const target_index_count = static_cast<u32>(static_cast<float>(previous_indices.size() / 3) * lod_reduction) * 3;
+
+        float error = 0.0f;
+        std::vector<u32> lod_indices = simplify(vertices, previous_indices, target_index_count, max_lod_error - total_error, error);
+
+        // A level that barely has fewer triangles isn't worth the memory
+        if (lod_indices.empty() || static_cast<float>(lod_indices.size()) > static_cast<float>(previous_indices.size()) * 0.8f)
+            break;
+
+        // Every level is simplified from the previous one, so their errors add up
+        total_error += error;
+
+        static_cast<void>(MeshOptimizer::optimize_vertex_cache(lod_indices, static_cast<u32>(vertices.size())));
+
+        lods.push_back({static_cast<u32>(indices.size()), static_cast<u32>(lod_indices.size()), total_error});
+        indices.insert(indices.end(), lod_indices.begin(), lod_indices.end());
+
+        previous_indices = std::move(lod_indices);
+    }
+
+    return lods;
+}
+
+std::vector<u32> MeshSimplifier::simplify(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
+                                          u32 const target_index_count, float const max_error, float& error)
+{
+    error = 0.0f;
+
+    std::vector<u32> result = indices;
+
+    if (vertices.empty() || result.size() % 3 != 0 || result.size() <= target_index_count)
+        return result;
+
+    auto const vertex_count = static_cast<u32>(vertices.size());
+
+    // Vertices at the same position, split by their normals or texture coordinates, move together.
+    // Every vertex refers to the first one at its position, which stands for the whole group.
+    std::vector<u32> position_ids(vertex_count);
+    {
+        AK::FlatHashMap<PositionKey, u32, PositionKeyHash> unique_positions = {};
+        unique_positions.reserve(vertex_count);
+
+        for (u32 i = 0; i < vertex_count; ++i)
+        {
+            PositionKey const key = {&vertices[i].position};
+
+            if (u32 const* existing = unique_positions.find(key); existing != nullptr)
+            {
+                position_ids[i] = *existing;
+                continue;
+            }
+
+            position_ids[i] = i;
+            unique_positions.insert_or_assign(key, i);
+        }
+    }
+
+    // Vertices of every group, laid out one group after another
+    std::vector<u32> group_offsets(vertex_count + 1, 0);
+    std::vector<u32> group_vertices(vertex_count);
+
+    for (u32 i = 0; i < vertex_count; ++i)
+        group_offsets[position_ids[i] + 1] += 1;
+
+    for (u32 i = 0; i < vertex_count; ++i)
+        group_offsets[i + 1] += group_offsets[i];
+
+    {
+        std::vector<u32> group_fill(group_offsets.begin(), group_offsets.end() - 1);
+
+        for (u32 i = 0; i < vertex_count; ++i)
+            group_vertices[group_fill[position_ids[i]]++] = i;
+    }
+
+    glm::vec3 bounds_min = vertices[0].position;
+    glm::vec3 bounds_max = vertices[0].position;
+
+    for (auto const& vertex : vertices)
+    {
+        bounds_min = glm::min(bounds_min, vertex.position);
+        bounds_max = glm::max(bounds_max, vertex.position);
+    }
+
+    float const extent = glm::length(bounds_max - bounds_min);
+
+    if (extent <= 0.0f)
+        return result;
+
+    double const max_squared_error = static_cast<double>(max_error * extent) * static_cast<double>(max_error * extent);
+
+    std::vector<Quadric> quadrics(vertex_count);
+    AK::FlatHashMap<u64, u32, EdgeKeyHash> edge_use_counts = {};
+    edge_use_counts.reserve(result.size());
+
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+        u32 const corners[3] = {position_ids[result[i]], position_ids[result[i + 1]], position_ids[result[i + 2]]};
+
+        if (corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2])
+            continue;
+
+        glm::vec3 const& p0 = vertices[corners[0]].position;
+        glm::vec3 const normal = glm::cross(vertices[corners[1]].position - p0, vertices[corners[2]].position - p0);
+        float const length = glm::length(normal);
+
+        for (u32 k = 0; k < 3; ++k)
+        {
+            u64 const key = get_edge_key(corners[k], corners[(k + 1) % 3]);
+
+            if (u32* count = edge_use_counts.find(key); count != nullptr)
+                *count += 1;
+            else
+                edge_use_counts.insert_or_assign(key, 1);
+        }
+
+        if (length <= 0.0f)
+            continue;
+
+        glm::vec3 const unit_normal = normal / length;
+
+        for (u32 const corner : corners)
+            quadrics[corner].add_plane(unit_normal, -glm::dot(unit_normal, p0), length * 0.5f);
+    }
+
+    // Moving a vertex on an open or non-manifold edge would tear holes into the mesh
+    std::vector<u8> is_locked(vertex_count, 0);
+
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+        for (u32 k = 0; k < 3; ++k)
+        {
+            u32 const a = position_ids[result[i + k]];
+            u32 const b = position_ids[result[i + (k + 1) % 3]];
+
+            if (a == b)
+                continue;
+
+            if (u32 const* count = edge_use_counts.find(get_edge_key(a, b)); count != nullptr && *count != 2)
+            {
+                is_locked[a] = 1;
+                is_locked[b] = 1;
+            }
+        }
+    }
+
+    auto const is_seam = [&](u32 const id) { return group_offsets[id + 1] - group_offsets[id] > 1; };
+
+    auto const can_collapse = [&](u32 const from, u32 const to) { return is_locked[from] == 0 && (!is_seam(from) || is_seam(to)); };
+
+    // Vertex of the group of to with the closest attributes, so triangles keep their normals and texture coordinates
+    auto const find_closest_vertex = [&](u32 const vertex, u32 const to) {
+        u32 closest = to;
+        float closest_distance = std::numeric_limits<float>::max();
+
+        for (u32 i = group_offsets[to]; i < group_offsets[to + 1]; ++i)
+        {
+            Vertex const& candidate = vertices[group_vertices[i]];
+            glm::vec3 const normal_difference = candidate.normal - vertices[vertex].normal;
+            glm::vec2 const texture_coordinates_difference = candidate.texture_coordinates - vertices[vertex].texture_coordinates;
+            float const distance =
+                glm::dot(normal_difference, normal_difference) + glm::dot(texture_coordinates_difference, texture_coordinates_difference);
+
+            if (distance < closest_distance)
+            {
+                closest = group_vertices[i];
+                closest_distance = distance;
+            }
+        }
+
+        return closest;
+    };
+
+    std::vector<Collapse> collapses = {};
+    std::vector<u32> triangle_offsets(vertex_count + 1);
+    std::vector<u32> vertex_triangles = {};
+    std::vector<u32> collapse_targets(vertex_count);
+    std::vector<u8> is_touched(vertex_count);
+    double max_collapse_error = 0.0;
+
+    while (result.size() > target_index_count)
+    {
+        auto const triangle_count = static_cast<u32>(result.size() / 3);
+
+        collapses.clear();
+
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            for (u32 k = 0; k < 3; ++k)
+            {
+                u32 const a = position_ids[result[i + k]];
+                u32 const b = position_ids[result[i + (k + 1) % 3]];
+
+                // Edges are shared by two triangles, both directions are considered below
+                if (a >= b)
+                    continue;
+
+                Quadric quadric = quadrics[a];
+                quadric += quadrics[b];
+
+                Collapse collapse = {};
+                collapse.cost = std::numeric_limits<double>::max();
+
+                if (can_collapse(a, b))
+                    collapse = {a, b, quadric.evaluate(vertices[b].position)};
+
+                if (can_collapse(b, a))
+                {
+                    if (double const cost = quadric.evaluate(vertices[a].position); cost < collapse.cost)
+                        collapse = {b, a, cost};
+                }
+
+                if (collapse.cost <= max_squared_error)
+                    collapses.emplace_back(collapse);
+            }
+        }
+
+        if (collapses.empty())
+            break;
+
+        std::ranges::sort(collapses, [](Collapse const& a, Collapse const& b) { return a.cost < b.cost; });
+
+        // Triangles around every vertex, to check what a collapse does to them
+        std::ranges::fill(triangle_offsets, 0);
+
+        for (u32 const vertex : result)
+            triangle_offsets[position_ids[vertex] + 1] += 1;
+
+        for (u32 i = 0; i < vertex_count; ++i)
+            triangle_offsets[i + 1] += triangle_offsets[i];
+
+        vertex_triangles.resize(result.size());
+        {
+            std::vector<u32> triangle_fill(triangle_offsets.begin(), triangle_offsets.end() - 1);
+
+            for (u32 i = 0; i < result.size(); ++i)
+                vertex_triangles[triangle_fill[position_ids[result[i]]]++] = i / 3;
+        }
+
+        // Triangles are flipped if their normal points the other way once from moves to to
+        auto const flips_triangles = [&](u32 const from, u32 const to) {
+            for (u32 i = triangle_offsets[from]; i < triangle_offsets[from + 1]; ++i)
+            {
+                u32 const triangle = vertex_triangles[i];
+                u32 corners[3] = {position_ids[result[triangle * 3]], position_ids[result[triangle * 3 + 1]],
+                                  position_ids[result[triangle * 3 + 2]]};
+
+                // Removed by the collapse
+                if (corners[0] == to || corners[1] == to || corners[2] == to)
+                    continue;
+
+                glm::vec3 const before = glm::cross(vertices[corners[1]].position - vertices[corners[0]].position,
+                                                    vertices[corners[2]].position - vertices[corners[0]].position);
+
+                for (u32& corner : corners)
+                    corner = corner == from ? to : corner;
+
+                glm::vec3 const after = glm::cross(vertices[corners[1]].position - vertices[corners[0]].position,
+                                                   vertices[corners[2]].position - vertices[corners[0]].position);
+
+                if (glm::dot(before, after) <= 0.0f)
+                    return true;
+            }
+
+            return false;
+        };
+
+        for (u32 i = 0; i < vertex_count; ++i)
+            collapse_targets[i] = i;
+
+        std::ranges::fill(is_touched, 0);
+
+        // Every collapse removes about two triangles
+        u32 const triangles_to_remove = triangle_count - static_cast<u32>(target_index_count / 3);
+        u32 removed_triangles = 0;
+
+        for (auto const& collapse : collapses)
+        {
+            if (removed_triangles >= triangles_to_remove)
+                break;
+
+            if (is_touched[collapse.from] != 0 || is_touched[collapse.to] != 0 || flips_triangles(collapse.from, collapse.to))
+                continue;
+
+            // Triangles around from change, so none of their vertices can move again until the next pass
+            for (u32 i = triangle_offsets[collapse.from]; i < triangle_offsets[collapse.from + 1]; ++i)
+            {
+                u32 const triangle = vertex_triangles[i];
+
+                for (u32 k = 0; k < 3; ++k)
+                    is_touched[position_ids[result[triangle * 3 + k]]] = 1;
+            }
+
+            is_touched[collapse.to] = 1;
+
+            collapse_targets[collapse.from] = collapse.to;
+            quadrics[collapse.to] += quadrics[collapse.from];
+            max_collapse_error = std::max(max_collapse_error, collapse.cost);
+            removed_triangles += 2;
+        }
+
+        if (removed_triangles == 0)
+            break;
+
+        size_t write = 0;
+
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            u32 triangle[3] = {result[i], result[i + 1], result[i + 2]};
+
+            for (u32& vertex : triangle)
+            {
+                u32 const target = collapse_targets[position_ids[vertex]];
+
+                if (target != position_ids[vertex])
+                    vertex = find_closest_vertex(vertex, target);
+            }
+
+            // Triangles along collapsed edges become degenerate
+            if (position_ids[triangle[0]] == position_ids[triangle[1]] || position_ids[triangle[1]] == position_ids[triangle[2]]
+                || position_ids[triangle[0]] == position_ids[triangle[2]])
+            {
+                continue;
+            }
+
+            result[write] = triangle[0];
+            result[write + 1] = triangle[1];
+            result[write + 2] = triangle[2];
+            write += 3;
+        }
+
+        result.resize(write);
+    }
+
+    error = static_cast<float>(std::sqrt(max_collapse_error)) / extent;
+
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "AK/Types.h"
+#include "MeshLod.h"
+#include "Vertex.h"
+
+// Simplifies meshes for levels of detail by collapsing edges in the order of their quadric error.
+// Simplified meshes only use vertices of the original one, so every level of detail can share its vertex buffer.
+// Only works with indexed triangle lists.
+class MeshSimplifier
+{
+public:
+    // Every level of detail aims for this fraction of triangles of the previous one.
+    static float constexpr lod_reduction = 0.5f;
+
+    // Largest error of the coarsest level of detail, relative to the diagonal of the bounds of the mesh.
+    static float constexpr max_lod_error = 0.05f;
+
+    // Including the full mesh.
+    static u32 constexpr max_lod_count = 4;
+
+    // Meshes with fewer triangles are drawn as they are at any distance.
+    static u32 constexpr min_lod_triangle_count = 64;
+
+    // Appends the indices of every coarser level of detail to indices, each simplified from the previous one.
+    // Returns all levels including the full mesh, which is the only one if the mesh can't be simplified enough.
+    [[nodiscard]] static std::vector<MeshLod> generate_lods(std::vector<Vertex> const& vertices, std::vector<u32>& indices);
+
+    // Collapses edges until there are at most target_index_count indices left, or collapsing any other edge would move
+    // the surface by more than max_error. Vertices on open edges of the mesh never move.
+    // Seams, vertices split by normals or texture coordinates, only move along other seams.
+    // error is set to how far the surface moved, both errors are relative to the diagonal of the bounds of the mesh.
+    [[nodiscard]] static std::vector<u32> simplify(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
+                                                   u32 const target_index_count, float const max_error, float& error);
+};
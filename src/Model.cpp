@@ -1,15 +1,21 @@
 #include "Model.h"
 
+#include "AK/AK.h"
 #include "AK/Types.h"
+#include "CookedModel.h"
 #include "Entity.h"
 #include "Globals.h"
 #include "Mesh.h"
 #include "MeshFactory.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "Renderer.h"
 #include "ResourceManager.h"
 #include "Texture.h"
 #include "Vertex.h"
+#include "VirtualFileSystem.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 
@@ -113,6 +119,63 @@ BoundingBox Model::get_adjusted_bounding_box(glm::mat4 const& model_matrix) cons
     return {};
 }
 
+void Model::select_lod(glm::vec3 const& camera_position, float const screen_scale)
+{
+    m_mesh_lods.resize(m_meshes.size(), 0);
+
+    if (!m_lods_enabled || entity == nullptr)
+    {
+        std::ranges::fill(m_mesh_lods, 0);
+        return;
+    }
+
+    glm::mat4 const& model_matrix = entity->transform->get_model_matrix();
+
+    // The largest scale, so the error of a stretched mesh isn't underestimated
+    float const scale = std::max({glm::length(glm::vec3(model_matrix[0])), glm::length(glm::vec3(model_matrix[1])),
+                                  glm::length(glm::vec3(model_matrix[2]))});
+
+    for (size_t i = 0; i < m_meshes.size(); ++i)
+    {
+        auto const& mesh = m_meshes[i];
+
+        if (mesh->get_lod_count() <= 1)
+        {
+            m_mesh_lods[i] = 0;
+            continue;
+        }
+
+        BoundingBox const& local_bounds = mesh->get_local_bounds();
+        auto const center = glm::vec3(model_matrix * glm::vec4(local_bounds.center, 1.0f));
+        float const size = glm::length(local_bounds.max - local_bounds.min) * scale;
+        float const distance = std::max(glm::distance(camera_position, center), 0.001f);
+
+        m_mesh_lods[i] = mesh->select_lod(size * screen_scale / distance, m_mesh_lods[i]);
+    }
+}
+
+bool Model::depends_on(std::string const& path) const
+{
+    if (model_path.empty())
+        return false;
+
+    std::filesystem::path const changed_path = VirtualFileSystem::normalize_path(path);
+    std::filesystem::path const source_path = VirtualFileSystem::normalize_path(model_path);
+
+    return changed_path.parent_path() == source_path.parent_path() && changed_path.stem() == source_path.stem()
+           && changed_path.extension() != ".mesh";
+}
+
+u32 Model::get_triangle_count() const
+{
+    u32 triangle_count = 0;
+
+    for (size_t i = 0; i < m_meshes.size(); ++i)
+        triangle_count += m_meshes[i]->get_triangle_count(i < m_mesh_lods.size() ? m_mesh_lods[i] : 0);
+
+    return triangle_count;
+}
+
 Model::Model(std::shared_ptr<Material> const& material) : Drawable(material)
 {
 }
@@ -127,8 +190,8 @@ void Model::draw() const
     // Either wireframe or solid for individual model
     Renderer::get_instance()->set_rasterizer_draw_type(m_rasterizer_draw_type);
 
-    for (auto const& mesh : m_meshes)
-        mesh->draw();
+    for (size_t i = 0; i < m_meshes.size(); ++i)
+        m_meshes[i]->draw_lod(i < m_mesh_lods.size() ? m_mesh_lods[i] : 0);
 
     Renderer::get_instance()->restore_default_rasterizer_draw_type();
 }
@@ -149,12 +212,20 @@ void Model::prepare()
         material->first_drawable = std::dynamic_pointer_cast<Drawable>(shared_from_this());
     }
 
+    // Models read ahead of time, like the ones of streamed prefabs, are faster to create right away
+    if (ResourceManager::is_async_loading_enabled() && !m_staged_model_data.contains(model_path))
+    {
+        load_model_async(model_path);
+        return;
+    }
+
     load_model(model_path);
 }
 
 void Model::reset()
 {
     m_meshes.clear();
+    m_mesh_lods.clear();
     m_loaded_textures.clear();
 }
 
@@ -165,6 +236,83 @@ void Model::reprepare()
 }
 
 void Model::load_model(std::string const& path)
+{
+    std::shared_ptr<ModelData const> data = nullptr;
+
+    if (auto const it = m_staged_model_data.find(path); it != m_staged_model_data.end())
+        data = it->second.data;
+    else
+        data = read_model_data(path);
+
+    if (data == nullptr)
+        return;
+
+    create_meshes(*data, path);
+}
+
+void Model::load_model_async(std::string const& path)
+{
+    ResourceHandle<ModelData const> const handle = ResourceManager::get_instance().load_model_async(path);
+
+    if (!handle.is_ready())
+    {
+        create_meshes(*handle.get(), "PLACEHOLDER_MODEL");
+    }
+
+    handle.on_ready([weak_model = std::weak_ptr(std::static_pointer_cast<Model>(shared_from_this())),
+                     path](std::shared_ptr<ModelData const> const& data) {
+        auto const model = weak_model.lock();
+
+        // The model was destroyed or pointed to a different file while loading
+        if (model == nullptr || model->model_path != path)
+            return;
+
+        model->reset();
+        model->create_meshes(*data, path);
+        model->calculate_bounding_box();
+
+        if (model->entity != nullptr)
+            model->adjust_bounding_box();
+    });
+}
+
+void Model::create_meshes(ModelData const& data, std::string const& name)
+{
+    m_meshes.reserve(data.meshes.size());
+
+    for (auto const& mesh : data.meshes)
+    {
+        std::vector<std::shared_ptr<Texture>> textures = load_material_textures(mesh.diffuse_texture_paths, TextureType::Diffuse);
+
+        std::vector<std::shared_ptr<Texture>> specular_maps = load_material_textures(mesh.specular_texture_paths, TextureType::Specular);
+        textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
+
+        m_meshes.emplace_back(ResourceManager::get_instance().load_mesh(m_meshes.size(), name, mesh.vertices, mesh.indices, textures,
+                                                                        m_draw_type, material, DrawFunctionType::Indexed, false,
+                                                                        mesh.lods));
+    }
+}
+
+std::shared_ptr<ModelData const> Model::read_model_data(std::string const& path)
+{
+    if (!m_mesh_cooking_enabled)
+        return import_model_data(path);
+
+    // Meshes imported with different settings are cooked separately
+    u32 const import_settings = (m_mesh_optimization_enabled ? 1 : 0) | (m_lod_generation_enabled ? 2 : 0);
+
+    if (auto cooked_data = CookedModel::load(path, import_settings); cooked_data != nullptr)
+        return cooked_data;
+
+    auto data = import_model_data(path);
+
+    if (data != nullptr)
+        CookedModel::save(path, *data, import_settings);
+
+    return data;
+}
+
+std::shared_ptr<ModelData> Model::import_model_data(std::string const& path)
 {
     Assimp::Importer importer;
     aiScene const* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
@@ -172,34 +320,86 @@ void Model::load_model(std::string const& path)
     if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
     {
         std::cout << "Error. Failed loading a model: " << importer.GetErrorString() << "\n";
-        return;
+        return nullptr;
     }
 
     std::filesystem::path const filesystem_path = path;
-    m_directory = filesystem_path.parent_path().string();
+    std::string const directory = filesystem_path.parent_path().string();
+
+    auto data = std::make_shared<ModelData>();
+    proccess_node(scene->mRootNode, scene, directory, *data);
+
+    if (m_mesh_optimization_enabled)
+    {
+        for (auto& mesh : data->meshes)
+        {
+            MeshOptimizer::optimize(mesh.vertices, mesh.indices);
+        }
+    }
 
-    proccess_node(scene->mRootNode, scene);
+    // After optimizing, so every level of detail uses the optimized vertices
+    if (m_lod_generation_enabled)
+    {
+        for (auto& mesh : data->meshes)
+        {
+            mesh.lods = MeshSimplifier::generate_lods(mesh.vertices, mesh.indices);
+        }
+    }
+
+    return data;
 }
 
-void Model::proccess_node(aiNode const* node, aiScene const* scene)
+void Model::stage_model_data(std::string const& path, std::shared_ptr<ModelData const> const& data)
+{
+    auto& staged = m_staged_model_data[path];
+    staged.data = data;
+    staged.stage_count += 1;
+}
+
+void Model::unstage_model_data(std::string const& path)
+{
+    auto const it = m_staged_model_data.find(path);
+
+    if (it == m_staged_model_data.end())
+        return;
+
+    it->second.stage_count -= 1;
+
+    if (it->second.stage_count == 0)
+        m_staged_model_data.erase(it);
+}
+
+TextureSettings Model::get_texture_settings()
+{
+    TextureSettings settings = {};
+    settings.flip_vertically = false;
+    settings.filtering_min = TextureFiltering::Nearest;
+    settings.filtering_max = TextureFiltering::Nearest;
+    settings.filtering_mipmap = TextureFiltering::Nearest;
+
+    return settings;
+}
+
+void Model::proccess_node(aiNode const* node, aiScene const* scene, std::string const& directory, ModelData& data)
 {
     for (u32 i = 0; i < node->mNumMeshes; ++i)
     {
         aiMesh const* mesh = scene->mMeshes[node->mMeshes[i]];
-        m_meshes.emplace_back(proccess_mesh(mesh, scene));
+        data.meshes.emplace_back(proccess_mesh(mesh, scene, directory));
     }
 
     for (u32 i = 0; i < node->mNumChildren; ++i)
     {
-        proccess_node(node->mChildren[i], scene);
+        proccess_node(node->mChildren[i], scene, directory, data);
     }
 }
 
-std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* scene)
+ModelMeshData Model::proccess_mesh(aiMesh const* mesh, aiScene const* scene, std::string const& directory)
 {
-    std::vector<Vertex> vertices;
-    std::vector<u32> indices;
-    std::vector<std::shared_ptr<Texture>> textures;
+    ModelMeshData data = {};
+    data.vertices.reserve(mesh->mNumVertices);
+    // Faces are triangulated on import
+    data.indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 
     for (u32 i = 0; i < mesh->mNumVertices; ++i)
     {
@@ -221,7 +421,7 @@ std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* sc
             vertex.texture_coordinates = glm::vec2(0.0f, 0.0f);
         }
 
-        vertices.push_back(vertex);
+        data.vertices.push_back(vertex);
     }
 
     for (u32 i = 0; i < mesh->mNumFaces; ++i)
@@ -229,27 +429,22 @@ std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* sc
         aiFace const face = mesh->mFaces[i];
         for (u32 k = 0; k < face.mNumIndices; k++)
         {
-            indices.push_back(face.mIndices[k]);
+            data.indices.push_back(face.mIndices[k]);
         }
     }
 
     aiMaterial const* assimp_material = scene->mMaterials[mesh->mMaterialIndex];
 
-    std::vector<std::shared_ptr<Texture>> diffuse_maps =
-        load_material_textures(assimp_material, aiTextureType_DIFFUSE, TextureType::Diffuse);
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
-
-    std::vector<std::shared_ptr<Texture>> specular_maps =
-        load_material_textures(assimp_material, aiTextureType_SPECULAR, TextureType::Specular);
-    textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
+    data.diffuse_texture_paths = get_material_texture_paths(assimp_material, aiTextureType_DIFFUSE, directory);
+    data.specular_texture_paths = get_material_texture_paths(assimp_material, aiTextureType_SPECULAR, directory);
 
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, vertices, indices, textures, m_draw_type, material);
+    return data;
 }
 
-std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial const* material, aiTextureType const type,
-                                                                    TextureType const type_name)
+std::vector<std::string> Model::get_material_texture_paths(aiMaterial const* material, aiTextureType const type,
+                                                           std::string const& directory)
 {
-    std::vector<std::shared_ptr<Texture>> textures;
+    std::vector<std::string> paths;
 
     u32 const material_count = material->GetTextureCount(type);
     for (u32 i = 0; i < material_count; ++i)
@@ -257,10 +452,22 @@ std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial c
         aiString str;
         material->GetTexture(type, i, &str);
 
+        paths.emplace_back(directory + '/' + str.C_Str());
+    }
+
+    return paths;
+}
+
+std::vector<std::shared_ptr<Texture>> Model::load_material_textures(std::vector<std::string> const& paths, TextureType const type_name)
+{
+    std::vector<std::shared_ptr<Texture>> textures;
+
+    for (auto const& file_path : paths)
+    {
         bool is_already_loaded = false;
         for (auto const& loaded_texture : m_loaded_textures)
         {
-            if (std::strcmp(loaded_texture->path.data(), str.C_Str()) == 0)
+            if (loaded_texture->path == file_path)
             {
                 textures.push_back(loaded_texture);
                 is_already_loaded = true;
@@ -271,16 +478,7 @@ std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial c
         if (is_already_loaded)
             continue;
 
-        auto file_path = std::string(str.C_Str());
-        file_path = m_directory + '/' + file_path;
-
-        TextureSettings settings = {};
-        settings.flip_vertically = false;
-        settings.filtering_min = TextureFiltering::Nearest;
-        settings.filtering_max = TextureFiltering::Nearest;
-        settings.filtering_mipmap = TextureFiltering::Nearest;
-
-        std::shared_ptr<Texture> texture = ResourceManager::get_instance().load_texture(file_path, type_name, settings);
+        std::shared_ptr<Texture> texture = ResourceManager::get_instance().load_texture(file_path, type_name, get_texture_settings());
         textures.push_back(texture);
         m_loaded_textures.push_back(texture);
     }
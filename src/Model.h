@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <assimp/material.h>
@@ -13,6 +14,23 @@ struct aiMesh;
 struct aiScene;
 struct aiNode;
 
+// Mesh read from a model file, before anything is created on the GPU.
+struct ModelMeshData
+{
+    std::vector<Vertex> vertices = {};
+    // Indices of every level of detail, one after another
+    std::vector<u32> indices = {};
+    // Empty if the mesh has no levels of detail besides the full one
+    std::vector<MeshLod> lods = {};
+    std::vector<std::string> diffuse_texture_paths = {};
+    std::vector<std::string> specular_texture_paths = {};
+};
+
+struct ModelData
+{
+    std::vector<ModelMeshData> meshes = {};
+};
+
 class Model : public Drawable
 {
 public:
@@ -40,6 +58,69 @@ public:
     virtual void adjust_bounding_box() override;
     virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
 
+    virtual void select_lod(glm::vec3 const& camera_position, float const screen_scale) override;
+
+    // Whether the model has to be loaded again when the file changes. Besides the model file, files next to it with the same name,
+    // like the buffers of glTF files, are read with it. Its cooked file isn't, it's written when the model is loaded.
+    [[nodiscard]] bool depends_on(std::string const& path) const;
+
+    // Triangles of all meshes at their selected levels of detail.
+    [[nodiscard]] u32 get_triangle_count() const;
+
+    // Only reads the file, so it can be called from any thread. Returns nullptr if the model can't be read.
+    // With mesh cooking enabled, reads the cooked file of the model instead, and cooks it on the first import.
+    // Imported meshes are optimized by MeshOptimizer unless mesh optimization is disabled,
+    // and get levels of detail from MeshSimplifier unless LOD generation is disabled.
+    [[nodiscard]] static std::shared_ptr<ModelData const> read_model_data(std::string const& path);
+
+    // Models read ahead of time are used instead of reading the file again. Only call these from the main thread.
+    // Staging is counted, so prefabs streamed at the same time can stage the same model, every stage needs an unstage.
+    static void stage_model_data(std::string const& path, std::shared_ptr<ModelData const> const& data);
+    static void unstage_model_data(std::string const& path);
+
+    [[nodiscard]] static TextureSettings get_texture_settings();
+
+    static void set_mesh_cooking_enabled(bool const enabled)
+    {
+        m_mesh_cooking_enabled = enabled;
+    }
+
+    [[nodiscard]] static bool is_mesh_cooking_enabled()
+    {
+        return m_mesh_cooking_enabled;
+    }
+
+    static void set_mesh_optimization_enabled(bool const enabled)
+    {
+        m_mesh_optimization_enabled = enabled;
+    }
+
+    [[nodiscard]] static bool is_mesh_optimization_enabled()
+    {
+        return m_mesh_optimization_enabled;
+    }
+
+    static void set_lod_generation_enabled(bool const enabled)
+    {
+        m_lod_generation_enabled = enabled;
+    }
+
+    [[nodiscard]] static bool is_lod_generation_enabled()
+    {
+        return m_lod_generation_enabled;
+    }
+
+    // With LODs disabled, meshes are always drawn in full.
+    static void set_lods_enabled(bool const enabled)
+    {
+        m_lods_enabled = enabled;
+    }
+
+    [[nodiscard]] static bool are_lods_enabled()
+    {
+        return m_lods_enabled;
+    }
+
     std::string model_path = "";
 
 protected:
@@ -47,14 +128,32 @@ protected:
 
     DrawType m_draw_type = DrawType::Triangles;
     std::vector<std::shared_ptr<Mesh>> m_meshes = {};
+    // Level of detail of every mesh, chosen every frame by select_lod()
+    std::vector<u32> m_mesh_lods = {};
 
 private:
     void load_model(std::string const& path);
-    void proccess_node(aiNode const* node, aiScene const* scene);
-    std::shared_ptr<Mesh> proccess_mesh(aiMesh const* mesh, aiScene const* scene);
-    std::vector<std::shared_ptr<Texture>> load_material_textures(aiMaterial const* material, aiTextureType type,
-                                                                 TextureType const type_name);
+    // Shows a placeholder until ResourceManager has loaded the model in the background.
+    void load_model_async(std::string const& path);
+    void create_meshes(ModelData const& data, std::string const& name);
+    [[nodiscard]] static std::shared_ptr<ModelData> import_model_data(std::string const& path);
+    static void proccess_node(aiNode const* node, aiScene const* scene, std::string const& directory, ModelData& data);
+    static ModelMeshData proccess_mesh(aiMesh const* mesh, aiScene const* scene, std::string const& directory);
+    static std::vector<std::string> get_material_texture_paths(aiMaterial const* material, aiTextureType type,
+                                                               std::string const& directory);
+    std::vector<std::shared_ptr<Texture>> load_material_textures(std::vector<std::string> const& paths, TextureType const type_name);
 
-    std::string m_directory;
     std::vector<std::shared_ptr<Texture>> m_loaded_textures;
+
+    struct StagedModelData
+    {
+        std::shared_ptr<ModelData const> data = {};
+        u32 stage_count = 0;
+    };
+
+    inline static std::unordered_map<std::string, StagedModelData> m_staged_model_data = {};
+    inline static bool m_mesh_cooking_enabled = true;
+    inline static bool m_mesh_optimization_enabled = true;
+    inline static bool m_lod_generation_enabled = true;
+    inline static bool m_lods_enabled = true;
 };
@@ -0,0 +1,266 @@
+#include "PackArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "AK/AK.h"
+#include "AK/Lz4.h"
+
+namespace
+{
+
+struct PackedFile
+{
+    std::string path = {};
+    std::filesystem::path source_path = {};
+    u64 path_hash = 0;
+};
+
+u64 align_up(u64 const offset)
+{
+    return (offset + pack_alignment - 1) & ~(pack_alignment - 1);
+}
+
+bool fits(u64 const offset, u64 const size, u64 const file_size)
+{
+    return offset <= file_size && size <= file_size - offset;
+}
+
+}
+
+bool PackArchive::build(std::string const& directory, std::string const& archive_path, bool const compress)
+{
+    std::error_code error;
+    std::filesystem::path const archive = std::filesystem::weakly_canonical(archive_path, error);
+    std::vector<PackedFile> files = {};
+
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        std::error_code entry_error;
+
+        if (!entry.is_regular_file(entry_error) || entry.path().extension() == ".tmp")
+            continue;
+
+        if (std::filesystem::weakly_canonical(entry.path(), entry_error) == archive)
+            continue;
+
+        PackedFile file = {};
+        file.path = std::filesystem::relative(entry.path(), directory, entry_error).generic_string();
+        file.source_path = entry.path();
+        file.path_hash = hash_path(file.path);
+        files.emplace_back(std::move(file));
+    }
+
+    if (error)
+    {
+        std::cout << "Error. Could not list the files to pack in " << directory << ": " << error.message() << "\n";
+        return false;
+    }
+
+    // Paths break ties between colliding hashes, so the same directory is always packed the same way
+    std::ranges::sort(files, [](PackedFile const& a, PackedFile const& b) {
+        return a.path_hash != b.path_hash ? a.path_hash < b.path_hash : a.path < b.path;
+    });
+
+    PackHeader header = {};
+    header.entry_count = static_cast<u32>(files.size());
+    header.entry_table_offset = sizeof(PackHeader);
+    header.path_table_offset = header.entry_table_offset + files.size() * sizeof(PackEntry);
+
+    std::vector<PackEntry> entries(files.size());
+    std::string paths = {};
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        entries[i].path_hash = files[i].path_hash;
+        entries[i].path_offset = static_cast<u32>(paths.size());
+        entries[i].path_length = static_cast<u32>(files[i].path.size());
+        paths += files[i].path;
+    }
+
+    header.path_table_size = static_cast<u32>(paths.size());
+    header.data_offset = align_up(header.path_table_offset + paths.size());
+
+    std::string const temporary_path = std::format("{}.{}.tmp", archive_path, std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            std::cout << "Error. Could not create an archive file: " << temporary_path << "\n";
+            return false;
+        }
+
+        // Entries are only known after every file is written, so their table is written last
+        std::vector<char> const padding(pack_alignment, 0);
+        u64 offset = header.data_offset;
+
+        file.seekp(static_cast<std::streamoff>(header.path_table_offset));
+        file.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+        file.write(padding.data(), static_cast<std::streamsize>(header.data_offset - header.path_table_offset - paths.size()));
+
+        for (size_t i = 0; i < files.size() && file.good(); ++i)
+        {
+            AK::MappedFile source = {};
+
+            if (!source.open(files[i].source_path.string()))
+            {
+                std::cout << "Error. Could not read a file to pack: " << files[i].source_path.string() << "\n";
+                file.setstate(std::ios::failbit);
+                break;
+            }
+
+            std::span<u8 const> bytes = source.get_bytes();
+            std::vector<u8> compressed = {};
+
+            entries[i].offset = offset;
+            entries[i].size = bytes.size();
+
+            if (compress && !bytes.empty())
+            {
+                compressed = AK::Lz4::compress(bytes);
+
+                // Decompressing costs more than reading the few bytes it would save
+                if (compressed.size() < bytes.size() - bytes.size() / 8)
+                {
+                    bytes = compressed;
+                    entries[i].compression = PackCompression::LZ4;
+                }
+            }
+
+            entries[i].stored_size = bytes.size();
+
+            u64 const aligned_size = align_up(bytes.size());
+            file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            file.write(padding.data(), static_cast<std::streamsize>(aligned_size - bytes.size()));
+            offset += aligned_size;
+        }
+
+        file.seekp(0);
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+
+        if (!file.good())
+        {
+            file.close();
+            std::filesystem::remove(temporary_path, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary_path, archive_path, error);
+
+    // The archive can be mounted right now, on Windows it can't be replaced then
+    if (error)
+    {
+        std::cout << "Error. Could not replace an archive file: " << archive_path << ": " << error.message() << "\n";
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    return true;
+}
+
+u64 PackArchive::hash_path(std::string_view const path)
+{
+    return AK::fnv1a_hash64(path);
+}
+
+bool PackArchive::open(std::string const& archive_path)
+{
+    m_entries = {};
+    m_paths = {};
+
+    if (!m_file.open(archive_path))
+        return false;
+
+    std::span<u8 const> const data = m_file.get_bytes();
+    PackHeader header = {};
+
+    if (data.size() < sizeof(header))
+    {
+        m_file.close();
+        return false;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, PackHeader {}.magic, sizeof(header.magic)) != 0 || header.version != pack_archive_version)
+    {
+        std::cout << "Error. Not an archive file or it was packed by a different version of the engine: " << archive_path << "\n";
+        m_file.close();
+        return false;
+    }
+
+    if (header.entry_table_offset % alignof(PackEntry) != 0
+        || !fits(header.entry_table_offset, static_cast<u64>(header.entry_count) * sizeof(PackEntry), data.size())
+        || !fits(header.path_table_offset, header.path_table_size, data.size()))
+    {
+        std::cout << "Error. Archive file is corrupted: " << archive_path << "\n";
+        m_file.close();
+        return false;
+    }
+
+    // Mappings start at a page, so the table is as aligned as its offset
+    std::span const entries(reinterpret_cast<PackEntry const*>(data.data() + header.entry_table_offset), header.entry_count);
+
+    for (auto const& entry : entries)
+    {
+        if (!fits(entry.offset, entry.stored_size, data.size())
+            || !fits(entry.path_offset, entry.path_length, header.path_table_size)
+            || entry.compression > PackCompression::LZ4
+            || (entry.compression == PackCompression::None && entry.stored_size != entry.size)
+            || (entry.compression == PackCompression::LZ4 && entry.size > AK::Lz4::get_decompress_bound(entry.stored_size)))
+        {
+            std::cout << "Error. Archive file is corrupted: " << archive_path << "\n";
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_entries = entries;
+    m_paths = std::string_view(reinterpret_cast<char const*>(data.data() + header.path_table_offset), header.path_table_size);
+    return true;
+}
+
+PackEntry const* PackArchive::find(std::string_view const path) const
+{
+    u64 const path_hash = hash_path(path);
+    auto it = std::ranges::lower_bound(m_entries, path_hash, {}, &PackEntry::path_hash);
+
+    for (; it != m_entries.end() && it->path_hash == path_hash; ++it)
+    {
+        if (get_path(*it) == path)
+            return &*it;
+    }
+
+    return nullptr;
+}
+
+std::span<PackEntry const> PackArchive::get_entries() const
+{
+    return m_entries;
+}
+
+std::string_view PackArchive::get_path(PackEntry const& entry) const
+{
+    return m_paths.substr(entry.path_offset, entry.path_length);
+}
+
+std::span<u8 const> PackArchive::get_stored_bytes(PackEntry const& entry) const
+{
+    return m_file.get_bytes().subspan(entry.offset, entry.stored_size);
+}
+
+void PackArchive::prefetch(PackEntry const& entry) const
+{
+    m_file.prefetch(entry.offset, entry.stored_size);
+}
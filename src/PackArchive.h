@@ -0,0 +1,85 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "AK/MappedFile.h"
+#include "AK/Types.h"
+
+// Packed asset archive. Every file of a directory in a single file, mapped into memory whole when the archive is opened.
+// Layout of a file, all offsets are counted from its beginning:
+//   PackHeader
+//   Entry table - PackEntry for every file, sorted by the hash of its path, so files are found with a binary search
+//   Path table  - paths of every file relative to the packed directory, with forward slashes and not null-terminated
+//   Data        - contents of every file one after another, each one starting at a multiple of pack_alignment
+// Nothing is parsed when an archive is opened, entries are read straight from the mapped file.
+// Bump the version whenever archives are packed differently, they have to be packed again.
+
+u32 constexpr pack_archive_version = 1;
+
+// Files are read in place, so cooked files that are read as tables of u32 or floats stay aligned
+u64 constexpr pack_alignment = 64;
+
+enum class PackCompression : u32
+{
+    None,
+    LZ4,
+};
+
+struct PackHeader
+{
+    char magic[4] = {'E', 'P', 'A', 'K'};
+    u32 version = pack_archive_version;
+    u32 entry_count = 0;
+    u32 path_table_size = 0;
+    u64 entry_table_offset = 0;
+    u64 path_table_offset = 0;
+    u64 data_offset = 0;
+};
+
+struct PackEntry
+{
+    u64 path_hash = 0;
+    u64 offset = 0;
+    // Size in the archive, smaller than size when the file is compressed
+    u64 stored_size = 0;
+    u64 size = 0;
+    u32 path_offset = 0;
+    u32 path_length = 0;
+    PackCompression compression = PackCompression::None;
+    u32 padding = 0;
+};
+
+static_assert(sizeof(PackHeader) == 40);
+static_assert(sizeof(PackEntry) == 48);
+
+class PackArchive
+{
+public:
+    // Packs every file in the directory and its subdirectories, except for temporary files and the archive itself.
+    // With compression, files are compressed with LZ4 only when it makes them noticeably smaller,
+    // so files that are already compressed, like images, stay stored as they are.
+    static bool build(std::string const& directory, std::string const& archive_path, bool const compress);
+
+    [[nodiscard]] static u64 hash_path(std::string_view const path);
+
+    bool open(std::string const& archive_path);
+
+    // The path is relative to the packed directory, with forward slashes. Returns nullptr if there is no such file.
+    [[nodiscard]] PackEntry const* find(std::string_view const path) const;
+
+    [[nodiscard]] std::span<PackEntry const> get_entries() const;
+    [[nodiscard]] std::string_view get_path(PackEntry const& entry) const;
+
+    // Bytes of the file as they are stored in the archive, compressed if the entry is.
+    [[nodiscard]] std::span<u8 const> get_stored_bytes(PackEntry const& entry) const;
+
+    // Starts reading the stored bytes of the file from the disk in the background.
+    void prefetch(PackEntry const& entry) const;
+
+private:
+    AK::MappedFile m_file = {};
+    std::span<PackEntry const> m_entries = {};
+    std::string_view m_paths = {};
+};
@@ -89,6 +89,7 @@ std::shared_ptr<Mesh> Panel::create_sprite() const
     TextureSettings texture_settings = {};
     texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+    texture_settings.compress = false;
 
     if (!background_path.empty())
         diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(background_path, TextureType::Diffuse, texture_settings));
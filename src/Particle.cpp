@@ -1,123 +1,44 @@
 #include "Particle.h"
 
-#include "AK/AK.h"
-#include "AK/Math.h"
-#include "Camera.h"
 #include "Entity.h"
-#include "Game/CustomerManager.h"
-#include "Game/GameController.h"
-#include "Globals.h"
-#include "RendererDX11.h"
 #include "ResourceManager.h"
 
-#include <glm/gtc/type_ptr.inl>
+#include <algorithm>
 
 #if EDITOR
 #include "imgui_stdlib.h"
 #endif
 
-std::shared_ptr<Particle> Particle::create()
-{
-    auto const particle_shader = ResourceManager::get_instance().load_shader("./res/shaders/particle.hlsl", "./res/shaders/particle.hlsl");
-    auto const particle_material = Material::create(particle_shader, 1000, false, false, true);
-    particle_material->casts_shadows = false;
-    particle_material->needs_forward_rendering = true;
-
-    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, 1.0f, "./res/textures/particle.png", particle_material, true);
-
-    particle->prepare();
-
-    return particle;
-}
-
-std::shared_ptr<Particle> Particle::create(ParticleSpawnData const& data, float spawn_bounds, std::string const& sprite_path,
-                                           bool const rotate_particle)
-{
-    auto const particle_shader = ResourceManager::get_instance().load_shader("./res/shaders/particle.hlsl", "./res/shaders/particle.hlsl");
-    auto const particle_material = Material::create(particle_shader, 1000, false, false, true);
-    particle_material->casts_shadows = false;
-    particle_material->needs_forward_rendering = true;
-
-    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, spawn_bounds, sprite_path, particle_material, rotate_particle);
-
-    particle->prepare();
-    particle->set_data(data);
-
-    return particle;
-}
-
-std::shared_ptr<Particle> Particle::create(ParticleSpawnData const& data, float spawn_bounds, std::string const& sprite_path,
-                                           bool const rotate_particle, std::shared_ptr<Shader> const& shader)
+std::shared_ptr<Particle> Particle::create(std::shared_ptr<ParticleSystem> const& particle_system, std::string const& sprite_path,
+                                           std::shared_ptr<Shader> const& shader)
 {
     auto const particle_material = Material::create(shader, 1000, false, false, true);
     particle_material->casts_shadows = false;
     particle_material->needs_forward_rendering = true;
-    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, spawn_bounds, sprite_path, particle_material, rotate_particle);
+
+    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, particle_system, sprite_path, particle_material);
 
     particle->prepare();
-    particle->set_data(data);
 
     return particle;
 }
 
-Particle::Particle(AK::Badge<Particle>, float const spawn_bounds, std::string const& sprite_path, std::shared_ptr<Material> const& mat,
-                   bool const rotate_particle)
-    : Drawable(mat), rotate(rotate_particle), path(sprite_path), m_particle_material(mat), m_spawn_bounds(spawn_bounds)
+Particle::Particle(AK::Badge<Particle>, std::shared_ptr<ParticleSystem> const& particle_system, std::string const& sprite_path,
+                   std::shared_ptr<Material> const& mat)
+    : Drawable(mat), path(sprite_path), m_particle_system(particle_system)
 {
 }
 
-void Particle::awake()
+void Particle::draw() const
 {
-    set_can_tick(true);
-
-    entity->transform->set_local_position({AK::random_float(-m_spawn_bounds, m_spawn_bounds),
-                                           AK::random_float(-m_spawn_bounds, m_spawn_bounds),
-                                           AK::random_float(-m_spawn_bounds, m_spawn_bounds)});
-    if (rotate)
-    {
-        auto const rot = entity->transform->get_euler_angles();
-        glm::vec3 const d_rot = {0.0f, 0.0f, AK::random_float(0.0f, 360.0f)};
-
-        entity->transform->set_euler_angles(rot + d_rot);
-    }
-
-    m_rotation_direction = AK::random_bool() ? 1.0f : -1.0f;
-
-    update_particle();
-
-    if (!entity->transform->parent.expired())
-    {
-        entity->transform->parent.lock()->set_euler_angles(Camera::get_main_camera()->entity->transform->get_euler_angles());
-    }
-    else
-    {
-        entity->transform->set_euler_angles(Camera::get_main_camera()->entity->transform->get_euler_angles());
-    }
-
-    m_random_seed = AK::random_float(-1.0f, 1.0f);
-
-    if (!entity->transform->parent.expired())
-    {
-        m_original_position = entity->transform->parent.lock()->get_position();
-    }
-    else
+    if (m_rasterizer_draw_type == RasterizerDrawType::None)
     {
-        m_original_position = entity->transform->get_position();
+        return;
     }
 
-    if (GameController::get_instance() != nullptr && !GameController::get_instance()->get_customer_manager_entity().expired())
-    {
-        m_customer_group_position =
-            GameController::get_instance()->get_customer_manager_entity().lock()->transform->get_position() + glm::vec3(0.0f, 1.0f, 0.0f);
-
-        m_fish_offset = {AK::random_float(-m_velocity.y, m_velocity.y), AK::random_float(-m_velocity.y, m_velocity.y),
-                         AK::random_float(-m_velocity.y, m_velocity.y)};
-    }
-}
+    auto const particle_system = m_particle_system.lock();
 
-void Particle::draw() const
-{
-    if (m_rasterizer_draw_type == RasterizerDrawType::None)
+    if (particle_system == nullptr || particle_system->get_particles().count == 0 || m_mesh == nullptr)
     {
         return;
     }
@@ -125,19 +46,8 @@ void Particle::draw() const
     // Either wireframe or solid for individual model
     Renderer::get_instance()->set_rasterizer_draw_type(m_rasterizer_draw_type);
 
-    if (!entity->transform->parent.expired())
-    {
-        entity->transform->parent.lock()->set_rotation(Camera::get_main_camera()->entity->transform->get_euler_angles());
-    }
-    else
-    {
-        entity->transform->set_rotation(Camera::get_main_camera()->entity->transform->get_euler_angles());
-    }
-
-    if (m_mesh != nullptr)
-    {
-        m_mesh->draw();
-    }
+    u32 const count = std::min(particle_system->get_particles().count, ParticleSystem::max_particle_count);
+    m_mesh->draw_instanced(static_cast<i32>(count));
 
     Renderer::get_instance()->restore_default_rasterizer_draw_type();
 }
@@ -147,14 +57,11 @@ void Particle::draw_editor()
 {
     Drawable::draw_editor();
 
-    ImGui::ColorEdit4("Color", glm::value_ptr(m_color));
     ImGui::InputText("Sprite Path", &path);
     if (ImGui::IsItemDeactivatedAfterEdit())
     {
         reprepare();
     }
-
-    update_particle();
 }
 #endif
 
@@ -165,104 +72,14 @@ void Particle::reprepare()
     prepare();
 }
 
-void Particle::update_particle() const
-{
-    m_particle_material->color = m_color;
-}
-
-bool Particle::update_lifetime()
-{
-    m_current_lifetime += static_cast<float>(delta_time);
-
-    if (m_current_lifetime >= m_lifetime)
-    {
-        if (!entity->transform->parent.expired())
-        {
-            entity->transform->parent.lock()->entity.lock()->destroy_immediate();
-        }
-        else if (entity != nullptr)
-        {
-            entity->destroy_immediate();
-        }
-
-        return true;
-    }
-
-    return false;
-}
-
-void Particle::update()
-{
-    if (update_lifetime())
-    {
-        return;
-    }
-
-    move();
-
-    interpolate_color();
-
-    update_particle();
-}
-
-void Particle::move() const
+u32 Particle::write_instances(std::span<ParticleInstance> const instances) const
 {
-    glm::vec3 new_position;
-    glm::vec3 change = {};
-
-    switch (particle_type)
-    {
-    case ParticleType::Prompt:
-    {
-        change.y = sin(m_current_lifetime * 5.0f) * 0.1f;
-        new_position = m_original_position + change;
-        break;
-    }
-    case ParticleType::Snow:
-    {
-        glm::vec3 const p = entity->transform->get_position();
-        change.x = sin(static_cast<float>(glfwGetTime()) + m_random_seed * 1.5f) * 0.035f - static_cast<float>(delta_time) * 1.7f;
-        change.z = change.x;
-
-        // Ensure the y-component decreases over time for downward motion
-        change.y = -static_cast<float>(delta_time) * 6.5f;
-        new_position = p + change;
-        break;
-    }
-    case ParticleType::Fish:
-    {
-        float t = m_current_lifetime / m_lifetime;
-
-        new_position = glm::mix(entity->transform->parent.lock()->get_position(), m_customer_group_position, t) + m_fish_offset;
-
-        auto const rot = entity->transform->get_euler_angles();
-        glm::vec3 const d_rot = {0.0f, 0.0f, delta_time * m_velocity.y * 600.0f};
-        entity->transform->set_euler_angles(rot + d_rot * m_rotation_direction);
-
-        break;
-    }
-    default:
-    {
-        glm::vec3 const p = entity->transform->get_position();
-        change = m_velocity * static_cast<float>(delta_time);
-        new_position = p + change;
-        break;
-    }
-    }
-
-    entity->transform->set_position(new_position);
+    auto const particle_system = m_particle_system.lock();
 
-    if (rotate)
-    {
-        auto const rot = entity->transform->get_euler_angles();
-        glm::vec3 const d_rot = {0.0f, 0.0f, delta_time * m_velocity.y * 50.0f};
-        entity->transform->set_euler_angles(rot + d_rot * m_rotation_direction);
-    }
-}
+    if (particle_system == nullptr)
+        return 0;
 
-void Particle::interpolate_color()
-{
-    m_color = AK::interpolate_color(m_start_color_1, m_end_color_1, m_current_lifetime / m_lifetime);
+    return particle_system->write_instances(instances);
 }
 
 bool Particle::is_particle() const
@@ -275,15 +92,6 @@ void Particle::prepare()
     m_mesh = create_sprite();
 }
 
-void Particle::set_data(ParticleSpawnData const& data)
-{
-    m_lifetime = data.lifetime;
-    m_velocity = data.start_velocity;
-    m_color = data.start_color_1;
-    m_start_color_1 = data.start_color_1;
-    m_end_color_1 = data.end_color_1;
-}
-
 std::shared_ptr<Mesh> Particle::create_sprite() const
 {
     std::vector<Vertex> const vertices = {
@@ -1,12 +1,14 @@
 #include "ParticleSystem.h"
 
 #include "AK/AK.h"
-#include "Camera.h"
 #include "Entity.h"
+#include "Game/GameController.h"
 #include "Globals.h"
 #include "Particle.h"
 #include "ResourceManager.h"
 
+#include <algorithm>
+#include <cmath>
 #include <glm/gtc/random.hpp>
 #include <glm/gtc/type_ptr.inl>
 
@@ -16,6 +18,51 @@
 #include <imgui_stdlib.h>
 #endif
 
+u32 ParticleBuffer::add()
+{
+    if (count == positions.size())
+    {
+        u32 const size = count + 1;
+        positions.resize(size);
+        velocities.resize(size);
+        colors.resize(size);
+        ages.resize(size);
+        lifetimes.resize(size);
+        seeds.resize(size);
+        sizes.resize(size);
+        rotations.resize(size);
+        rotation_speeds.resize(size);
+        origins.resize(size);
+        targets.resize(size);
+    }
+
+    return count++;
+}
+
+void ParticleBuffer::remove(u32 const index)
+{
+    u32 const last = count - 1;
+
+    positions[index] = positions[last];
+    velocities[index] = velocities[last];
+    colors[index] = colors[last];
+    ages[index] = ages[last];
+    lifetimes[index] = lifetimes[last];
+    seeds[index] = seeds[last];
+    sizes[index] = sizes[last];
+    rotations[index] = rotations[last];
+    rotation_speeds[index] = rotation_speeds[last];
+    origins[index] = origins[last];
+    targets[index] = targets[last];
+
+    count = last;
+}
+
+void ParticleBuffer::clear()
+{
+    count = 0;
+}
+
 std::shared_ptr<ParticleSystem> ParticleSystem::create()
 {
     auto particle_system = std::make_shared<ParticleSystem>(AK::Badge<ParticleSystem> {});
@@ -31,6 +78,23 @@ ParticleSystem::ParticleSystem(AK::Badge<ParticleSystem>)
 void ParticleSystem::awake()
 {
     set_can_tick(true);
+
+    m_last_emitter_position = entity->transform->get_position();
+}
+
+void ParticleSystem::uninitialize()
+{
+    Component::uninitialize();
+
+    // Particles are gone together with their emitter. Children are destroyed after the components of their parent are uninitialized.
+    if (m_drawable_entity != nullptr)
+    {
+        m_drawable_entity->destroy_immediate();
+        m_drawable_entity = nullptr;
+        m_drawable = nullptr;
+    }
+
+    m_particles.clear();
 }
 
 #if EDITOR
@@ -47,6 +111,12 @@ void ParticleSystem::draw_editor()
     }
 
     ImGui::InputText("Sprite", &sprite_path);
+    if (ImGui::IsItemDeactivatedAfterEdit() && m_drawable != nullptr)
+    {
+        m_drawable->path = sprite_path;
+        m_drawable->reprepare();
+    }
+
     ImGui::ColorEdit4("Start color 1", value_ptr(start_color_1));
     ImGui::ColorEdit4("End color 1", value_ptr(end_color_1));
     ImGuiEx::InputFloat("Lifetime 1", &lifetime_1);
@@ -72,14 +142,32 @@ void ParticleSystem::update()
 
 void ParticleSystem::update_system()
 {
-    if (m_spawn_data_vector.empty())
+    glm::vec3 const emitter_position = entity->transform->get_position();
+
+    // Despite its name, the setting carries particles along with the emitter, like it did when particles were entities
+    // parented to it. Only its movement is followed, its rotation and scale aren't applied to particles anymore.
+    if (m_simulate_in_world_space && emitter_position != m_last_emitter_position)
+    {
+        glm::vec3 const offset = emitter_position - m_last_emitter_position;
+
+        for (u32 i = 0; i < m_particles.count; ++i)
+        {
+            m_particles.positions[i] += offset;
+            m_particles.origins[i] += offset;
+        }
+    }
+
+    m_last_emitter_position = emitter_position;
+
+    simulate(static_cast<float>(delta_time), static_cast<float>(glfwGetTime()));
+
+    if (m_spawn_data_vector.empty() && !m_is_spawning_finished)
     {
         spawn_calculations();
     }
     else
     {
         //  TODO: Modes in shader/cbuffer: override/multiply color, adjustable alpha bias
-
         for (i32 i = 0; i < m_random_spawn_count; i++)
         {
             if (m_time_counter < m_spawn_data_vector[i].spawn_time)
@@ -87,31 +175,10 @@ void ParticleSystem::update_system()
                 continue;
             }
 
-            // Use fake guids so that we don't have to use performance-heavy guid RNG
-            auto const particle_parent = Entity::create("1", "PARTICLE_PARENT");
-            auto const particle = Entity::create("1", "PARTICLE_");
-            particle_parent->is_serialized = false;
-            particle->is_serialized = false;
-
-            if (m_simulate_in_world_space)
-            {
-                particle_parent->transform->set_parent(entity->transform);
-            }
-            else
-            {
-                particle_parent->transform->set_position(entity->transform->get_position());
-            }
-
-            particle->transform->set_parent(particle_parent->transform);
+            if (m_drawable == nullptr)
+                create_drawable();
 
-            auto const particle_comp = particle->add_component(
-                Particle::create(m_spawn_data_vector[i], emitter_bounds, sprite_path, rotate_particles, m_particle_shader));
-
-            particle_comp->particle_type = particle_type;
-
-            // Adjust scale
-            glm::vec3 const scale_factor = glm::linearRand(start_min_particle_size, start_max_particle_size);
-            particle->transform->set_local_scale(scale_factor);
+            static_cast<void>(emit(m_spawn_data_vector[i], emitter_position));
 
             AK::swap_and_erase(m_spawn_data_vector, i);
             i -= 1;
@@ -119,11 +186,169 @@ void ParticleSystem::update_system()
         }
 
         if (play_once && m_spawn_data_vector.empty())
-            entity->destroy_immediate();
+            m_is_spawning_finished = true;
+
+        // Waits for the particles it spawned, they are destroyed with it
+        if (m_is_spawning_finished && m_particles.count == 0)
+            entity->destroy();
     }
+
     m_time_counter += delta_time;
 }
 
+bool ParticleSystem::emit(ParticleSpawnData const& data, glm::vec3 const& emitter_position)
+{
+    if (m_particles.count >= max_particle_count)
+        return false;
+
+    u32 const i = m_particles.add();
+
+    glm::vec3 const offset = {AK::random_float(-emitter_bounds, emitter_bounds), AK::random_float(-emitter_bounds, emitter_bounds),
+                              AK::random_float(-emitter_bounds, emitter_bounds)};
+
+    float const rotation_direction = AK::random_bool() ? 1.0f : -1.0f;
+    float rotation_speed = rotate_particles ? data.start_velocity.y * glm::radians(50.0f) : 0.0f;
+
+    m_particles.positions[i] = emitter_position + offset;
+    m_particles.velocities[i] = data.start_velocity;
+    m_particles.colors[i] = data.start_color_1;
+    m_particles.ages[i] = 0.0f;
+    m_particles.lifetimes[i] = data.lifetime;
+    m_particles.seeds[i] = AK::random_float(-1.0f, 1.0f);
+    m_particles.sizes[i] = glm::vec2(glm::linearRand(start_min_particle_size, start_max_particle_size));
+    m_particles.rotations[i] = rotate_particles ? glm::radians(AK::random_float(0.0f, 360.0f)) : 0.0f;
+    m_particles.origins[i] = emitter_position;
+    m_particles.targets[i] = emitter_position;
+
+    if (particle_type == ParticleType::Fish)
+    {
+        // Fish swim to the customers from wherever the emitter is
+        glm::vec3 const fish_offset = {AK::random_float(-data.start_velocity.y, data.start_velocity.y),
+                                       AK::random_float(-data.start_velocity.y, data.start_velocity.y),
+                                       AK::random_float(-data.start_velocity.y, data.start_velocity.y)};
+
+        glm::vec3 customer_group_position = emitter_position;
+        auto const game_controller = GameController::get_instance();
+
+        if (game_controller != nullptr && !game_controller->get_customer_manager_entity().expired())
+        {
+            customer_group_position =
+                game_controller->get_customer_manager_entity().lock()->transform->get_position() + glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+
+        m_particles.origins[i] = emitter_position + fish_offset;
+        m_particles.targets[i] = customer_group_position + fish_offset;
+        rotation_speed += data.start_velocity.y * glm::radians(600.0f);
+    }
+
+    m_particles.rotation_speeds[i] = rotation_speed * rotation_direction;
+
+    return true;
+}
+
+namespace
+{
+
+// Simulation kernels of the particle types, each one moves all live particles of an emitter in one loop
+
+void move_default(ParticleBuffer& particles, float const delta_time)
+{
+    for (u32 i = 0; i < particles.count; ++i)
+        particles.positions[i] += particles.velocities[i] * delta_time;
+}
+
+void move_prompt(ParticleBuffer& particles)
+{
+    for (u32 i = 0; i < particles.count; ++i)
+        particles.positions[i] = particles.origins[i] + glm::vec3(0.0f, std::sin(particles.ages[i] * 5.0f) * 0.1f, 0.0f);
+}
+
+void move_snow(ParticleBuffer& particles, float const delta_time, float const time)
+{
+    // Sways sideways while falling down
+    for (u32 i = 0; i < particles.count; ++i)
+    {
+        float const sway = std::sin(time + particles.seeds[i] * 1.5f) * 0.035f - delta_time * 1.7f;
+        particles.positions[i] += glm::vec3(sway, -delta_time * 6.5f, sway);
+    }
+}
+
+void move_fish(ParticleBuffer& particles)
+{
+    for (u32 i = 0; i < particles.count; ++i)
+        particles.positions[i] = glm::mix(particles.origins[i], particles.targets[i], particles.ages[i] / particles.lifetimes[i]);
+}
+
+}
+
+void ParticleSystem::simulate(float const delta_time, float const time)
+{
+    for (u32 i = 0; i < m_particles.count; ++i)
+        m_particles.ages[i] += delta_time;
+
+    for (u32 i = 0; i < m_particles.count;)
+    {
+        if (m_particles.ages[i] >= m_particles.lifetimes[i])
+            m_particles.remove(i);
+        else
+            ++i;
+    }
+
+    switch (particle_type)
+    {
+    case ParticleType::Prompt:
+        move_prompt(m_particles);
+        break;
+    case ParticleType::Snow:
+        move_snow(m_particles, delta_time, time);
+        break;
+    case ParticleType::Fish:
+        move_fish(m_particles);
+        break;
+    default:
+        move_default(m_particles, delta_time);
+        break;
+    }
+
+    for (u32 i = 0; i < m_particles.count; ++i)
+        m_particles.rotations[i] += m_particles.rotation_speeds[i] * delta_time;
+
+    for (u32 i = 0; i < m_particles.count; ++i)
+        m_particles.colors[i] = AK::interpolate_color(start_color_1, end_color_1, m_particles.ages[i] / m_particles.lifetimes[i]);
+}
+
+ParticleBuffer const& ParticleSystem::get_particles() const
+{
+    return m_particles;
+}
+
+u32 ParticleSystem::write_instances(std::span<ParticleInstance> const instances) const
+{
+    u32 const count = std::min(m_particles.count, static_cast<u32>(instances.size()));
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        instances[i].position = m_particles.positions[i];
+        instances[i].rotation = m_particles.rotations[i];
+        instances[i].size = m_particles.sizes[i];
+        instances[i].color = m_particles.colors[i];
+    }
+
+    return count;
+}
+
+void ParticleSystem::create_drawable()
+{
+    // Use a fake guid so that we don't have to use performance-heavy guid RNG.
+    // A child of the emitter, so transparent drawables are sorted by the emitter position.
+    m_drawable_entity = Entity::create("1", "PARTICLES");
+    m_drawable_entity->is_serialized = false;
+    m_drawable_entity->transform->set_parent(entity->transform);
+
+    m_drawable = m_drawable_entity->add_component(
+        Particle::create(std::static_pointer_cast<ParticleSystem>(shared_from_this()), sprite_path, m_particle_shader));
+}
+
 void ParticleSystem::spawn_calculations()
 {
     m_spawn_data_vector.clear();
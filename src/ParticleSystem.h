@@ -3,9 +3,15 @@
 #include "AK/Badge.h"
 #include "AK/Types.h"
 #include "Component.h"
+#include "ConstantBufferTypes.h"
 #include "Shader.h"
 
+#include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
+#include <span>
+#include <vector>
+
+class Particle;
 
 enum class ParticleType
 {
@@ -29,6 +35,36 @@ struct ParticleSpawnData
     bool simulate_in_world_space = false;
 };
 
+// Every live particle of one emitter as a structure of arrays, so every step of the simulation runs over the few arrays
+// it needs in one loop. Live particles are the first count elements of every array. A particle that dies is replaced by
+// the last live one, and its slot is reused by the next particle, so nothing is allocated once the emitter stops growing.
+struct ParticleBuffer
+{
+    // Returns the index of the new particle, every property of it has to be set.
+    u32 add();
+    void remove(u32 const index);
+    void clear();
+
+    std::vector<glm::vec3> positions = {};
+    std::vector<glm::vec3> velocities = {};
+    std::vector<glm::vec4> colors = {};
+    std::vector<float> ages = {};
+    std::vector<float> lifetimes = {};
+    std::vector<float> seeds = {};
+
+    std::vector<glm::vec2> sizes = {};
+    std::vector<float> rotations = {};
+    std::vector<float> rotation_speeds = {};
+
+    // Prompt particles bob around their origin, fish swim from their origin to their target
+    std::vector<glm::vec3> origins = {};
+    std::vector<glm::vec3> targets = {};
+
+    u32 count = 0;
+};
+
+// Spawns particles around its entity and simulates all of them together, with the kernel of its particle type.
+// Particles aren't entities. They are drawn by a Particle drawable on an entity the system creates, with one instanced draw.
 class ParticleSystem final : public Component
 {
 public:
@@ -36,6 +72,7 @@ public:
     explicit ParticleSystem(AK::Badge<ParticleSystem>);
 
     virtual void awake() override;
+    virtual void uninitialize() override;
 
 #if EDITOR
     virtual void draw_editor() override;
@@ -44,6 +81,21 @@ public:
     virtual void update() override;
     void update_system();
 
+    // Adds a particle around the position, returns false if the emitter already has max_particle_count particles.
+    bool emit(ParticleSpawnData const& data, glm::vec3 const& emitter_position);
+
+    // Ages, moves, rotates and colors every live particle, and removes the ones that lived their whole lifetime.
+    // Time is the time since the engine started, snow sways with it.
+    void simulate(float const delta_time, float const time);
+
+    [[nodiscard]] ParticleBuffer const& get_particles() const;
+
+    // Writes the live particles as instances for drawing, returns how many were written.
+    u32 write_instances(std::span<ParticleInstance> const instances) const;
+
+    // Particles of one emitter are drawn at once, from a buffer that fits this many of them
+    static constexpr u32 max_particle_count = 1 << 17;
+
     ParticleType particle_type = ParticleType::Default;
 
     bool play_once = false;
@@ -78,12 +130,21 @@ public:
 
 private:
     void spawn_calculations();
+    void create_drawable();
 
     std::shared_ptr<Shader> m_particle_shader = {};
 
+    ParticleBuffer m_particles = {};
+    std::shared_ptr<Entity> m_drawable_entity = {};
+    std::shared_ptr<Particle> m_drawable = {};
+
+    // Particles follow the emitter when they are simulated in its space
+    glm::vec3 m_last_emitter_position = {};
+
     std::vector<ParticleSpawnData> m_spawn_data_vector = {};
     u32 m_random_spawn_count = 0;
     double m_time_counter = 0.0;
     double m_spawn_interval = 0.0;
     bool m_first_time_spawning = true;
+    bool m_is_spawning_finished = false;
 };
@@ -1,6 +1,7 @@
 #include "PhysicsEngine.h"
 
 #include "AK/AK.h"
+#include "AK/LinearArena.h"
 #include "AK/Math.h"
 #include "Debug.h"
 #include "Engine.h"
@@ -122,8 +123,9 @@ void PhysicsEngine::solve_collisions() const
             if (i == j || (colliders[i]->is_static && colliders[j]->is_static))
                 continue;
 
-            std::shared_ptr<Collider2D> collider1 = colliders[i];
-            std::shared_ptr<Collider2D> collider2 = colliders[j];
+            // Copies, callbacks can add or remove colliders
+            std::shared_ptr<Collider2D> const collider1 = colliders[i];
+            std::shared_ptr<Collider2D> const collider2 = colliders[j];
 
             bool const should_overlap_as_trigger = collider1->is_trigger || collider2->is_trigger;
 
@@ -139,16 +141,16 @@ void PhysicsEngine::solve_collisions() const
                 collider1->add_overlapped_this_frame(collider2);
 
 #if _DEBUG
-                if (collider1->is_inside_trigger(collider2->guid))
+                if (collider1->is_inside_trigger(collider2->get_handle()))
                 {
-                    if (!collider2->is_inside_trigger(collider1->guid))
+                    if (!collider2->is_inside_trigger(collider1->get_handle()))
                     {
                         Debug::log("Colllider2 does not have collider1 inside trigger, but the opposite is true", DebugType::Error);
                     }
                 }
                 else
                 {
-                    if (collider2->is_inside_trigger(collider1->guid))
+                    if (collider2->is_inside_trigger(collider1->get_handle()))
                     {
                         Debug::log("Colllider1 does not have collider2 inside trigger, but the opposite is true", DebugType::Error);
                     }
@@ -180,41 +182,48 @@ void PhysicsEngine::solve_collisions() const
         }
     }
 
-    for (auto const& collider : colliders)
+    // Triggers are called on copies of the lists, callbacks can add or remove colliders and change what they overlap
+    std::pmr::vector<std::shared_ptr<Collider2D>> const colliders_copy(colliders.begin(), colliders.end(), &AK::frame_arena());
+
+    for (auto const& collider : colliders_copy)
     {
-        std::unordered_map<std::string, std::weak_ptr<Collider2D>> new_inside_trigger = {};
-        std::vector<std::weak_ptr<Collider2D>> new_inside_trigger_vector = {};
+        std::pmr::vector<AK::Handle<Component>> const overlapping(collider->get_all_overlapping_this_frame().begin(),
+                                                                  collider->get_all_overlapping_this_frame().end(), &AK::frame_arena());
+        std::pmr::vector<AK::Handle<Component>> const inside_trigger(collider->get_inside_trigger().begin(),
+                                                                     collider->get_inside_trigger().end(), &AK::frame_arena());
 
-        for (auto const& other : collider->get_all_overlapping_this_frame())
+        std::pmr::vector<AK::Handle<Component>> new_inside_trigger(&AK::frame_arena());
+        new_inside_trigger.reserve(overlapping.size());
+
+        for (auto const other : overlapping)
         {
-            if (other.expired())
-                continue;
+            auto* const other_collider = static_cast<Collider2D*>(AK::resolve(other));
 
-            auto const other_locked = other.lock();
+            if (other_collider == nullptr)
+                continue;
 
-            new_inside_trigger.emplace(other_locked->guid, other);
-            new_inside_trigger_vector.emplace_back(other);
+            new_inside_trigger.emplace_back(other);
 
-            if (!collider->is_inside_trigger(other_locked->guid))
+            if (!collider->is_inside_trigger(other))
             {
-                on_trigger_enter(collider, other_locked);
+                on_trigger_enter(collider, std::static_pointer_cast<Collider2D>(other_collider->shared_from_this()));
             }
         }
 
-        for (auto const& other : collider->get_inside_trigger_vector())
+        for (auto const other : inside_trigger)
         {
-            if (other.expired())
-                continue;
+            auto* const other_collider = static_cast<Collider2D*>(AK::resolve(other));
 
-            auto const other_locked = other.lock();
+            if (other_collider == nullptr)
+                continue;
 
-            if (!new_inside_trigger.contains(other_locked->guid))
+            if (!collider->is_overlapping_this_frame(other))
             {
-                on_trigger_exit(collider, other_locked);
+                on_trigger_exit(collider, std::static_pointer_cast<Collider2D>(other_collider->shared_from_this()));
             }
         }
 
-        collider->set_inside_trigger(new_inside_trigger, new_inside_trigger_vector);
+        collider->set_inside_trigger(new_inside_trigger);
         collider->clear_overlapped_this_frame();
     }
 }
@@ -0,0 +1,184 @@
+#include "PrefabStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Debug.h"
+#include "Entity.h"
+#include "ResourceManager.h"
+#include "SceneSerializer.h"
+
+PrefabLoadHandle::PrefabLoadHandle(std::string const& prefab_name) : m_prefab_name(prefab_name)
+{
+}
+
+PrefabLoadHandle::~PrefabLoadHandle()
+{
+    if (m_state == PrefabLoadState::Uploading || m_state == PrefabLoadState::Ready)
+    {
+        for (auto const& [path, data] : m_result.models)
+        {
+            Model::unstage_model_data(path);
+        }
+    }
+}
+
+PrefabLoadState PrefabLoadHandle::get_state() const
+{
+    return m_state;
+}
+
+bool PrefabLoadHandle::is_ready() const
+{
+    return m_state == PrefabLoadState::Ready;
+}
+
+bool PrefabLoadHandle::has_failed() const
+{
+    return m_state == PrefabLoadState::Failed;
+}
+
+std::string const& PrefabLoadHandle::get_prefab_name() const
+{
+    return m_prefab_name;
+}
+
+std::shared_ptr<Entity> PrefabLoadHandle::instantiate()
+{
+    if (m_state != PrefabLoadState::Ready)
+    {
+        Debug::log("Prefab " + m_prefab_name + " is not ready to be instantiated.", DebugType::Error);
+        return nullptr;
+    }
+
+    // Models read on the worker thread are used by Model::load_model()
+    std::shared_ptr<Entity> entity = SceneSerializer::load_parsed_prefab(*m_result.prefab);
+
+    for (auto const& [path, data] : m_result.models)
+    {
+        Model::unstage_model_data(path);
+    }
+
+    m_result = {};
+    m_state = PrefabLoadState::Instantiated;
+
+    return entity;
+}
+
+PrefabStreamer& PrefabStreamer::get_instance()
+{
+    static PrefabStreamer instance;
+    return instance;
+}
+
+std::shared_ptr<PrefabLoadHandle> PrefabStreamer::load_prefab_async(std::string const& prefab_name)
+{
+    auto handle = std::make_shared<PrefabLoadHandle>(prefab_name);
+    handle->m_future = std::async(std::launch::async, &PrefabStreamer::read_prefab, prefab_name);
+
+    m_loads.emplace_back(handle);
+    return handle;
+}
+
+void PrefabStreamer::update()
+{
+    auto const begin = std::chrono::high_resolution_clock::now();
+    auto const elapsed_ms = [&begin] {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    };
+
+    for (auto const& load : m_loads)
+    {
+        if (load->m_state == PrefabLoadState::Loading)
+        {
+            if (load->m_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                continue;
+
+            load->m_result = load->m_future.get();
+
+            if (load->m_result.prefab == nullptr)
+            {
+                Debug::log("Could not load prefab " + load->m_prefab_name + ".", DebugType::Error);
+                load->m_state = PrefabLoadState::Failed;
+                continue;
+            }
+
+            for (auto const& [path, data] : load->m_result.models)
+            {
+                Model::stage_model_data(path, data);
+            }
+
+            load->m_state = PrefabLoadState::Uploading;
+        }
+
+        if (load->m_state != PrefabLoadState::Uploading)
+            continue;
+
+        // Uploaded from the back, so finished images can be popped
+        auto& images = load->m_result.images;
+        while (!images.empty() && elapsed_ms() < upload_budget_ms)
+        {
+            auto& [path, type, image] = images.back();
+
+            TextureLoader::stage_image(path, std::move(image));
+            load->m_result.textures.emplace_back(ResourceManager::get_instance().load_texture(path, type, Model::get_texture_settings()));
+            TextureLoader::unstage_image(path);
+
+            images.pop_back();
+        }
+
+        if (images.empty())
+            load->m_state = PrefabLoadState::Ready;
+    }
+
+    std::erase_if(m_loads, [](auto const& load) {
+        return load->m_state != PrefabLoadState::Loading && load->m_state != PrefabLoadState::Uploading;
+    });
+}
+
+StreamedPrefab PrefabStreamer::read_prefab(std::string const& prefab_name)
+{
+    StreamedPrefab result = {};
+    result.prefab = SceneSerializer::parse_prefab(prefab_name);
+
+    if (result.prefab == nullptr)
+        return result;
+
+    TextureSettings const texture_settings = Model::get_texture_settings();
+
+    auto const decode = [&](std::string const& path, TextureType const type) {
+        if (std::ranges::any_of(result.images, [&path](auto const& image) { return image.path == path; }))
+            return;
+
+        DecodedImage image = TextureLoader::read_image(path, type, texture_settings);
+
+        // Failed images are left to the main thread, which reports them when loading the texture
+        if (image.pixels != nullptr)
+            result.images.emplace_back(path, type, std::move(image));
+    };
+
+    for (auto const& model_path : result.prefab->model_paths)
+    {
+        auto data = Model::read_model_data(model_path);
+
+        if (data == nullptr)
+            continue;
+
+        for (auto const& mesh : data->meshes)
+        {
+            for (auto const& path : mesh.diffuse_texture_paths)
+            {
+                decode(path, TextureType::Diffuse);
+            }
+
+            for (auto const& path : mesh.specular_texture_paths)
+            {
+                decode(path, TextureType::Specular);
+            }
+        }
+
+        result.models.emplace_back(model_path, std::move(data));
+    }
+
+    return result;
+}
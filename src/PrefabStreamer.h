@@ -0,0 +1,96 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AK/Types.h"
+#include "Model.h"
+#include "TextureLoader.h"
+
+class Entity;
+struct ParsedPrefab;
+
+// Everything read on a worker thread for a single prefab.
+struct StreamedPrefab
+{
+    struct Image
+    {
+        std::string path = {};
+        TextureType type = TextureType::Diffuse;
+        DecodedImage image = {};
+    };
+
+    std::shared_ptr<ParsedPrefab> prefab = {};
+    std::vector<std::pair<std::string, std::shared_ptr<ModelData const>>> models = {};
+    std::vector<Image> images = {};
+
+    // Uploaded textures are kept referenced until the prefab is instantiated, so ResourceManager doesn't unload them
+    std::vector<std::shared_ptr<Texture>> textures = {};
+};
+
+enum class PrefabLoadState : u8
+{
+    Loading,
+    Uploading,
+    Ready,
+    Instantiated,
+    Failed,
+};
+
+class PrefabLoadHandle
+{
+public:
+    explicit PrefabLoadHandle(std::string const& prefab_name);
+    ~PrefabLoadHandle();
+
+    PrefabLoadHandle(PrefabLoadHandle const&) = delete;
+    PrefabLoadHandle& operator=(PrefabLoadHandle const&) = delete;
+
+    [[nodiscard]] PrefabLoadState get_state() const;
+    [[nodiscard]] bool is_ready() const;
+    [[nodiscard]] bool has_failed() const;
+    [[nodiscard]] std::string const& get_prefab_name() const;
+
+    // Creates the objects of the prefab and inserts them into the scene, all in the current frame.
+    // Can only be called once, after the handle is ready.
+    std::shared_ptr<Entity> instantiate();
+
+private:
+    std::string m_prefab_name = {};
+    PrefabLoadState m_state = PrefabLoadState::Loading;
+
+    std::future<StreamedPrefab> m_future = {};
+    StreamedPrefab m_result = {};
+
+    friend class PrefabStreamer;
+};
+
+// Loads prefabs in the background. Files are read, parsed and decoded on worker threads,
+// textures are uploaded on the main thread in update(), within a time budget every frame.
+class PrefabStreamer
+{
+public:
+    PrefabStreamer(PrefabStreamer const&) = delete;
+    void operator=(PrefabStreamer const&) = delete;
+    ~PrefabStreamer() = default;
+
+    static PrefabStreamer& get_instance();
+
+    [[nodiscard]] std::shared_ptr<PrefabLoadHandle> load_prefab_async(std::string const& prefab_name);
+
+    // Called once per frame on the main thread.
+    void update();
+
+    // How long update() can spend uploading textures every frame, shared by all loads. A texture that is started
+    // within the budget is always finished, so a frame can go over it by one texture.
+    double upload_budget_ms = 2.0;
+
+private:
+    PrefabStreamer() = default;
+
+    [[nodiscard]] static StreamedPrefab read_prefab(std::string const& prefab_name);
+
+    std::vector<std::shared_ptr<PrefabLoadHandle>> m_loads = {};
+};
@@ -1,6 +1,7 @@
 #include "Renderer.h"
 
 #include <array>
+#include <cmath>
 #include <format>
 #include <glad/glad.h>
 #include <glm/gtx/rotate_vector.hpp>
@@ -8,10 +9,13 @@
 #include <iostream>
 
 #include "AK/AK.h"
+#include "AK/LinearArena.h"
 #include "Camera.h"
 #include "Debug.h"
 #include "Engine.h"
 #include "Entity.h"
+#include "Model.h"
+#include "ShaderDX11.h"
 #include "ShaderFactory.h"
 #include "Skybox.h"
 
@@ -34,8 +38,6 @@ void Renderer::initialize()
     }
 
     initialize_buffers(max_size);
-
-    load_fonts();
 }
 
 void Renderer::uninitialize()
@@ -268,6 +270,9 @@ void Renderer::render() const
     if (Camera::get_main_camera() == nullptr)
         return;
 
+    // Once per frame, so shadow maps are drawn with the same levels of detail as the camera sees
+    select_lods();
+
     render_shadow_maps();
 
     // Premultiply projection and view matrices
@@ -412,6 +417,28 @@ void Renderer::render_single_shadow_map(glm::mat4 const& projection_view) const
     }
 }
 
+void Renderer::select_lods() const
+{
+    std::shared_ptr<Camera> const camera = Camera::get_main_camera();
+    glm::vec3 const camera_position = camera->get_position();
+    float const screen_scale = camera->height / (2.0f * std::tan(camera->fov * 0.5f));
+
+    for (auto const& shader : m_shaders)
+    {
+        for (auto const& material : shader->materials)
+        {
+            // Instanced drawables are drawn together with the meshes of the first one
+            if (material->is_gpu_instanced)
+                continue;
+
+            for (auto const& drawable : material->drawables)
+            {
+                drawable->select_lod(camera_position, screen_scale);
+            }
+        }
+    }
+}
+
 void Renderer::end_frame() const
 {
 }
@@ -434,14 +461,78 @@ void Renderer::reload_shaders() const
 {
     float const time = glfwGetTime();
 
+    // Every changed shader is compiled at once, so loading them one by one only reads bytecode
+    if (renderer_api == RendererApi::DirectX11)
+        ShaderDX11::compile_shaders(m_shaders);
+
     for (u32 i = 0; i < m_shaders.size(); i++)
     {
         m_shaders[i]->load_shader();
     }
 
+    if (renderer_api == RendererApi::DirectX11)
+        ShaderDX11::prune_shader_cache();
+
     Debug::log(std::format("Shader reload time: {}", glfwGetTime() - time));
 }
 
+u32 Renderer::reload_shaders(std::vector<std::string> const& changed_paths) const
+{
+    std::vector<std::shared_ptr<Shader>> changed_shaders = {};
+
+    for (auto const& shader : m_shaders)
+    {
+        if (std::ranges::any_of(changed_paths, [&](std::string const& path) { return shader->depends_on(path); }))
+            changed_shaders.emplace_back(shader);
+    }
+
+    if (changed_shaders.empty())
+        return 0;
+
+    if (renderer_api == RendererApi::DirectX11)
+        ShaderDX11::compile_shaders(changed_shaders);
+
+    for (auto const& shader : changed_shaders)
+        shader->load_shader();
+
+    return static_cast<u32>(changed_shaders.size());
+}
+
+u32 Renderer::reload_models(std::vector<std::string> const& changed_paths) const
+{
+    u32 reloaded_count = 0;
+
+    // Every drawable is registered in a material of a shader
+    for (auto const& shader : m_shaders)
+    {
+        for (auto const& material : shader->materials)
+        {
+            for (auto const& drawable : material->drawables)
+            {
+                auto const model = std::dynamic_pointer_cast<Model>(drawable);
+                auto const is_changed = [&](std::string const& path) { return model->depends_on(path); };
+
+                if (model == nullptr || !std::ranges::any_of(changed_paths, is_changed))
+                    continue;
+
+                // Instanced models are only prepared once per material, by the first one
+                if (material->first_drawable == drawable)
+                    material->first_drawable = nullptr;
+
+                model->reprepare();
+                model->calculate_bounding_box();
+
+                if (model->entity != nullptr)
+                    model->adjust_bounding_box();
+
+                ++reloaded_count;
+            }
+        }
+    }
+
+    return reloaded_count;
+}
+
 void Renderer::set_vsync(bool const enabled)
 {
     vsync_enabled = enabled;
@@ -518,24 +609,43 @@ void Renderer::draw_instanced(std::shared_ptr<Material> const& material, glm::ma
 
 void Renderer::draw_transparent(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
 {
-    std::vector<std::shared_ptr<Drawable>> transparent_drawables = {};
+    size_t transparent_drawables_count = 0;
 
     for (auto const& material : m_transparent_materials)
     {
-        transparent_drawables.insert(transparent_drawables.end(), material->drawables.begin(), material->drawables.end());
+        transparent_drawables_count += material->drawables.size();
     }
 
     std::shared_ptr<Camera> const camera = Camera::get_main_camera();
     glm::vec3 camera_position = camera->entity->transform->get_position();
 
-    std::ranges::sort(transparent_drawables, [&camera_position](std::shared_ptr<Drawable> const& a, std::shared_ptr<Drawable> const& b) {
-        float const distance_a = glm::distance2(camera_position, a->entity->transform->get_position());
-        float const distance_b = glm::distance2(camera_position, b->entity->transform->get_position());
-        return distance_a >= distance_b; // For back-to-front rendering
+    // Pointers to the shared pointers owned by materials, so sorting doesn't touch any reference counts.
+    // Distances are computed once instead of in every comparison.
+    struct TransparentDrawable
+    {
+        float distance = 0.0f;
+        std::shared_ptr<Drawable> const* drawable = nullptr;
+    };
+
+    std::pmr::vector<TransparentDrawable> transparent_drawables(&AK::frame_arena());
+    transparent_drawables.reserve(transparent_drawables_count);
+
+    for (auto const& material : m_transparent_materials)
+    {
+        for (auto const& drawable : material->drawables)
+        {
+            transparent_drawables.emplace_back(glm::distance2(camera_position, drawable->entity->transform->get_position()), &drawable);
+        }
+    }
+
+    std::ranges::sort(transparent_drawables, [](TransparentDrawable const& a, TransparentDrawable const& b) {
+        return a.distance > b.distance; // For back-to-front rendering
     });
 
-    for (auto const& drawable : transparent_drawables)
+    for (auto const& transparent_drawable : transparent_drawables)
     {
+        auto const& drawable = *transparent_drawable.drawable;
+
         drawable->material->shader->use();
 
         update_shader(drawable->material->shader, projection_view, projection_view_no_translation);
@@ -563,8 +673,9 @@ void Renderer::draw_transparent(glm::mat4 const& projection_view, glm::mat4 cons
     }
 }
 
-void Renderer::load_fonts()
+std::vector<Font> Renderer::add_font_resources()
 {
+    std::vector<Font> fonts = {};
     bool changed = false;
 
     for (auto const& path : std::filesystem::recursive_directory_iterator(m_font_path))
@@ -599,7 +710,7 @@ void Renderer::load_fonts()
         new_font.family_name = family_name;
 
         bool is_new = true;
-        for (auto& font : loaded_fonts)
+        for (auto& font : fonts)
         {
             if (font.family_name == family_name)
             {
@@ -611,7 +722,7 @@ void Renderer::load_fonts()
 
         if (is_new)
         {
-            loaded_fonts.emplace_back(new_font);
+            fonts.emplace_back(new_font);
         }
 
         // This might not return more than 0 if the font was already loaded or if it was loaded unsuccessfully, we can't tell for sure.
@@ -620,7 +731,7 @@ void Renderer::load_fonts()
             changed = true;
 
 #if _DEBUG
-            Debug::log("Loaded font: " + path.path().string());
+            std::cout << "Loaded font: " << path_str << "\n";
 #endif
         }
     }
@@ -629,6 +740,13 @@ void Renderer::load_fonts()
     {
         PostMessage(HWND_BROADCAST, WM_FONTCHANGE, 0, 0);
     }
+
+    return fonts;
+}
+
+void Renderer::set_loaded_fonts(std::vector<Font> fonts)
+{
+    loaded_fonts = std::move(fonts);
 }
 
 void Renderer::unload_fonts()
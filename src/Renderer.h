@@ -28,6 +28,7 @@ public:
     Renderer(Renderer const&) = delete;
     void operator=(Renderer const&) = delete;
 
+    // Fonts aren't loaded here, see add_font_resources().
     void initialize();
     void uninitialize();
 
@@ -59,6 +60,12 @@ public:
     void set_rendering_to_texture(bool const render_to_texture);
     void reload_shaders() const;
 
+    // Reloads only the shaders that depend on any of the files. Returns how many were reloaded.
+    u32 reload_shaders(std::vector<std::string> const& changed_paths) const;
+
+    // Reloads models read from any of the files. Returns how many were reloaded.
+    u32 reload_models(std::vector<std::string> const& changed_paths) const;
+
     void set_vsync(bool const enabled);
 
     virtual void set_rasterizer_draw_type(RasterizerDrawType const rasterizer_draw_type) = 0;
@@ -94,6 +101,13 @@ public:
 
     inline static std::vector<Font> loaded_fonts = {};
 
+    // Adds every font in the font directory to the system and returns them grouped by family.
+    // Can be called from any thread, so fonts are added while the renderer is created.
+    [[nodiscard]] static std::vector<Font> add_font_resources();
+
+    // Keeps fonts returned by add_font_resources(), they are removed from the system again by uninitialize().
+    static void set_loaded_fonts(std::vector<Font> fonts);
+
 protected:
     Renderer() = default;
     virtual ~Renderer() = default;
@@ -116,6 +130,7 @@ protected:
     void virtual perform_frustum_culling(std::shared_ptr<Material> const& material) const = 0;
     virtual void render_shadow_maps() const = 0;
     void render_single_shadow_map(glm::mat4 const& projection_view) const;
+    void select_lods() const;
 
     virtual void render_lighting_pass() const;
     virtual void render_geometry_pass(glm::mat4 const& projection_view) const;
@@ -159,7 +174,6 @@ protected:
 
 private:
     void draw_transparent(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const;
-    static void load_fonts();
     static void unload_fonts();
 
     struct MaterialWithOrder
@@ -13,6 +13,7 @@
 #include "Game/Player.h"
 #include "Input.h"
 #include "Model.h"
+#include "Particle.h"
 #include "ResourceManager.h"
 #include "ShaderFactory.h"
 #include "ShadingDefines.h"
@@ -73,6 +74,30 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
 
     assert(SUCCEEDED(hr));
 
+    // Every particle of an emitter is drawn from it with one draw call
+    D3D11_BUFFER_DESC particle_instance_desc = {};
+    particle_instance_desc.Usage = D3D11_USAGE_DYNAMIC;
+    particle_instance_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    particle_instance_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    particle_instance_desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    particle_instance_desc.ByteWidth = static_cast<UINT>(sizeof(ParticleInstance) * ParticleSystem::max_particle_count);
+    particle_instance_desc.StructureByteStride = sizeof(ParticleInstance);
+
+    hr = renderer->get_device()->CreateBuffer(&particle_instance_desc, nullptr, &renderer->m_particle_instance_buffer);
+
+    assert(SUCCEEDED(hr));
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC particle_instance_view_desc = {};
+    particle_instance_view_desc.Format = DXGI_FORMAT_UNKNOWN;
+    particle_instance_view_desc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    particle_instance_view_desc.Buffer.FirstElement = 0;
+    particle_instance_view_desc.Buffer.NumElements = ParticleSystem::max_particle_count;
+
+    hr = renderer->get_device()->CreateShaderResourceView(renderer->m_particle_instance_buffer, &particle_instance_view_desc,
+                                                          &renderer->m_particle_instance_view);
+
+    assert(SUCCEEDED(hr));
+
     glfwSetWindowSizeCallback(Engine::window->get_glfw_window(), on_window_resize);
 
     D3D11_BUFFER_DESC light_buffer_desc = {};
@@ -172,7 +197,12 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
     hr = renderer->get_device()->CreateSamplerState(&anisotropic_sampler_desc, &renderer->m_anisotropic_sampler_state);
     assert(SUCCEEDED(hr));
 
-    renderer->m_shadow_texture = ResourceManager::get_instance().load_texture("./res/textures/noise.jpg", TextureType::Diffuse);
+    // Every texel is a random rotation, filtering or compressing them would make the noise less random
+    TextureSettings noise_texture_settings = {};
+    noise_texture_settings.generate_mipmaps = false;
+    noise_texture_settings.compress = false;
+    renderer->m_shadow_texture =
+        ResourceManager::get_instance().load_texture("./res/textures/noise.jpg", TextureType::Diffuse, noise_texture_settings);
 
     renderer->m_skybox_entity = Entity::create_internal("Skybox");
     auto const skybox = renderer->m_skybox_entity->add_component_internal(SkyboxFactory::create());
@@ -777,18 +807,32 @@ void RendererDX11::set_particle_buffer(std::shared_ptr<Drawable> const& drawable
 {
     assert(drawable->is_particle());
 
+    // Rows of the view matrix are the axes of the camera in the world
+    glm::mat4 const view = Camera::get_main_camera()->get_view_matrix();
+
     ConstantBufferParticle particle_data = {};
-    particle_data.color = material->color;
+    particle_data.camera_right = glm::vec4(view[0][0], view[1][0], view[2][0], 0.0f);
+    particle_data.camera_up = glm::vec4(view[0][1], view[1][1], view[2][1], 0.0f);
 
     D3D11_MAPPED_SUBRESOURCE particle_mapped_resource = {};
-    HRESULT const hr = get_instance_dx11()->get_device_context()->Map(m_constant_buffer_particle, 0, D3D11_MAP_WRITE_DISCARD, 0,
-                                                                      &particle_mapped_resource);
+    HRESULT hr = get_device_context()->Map(m_constant_buffer_particle, 0, D3D11_MAP_WRITE_DISCARD, 0, &particle_mapped_resource);
     assert(SUCCEEDED(hr));
 
     CopyMemory(particle_mapped_resource.pData, &particle_data, sizeof(ConstantBufferParticle));
 
-    get_instance_dx11()->get_device_context()->Unmap(m_constant_buffer_particle, 0);
-    get_instance_dx11()->get_device_context()->PSSetConstantBuffers(4, 1, &m_constant_buffer_particle);
+    get_device_context()->Unmap(m_constant_buffer_particle, 0);
+    get_device_context()->VSSetConstantBuffers(4, 1, &m_constant_buffer_particle);
+
+    // Particles are written straight into the buffer, without copying them anywhere else first
+    D3D11_MAPPED_SUBRESOURCE instance_mapped_resource = {};
+    hr = get_device_context()->Map(m_particle_instance_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &instance_mapped_resource);
+    assert(SUCCEEDED(hr));
+
+    auto const particle = std::static_pointer_cast<Particle>(drawable);
+    particle->write_instances({static_cast<ParticleInstance*>(instance_mapped_resource.pData), ParticleSystem::max_particle_count});
+
+    get_device_context()->Unmap(m_particle_instance_buffer, 0);
+    get_device_context()->VSSetShaderResources(1, 1, &m_particle_instance_view);
 }
 
 void RendererDX11::set_camera_position_buffer(std::shared_ptr<Drawable> const& drawable) const
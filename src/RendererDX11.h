@@ -116,6 +116,8 @@ private:
     ID3D11Buffer* m_constant_buffer_ssao = nullptr;
     ID3D11Buffer* m_constant_buffer_psmisc = nullptr;
     ID3D11Buffer* m_constant_buffer_particle = nullptr;
+    ID3D11Buffer* m_particle_instance_buffer = nullptr;
+    ID3D11ShaderResourceView* m_particle_instance_view = nullptr;
     ID3D11DepthStencilView* m_depth_stencil_view = nullptr;
     ID3D11Texture2D* m_depth_stencil_buffer = nullptr;
     ID3D11DepthStencilState* m_depth_stencil_state = nullptr;
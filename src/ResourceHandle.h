@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "AK/Types.h"
+
+enum class ResourceLoadState : u8
+{
+    Loading,
+    Ready,
+    Failed,
+};
+
+// Resource loaded in the background by ResourceManager. All handles requested for the same resource
+// while it's loading share a single AsyncResource.
+template<typename T>
+struct AsyncResource
+{
+    ResourceLoadState state = ResourceLoadState::Loading;
+    std::shared_ptr<T> resource = {};
+    std::shared_ptr<T> placeholder = {};
+
+    // Called once the load has finished, successfully or not
+    std::vector<std::function<void()>> finished_callbacks = {};
+
+    void finish(std::shared_ptr<T> const& loaded_resource)
+    {
+        resource = loaded_resource;
+        state = resource != nullptr ? ResourceLoadState::Ready : ResourceLoadState::Failed;
+
+        auto const callbacks = std::move(finished_callbacks);
+        finished_callbacks.clear();
+
+        for (auto const& callback : callbacks)
+        {
+            callback();
+        }
+    }
+};
+
+// Returned right away by the async loading functions of ResourceManager. Until the resource is ready,
+// get() returns a placeholder. Handles are not thread-safe, only use them on the main thread.
+template<typename T>
+class ResourceHandle
+{
+public:
+    ResourceHandle() = default;
+
+    explicit ResourceHandle(std::shared_ptr<AsyncResource<T>> const& resource) : m_resource(resource)
+    {
+    }
+
+    [[nodiscard]] std::shared_ptr<T> get() const
+    {
+        if (m_resource == nullptr)
+            return nullptr;
+
+        return is_ready() ? m_resource->resource : m_resource->placeholder;
+    }
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return m_resource != nullptr;
+    }
+
+    [[nodiscard]] bool is_ready() const
+    {
+        return m_resource != nullptr && m_resource->state == ResourceLoadState::Ready;
+    }
+
+    [[nodiscard]] bool has_failed() const
+    {
+        return m_resource != nullptr && m_resource->state == ResourceLoadState::Failed;
+    }
+
+    // Called right away if the resource is already ready, never if loading it fails.
+    void on_ready(std::function<void(std::shared_ptr<T> const&)> callback) const
+    {
+        if (m_resource == nullptr || has_failed())
+            return;
+
+        if (is_ready())
+        {
+            callback(m_resource->resource);
+            return;
+        }
+
+        // Callbacks are owned by the resource, so it's alive whenever they are called
+        m_resource->finished_callbacks.emplace_back([resource = m_resource.get(), callback = std::move(callback)] {
+            if (resource->state == ResourceLoadState::Ready)
+                callback(resource->resource);
+        });
+    }
+
+private:
+    std::shared_ptr<AsyncResource<T>> m_resource = {};
+};
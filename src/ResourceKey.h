@@ -0,0 +1,59 @@
+#pragma once
+
+#include "AK/AK.h"
+#include "AK/Types.h"
+
+// Path interned by ResourceManager::intern_path(). Its hash is computed once, comparing two ids is comparing integers.
+struct PathId
+{
+    static u32 constexpr invalid_index = 0xFFFFFFFF;
+
+    u32 index = invalid_index;
+    u64 hash = 0;
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return index != invalid_index;
+    }
+
+    bool operator==(PathId const& other) const
+    {
+        return index == other.index;
+    }
+};
+
+enum class ResourceType : u8
+{
+    Texture,
+    Cubemap,
+    Shader,
+    Mesh,
+    Model,
+};
+
+// Identifies a cached resource. Everything that makes two resources with the same path different, like texture settings,
+// other shader stages or the geometry of a mesh, is folded into settings_hash.
+struct ResourceKey
+{
+    PathId path = {};
+    ResourceType type = ResourceType::Texture;
+    u64 settings_hash = 0;
+
+    bool operator==(ResourceKey const&) const = default;
+};
+
+struct ResourceKeyHash
+{
+    u64 operator()(ResourceKey const& key) const
+    {
+        return AK::hash_combine(AK::hash_combine(key.path.hash, static_cast<u64>(key.type)), key.settings_hash);
+    }
+};
+
+struct PathHash
+{
+    u64 operator()(std::string const& path) const
+    {
+        return AK::fnv1a_hash64(path);
+    }
+};
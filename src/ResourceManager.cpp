@@ -2,12 +2,37 @@
 
 #include "Globals.h"
 
+#include <algorithm>
+#include <chrono>
+#include <format>
 #include <iostream>
-#include <sstream>
+#include <string_view>
+#include <unordered_set>
 
+#include "Debug.h"
 #include "MeshFactory.h"
 #include "ShaderFactory.h"
 #include "TextureLoader.h"
+#include "VirtualFileSystem.h"
+
+namespace
+{
+
+// Textures are uploaded as RGBA8 without mipmaps
+u64 get_texture_size(Texture const& texture, u32 const face_count = 1)
+{
+    if (texture.memory_size != 0)
+        return texture.memory_size * face_count;
+
+    return static_cast<u64>(texture.width) * texture.height * 4 * face_count;
+}
+
+double to_mb(u64 const bytes)
+{
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+}
 
 ResourceManager& ResourceManager::get_instance()
 {
@@ -15,17 +40,36 @@ ResourceManager& ResourceManager::get_instance()
     return instance;
 }
 
+PathId ResourceManager::intern_path(std::string const& path)
+{
+    u64 const hash = AK::fnv1a_hash64(path);
+
+    if (PathId const* id = m_path_ids.find(path, hash); id != nullptr)
+        return *id;
+
+    PathId const id = {static_cast<u32>(m_paths.size()), hash};
+    m_paths.emplace_back(path);
+    m_path_ids.insert_or_assign(path, id, hash);
+
+    return id;
+}
+
+std::string const& ResourceManager::get_path(PathId const id) const
+{
+    return m_paths[id.index];
+}
+
 std::shared_ptr<Texture> ResourceManager::load_texture(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
-    std::string const& key = path; // No need to even call generate_key()
-    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+    ResourceKey const key = {intern_path(path), ResourceType::Texture, hash_texture_settings(type, settings)};
+    std::shared_ptr<Texture> resource_ptr = get_from_cache<Texture>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = TextureLoader::get_instance()->load_texture(path, type, settings);
-    m_textures.emplace_back(resource_ptr);
-    names_to_textures.insert(std::pair<std::string, u16>(key, m_textures.size() - 1));
+    resource_ptr->settings = settings;
+    add_to_cache(key, resource_ptr, get_texture_size(*resource_ptr));
 
     return resource_ptr;
 }
@@ -35,69 +79,62 @@ std::shared_ptr<Texture> ResourceManager::load_cubemap(std::vector<std::string>
 {
     assert(paths.size() >= 6);
 
-    std::stringstream stream;
-    stream << paths[0] << paths[1] << paths[2] << paths[3] << paths[4] << paths[5];
-    std::string const& key = generate_key(stream);
-    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+    u64 settings_hash = hash_texture_settings(type, settings);
+    for (size_t i = 1; i < 6; ++i)
+    {
+        settings_hash = AK::hash_combine(settings_hash, intern_path(paths[i]).hash);
+    }
+
+    ResourceKey const key = {intern_path(paths[0]), ResourceType::Cubemap, settings_hash};
+    std::shared_ptr<Texture> resource_ptr = get_from_cache<Texture>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = TextureLoader::get_instance()->load_cubemap(paths, type, settings);
-    m_textures.emplace_back(resource_ptr);
-    names_to_textures.insert(std::make_pair(key, m_textures.size() - 1));
+    add_to_cache(key, resource_ptr, get_texture_size(*resource_ptr, 6));
 
     return resource_ptr;
 }
 
 std::shared_ptr<Texture> ResourceManager::load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
-    std::stringstream stream;
-    stream << path;
-    std::string const& key = generate_key(stream);
-    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+    ResourceKey const key = {intern_path(path), ResourceType::Cubemap, hash_texture_settings(type, settings)};
+    std::shared_ptr<Texture> resource_ptr = get_from_cache<Texture>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = TextureLoader::get_instance()->load_cubemap(path, type, settings);
-    m_textures.emplace_back(resource_ptr);
-    names_to_textures.insert(std::make_pair(key, m_textures.size() - 1));
+    add_to_cache(key, resource_ptr, get_texture_size(*resource_ptr, 6));
 
     return resource_ptr;
 }
 
 std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& compute_path)
 {
-    std::stringstream stream;
-    stream << compute_path;
-    std::string const& key = generate_key(stream);
-    auto resource_ptr = get_from_vector<Shader>(key);
+    ResourceKey const key = {intern_path(compute_path), ResourceType::Shader, 0};
+    auto resource_ptr = get_from_cache<Shader>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = ShaderFactory::create(compute_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+    add_to_cache(key, resource_ptr, 0);
 
     return resource_ptr;
 }
 
 std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& fragment_path)
 {
-    std::stringstream stream;
-    stream << vertex_path << fragment_path;
-    std::string const& key = generate_key(stream);
-
-    auto resource_ptr = get_from_vector<Shader>(key);
+    ResourceKey const key = {intern_path(vertex_path), ResourceType::Shader, intern_path(fragment_path).hash};
+    auto resource_ptr = get_from_cache<Shader>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = ShaderFactory::create(vertex_path, fragment_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+    add_to_cache(key, resource_ptr, 0);
 
     return resource_ptr;
 }
@@ -105,18 +142,15 @@ std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_p
 std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& fragment_path,
                                                      std::string const& geometry_path)
 {
-    std::stringstream stream;
-    stream << vertex_path << fragment_path << geometry_path;
-    std::string const& key = generate_key(stream);
-
-    auto resource_ptr = get_from_vector<Shader>(key);
+    u64 const settings_hash = AK::hash_combine(intern_path(fragment_path).hash, intern_path(geometry_path).hash);
+    ResourceKey const key = {intern_path(vertex_path), ResourceType::Shader, settings_hash};
+    auto resource_ptr = get_from_cache<Shader>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = ShaderFactory::create(vertex_path, fragment_path, geometry_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+    add_to_cache(key, resource_ptr, 0);
 
     return resource_ptr;
 }
@@ -124,18 +158,18 @@ std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_p
 std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& tessellation_control_path,
                                                      std::string const& tessellation_evaluation_path, std::string const& fragment_path)
 {
-    std::stringstream stream;
-    stream << vertex_path << tessellation_control_path << tessellation_evaluation_path << fragment_path;
-    std::string const& key = generate_key(stream);
+    u64 settings_hash = intern_path(tessellation_control_path).hash;
+    settings_hash = AK::hash_combine(settings_hash, intern_path(tessellation_evaluation_path).hash);
+    settings_hash = AK::hash_combine(settings_hash, intern_path(fragment_path).hash);
 
-    auto resource_ptr = get_from_vector<Shader>(key);
+    ResourceKey const key = {intern_path(vertex_path), ResourceType::Shader, settings_hash};
+    auto resource_ptr = get_from_cache<Shader>(key);
 
     if (resource_ptr != nullptr)
         return resource_ptr;
 
     resource_ptr = ShaderFactory::create(vertex_path, tessellation_control_path, tessellation_evaluation_path, fragment_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+    add_to_cache(key, resource_ptr, 0);
 
     return resource_ptr;
 }
@@ -143,51 +177,417 @@ std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_p
 std::shared_ptr<Mesh> ResourceManager::load_mesh(u32 const array_id, std::string const& name, std::vector<Vertex> const& vertices,
                                                  std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
                                                  DrawType const draw_type, std::shared_ptr<Material> const& material,
-                                                 DrawFunctionType const draw_function)
+                                                 DrawFunctionType const draw_function, bool const cpu_access,
+                                                 std::vector<MeshLod> const& lods)
 {
-    std::stringstream stream;
-    stream << name << array_id;
+    // Geometry is part of the key, so meshes with the same name never collide, even when the name doesn't describe the geometry.
+    // Textures are compared by identity, cached meshes keep their textures alive, so the addresses can't be reused.
+    u64 settings_hash = AK::murmur_hash64(vertices.data(), vertices.size() * sizeof(Vertex), array_id);
+    settings_hash = AK::hash_combine(settings_hash, AK::murmur_hash64(indices.data(), indices.size() * sizeof(u32), 0));
+    settings_hash = AK::hash_combine(settings_hash, static_cast<u64>(draw_type) << 8 | static_cast<u64>(draw_function));
+    settings_hash = AK::hash_combine(settings_hash, static_cast<u64>(cpu_access));
+    settings_hash = AK::hash_combine(settings_hash, AK::murmur_hash64(lods.data(), lods.size() * sizeof(MeshLod), 0));
 
     for (auto const& texture : textures)
     {
-        stream << texture->path;
+        settings_hash = AK::hash_combine(settings_hash, reinterpret_cast<uintptr_t>(texture.get()));
     }
 
-    std::string const& key = generate_key(stream);
+    ResourceKey const key = {intern_path(name), ResourceType::Mesh, settings_hash};
+    auto resource_ptr = get_from_cache<Mesh>(key);
+
+    if (resource_ptr != nullptr)
+        return resource_ptr;
+
+    resource_ptr = MeshFactory::create(vertices, indices, textures, draw_type, material, draw_function, cpu_access, lods);
+    add_to_cache(key, resource_ptr, resource_ptr->get_memory_size());
+
+    return resource_ptr;
+}
+
+ResourceHandle<Texture> ResourceManager::load_texture_async(std::string const& path, TextureType const type,
+                                                            TextureSettings const& settings)
+{
+    return ResourceHandle<Texture>(request_texture(path, type, settings));
+}
+
+ResourceHandle<ModelData const> ResourceManager::load_model_async(std::string const& path)
+{
+    ResourceKey const key = {intern_path(path), ResourceType::Model, 0};
+
+    if (auto const* existing = m_model_loads.find(key); existing != nullptr)
+        return ResourceHandle<ModelData const>(*existing);
+
+    auto const load = std::make_shared<AsyncResource<ModelData const>>();
+    load->placeholder = get_placeholder_model();
+    m_model_loads.insert_or_assign(key, load);
 
-    // HACK: We currently don't unload any resources including meshes, even in the editor.
-    //       Changing water parameters inside editor recreates the mesh (very similar to changing Sphere's parameters),
-    //       which creates lots of big meshes. To work around this we just unload the water mesh everytime someone asks for it.
-    if (name == "WATER")
+    get_thread_pool().enqueue([this, key, path] {
+        std::shared_ptr<ModelData const> data = Model::read_model_data(path);
+        push_completion([this, key, data] { load_model_textures(key, data); });
+    });
+
+    return ResourceHandle<ModelData const>(load);
+}
+
+u32 ResourceManager::reload_textures(std::vector<std::string> const& changed_paths)
+{
+    std::unordered_set<std::string> normalized_paths = {};
+
+    for (auto const& path : changed_paths)
+        normalized_paths.emplace(VirtualFileSystem::normalize_path(path));
+
+    u32 reloaded_count = 0;
+
+    for (auto& [key, entry] : m_textures)
     {
-        names_to_meshes.erase(key);
+        if (key.type != ResourceType::Texture || !normalized_paths.contains(VirtualFileSystem::normalize_path(get_path(key.path))))
+            continue;
+
+        std::shared_ptr<Texture> const& texture = entry.resource;
+        std::string const& path = get_path(key.path);
+
+        // Keeps the old image if the file is being written or was removed, the texture loader asserts on images it can't read
+        DecodedImage image = TextureLoader::read_image(path, texture->type, texture->settings);
+
+        if (image.pixels == nullptr)
+        {
+            Debug::log("Could not reload texture " + path + ".", DebugType::Error);
+            continue;
+        }
+
+        TextureLoader::stage_image(path, std::move(image));
+        auto const reloaded_texture = TextureLoader::get_instance()->load_texture(path, texture->type, texture->settings);
+        TextureLoader::unstage_image(path);
+
+        // Materials and meshes keep pointing at the same texture, the old GPU objects are released with reloaded_texture
+        reloaded_texture->settings = texture->settings;
+        std::swap(*texture, *reloaded_texture);
+
+        m_cached_bytes -= entry.size_bytes;
+        entry.size_bytes = get_texture_size(*texture);
+        m_cached_bytes += entry.size_bytes;
+        ++reloaded_count;
     }
 
-    auto resource_ptr = get_from_vector<Mesh>(key);
+    return reloaded_count;
+}
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+void ResourceManager::update()
+{
+    auto const begin = std::chrono::high_resolution_clock::now();
+    auto const elapsed_ms = [&begin] {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    };
 
-    resource_ptr = MeshFactory::create(vertices, indices, textures, draw_type, material, draw_function);
-    m_meshes.emplace_back(resource_ptr);
-    names_to_meshes.insert(std::make_pair(key, m_meshes.size() - 1));
+    do
+    {
+        if (!process_completion())
+            break;
+    } while (elapsed_ms() < upload_budget_ms);
+}
 
-    return resource_ptr;
+void ResourceManager::finish_async_loads()
+{
+    while (get_pending_load_count() > 0)
+    {
+        {
+            std::unique_lock lock(m_completions_mutex);
+            m_completion_available.wait(lock, [this] { return !m_completions.empty(); });
+        }
+
+        static_cast<void>(process_completion());
+    }
+}
+
+u32 ResourceManager::get_pending_load_count() const
+{
+    return static_cast<u32>(m_texture_loads.size() + m_model_loads.size());
+}
+
+void ResourceManager::set_async_loading_enabled(bool const enabled)
+{
+    m_async_loading_enabled = enabled;
+}
+
+bool ResourceManager::is_async_loading_enabled()
+{
+    return m_async_loading_enabled;
 }
 
 void ResourceManager::reset_state() const
 {
     // NOTE: When unloading a scene all entities should have already been destroyed,
     //       and their drawables, and thus materials, uninitialized - unregistered.
-    for (auto const& shader : m_shaders)
+    for (auto const& [key, shader] : m_shaders)
     {
-        shader->materials.clear();
+        shader.resource->materials.clear();
     }
 
     initialize_default_material();
 }
 
-std::string ResourceManager::generate_key(std::stringstream const& stream) const
+u64 ResourceManager::collect()
+{
+    // Meshes first, they hold references to their textures
+    u64 const freed_bytes = evict_unreferenced(m_meshes) + evict_unreferenced(m_textures);
+    m_cached_bytes -= freed_bytes;
+
+    return freed_bytes;
+}
+
+u64 ResourceManager::get_memory_usage() const
+{
+    return m_cached_bytes;
+}
+
+void ResourceManager::log_memory_report() const
+{
+    auto const log_cache = [](std::string_view const name, auto const& cache) {
+        u32 unreferenced_count = 0;
+        u64 bytes = 0;
+        u64 unreferenced_bytes = 0;
+
+        for (auto const& [key, entry] : cache)
+        {
+            bytes += entry.size_bytes;
+
+            if (entry.resource.use_count() == 1)
+            {
+                unreferenced_count += 1;
+                unreferenced_bytes += entry.size_bytes;
+            }
+        }
+
+        Debug::log(std::format("Resources: {} {}, {:.2f} MB, {} unreferenced ({:.2f} MB).", cache.size(), name, to_mb(bytes),
+                               unreferenced_count, to_mb(unreferenced_bytes)));
+    };
+
+    log_cache("textures", m_textures);
+    log_cache("meshes", m_meshes);
+    log_cache("shaders", m_shaders);
+
+    Debug::log(std::format("Resources: {:.2f} MB in total, budget {:.2f} MB.", to_mb(m_cached_bytes), to_mb(memory_budget_bytes)));
+}
+
+u64 ResourceManager::hash_texture_settings(TextureType const type, TextureSettings const& settings)
+{
+    u64 hash = static_cast<u64>(type);
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.wrap_mode_x));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.wrap_mode_y));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.wrap_mode_z));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.filtering_min));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.filtering_max));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.filtering_mipmap));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.generate_mipmaps));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.flip_vertically));
+    hash = AK::hash_combine(hash, static_cast<u64>(settings.compress));
+
+    return hash;
+}
+
+std::shared_ptr<AsyncResource<Texture>> ResourceManager::request_texture(std::string const& path, TextureType const type,
+                                                                         TextureSettings const& settings)
+{
+    ResourceKey const key = {intern_path(path), ResourceType::Texture, hash_texture_settings(type, settings)};
+
+    if (auto const* existing = m_texture_loads.find(key); existing != nullptr)
+        return *existing;
+
+    auto const load = std::make_shared<AsyncResource<Texture>>();
+
+    if (std::shared_ptr<Texture> const texture = get_from_cache<Texture>(key); texture != nullptr)
+    {
+        load->finish(texture);
+        return load;
+    }
+
+    load->placeholder = InternalMeshData::white_texture;
+    m_texture_loads.insert_or_assign(key, load);
+
+    get_thread_pool().enqueue([this, key, path, type, settings] {
+        DecodedImage image = TextureLoader::read_image(path, type, settings);
+
+        push_completion([this, key, path, type, settings, image = std::move(image)]() mutable {
+            std::shared_ptr<Texture> texture = nullptr;
+
+            // The texture loader asserts on images that can't be read, so they are only reported here
+            if (image.pixels != nullptr)
+            {
+                TextureLoader::stage_image(path, std::move(image));
+                texture = load_texture(path, type, settings);
+                TextureLoader::unstage_image(path);
+            }
+            else
+            {
+                Debug::log("Could not load texture " + path + ".", DebugType::Error);
+            }
+
+            auto const load = *m_texture_loads.find(key);
+            m_texture_loads.erase(key);
+            load->finish(texture);
+        });
+    });
+
+    return load;
+}
+
+void ResourceManager::load_model_textures(ResourceKey const& key, std::shared_ptr<ModelData const> const& data)
+{
+    auto const finish = [this, key, data] {
+        auto const load = *m_model_loads.find(key);
+        m_model_loads.erase(key);
+        load->finish(data);
+    };
+
+    if (data == nullptr)
+    {
+        finish();
+        return;
+    }
+
+    // Textures are requested on the main thread, so the ones already loaded aren't decoded again,
+    // and the ones shared with other loads in progress are only loaded once
+    std::vector<std::shared_ptr<AsyncResource<Texture>>> textures = {};
+    TextureSettings const settings = Model::get_texture_settings();
+
+    for (auto const& mesh : data->meshes)
+    {
+        for (auto const& texture_path : mesh.diffuse_texture_paths)
+        {
+            textures.emplace_back(request_texture(texture_path, TextureType::Diffuse, settings));
+        }
+
+        for (auto const& texture_path : mesh.specular_texture_paths)
+        {
+            textures.emplace_back(request_texture(texture_path, TextureType::Specular, settings));
+        }
+    }
+
+    std::erase_if(textures, [](auto const& texture) { return texture->state != ResourceLoadState::Loading; });
+
+    if (textures.empty())
+    {
+        finish();
+        return;
+    }
+
+    // Failed textures don't fail the model, Model::load_material_textures() reports them again.
+    // Textures stay referenced until the model is finished, so they can't be evicted in between.
+    auto const pending = std::make_shared<std::vector<std::shared_ptr<AsyncResource<Texture>>>>(std::move(textures));
+    auto const remaining = std::make_shared<size_t>(pending->size());
+    for (auto const& texture : *pending)
+    {
+        texture->finished_callbacks.emplace_back([pending, remaining, finish] {
+            *remaining -= 1;
+
+            if (*remaining == 0)
+                finish();
+        });
+    }
+}
+
+std::shared_ptr<ModelData const> ResourceManager::get_placeholder_model()
+{
+    if (m_placeholder_model == nullptr)
+    {
+        ModelMeshData mesh = {};
+        mesh.vertices = InternalMeshData::cube.vertices;
+        mesh.indices = InternalMeshData::cube.indices;
+        mesh.diffuse_texture_paths.emplace_back(InternalMeshData::white_texture->path);
+
+        auto data = std::make_shared<ModelData>();
+        data->meshes.emplace_back(std::move(mesh));
+        m_placeholder_model = std::move(data);
+    }
+
+    return m_placeholder_model;
+}
+
+void ResourceManager::push_completion(std::function<void()> completion)
+{
+    {
+        std::lock_guard lock(m_completions_mutex);
+        m_completions.emplace_back(std::move(completion));
+    }
+
+    m_completion_available.notify_one();
+}
+
+bool ResourceManager::process_completion()
+{
+    std::function<void()> completion = {};
+
+    {
+        std::lock_guard lock(m_completions_mutex);
+
+        if (m_completions.empty())
+            return false;
+
+        completion = std::move(m_completions.front());
+        m_completions.pop_front();
+    }
+
+    completion();
+    return true;
+}
+
+AK::ThreadPool& ResourceManager::get_thread_pool()
+{
+    if (m_thread_pool == nullptr)
+        m_thread_pool = std::make_unique<AK::ThreadPool>();
+
+    return *m_thread_pool;
+}
+
+template<typename T>
+void ResourceManager::evict_least_recently_used(ResourceCache<T>& cache)
+{
+    struct Candidate
+    {
+        u64 last_used = 0;
+        u64 size_bytes = 0;
+        ResourceKey key = {};
+    };
+
+    std::vector<Candidate> unreferenced = {};
+    for (auto const& [key, entry] : cache)
+    {
+        if (entry.resource.use_count() == 1)
+            unreferenced.push_back({entry.last_used, entry.size_bytes, key});
+    }
+
+    std::ranges::sort(unreferenced, {}, &Candidate::last_used);
+
+    for (auto const& candidate : unreferenced)
+    {
+        if (m_cached_bytes <= memory_budget_bytes)
+            return;
+
+        m_cached_bytes -= candidate.size_bytes;
+        cache.erase(candidate.key);
+    }
+}
+
+template<typename T>
+u64 ResourceManager::evict_unreferenced(ResourceCache<T>& cache)
+{
+    u64 freed_bytes = 0;
+
+    cache.erase_if([&freed_bytes](auto const& entry) {
+        if (entry.value.resource.use_count() > 1)
+            return false;
+
+        freed_bytes += entry.value.size_bytes;
+        return true;
+    });
+
+    return freed_bytes;
+}
+
+void ResourceManager::evict_over_budget()
 {
-    return stream.str();
+    // Meshes first, they hold references to their textures
+    evict_least_recently_used(m_meshes);
+    evict_least_recently_used(m_textures);
 }
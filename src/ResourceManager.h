@@ -1,20 +1,46 @@
 #pragma once
 
-#include <unordered_map>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <vector>
 
+#include "AK/FlatHashMap.h"
+#include "AK/ThreadPool.h"
 #include "AK/Types.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "ResourceHandle.h"
+#include "ResourceKey.h"
 #include "Shader.h"
 #include "Texture.h"
 
+template<typename T>
+struct CachedResource
+{
+    std::shared_ptr<T> resource = {};
+    // Estimated size on the GPU
+    u64 size_bytes = 0;
+    u64 last_used = 0;
+};
+
+template<typename T>
+using ResourceCache = AK::FlatHashMap<ResourceKey, CachedResource<T>, ResourceKeyHash>;
+
 // How ResourceManager works:
 //
-// 1. Generate key (each function may have its own implementation) and save it in a local variable.
-// 2. Call template method get_from_vector() specifying desired <TYPE> and providing the key. It will return either nullptr or a valid resource.
-// 3a. If a valid resource is returned by get_from_vector(), you've got your resource!
-// 3b. If a nullptr is returned by get_from_vector(), an internal loading function is called and the returned value is added to vector along with key and ID to the map.
+// 1. Generate a ResourceKey from interned paths and a hash of everything else that makes the resource unique.
+// 2. Call template method get_from_cache() specifying desired <TYPE> and providing the key. It will return either nullptr or a valid resource.
+// 3a. If a valid resource is returned by get_from_cache(), you've got your resource!
+// 3b. If a nullptr is returned by get_from_cache(), an internal loading function is called and the returned value is added to the cache.
+//
+// Resources are shared pointers, a resource is unreferenced when the cache holds the only reference to it.
+// Unreferenced resources are unloaded by collect(), or when the cache grows over memory_budget_bytes, least recently used first.
+//
+// Async variants return a handle right away. Files are read and decoded on worker threads, and the results are pushed
+// to a completion queue, which update() processes on the main thread, where resources are created on the GPU.
+// Requests for a resource that is already loading share its handle.
 class ResourceManager
 {
 public:
@@ -24,6 +50,10 @@ public:
 
     static ResourceManager& get_instance();
 
+    // Paths are interned once and never removed. Ids are only valid in the ResourceManager that interned them.
+    [[nodiscard]] PathId intern_path(std::string const& path);
+    [[nodiscard]] std::string const& get_path(PathId const id) const;
+
     std::shared_ptr<Texture> load_texture(std::string const& path, TextureType const type, TextureSettings const& settings = {});
     std::shared_ptr<Texture> load_cubemap(std::vector<std::string> const& paths, TextureType const type,
                                           TextureSettings const& settings = {});
@@ -38,62 +68,128 @@ public:
     std::shared_ptr<Mesh> load_mesh(u32 const array_id, std::string const& name, std::vector<Vertex> const& vertices,
                                     std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
                                     DrawType const draw_type, std::shared_ptr<Material> const& material,
-                                    DrawFunctionType const draw_function = DrawFunctionType::Indexed);
+                                    DrawFunctionType const draw_function = DrawFunctionType::Indexed, bool const cpu_access = false,
+                                    std::vector<MeshLod> const& lods = {});
+
+    // Returns white_texture until the texture is ready.
+    [[nodiscard]] ResourceHandle<Texture> load_texture_async(std::string const& path, TextureType const type,
+                                                             TextureSettings const& settings = {});
+
+    // Returns a cube until the model file and all of its textures are loaded. Meshes are created by the model itself.
+    [[nodiscard]] ResourceHandle<ModelData const> load_model_async(std::string const& path);
+
+    // Loads textures read from any of the files again, in place, so everything using them shows the new images.
+    // Cubemaps aren't reloaded. Returns how many textures were reloaded.
+    u32 reload_textures(std::vector<std::string> const& changed_paths);
+
+    // Called once per frame on the main thread.
+    void update();
+
+    // Blocks until every async load is finished, including the ones started by callbacks of finished loads.
+    void finish_async_loads();
+
+    [[nodiscard]] u32 get_pending_load_count() const;
+
+    // When enabled, models load asynchronously with a placeholder, unless they were read ahead of time.
+    static void set_async_loading_enabled(bool const enabled);
+    [[nodiscard]] static bool is_async_loading_enabled();
 
     void reset_state() const;
 
+    // Unloads every unreferenced texture and mesh, meant to be called at level transitions. Returns the number of freed bytes.
+    u64 collect();
+
+    [[nodiscard]] u64 get_memory_usage() const;
+    void log_memory_report() const;
+
+    // Memory the cache can use before unreferenced resources are unloaded.
+    u64 memory_budget_bytes = 512ull * 1024 * 1024;
+
+    // How long update() can spend on completed loads every frame. At least one completion is processed per frame.
+    double upload_budget_ms = 2.0;
+
 private:
     ResourceManager() = default;
 
+    [[nodiscard]] std::shared_ptr<AsyncResource<Texture>> request_texture(std::string const& path, TextureType const type,
+                                                                          TextureSettings const& settings);
+    void load_model_textures(ResourceKey const& key, std::shared_ptr<ModelData const> const& data);
+    [[nodiscard]] std::shared_ptr<ModelData const> get_placeholder_model();
+
+    // Can be called from any thread
+    void push_completion(std::function<void()> completion);
+    [[nodiscard]] bool process_completion();
+
+    [[nodiscard]] AK::ThreadPool& get_thread_pool();
+
     template<typename T>
-    std::shared_ptr<T> get_from_vector(std::string const& key)
+    ResourceCache<T>& get_cache()
     {
-        i32 id = -1;
-
-        // TODO: This can be automatized by extending EngineHeaderTool.
-        // For now it's good enough.
         if constexpr (std::is_same_v<T, Texture>)
-        {
-            auto const it = names_to_textures.find(key);
-            if (it != names_to_textures.end())
-            {
-                id = it->second;
-                return m_textures[id];
-            }
-        }
+            return m_textures;
         else if constexpr (std::is_same_v<T, Mesh>)
-        {
-            auto const it = names_to_meshes.find(key);
-            if (it != names_to_meshes.end())
-            {
-                id = it->second;
-                return m_meshes[id];
-            }
-        }
+            return m_meshes;
         else if constexpr (std::is_same_v<T, Shader>)
-        {
-            auto const it = names_to_shaders.find(key);
-            if (it != names_to_shaders.end())
-            {
-                id = it->second;
-                return m_shaders[id];
-            }
-        }
-
-        return nullptr;
+            return m_shaders;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> get_from_cache(ResourceKey const& key)
+    {
+        CachedResource<T>* entry = get_cache<T>().find(key);
+        if (entry == nullptr)
+            return nullptr;
+
+        entry->last_used = ++m_use_counter;
+        return entry->resource;
+    }
+
+    template<typename T>
+    void add_to_cache(ResourceKey const& key, std::shared_ptr<T> const& resource, u64 const size_bytes)
+    {
+        auto& cache = get_cache<T>();
+
+        if (CachedResource<T> const* existing = cache.find(key); existing != nullptr)
+            m_cached_bytes -= existing->size_bytes;
+
+        cache.insert_or_assign(key, CachedResource<T> {resource, size_bytes, ++m_use_counter});
+        m_cached_bytes += size_bytes;
+
+        if (m_cached_bytes > memory_budget_bytes)
+            evict_over_budget();
     }
 
-    [[nodiscard]] std::string generate_key(std::stringstream const& stream) const;
+    template<typename T>
+    void evict_least_recently_used(ResourceCache<T>& cache);
+    template<typename T>
+    u64 evict_unreferenced(ResourceCache<T>& cache);
+    void evict_over_budget();
+
+    [[nodiscard]] static u64 hash_texture_settings(TextureType const type, TextureSettings const& settings);
+
+    // Shaders are never unloaded, materials register themselves in them.
+    ResourceCache<Texture> m_textures = {};
+    ResourceCache<Mesh> m_meshes = {};
+    ResourceCache<Shader> m_shaders = {};
+
+    AK::FlatHashMap<std::string, PathId, PathHash> m_path_ids = {};
+    std::vector<std::string> m_paths = {};
 
-    // NOTE: RM currently doesn't allow unloadading any resources that were previously loaded.
-    std::vector<std::shared_ptr<Texture>> m_textures = {};
-    std::vector<std::shared_ptr<Mesh>> m_meshes = {};
-    std::vector<std::shared_ptr<Shader>> m_shaders = {};
+    u64 m_cached_bytes = 0;
+    u64 m_use_counter = 0;
 
-    // KEYS (usually generated from path and optionally additional data) | INDICES, in a respective vector.
-    std::unordered_map<std::string, u16> names_to_textures = {};
-    std::unordered_map<std::string, u16> names_to_meshes = {};
-    std::unordered_map<std::string, u16> names_to_shaders = {};
+    // Loads in progress
+    AK::FlatHashMap<ResourceKey, std::shared_ptr<AsyncResource<Texture>>, ResourceKeyHash> m_texture_loads = {};
+    AK::FlatHashMap<ResourceKey, std::shared_ptr<AsyncResource<ModelData const>>, ResourceKeyHash> m_model_loads = {};
+    std::shared_ptr<ModelData const> m_placeholder_model = {};
+
+    std::mutex m_completions_mutex = {};
+    std::condition_variable m_completion_available = {};
+    std::deque<std::function<void()>> m_completions = {};
 
     inline static std::shared_ptr<ResourceManager> m_instance;
+    inline static bool m_async_loading_enabled = false;
+
+    // Last, so workers are stopped before anything they use is destroyed
+    std::unique_ptr<AK::ThreadPool> m_thread_pool = {};
 };
@@ -1,7 +1,12 @@
 #include "Scene.h"
 
+#include <algorithm>
+#include <execution>
+
 #include "AK/AK.h"
+#include "Debug.h"
 #include "Entity.h"
+#include "EntityPool.h"
 #include "ResourceManager.h"
 
 void Scene::unload()
@@ -11,7 +16,7 @@ void Scene::unload()
     std::vector<std::shared_ptr<Entity>> top_level_entities = {};
     for (auto const& entity : entities)
     {
-        if (entity->transform->parent.expired())
+        if (!entity->transform->has_parent())
             top_level_entities.emplace_back(entity);
     }
 
@@ -20,24 +25,80 @@ void Scene::unload()
         entity->destroy_immediate();
     }
 
+    m_command_buffer.clear();
+
+    EntityPool::get_instance().clear();
+
     ResourceManager::get_instance().reset_state();
+    ResourceManager::get_instance().collect();
 }
 
 void Scene::add_child(std::shared_ptr<Entity> const& entity)
 {
-    entities.emplace_back(entity);
+    entity->m_scene_slot = entities.insert(entity);
 }
 
 void Scene::remove_child(std::shared_ptr<Entity> const& entity)
 {
-    auto const it = std::ranges::find(entities, entity);
+    bool const erased = entities.erase(entity->m_scene_slot);
+
+    assert(erased);
+
+    entity->m_scene_slot = {};
+
+    // Only the editor saves scenes, entities removed while the game runs don't look anything up
+    if (m_serialized_entities.empty())
+        return;
+
+    mark_dirty(entity);
+
+    if (auto const* parent = entity->transform->get_parent(); parent != nullptr && !parent->entity.expired())
+        mark_dirty(parent->entity.lock());
+
+    mark_referrers_dirty(entity->guid);
+
+    for (auto const& component : entity->components)
+        mark_referrers_dirty(component->guid);
+}
+
+bool Scene::contains(std::shared_ptr<Entity> const& entity) const
+{
+    return entities.contains(entity->m_scene_slot);
+}
+
+void Scene::mark_dirty(std::shared_ptr<Entity> const& entity)
+{
+    m_serialized_entities.erase(entity->guid);
+}
+
+void Scene::mark_all_dirty()
+{
+    m_serialized_entities.clear();
+    m_referrers.clear();
+}
 
-    assert(it != entities.end());
+void Scene::mark_referrers_dirty(std::string const& guid)
+{
+    auto const it = m_referrers.find(guid);
 
-    if (it == entities.end())
+    if (it == m_referrers.end())
         return;
 
-    entities.erase(it);
+    for (auto const& referrer_guid : it->second)
+        m_serialized_entities.erase(referrer_guid);
+
+    m_referrers.erase(it);
+}
+
+void Scene::mark_dirty_recursively(std::shared_ptr<Entity> const& entity)
+{
+    mark_dirty(entity);
+
+    for (auto const& child : entity->transform->children)
+    {
+        if (auto const child_entity = child->entity.lock(); child_entity != nullptr)
+            mark_dirty_recursively(child_entity);
+    }
 }
 
 void Scene::add_component_to_awake(std::shared_ptr<Component> const& component)
@@ -68,6 +129,143 @@ void Scene::remove_component_to_start(std::shared_ptr<Component> const& componen
     }
 }
 
+void Scene::add_tickable_component(std::shared_ptr<Component> const& component)
+{
+    if (m_is_updating)
+    {
+        m_command_buffer.add_tickable(component);
+        return;
+    }
+
+    std::type_index const type = typeid(*component);
+
+    auto const it = std::ranges::find_if(m_update_phases, [&type](UpdatePhase const& phase) { return phase.type == type; });
+
+    if (it != m_update_phases.end())
+    {
+        it->components.emplace_back(component);
+        return;
+    }
+
+    m_update_phases.emplace_back(type, component->is_parallel_update_safe(), std::vector {component});
+    m_is_update_order_dirty = true;
+}
+
+void Scene::remove_tickable_component(std::shared_ptr<Component> const& component)
+{
+    if (m_is_updating)
+    {
+        m_command_buffer.remove_tickable(component);
+        return;
+    }
+
+    std::type_index const type = typeid(*component);
+
+    auto const it = std::ranges::find_if(m_update_phases, [&type](UpdatePhase const& phase) { return phase.type == type; });
+
+    if (it == m_update_phases.end())
+        return;
+
+    AK::swap_and_erase(it->components, component);
+}
+
+void Scene::create_deferred(std::string const& name, std::function<void(std::shared_ptr<Entity> const&)> const& on_created)
+{
+    m_command_buffer.create_entity(name, on_created);
+}
+
+void Scene::destroy_deferred(std::shared_ptr<Entity> const& entity)
+{
+    m_command_buffer.destroy_entity(entity);
+}
+
+void Scene::destroy_deferred(std::shared_ptr<Component> const& component)
+{
+    m_command_buffer.destroy_component(component);
+}
+
+void Scene::release_to_pool_deferred(std::shared_ptr<Entity> const& entity)
+{
+    m_command_buffer.release_to_pool(entity);
+}
+
+void Scene::set_parent_deferred(std::shared_ptr<Transform> const& transform, std::shared_ptr<Transform> const& parent)
+{
+    m_command_buffer.set_parent(transform, parent);
+}
+
+void Scene::set_enabled_deferred(std::shared_ptr<Component> const& component, bool const enabled)
+{
+    m_command_buffer.set_enabled(component, enabled);
+}
+
+void Scene::play_back_commands()
+{
+    // Sync points are never reached during the update, but the commands themselves might change tickable components
+    bool const was_updating = m_is_updating;
+    m_is_updating = false;
+
+    // Commands executed here might record new commands, ex. when an entity created by a command is destroyed in on_created
+    while (!m_command_buffer.is_empty())
+    {
+        m_command_buffer.take_commands(m_commands_to_play_back);
+
+        for (auto const& command : m_commands_to_play_back)
+        {
+            switch (command.type)
+            {
+            case SceneCommandType::CreateEntity:
+            {
+                auto const entity = Entity::create(command.name);
+
+                if (command.on_created)
+                    command.on_created(entity);
+
+                break;
+            }
+            case SceneCommandType::DestroyEntity:
+                // Entity could have been destroyed in the meantime, ex. together with its parent
+                if (contains(command.entity))
+                    command.entity->destroy_immediate();
+
+                break;
+            case SceneCommandType::DestroyComponent:
+                if (command.component->entity != nullptr)
+                    command.component->destroy_immediate();
+
+                break;
+            case SceneCommandType::ReleaseToPool:
+                if (contains(command.entity))
+                    EntityPool::get_instance().release_immediate(command.entity);
+
+                break;
+            case SceneCommandType::SetParent:
+                if (!command.transform->entity.expired() && contains(command.transform->entity.lock()))
+                    command.transform->set_parent(command.parent);
+
+                break;
+            case SceneCommandType::SetEnabled:
+                if (command.component->entity != nullptr)
+                    command.component->set_enabled(command.value);
+
+                break;
+            case SceneCommandType::AddTickable:
+                add_tickable_component(command.component);
+                break;
+            case SceneCommandType::RemoveTickable:
+                remove_tickable_component(command.component);
+                break;
+            default:
+                std::unreachable();
+            }
+        }
+    }
+
+    m_commands_to_play_back.clear();
+
+    m_is_updating = was_updating;
+}
+
 std::shared_ptr<Entity> Scene::get_entity_by_guid(std::string const& guid) const
 {
     // TODO: Cache entities in an unordered map with guids as keys
@@ -106,7 +304,6 @@ void Scene::run_frame()
     {
         is_running = true;
 
-        auto const copy_components_to_awake = this->components_to_awake;
         for (auto const& component : components_to_awake)
         {
             component->awake();
@@ -123,28 +320,140 @@ void Scene::run_frame()
     }
 
     // Call Start on every component that hasn't been started yet
-    auto const copy_components_to_start = this->components_to_start;
-    for (auto const& component : copy_components_to_start)
+    // Components added in Start are started in the next frame. Swapping keeps the capacity of both vectors.
+    std::swap(m_components_starting, components_to_start);
+
+    for (auto const& component : m_components_starting)
     {
         component->start();
         component->has_been_started = true;
+    }
 
-        AK::swap_and_erase(this->components_to_start, component);
+    m_components_starting.clear();
+
+    // Call Update on every tickable component, one phase at a time
+    if (m_is_update_order_dirty)
+        resolve_update_order();
+
+    for (u32 const phase_index : m_update_order)
+    {
+        run_update_phase(phase_index);
     }
 
-    // Call Update on every tickable component
+    play_back_commands();
+}
+
+void Scene::resolve_update_order()
+{
+    m_update_order.clear();
+
+    auto const find_phase = [this](std::type_index const& type) -> i32 {
+        for (u32 i = 0; i < m_update_phases.size(); ++i)
+        {
+            if (m_update_phases[i].type == type)
+                return static_cast<i32>(i);
+        }
 
-    // Scene Entities vector might be modified by components, ex. when they create new entities
-    // TODO: Destroying entities is not handled properly. But we don't support any way of destroying an entity anyway, so...
+        return -1;
+    };
 
-    // TODO: Don't make a copy of tickable components every frame, since they will most likely not change frequently, so we might
-    //       just manually manage the vector?
-    auto const components_copy = tickable_components;
-    for (auto const& component : components_copy)
+    // Dependencies between types that currently don't tick are irrelevant
+    std::vector<std::pair<u32, u32>> edges = {};
+    std::vector<u32> dependencies_left(m_update_phases.size(), 0);
+    for (auto const& [before, after] : m_update_dependencies)
     {
-        if (component == nullptr || component->entity == nullptr || !component->enabled())
+        i32 const before_index = find_phase(before);
+        i32 const after_index = find_phase(after);
+
+        if (before_index == -1 || after_index == -1)
             continue;
 
-        component->update();
+        edges.emplace_back(before_index, after_index);
+        dependencies_left[after_index] += 1;
     }
+
+    std::vector<bool> is_ordered(m_update_phases.size(), false);
+    while (m_update_order.size() < m_update_phases.size())
+    {
+        // Always pick the earliest registered phase that is ready, so that phases without any dependencies
+        // keep the order in which they started ticking
+        i32 next = -1;
+        for (u32 i = 0; i < m_update_phases.size(); ++i)
+        {
+            if (!is_ordered[i] && dependencies_left[i] == 0)
+            {
+                next = static_cast<i32>(i);
+                break;
+            }
+        }
+
+        if (next == -1)
+        {
+            Debug::log("Cyclic update dependency detected. Remaining phases will be updated in registration order.", DebugType::Error);
+
+            for (u32 i = 0; i < m_update_phases.size(); ++i)
+            {
+                if (!is_ordered[i])
+                    m_update_order.emplace_back(i);
+            }
+
+            break;
+        }
+
+        is_ordered[next] = true;
+        m_update_order.emplace_back(next);
+
+        for (auto const& [before, after] : edges)
+        {
+            if (before == static_cast<u32>(next))
+                dependencies_left[after] -= 1;
+        }
+    }
+
+    m_is_update_order_dirty = false;
+}
+
+void Scene::run_update_phase(u32 const phase_index)
+{
+    // Structural changes made during the update never touch the phases directly, they are played back at the sync point below,
+    // so we can iterate over the phase without making a copy of it. Components destroyed immediately are only skipped.
+    m_is_updating = true;
+
+    UpdatePhase const& phase = m_update_phases[phase_index];
+
+    if (!phase.is_parallel_safe)
+    {
+        for (u32 i = 0; i < phase.components.size(); ++i)
+        {
+            auto const& component = phase.components[i];
+
+            if (component->entity == nullptr || !component->get_can_tick() || !component->enabled())
+                continue;
+
+            component->update();
+        }
+    }
+    else
+    {
+        // World matrices are computed lazily. Parallel-safe components are allowed to read transforms outside of their own entity
+        // (ex. their parent's), so we need to make sure these are up-to-date beforehand, otherwise two threads could recompute them at once.
+        for (auto const& component : phase.components)
+        {
+            if (component->entity != nullptr)
+                static_cast<void>(component->entity->transform->get_model_matrix());
+        }
+
+        std::for_each(std::execution::par, phase.components.begin(), phase.components.end(),
+                      [](std::shared_ptr<Component> const& component) {
+                          if (component->entity == nullptr || !component->get_can_tick() || !component->enabled())
+                              return;
+
+                          component->update();
+                      });
+    }
+
+    m_is_updating = false;
+
+    // Sync point
+    play_back_commands();
 }
@@ -1,10 +1,27 @@
 #pragma once
+#include <functional>
 #include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "AK/SlotMap.h"
+#include "AK/Types.h"
 #include "Component.h"
+#include "SceneCommandBuffer.h"
 
 class Entity;
+class Transform;
+
+// All tickable components of a single type. Phases are updated one after another, in order resolved from the declared dependencies.
+struct UpdatePhase
+{
+    std::type_index type;
+    bool is_parallel_safe = false;
+    std::vector<std::shared_ptr<Component>> components = {};
+};
 
 class Scene
 {
@@ -22,6 +39,41 @@ public:
     void add_component_to_start(std::shared_ptr<Component> const& component);
     void remove_component_to_start(std::shared_ptr<Component> const& component);
 
+    void add_tickable_component(std::shared_ptr<Component> const& component);
+    void remove_tickable_component(std::shared_ptr<Component> const& component);
+
+    // All components of type Before will be updated before any component of type After.
+    template<typename Before, typename After>
+    void declare_update_dependency()
+    {
+        m_update_dependencies.emplace_back(typeid(Before), typeid(After));
+        m_is_update_order_dirty = true;
+    }
+
+    // Structural changes are recorded and executed at the next sync point. Sync points are the end of every update phase
+    // and the end of the frame. These are safe to call from parallel updates.
+    void create_deferred(std::string const& name, std::function<void(std::shared_ptr<Entity> const&)> const& on_created = {});
+    void destroy_deferred(std::shared_ptr<Entity> const& entity);
+    void destroy_deferred(std::shared_ptr<Component> const& component);
+    void release_to_pool_deferred(std::shared_ptr<Entity> const& entity);
+    void set_parent_deferred(std::shared_ptr<Transform> const& transform, std::shared_ptr<Transform> const& parent);
+    void set_enabled_deferred(std::shared_ptr<Component> const& component, bool const enabled);
+
+    void play_back_commands();
+
+    [[nodiscard]] bool contains(std::shared_ptr<Entity> const& entity) const;
+
+    // Change tracking for incremental saves. Entities are written again on the next save when their transform changed,
+    // a component was added or removed, or they were marked dirty. Fields of components can only be marked by whoever
+    // edits them. Removing an entity marks it and its parent dirty, and so does removing a component for its entity.
+    // Removing either also marks the entities whose components refer to it, their text would keep its guid.
+    void mark_dirty(std::shared_ptr<Entity> const& entity);
+    void mark_all_dirty();
+    void mark_referrers_dirty(std::string const& guid);
+
+    // Also marks every entity under it, components often edit their children.
+    void mark_dirty_recursively(std::shared_ptr<Entity> const& entity);
+
     [[nodiscard]] std::shared_ptr<Entity> get_entity_by_guid(std::string const& guid) const;
     [[nodiscard]] std::shared_ptr<Component> get_component_by_guid(std::string const& guid) const;
 
@@ -29,12 +81,43 @@ public:
 
     bool is_running = false;
 
-    std::vector<std::shared_ptr<Entity>> entities = {};
-    std::vector<std::shared_ptr<Component>> tickable_components = {};
+    AK::SlotMap<std::shared_ptr<Entity>> entities = {};
 
 private:
+    void resolve_update_order();
+    void run_update_phase(u32 const phase_index);
+
     std::vector<std::shared_ptr<Component>> components_to_awake = {};
     std::vector<std::shared_ptr<Component>> components_to_start = {};
+    std::vector<std::shared_ptr<Component>> m_components_starting = {};
+
+    std::vector<UpdatePhase> m_update_phases = {};
+    std::vector<u32> m_update_order = {};
+    std::vector<std::pair<std::type_index, std::type_index>> m_update_dependencies = {};
+    bool m_is_update_order_dirty = false;
+
+    // While updating, tickable components are only added or removed at the sync points,
+    // so that update phases can be iterated without copying them
+    bool m_is_updating = false;
+
+    SceneCommandBuffer m_command_buffer = {};
+    std::vector<SceneCommand> m_commands_to_play_back = {};
+
+    struct SerializedEntity
+    {
+        std::string text = {};
+
+        // Versions of the entity and its transform when the text was emitted
+        u32 entity_version = 0;
+        u32 transform_version = 0;
+    };
+
+    // YAML of entities written by the last incremental save, by guid
+    std::unordered_map<std::string, SerializedEntity> m_serialized_entities = {};
+
+    // Guids of entities whose YAML refers to an entity or component, by the guid it refers to. Entries aren't removed
+    // when a reference changes, marking an entity that no longer refers to the guid only emits it again.
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_referrers = {};
 
     friend class SceneSerializer;
 };
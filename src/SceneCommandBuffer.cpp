@@ -0,0 +1,98 @@
+#include "SceneCommandBuffer.h"
+
+void SceneCommandBuffer::create_entity(std::string const& name, std::function<void(std::shared_ptr<Entity> const&)> const& on_created)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::CreateEntity;
+    command.name = name;
+    command.on_created = on_created;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::destroy_entity(std::shared_ptr<Entity> const& entity)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::DestroyEntity;
+    command.entity = entity;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::destroy_component(std::shared_ptr<Component> const& component)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::DestroyComponent;
+    command.component = component;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::release_to_pool(std::shared_ptr<Entity> const& entity)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::ReleaseToPool;
+    command.entity = entity;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::set_parent(std::shared_ptr<Transform> const& transform, std::shared_ptr<Transform> const& parent)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::SetParent;
+    command.transform = transform;
+    command.parent = parent;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::set_enabled(std::shared_ptr<Component> const& component, bool const enabled)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::SetEnabled;
+    command.component = component;
+    command.value = enabled;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::add_tickable(std::shared_ptr<Component> const& component)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::AddTickable;
+    command.component = component;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::remove_tickable(std::shared_ptr<Component> const& component)
+{
+    SceneCommand command = {};
+    command.type = SceneCommandType::RemoveTickable;
+    command.component = component;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::take_commands(std::vector<SceneCommand>& commands)
+{
+    commands.clear();
+
+    std::lock_guard guard(m_mutex);
+
+    std::swap(commands, m_commands);
+}
+
+bool SceneCommandBuffer::is_empty()
+{
+    std::lock_guard guard(m_mutex);
+
+    return m_commands.empty();
+}
+
+void SceneCommandBuffer::clear()
+{
+    std::lock_guard guard(m_mutex);
+
+    m_commands.clear();
+}
+
+void SceneCommandBuffer::record(SceneCommand&& command)
+{
+    std::lock_guard guard(m_mutex);
+
+    m_commands.emplace_back(std::move(command));
+}
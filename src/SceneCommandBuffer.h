@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Component;
+class Entity;
+class Transform;
+
+enum class SceneCommandType
+{
+    CreateEntity,
+    DestroyEntity,
+    DestroyComponent,
+    ReleaseToPool,
+    SetParent,
+    SetEnabled,
+    AddTickable,
+    RemoveTickable,
+};
+
+struct SceneCommand
+{
+    SceneCommandType type = SceneCommandType::DestroyEntity;
+
+    std::shared_ptr<Entity> entity = {};
+    std::shared_ptr<Component> component = {};
+    std::shared_ptr<Transform> transform = {};
+    std::shared_ptr<Transform> parent = {};
+    bool value = false;
+
+    std::string name = {};
+    std::function<void(std::shared_ptr<Entity> const&)> on_created = {};
+};
+
+// Structural changes of the scene recorded during the frame. Recording is thread-safe.
+// Commands are executed by the Scene at its sync points, in the order they were recorded.
+class SceneCommandBuffer
+{
+public:
+    void create_entity(std::string const& name, std::function<void(std::shared_ptr<Entity> const&)> const& on_created);
+    void destroy_entity(std::shared_ptr<Entity> const& entity);
+    void destroy_component(std::shared_ptr<Component> const& component);
+    void release_to_pool(std::shared_ptr<Entity> const& entity);
+    void set_parent(std::shared_ptr<Transform> const& transform, std::shared_ptr<Transform> const& parent);
+    void set_enabled(std::shared_ptr<Component> const& component, bool const enabled);
+    void add_tickable(std::shared_ptr<Component> const& component);
+    void remove_tickable(std::shared_ptr<Component> const& component);
+
+    // Swaps recorded commands with the given vector, so that both keep their capacity between frames
+    void take_commands(std::vector<SceneCommand>& commands);
+    [[nodiscard]] bool is_empty();
+    void clear();
+
+private:
+    void record(SceneCommand&& command);
+
+    std::mutex m_mutex = {};
+    std::vector<SceneCommand> m_commands = {};
+};
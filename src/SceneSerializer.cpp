@@ -2,17 +2,27 @@
 
 #include "AssetPreloader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <execution>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <ranges>
+#include <spanstream>
 #include <unordered_set>
 
 #include <yaml-cpp/yaml.h>
 
+#include "AK/AK.h"
 #include "AK/ScopeGuard.h"
+#include "BinarySerialization.h"
 #include "Button.h"
 #include "Camera.h"
 #include "Collider2D.h"
+#include "ComponentList.h"
+#include "ComponentReflectionTables.h"
 #include "Cube.h"
 #include "Curve.h"
 #include "DebugDrawing.h"
@@ -63,9 +73,180 @@
 #include "Sphere.h"
 #include "SpotLight.h"
 #include "Sprite.h"
+#include "VirtualFileSystem.h"
 #include "Water.h"
 #include "yaml-cpp-extensions.h"
-// # Put new header here
+#include "BinarySerializationExtensions.h"
+
+// Prefab parsed once and kept in the binary format. References between its objects are already resolved
+// to indices of their guids in the string table, so an instance only needs new guids.
+struct PrefabTemplate
+{
+    std::vector<u8> data = {};
+    BinaryReader reader = {};
+
+    // Indices of the guids of all entities and components in the string table
+    std::vector<u32> guid_indices = {};
+};
+
+namespace
+{
+
+std::unordered_map<std::string, std::unique_ptr<PrefabTemplate>>& get_prefab_templates()
+{
+    static std::unordered_map<std::string, std::unique_ptr<PrefabTemplate>> prefab_templates = {};
+    return prefab_templates;
+}
+
+bool open_prefab_template(PrefabTemplate& prefab, u32 const schema_hash)
+{
+    if (!prefab.reader.open(prefab.data, schema_hash))
+        return false;
+
+    for (auto const& entity_record : prefab.reader.get_entities())
+        prefab.guid_indices.emplace_back(entity_record.guid);
+
+    for (auto const& component_record : prefab.reader.get_components())
+        prefab.guid_indices.emplace_back(component_record.guid);
+
+    return true;
+}
+
+// Model files are the slowest part of loading a prefab, so their paths are collected to read them ahead of time
+void add_model_path(std::string_view const str, std::vector<std::string>& model_paths)
+{
+    if (!str.ends_with(".gltf") && !str.ends_with(".glb") && !str.ends_with(".obj") && !str.ends_with(".fbx"))
+        return;
+
+    if (std::ranges::find(model_paths, str) == model_paths.end())
+        model_paths.emplace_back(str);
+}
+
+// Preloaded files are mapped into memory and Windows doesn't allow overwriting them, so they are unmapped while saving.
+// They are preloaded again when the returned guard goes out of scope, with what was written.
+[[nodiscard]] auto unload_preloaded_while_saving(std::string const& file_path)
+{
+    bool const was_preloaded = Engine::asset_preloader->unload_asset(file_path);
+
+    return ScopeGuard([file_path, was_preloaded] {
+        if (was_preloaded)
+            Engine::asset_preloader->preload_asset(file_path);
+    });
+}
+
+// Components without their own serialization, like Terrain, are passed to the function as their nearest serialized base.
+template<typename Function>
+bool visit_serialized_component(Component& component, Function const& function)
+{
+#define ENUMERATE_COMPONENT(type, ui_name)             \
+    if (typeid(component) == typeid(class type))       \
+    {                                                  \
+        function(static_cast<class type&>(component)); \
+        return true;                                   \
+    }
+    ENUMERATE_COMPONENTS
+#undef ENUMERATE_COMPONENT
+
+    // Bases are listed before the components derived from them, so the last match is the nearest one
+    std::function<void()> visit_nearest_base = {};
+
+#define ENUMERATE_COMPONENT(type, ui_name)                                         \
+    if (auto* const base = dynamic_cast<class type*>(&component); base != nullptr) \
+        visit_nearest_base = [&function, base] { function(*base); };
+    ENUMERATE_ABSTRACT_COMPONENTS
+    ENUMERATE_COMPONENTS
+#undef ENUMERATE_COMPONENT
+
+    if (!visit_nearest_base)
+        return false;
+
+    visit_nearest_base();
+    return true;
+}
+
+template<typename Field, typename T>
+void write_yaml_field(YAML::Emitter& out, Field const& field, T const& component)
+{
+    if constexpr (Field::is_serialized)
+        out << YAML::Key << field.name << YAML::Value << field.get(component);
+}
+
+template<typename T>
+void write_yaml_component(YAML::Emitter& out, T const& component)
+{
+    out << YAML::BeginMap;
+    out << YAML::Key << "ComponentName" << YAML::Value << ComponentReflection<T>::name;
+    out << YAML::Key << "guid" << YAML::Value << component.guid;
+    out << YAML::Key << "custom_name" << YAML::Value << component.custom_name;
+    std::apply([&](auto const&... field) { (write_yaml_field(out, field, component), ...); }, ComponentReflection<T>::fields);
+    out << YAML::EndMap;
+}
+
+// Returns true if the key belongs to the field.
+template<typename Field, typename T>
+bool read_yaml_field(Field const& field, u32 const key_hash, YAML::Node const& value, T& component)
+{
+    if constexpr (Field::is_serialized)
+    {
+        if (field.name_hash == key_hash)
+        {
+            field.get(component) = value.as<typename Field::ValueType>();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Every key of the node is hashed once and compared with the precomputed hashes of the fields,
+// instead of looking up every field in the node by its name.
+template<typename T>
+void read_yaml_fields(YAML::Node const& node, T& component)
+{
+    static_assert(has_unique_field_hashes<T>());
+
+    for (auto it = node.begin(); it != node.end(); ++it)
+    {
+        u32 const key_hash = AK::fnv1a_hash(it->first.Scalar());
+        YAML::Node const& value = it->second;
+
+        std::apply([&](auto const&... field) { static_cast<void>((read_yaml_field(field, key_hash, value, component) || ...)); },
+                   ComponentReflection<T>::fields);
+    }
+}
+
+template<typename Field, typename T>
+void write_binary_field(BinaryWriter& writer, Field const& field, T const& component)
+{
+    if constexpr (Field::is_serialized)
+        writer.write_field(field.get(component));
+}
+
+template<typename Field, typename T>
+void read_binary_field(BinaryReader& reader, Field const& field, T& component)
+{
+    if constexpr (Field::is_serialized)
+        reader.read_field(field.get(component));
+}
+
+template<typename T>
+void write_binary_component(BinaryWriter& writer, T const& component)
+{
+    writer.begin_component(ComponentReflection<T>::name, component.guid, component.custom_name);
+    std::apply([&](auto const&... field) { (write_binary_field(writer, field, component), ...); }, ComponentReflection<T>::fields);
+    writer.end_component();
+}
+
+template<typename T>
+void read_binary_component(BinaryReader& reader, T& component)
+{
+    std::apply([&](auto const&... field) { (read_binary_field(reader, field, component), ...); }, ComponentReflection<T>::fields);
+}
+
+}
+
+ParsedPrefab::ParsedPrefab() = default;
+ParsedPrefab::~ParsedPrefab() = default;
 
 SceneSerializer::SceneSerializer(std::shared_ptr<Scene> const& scene) : m_scene(scene)
 {
@@ -126,589 +307,17 @@ std::shared_ptr<Entity> SceneSerializer::get_entity_from_pool(std::string const&
 
 void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_ptr<Component> const& component)
 {
-    // # Auto serialization start
-    if (auto const camera = std::dynamic_pointer_cast<class Camera>(component); camera != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CameraComponent";
-        out << YAML::Key << "guid" << YAML::Value << camera->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << camera->custom_name;
-        out << YAML::Key << "width" << YAML::Value << camera->width;
-        out << YAML::Key << "height" << YAML::Value << camera->height;
-        out << YAML::Key << "fov" << YAML::Value << camera->fov;
-        out << YAML::Key << "near_plane" << YAML::Value << camera->near_plane;
-        out << YAML::Key << "far_plane" << YAML::Value << camera->far_plane;
-        out << YAML::EndMap;
-    }
-    else if (auto const collider2d = std::dynamic_pointer_cast<class Collider2D>(component); collider2d != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "Collider2DComponent";
-        out << YAML::Key << "guid" << YAML::Value << collider2d->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << collider2d->custom_name;
-        out << YAML::Key << "offset" << YAML::Value << collider2d->offset;
-        out << YAML::Key << "is_trigger" << YAML::Value << collider2d->is_trigger;
-        out << YAML::Key << "is_static" << YAML::Value << collider2d->is_static;
-        out << YAML::Key << "collider_type" << YAML::Value << collider2d->collider_type;
-        out << YAML::Key << "width" << YAML::Value << collider2d->width;
-        out << YAML::Key << "height" << YAML::Value << collider2d->height;
-        out << YAML::Key << "radius" << YAML::Value << collider2d->radius;
-        out << YAML::Key << "drag" << YAML::Value << collider2d->drag;
-        out << YAML::Key << "velocity" << YAML::Value << collider2d->velocity;
-        out << YAML::EndMap;
-    }
-    else if (auto const curve = std::dynamic_pointer_cast<class Curve>(component); curve != nullptr)
-    {
-        out << YAML::BeginMap;
-        // # Put new Curve kid here
-        if (auto const path = std::dynamic_pointer_cast<class Path>(component); path != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PathComponent";
-            out << YAML::Key << "guid" << YAML::Value << path->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << path->custom_name;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "CurveComponent";
-            out << YAML::Key << "guid" << YAML::Value << curve->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << curve->custom_name;
-        }
-        out << YAML::Key << "points" << YAML::Value << curve->points;
-        out << YAML::EndMap;
-    }
-    else if (auto const debuginputcontroller = std::dynamic_pointer_cast<class DebugInputController>(component);
-             debuginputcontroller != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "DebugInputControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << debuginputcontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << debuginputcontroller->custom_name;
-        out << YAML::Key << "gamma" << YAML::Value << debuginputcontroller->gamma;
-        out << YAML::Key << "exposure" << YAML::Value << debuginputcontroller->exposure;
-        out << YAML::EndMap;
-    }
-    else if (auto const dialoguepromptcontroller = std::dynamic_pointer_cast<class DialoguePromptController>(component);
-             dialoguepromptcontroller != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "DialoguePromptControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << dialoguepromptcontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << dialoguepromptcontroller->custom_name;
-        out << YAML::Key << "interp_speed" << YAML::Value << dialoguepromptcontroller->interp_speed;
-        out << YAML::Key << "dialogue_panel" << YAML::Value << dialoguepromptcontroller->dialogue_panel;
-        out << YAML::Key << "panel_parent" << YAML::Value << dialoguepromptcontroller->panel_parent;
-        out << YAML::Key << "keeper_sprite" << YAML::Value << dialoguepromptcontroller->keeper_sprite;
-        out << YAML::Key << "upper_text" << YAML::Value << dialoguepromptcontroller->upper_text;
-        out << YAML::Key << "middle_text" << YAML::Value << dialoguepromptcontroller->middle_text;
-        out << YAML::Key << "lower_text" << YAML::Value << dialoguepromptcontroller->lower_text;
-        out << YAML::Key << "dialogue_objects" << YAML::Value << dialoguepromptcontroller->dialogue_objects;
-        out << YAML::EndMap;
-    }
-    else if (auto const drawable = std::dynamic_pointer_cast<class Drawable>(component); drawable != nullptr)
-    {
-        out << YAML::BeginMap;
-        // # Put new Drawable kid here
-        if (auto const screentext = std::dynamic_pointer_cast<class ScreenText>(component); screentext != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "ScreenTextComponent";
-            out << YAML::Key << "guid" << YAML::Value << screentext->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << screentext->custom_name;
-            out << YAML::Key << "text" << YAML::Value << screentext->text;
-            out << YAML::Key << "position" << YAML::Value << screentext->position;
-            out << YAML::Key << "font_size" << YAML::Value << screentext->font_size;
-            out << YAML::Key << "color" << YAML::Value << screentext->color;
-            out << YAML::Key << "flags" << YAML::Value << screentext->flags;
-            out << YAML::Key << "font_name" << YAML::Value << screentext->font_name;
-            out << YAML::Key << "bold" << YAML::Value << screentext->bold;
-            out << YAML::Key << "button_ref" << YAML::Value << screentext->button_ref;
-        }
-        else if (auto const panel = std::dynamic_pointer_cast<class Panel>(component); panel != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PanelComponent";
-            out << YAML::Key << "guid" << YAML::Value << panel->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << panel->custom_name;
-            out << YAML::Key << "background_path" << YAML::Value << panel->background_path;
-        }
-        else if (auto const model = std::dynamic_pointer_cast<class Model>(component); model != nullptr)
-        {
-            // # Put new Model kid here
-            if (auto const water = std::dynamic_pointer_cast<class Water>(component); water != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "WaterComponent";
-                out << YAML::Key << "guid" << YAML::Value << water->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << water->custom_name;
-                out << YAML::Key << "waves" << YAML::Value << water->waves;
-                out << YAML::Key << "m_ps_buffer" << YAML::Value << water->m_ps_buffer;
-                out << YAML::Key << "tesselation_level" << YAML::Value << water->tesselation_level;
-            }
-            else if (auto const sprite = std::dynamic_pointer_cast<class Sprite>(component); sprite != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "SpriteComponent";
-                out << YAML::Key << "guid" << YAML::Value << sprite->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << sprite->custom_name;
-                out << YAML::Key << "diffuse_texture_path" << YAML::Value << sprite->diffuse_texture_path;
-            }
-            else if (auto const sphere = std::dynamic_pointer_cast<class Sphere>(component); sphere != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "SphereComponent";
-                out << YAML::Key << "guid" << YAML::Value << sphere->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << sphere->custom_name;
-                out << YAML::Key << "sector_count" << YAML::Value << sphere->sector_count;
-                out << YAML::Key << "stack_count" << YAML::Value << sphere->stack_count;
-                out << YAML::Key << "texture_path" << YAML::Value << sphere->texture_path;
-                out << YAML::Key << "radius" << YAML::Value << sphere->radius;
-            }
-            else if (auto const cube = std::dynamic_pointer_cast<class Cube>(component); cube != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "CubeComponent";
-                out << YAML::Key << "guid" << YAML::Value << cube->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << cube->custom_name;
-                out << YAML::Key << "diffuse_texture_path" << YAML::Value << cube->diffuse_texture_path;
-                out << YAML::Key << "specular_texture_path" << YAML::Value << cube->specular_texture_path;
-            }
-            else
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "ModelComponent";
-                out << YAML::Key << "guid" << YAML::Value << model->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << model->custom_name;
-            }
-            out << YAML::Key << "model_path" << YAML::Value << model->model_path;
-        }
-        else if (auto const button = std::dynamic_pointer_cast<class Button>(component); button != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "ButtonComponent";
-            out << YAML::Key << "guid" << YAML::Value << button->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << button->custom_name;
-            out << YAML::Key << "path_default" << YAML::Value << button->path_default;
-            out << YAML::Key << "path_hovered" << YAML::Value << button->path_hovered;
-            out << YAML::Key << "path_pressed" << YAML::Value << button->path_pressed;
-            out << YAML::Key << "top_left_corner" << YAML::Value << button->top_left_corner;
-            out << YAML::Key << "top_right_corner" << YAML::Value << button->top_right_corner;
-            out << YAML::Key << "bottom_left_corner" << YAML::Value << button->bottom_left_corner;
-            out << YAML::Key << "bottom_right_corner" << YAML::Value << button->bottom_right_corner;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "DrawableComponent";
-            out << YAML::Key << "guid" << YAML::Value << drawable->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << drawable->custom_name;
-        }
-        out << YAML::Key << "material" << YAML::Value << drawable->material;
-        out << YAML::EndMap;
-    }
-    else if (auto const exampledynamictext = std::dynamic_pointer_cast<class ExampleDynamicText>(component); exampledynamictext != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ExampleDynamicTextComponent";
-        out << YAML::Key << "guid" << YAML::Value << exampledynamictext->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << exampledynamictext->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const exampleuibar = std::dynamic_pointer_cast<class ExampleUIBar>(component); exampleuibar != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ExampleUIBarComponent";
-        out << YAML::Key << "guid" << YAML::Value << exampleuibar->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << exampleuibar->custom_name;
-        out << YAML::Key << "value" << YAML::Value << exampleuibar->value;
-        out << YAML::EndMap;
-    }
-    else if (auto const floater = std::dynamic_pointer_cast<class Floater>(component); floater != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FloaterComponent";
-        out << YAML::Key << "guid" << YAML::Value << floater->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << floater->custom_name;
-        out << YAML::Key << "sink" << YAML::Value << floater->sink;
-        out << YAML::Key << "side_floaters_offset" << YAML::Value << floater->side_floaters_offset;
-        out << YAML::Key << "side_roation_strength" << YAML::Value << floater->side_roation_strength;
-        out << YAML::Key << "forward_rotation_strength" << YAML::Value << floater->forward_rotation_strength;
-        out << YAML::Key << "forward_floaters_offest" << YAML::Value << floater->forward_floaters_offest;
-        out << YAML::Key << "water" << YAML::Value << floater->water;
-        out << YAML::EndMap;
-    }
-    else if (auto const floatersmanager = std::dynamic_pointer_cast<class FloatersManager>(component); floatersmanager != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FloatersManagerComponent";
-        out << YAML::Key << "guid" << YAML::Value << floatersmanager->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << floatersmanager->custom_name;
-        out << YAML::Key << "big_boat_settings" << YAML::Value << floatersmanager->big_boat_settings;
-        out << YAML::Key << "small_boat_settings" << YAML::Value << floatersmanager->small_boat_settings;
-        out << YAML::Key << "medium_boat_settings" << YAML::Value << floatersmanager->medium_boat_settings;
-        out << YAML::Key << "tool_boat_settings" << YAML::Value << floatersmanager->tool_boat_settings;
-        out << YAML::Key << "pirate_boat_settings" << YAML::Value << floatersmanager->pirate_boat_settings;
-        out << YAML::Key << "water" << YAML::Value << floatersmanager->water;
-        out << YAML::EndMap;
-    }
-    else if (auto const floebutton = std::dynamic_pointer_cast<class FloeButton>(component); floebutton != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FloeButtonComponent";
-        out << YAML::Key << "guid" << YAML::Value << floebutton->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << floebutton->custom_name;
-        out << YAML::Key << "floe_button_type" << YAML::Value << floebutton->floe_button_type;
-        out << YAML::EndMap;
-    }
-    else if (auto const light = std::dynamic_pointer_cast<class Light>(component); light != nullptr)
-    {
-        out << YAML::BeginMap;
-        // # Put new Light kid here
-        if (auto const spotlight = std::dynamic_pointer_cast<class SpotLight>(component); spotlight != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "SpotLightComponent";
-            out << YAML::Key << "guid" << YAML::Value << spotlight->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << spotlight->custom_name;
-            out << YAML::Key << "constant" << YAML::Value << spotlight->constant;
-            out << YAML::Key << "linear" << YAML::Value << spotlight->linear;
-            out << YAML::Key << "quadratic" << YAML::Value << spotlight->quadratic;
-            out << YAML::Key << "scattering_factor" << YAML::Value << spotlight->scattering_factor;
-            out << YAML::Key << "cut_off" << YAML::Value << spotlight->cut_off;
-            out << YAML::Key << "outer_cut_off" << YAML::Value << spotlight->outer_cut_off;
-        }
-        else if (auto const pointlight = std::dynamic_pointer_cast<class PointLight>(component); pointlight != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PointLightComponent";
-            out << YAML::Key << "guid" << YAML::Value << pointlight->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << pointlight->custom_name;
-            out << YAML::Key << "constant" << YAML::Value << pointlight->constant;
-            out << YAML::Key << "linear" << YAML::Value << pointlight->linear;
-            out << YAML::Key << "quadratic" << YAML::Value << pointlight->quadratic;
-        }
-        else if (auto const directionallight = std::dynamic_pointer_cast<class DirectionalLight>(component); directionallight != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "DirectionalLightComponent";
-            out << YAML::Key << "guid" << YAML::Value << directionallight->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << directionallight->custom_name;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "LightComponent";
-            out << YAML::Key << "guid" << YAML::Value << light->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << light->custom_name;
-        }
-        out << YAML::Key << "ambient" << YAML::Value << light->ambient;
-        out << YAML::Key << "diffuse" << YAML::Value << light->diffuse;
-        out << YAML::Key << "specular" << YAML::Value << light->specular;
-        out << YAML::Key << "m_near_plane" << YAML::Value << light->m_near_plane;
-        out << YAML::Key << "m_far_plane" << YAML::Value << light->m_far_plane;
-        out << YAML::Key << "m_blocker_search_num_samples" << YAML::Value << light->m_blocker_search_num_samples;
-        out << YAML::Key << "m_pcf_num_samples" << YAML::Value << light->m_pcf_num_samples;
-        out << YAML::Key << "m_light_world_size" << YAML::Value << light->m_light_world_size;
-        out << YAML::Key << "m_light_frustum_width" << YAML::Value << light->m_light_frustum_width;
-        out << YAML::EndMap;
-    }
-    else if (auto const nowprompttrigger = std::dynamic_pointer_cast<class NowPromptTrigger>(component); nowprompttrigger != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "NowPromptTriggerComponent";
-        out << YAML::Key << "guid" << YAML::Value << nowprompttrigger->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << nowprompttrigger->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const particlesystem = std::dynamic_pointer_cast<class ParticleSystem>(component); particlesystem != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ParticleSystemComponent";
-        out << YAML::Key << "guid" << YAML::Value << particlesystem->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << particlesystem->custom_name;
-        out << YAML::Key << "particle_type" << YAML::Value << particlesystem->particle_type;
-        out << YAML::Key << "play_once" << YAML::Value << particlesystem->play_once;
-        out << YAML::Key << "rotate_particles" << YAML::Value << particlesystem->rotate_particles;
-        out << YAML::Key << "spawn_instantly" << YAML::Value << particlesystem->spawn_instantly;
-        out << YAML::Key << "sprite_path" << YAML::Value << particlesystem->sprite_path;
-        out << YAML::Key << "min_spawn_interval" << YAML::Value << particlesystem->min_spawn_interval;
-        out << YAML::Key << "max_spawn_interval" << YAML::Value << particlesystem->max_spawn_interval;
-        out << YAML::Key << "start_velocity_1" << YAML::Value << particlesystem->start_velocity_1;
-        out << YAML::Key << "start_velocity_2" << YAML::Value << particlesystem->start_velocity_2;
-        out << YAML::Key << "min_spawn_alpha" << YAML::Value << particlesystem->min_spawn_alpha;
-        out << YAML::Key << "max_spawn_alpha" << YAML::Value << particlesystem->max_spawn_alpha;
-        out << YAML::Key << "start_min_particle_size" << YAML::Value << particlesystem->start_min_particle_size;
-        out << YAML::Key << "start_max_particle_size" << YAML::Value << particlesystem->start_max_particle_size;
-        out << YAML::Key << "emitter_bounds" << YAML::Value << particlesystem->emitter_bounds;
-        out << YAML::Key << "min_spawn_count" << YAML::Value << particlesystem->min_spawn_count;
-        out << YAML::Key << "max_spawn_count" << YAML::Value << particlesystem->max_spawn_count;
-        out << YAML::Key << "start_color_1" << YAML::Value << particlesystem->start_color_1;
-        out << YAML::Key << "end_color_1" << YAML::Value << particlesystem->end_color_1;
-        out << YAML::Key << "lifetime_1" << YAML::Value << particlesystem->lifetime_1;
-        out << YAML::Key << "lifetime_2" << YAML::Value << particlesystem->lifetime_2;
-        out << YAML::Key << "m_simulate_in_world_space" << YAML::Value << particlesystem->m_simulate_in_world_space;
-        out << YAML::EndMap;
-    }
-    else if (auto const sound = std::dynamic_pointer_cast<class Sound>(component); sound != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "SoundComponent";
-        out << YAML::Key << "guid" << YAML::Value << sound->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << sound->custom_name;
-        out << YAML::Key << "path" << YAML::Value << sound->path;
-        out << YAML::Key << "volume" << YAML::Value << sound->volume;
-        out << YAML::Key << "play_on_awake" << YAML::Value << sound->play_on_awake;
-        out << YAML::Key << "is_positional" << YAML::Value << sound->is_positional;
-        out << YAML::EndMap;
-    }
-    else if (auto const soundlistener = std::dynamic_pointer_cast<class SoundListener>(component); soundlistener != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "SoundListenerComponent";
-        out << YAML::Key << "guid" << YAML::Value << soundlistener->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << soundlistener->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const clock = std::dynamic_pointer_cast<class Clock>(component); clock != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ClockComponent";
-        out << YAML::Key << "guid" << YAML::Value << clock->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << clock->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const credits = std::dynamic_pointer_cast<class Credits>(component); credits != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CreditsComponent";
-        out << YAML::Key << "guid" << YAML::Value << credits->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << credits->custom_name;
-        out << YAML::Key << "back_to_menu_button" << YAML::Value << credits->back_to_menu_button;
-        out << YAML::EndMap;
-    }
-    else if (auto const customer = std::dynamic_pointer_cast<class Customer>(component); customer != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CustomerComponent";
-        out << YAML::Key << "guid" << YAML::Value << customer->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << customer->custom_name;
-        out << YAML::Key << "collider" << YAML::Value << customer->collider;
-        out << YAML::Key << "left_hand" << YAML::Value << customer->left_hand;
-        out << YAML::Key << "right_hand" << YAML::Value << customer->right_hand;
-        out << YAML::EndMap;
-    }
-    else if (auto const customermanager = std::dynamic_pointer_cast<class CustomerManager>(component); customermanager != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CustomerManagerComponent";
-        out << YAML::Key << "guid" << YAML::Value << customermanager->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << customermanager->custom_name;
-        out << YAML::Key << "destinations_after_feeding" << YAML::Value << customermanager->destinations_after_feeding;
-        out << YAML::Key << "destination_curve" << YAML::Value << customermanager->destination_curve;
-        out << YAML::Key << "customer_prefab" << YAML::Value << customermanager->customer_prefab;
-        out << YAML::EndMap;
-    }
-    else if (auto const factory = std::dynamic_pointer_cast<class Factory>(component); factory != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FactoryComponent";
-        out << YAML::Key << "guid" << YAML::Value << factory->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << factory->custom_name;
-        out << YAML::Key << "type" << YAML::Value << factory->type;
-        out << YAML::Key << "lights" << YAML::Value << factory->lights;
-        out << YAML::Key << "factory_light" << YAML::Value << factory->factory_light;
-        out << YAML::EndMap;
-    }
-    else if (auto const gamecontroller = std::dynamic_pointer_cast<class GameController>(component); gamecontroller != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "GameControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << gamecontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << gamecontroller->custom_name;
-        out << YAML::Key << "current_scene" << YAML::Value << gamecontroller->current_scene;
-        out << YAML::Key << "next_scene" << YAML::Value << gamecontroller->next_scene;
-        out << YAML::Key << "dialog_manager" << YAML::Value << gamecontroller->dialog_manager;
-        out << YAML::EndMap;
-    }
-    else if (auto const hovercraftwithoutkeeper = std::dynamic_pointer_cast<class HovercraftWithoutKeeper>(component);
-             hovercraftwithoutkeeper != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "HovercraftWithoutKeeperComponent";
-        out << YAML::Key << "guid" << YAML::Value << hovercraftwithoutkeeper->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << hovercraftwithoutkeeper->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const icebound = std::dynamic_pointer_cast<class IceBound>(component); icebound != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "IceBoundComponent";
-        out << YAML::Key << "guid" << YAML::Value << icebound->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << icebound->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const levelcontroller = std::dynamic_pointer_cast<class LevelController>(component); levelcontroller != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LevelControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << levelcontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << levelcontroller->custom_name;
-        out << YAML::Key << "map_time" << YAML::Value << levelcontroller->map_time;
-        out << YAML::Key << "map_food" << YAML::Value << levelcontroller->map_food;
-        out << YAML::Key << "maximum_lighthouse_level" << YAML::Value << levelcontroller->maximum_lighthouse_level;
-        out << YAML::Key << "factories" << YAML::Value << levelcontroller->factories;
-        out << YAML::Key << "port" << YAML::Value << levelcontroller->port;
-        out << YAML::Key << "lighthouse" << YAML::Value << levelcontroller->lighthouse;
-        out << YAML::Key << "customer_manager" << YAML::Value << levelcontroller->customer_manager;
-        out << YAML::Key << "playfield_width" << YAML::Value << levelcontroller->playfield_width;
-        out << YAML::Key << "playfield_additional_width" << YAML::Value << levelcontroller->playfield_additional_width;
-        out << YAML::Key << "playfield_height" << YAML::Value << levelcontroller->playfield_height;
-        out << YAML::Key << "playfield_y_shift" << YAML::Value << levelcontroller->playfield_y_shift;
-        out << YAML::Key << "ships_limit_curve" << YAML::Value << levelcontroller->ships_limit_curve;
-        out << YAML::Key << "ships_limit" << YAML::Value << levelcontroller->ships_limit;
-        out << YAML::Key << "ships_speed_curve" << YAML::Value << levelcontroller->ships_speed_curve;
-        out << YAML::Key << "ships_speed" << YAML::Value << levelcontroller->ships_speed;
-        out << YAML::Key << "ships_range_curve" << YAML::Value << levelcontroller->ships_range_curve;
-        out << YAML::Key << "ships_turn_curve" << YAML::Value << levelcontroller->ships_turn_curve;
-        out << YAML::Key << "ships_additional_speed_curve" << YAML::Value << levelcontroller->ships_additional_speed_curve;
-        out << YAML::Key << "pirates_in_control_curve" << YAML::Value << levelcontroller->pirates_in_control_curve;
-        out << YAML::Key << "is_tutorial" << YAML::Value << levelcontroller->is_tutorial;
-        out << YAML::Key << "starting_packages" << YAML::Value << levelcontroller->starting_packages;
-        out << YAML::Key << "tutorial_level" << YAML::Value << levelcontroller->tutorial_level;
-        out << YAML::EndMap;
-    }
-    else if (auto const lighthouse = std::dynamic_pointer_cast<class Lighthouse>(component); lighthouse != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LighthouseComponent";
-        out << YAML::Key << "guid" << YAML::Value << lighthouse->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << lighthouse->custom_name;
-        out << YAML::Key << "light" << YAML::Value << lighthouse->light;
-        out << YAML::Key << "water" << YAML::Value << lighthouse->water;
-        out << YAML::Key << "spawn_position" << YAML::Value << lighthouse->spawn_position;
-        out << YAML::EndMap;
-    }
-    else if (auto const lighthousekeeper = std::dynamic_pointer_cast<class LighthouseKeeper>(component); lighthousekeeper != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LighthouseKeeperComponent";
-        out << YAML::Key << "guid" << YAML::Value << lighthousekeeper->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << lighthousekeeper->custom_name;
-        out << YAML::Key << "maximum_speed" << YAML::Value << lighthousekeeper->maximum_speed;
-        out << YAML::Key << "acceleration" << YAML::Value << lighthousekeeper->acceleration;
-        out << YAML::Key << "deceleration" << YAML::Value << lighthousekeeper->deceleration;
-        out << YAML::Key << "lighthouse" << YAML::Value << lighthousekeeper->lighthouse;
-        out << YAML::Key << "port" << YAML::Value << lighthousekeeper->port;
-        out << YAML::Key << "keeper_dust" << YAML::Value << lighthousekeeper->keeper_dust;
-        out << YAML::Key << "keeper_splash" << YAML::Value << lighthousekeeper->keeper_splash;
-        out << YAML::Key << "packages" << YAML::Value << lighthousekeeper->packages;
-        out << YAML::EndMap;
-    }
-    else if (auto const lighthouselight = std::dynamic_pointer_cast<class LighthouseLight>(component); lighthouselight != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LighthouseLightComponent";
-        out << YAML::Key << "guid" << YAML::Value << lighthouselight->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << lighthouselight->custom_name;
-        out << YAML::Key << "spotlight" << YAML::Value << lighthouselight->spotlight;
-        out << YAML::Key << "spotlight_beam_width" << YAML::Value << lighthouselight->spotlight_beam_width;
-        out << YAML::EndMap;
-    }
-    else if (auto const player = std::dynamic_pointer_cast<class Player>(component); player != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "PlayerComponent";
-        out << YAML::Key << "guid" << YAML::Value << player->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << player->custom_name;
-        out << YAML::Key << "packages_text" << YAML::Value << player->packages_text;
-        out << YAML::Key << "flashes_text" << YAML::Value << player->flashes_text;
-        out << YAML::Key << "level_text" << YAML::Value << player->level_text;
-        out << YAML::Key << "clock_text" << YAML::Value << player->clock_text;
-        out << YAML::EndMap;
-    }
-    else if (auto const popup = std::dynamic_pointer_cast<class Popup>(component); popup != nullptr)
-    {
-        out << YAML::BeginMap;
-        // # Put new Popup kid here
-        if (auto const endscreen = std::dynamic_pointer_cast<class EndScreen>(component); endscreen != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "EndScreenComponent";
-            out << YAML::Key << "guid" << YAML::Value << endscreen->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << endscreen->custom_name;
-            out << YAML::Key << "is_failed" << YAML::Value << endscreen->is_failed;
-            out << YAML::Key << "number_of_stars" << YAML::Value << endscreen->number_of_stars;
-            out << YAML::Key << "stars" << YAML::Value << endscreen->stars;
-            out << YAML::Key << "star_scale" << YAML::Value << endscreen->star_scale;
-            out << YAML::Key << "next_level_button" << YAML::Value << endscreen->next_level_button;
-            out << YAML::Key << "restart_button" << YAML::Value << endscreen->restart_button;
-            out << YAML::Key << "menu_button" << YAML::Value << endscreen->menu_button;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PopupComponent";
-            out << YAML::Key << "guid" << YAML::Value << popup->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << popup->custom_name;
-        }
-        out << YAML::EndMap;
-    }
-    else if (auto const port = std::dynamic_pointer_cast<class Port>(component); port != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "PortComponent";
-        out << YAML::Key << "guid" << YAML::Value << port->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << port->custom_name;
-        out << YAML::Key << "lights" << YAML::Value << port->lights;
-        out << YAML::EndMap;
-    }
-    else if (auto const ship = std::dynamic_pointer_cast<class Ship>(component); ship != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ShipComponent";
-        out << YAML::Key << "guid" << YAML::Value << ship->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << ship->custom_name;
-        out << YAML::Key << "type" << YAML::Value << ship->type;
-        out << YAML::Key << "light" << YAML::Value << ship->light;
-        out << YAML::Key << "spawner" << YAML::Value << ship->spawner;
-        out << YAML::Key << "eyes" << YAML::Value << ship->eyes;
-        out << YAML::Key << "my_light" << YAML::Value << ship->my_light;
-        out << YAML::EndMap;
-    }
-    else if (auto const shipeyes = std::dynamic_pointer_cast<class ShipEyes>(component); shipeyes != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ShipEyesComponent";
-        out << YAML::Key << "guid" << YAML::Value << shipeyes->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << shipeyes->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const shipspawner = std::dynamic_pointer_cast<class ShipSpawner>(component); shipspawner != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ShipSpawnerComponent";
-        out << YAML::Key << "guid" << YAML::Value << shipspawner->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << shipspawner->custom_name;
-        out << YAML::Key << "paths" << YAML::Value << shipspawner->paths;
-        out << YAML::Key << "floaters_manager" << YAML::Value << shipspawner->floaters_manager;
-        out << YAML::Key << "light" << YAML::Value << shipspawner->light;
-        out << YAML::Key << "last_chance_food_threshold" << YAML::Value << shipspawner->last_chance_food_threshold;
-        out << YAML::Key << "last_chance_time_threshold" << YAML::Value << shipspawner->last_chance_time_threshold;
-        out << YAML::Key << "main_event_spawn" << YAML::Value << shipspawner->main_event_spawn;
-        out << YAML::Key << "backup_spawn" << YAML::Value << shipspawner->backup_spawn;
-        out << YAML::EndMap;
-    }
-    else if (auto const thanks = std::dynamic_pointer_cast<class Thanks>(component); thanks != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ThanksComponent";
-        out << YAML::Key << "guid" << YAML::Value << thanks->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << thanks->custom_name;
-        out << YAML::Key << "back_to_menu_button" << YAML::Value << thanks->back_to_menu_button;
-        out << YAML::EndMap;
-    }
-    else if (auto const playerinput = std::dynamic_pointer_cast<class PlayerInput>(component); playerinput != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "PlayerInputComponent";
-        out << YAML::Key << "guid" << YAML::Value << playerinput->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << playerinput->custom_name;
-        out << YAML::Key << "player_speed" << YAML::Value << playerinput->player_speed;
-        out << YAML::Key << "camera_speed" << YAML::Value << playerinput->camera_speed;
-        out << YAML::EndMap;
-    }
-    else
+    bool const is_serialized = visit_serialized_component(*component, [&out](auto const& serialized_component) {
+        write_yaml_component(out, serialized_component);
+    });
+
+    if (!is_serialized)
     {
         // NOTE: This only returns unmangled name while using the MSVC compiler
         std::string const name = typeid(*component).name();
         std::cout << "Error. Serialization of component " << name.substr(6) << " failed."
                   << "\n";
     }
-    // # Put new serialization here
 }
 
 void SceneSerializer::serialize_entity(YAML::Emitter& out, std::shared_ptr<Entity> const& entity)
@@ -726,11 +335,11 @@ void SceneSerializer::serialize_entity(YAML::Emitter& out, std::shared_ptr<Entit
         out << YAML::Key << "Rotation" << YAML::Value << entity->transform->get_euler_angles();
         out << YAML::Key << "Scale" << YAML::Value << entity->transform->get_local_scale();
 
-        if (!entity->transform->parent.expired())
+        if (entity->transform->has_parent())
         {
             out << YAML::Key << "Parent";
             out << YAML::BeginMap;
-            out << YAML::Key << "guid" << YAML::Value << entity->transform->parent.lock()->entity.lock()->guid;
+            out << YAML::Key << "guid" << YAML::Value << entity->transform->get_parent()->entity.lock()->guid;
             out << YAML::EndMap;
         }
         else
@@ -780,1660 +389,130 @@ void SceneSerializer::serialize_entity_recursively(YAML::Emitter& out, std::shar
     }
 }
 
-void SceneSerializer::auto_deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity,
-                                                 bool const first_pass)
-{
-    auto component_name = component["ComponentName"].as<std::string>();
-    // # Auto deserialization start
-    if (component_name == "CameraComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Camera::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Camera>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["width"].IsDefined())
-            {
-                deserialized_component->width = component["width"].as<float>();
-            }
-            if (component["height"].IsDefined())
-            {
-                deserialized_component->height = component["height"].as<float>();
-            }
-            if (component["fov"].IsDefined())
-            {
-                deserialized_component->fov = component["fov"].as<float>();
-            }
-            if (component["near_plane"].IsDefined())
-            {
-                deserialized_component->near_plane = component["near_plane"].as<float>();
-            }
-            if (component["far_plane"].IsDefined())
-            {
-                deserialized_component->far_plane = component["far_plane"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "Collider2DComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Collider2D::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Collider2D>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["offset"].IsDefined())
-            {
-                deserialized_component->offset = component["offset"].as<glm::vec2>();
-            }
-            if (component["is_trigger"].IsDefined())
-            {
-                deserialized_component->is_trigger = component["is_trigger"].as<bool>();
-            }
-            if (component["is_static"].IsDefined())
-            {
-                deserialized_component->is_static = component["is_static"].as<bool>();
-            }
-            if (component["collider_type"].IsDefined())
-            {
-                deserialized_component->collider_type = component["collider_type"].as<ColliderType2D>();
-            }
-            if (component["width"].IsDefined())
-            {
-                deserialized_component->width = component["width"].as<float>();
-            }
-            if (component["height"].IsDefined())
-            {
-                deserialized_component->height = component["height"].as<float>();
-            }
-            if (component["radius"].IsDefined())
-            {
-                deserialized_component->radius = component["radius"].as<float>();
-            }
-            if (component["drag"].IsDefined())
-            {
-                deserialized_component->drag = component["drag"].as<float>();
-            }
-            if (component["velocity"].IsDefined())
-            {
-                deserialized_component->velocity = component["velocity"].as<glm::vec2>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CurveComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Curve::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Curve>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["points"].IsDefined())
-            {
-                deserialized_component->points = component["points"].as<std::vector<glm::vec2>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PathComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Path::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Path>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["points"].IsDefined())
-            {
-                deserialized_component->points = component["points"].as<std::vector<glm::vec2>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "DebugInputControllerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = DebugInputController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class DebugInputController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["gamma"].IsDefined())
-            {
-                deserialized_component->gamma = component["gamma"].as<float>();
-            }
-            if (component["exposure"].IsDefined())
-            {
-                deserialized_component->exposure = component["exposure"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "DialoguePromptControllerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = DialoguePromptController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class DialoguePromptController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["interp_speed"].IsDefined())
-            {
-                deserialized_component->interp_speed = component["interp_speed"].as<float>();
-            }
-            if (component["dialogue_panel"].IsDefined())
-            {
-                deserialized_component->dialogue_panel = component["dialogue_panel"].as<std::weak_ptr<Button>>();
-            }
-            if (component["panel_parent"].IsDefined())
-            {
-                deserialized_component->panel_parent = component["panel_parent"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["keeper_sprite"].IsDefined())
-            {
-                deserialized_component->keeper_sprite = component["keeper_sprite"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["upper_text"].IsDefined())
-            {
-                deserialized_component->upper_text = component["upper_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["middle_text"].IsDefined())
-            {
-                deserialized_component->middle_text = component["middle_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["lower_text"].IsDefined())
-            {
-                deserialized_component->lower_text = component["lower_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["dialogue_objects"].IsDefined())
-            {
-                deserialized_component->dialogue_objects = component["dialogue_objects"].as<std::vector<DialogueObject>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ButtonComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Button::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Button>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["path_default"].IsDefined())
-            {
-                deserialized_component->path_default = component["path_default"].as<std::string>();
-            }
-            if (component["path_hovered"].IsDefined())
-            {
-                deserialized_component->path_hovered = component["path_hovered"].as<std::string>();
-            }
-            if (component["path_pressed"].IsDefined())
-            {
-                deserialized_component->path_pressed = component["path_pressed"].as<std::string>();
-            }
-            if (component["top_left_corner"].IsDefined())
-            {
-                deserialized_component->top_left_corner = component["top_left_corner"].as<glm::vec2>();
-            }
-            if (component["top_right_corner"].IsDefined())
-            {
-                deserialized_component->top_right_corner = component["top_right_corner"].as<glm::vec2>();
-            }
-            if (component["bottom_left_corner"].IsDefined())
-            {
-                deserialized_component->bottom_left_corner = component["bottom_left_corner"].as<glm::vec2>();
-            }
-            if (component["bottom_right_corner"].IsDefined())
-            {
-                deserialized_component->bottom_right_corner = component["bottom_right_corner"].as<glm::vec2>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ModelComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Model::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Model>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CubeComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Cube::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Cube>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["diffuse_texture_path"].IsDefined())
-            {
-                deserialized_component->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
-            }
-            if (component["specular_texture_path"].IsDefined())
-            {
-                deserialized_component->specular_texture_path = component["specular_texture_path"].as<std::string>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SphereComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Sphere::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Sphere>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["sector_count"].IsDefined())
-            {
-                deserialized_component->sector_count = component["sector_count"].as<u32>();
-            }
-            if (component["stack_count"].IsDefined())
-            {
-                deserialized_component->stack_count = component["stack_count"].as<u32>();
-            }
-            if (component["texture_path"].IsDefined())
-            {
-                deserialized_component->texture_path = component["texture_path"].as<std::string>();
-            }
-            if (component["radius"].IsDefined())
-            {
-                deserialized_component->radius = component["radius"].as<float>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SpriteComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Sprite::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Sprite>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["diffuse_texture_path"].IsDefined())
-            {
-                deserialized_component->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "WaterComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Water::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Water>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["waves"].IsDefined())
-            {
-                deserialized_component->waves = component["waves"].as<std::vector<DXWave>>();
-            }
-            if (component["m_ps_buffer"].IsDefined())
-            {
-                deserialized_component->m_ps_buffer = component["m_ps_buffer"].as<ConstantBufferWater>();
-            }
-            if (component["tesselation_level"].IsDefined())
-            {
-                deserialized_component->tesselation_level = component["tesselation_level"].as<u32>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PanelComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Panel::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Panel>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["background_path"].IsDefined())
-            {
-                deserialized_component->background_path = component["background_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ScreenTextComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ScreenText::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ScreenText>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["text"].IsDefined())
-            {
-                deserialized_component->text = component["text"].as<std::string>();
-            }
-            if (component["position"].IsDefined())
-            {
-                deserialized_component->position = component["position"].as<glm::vec2>();
-            }
-            if (component["font_size"].IsDefined())
-            {
-                deserialized_component->font_size = component["font_size"].as<float>();
-            }
-            if (component["color"].IsDefined())
-            {
-                deserialized_component->color = component["color"].as<u32>();
-            }
-            if (component["flags"].IsDefined())
-            {
-                deserialized_component->flags = component["flags"].as<u16>();
-            }
-            if (component["font_name"].IsDefined())
-            {
-                deserialized_component->font_name = component["font_name"].as<std::string>();
-            }
-            if (component["bold"].IsDefined())
-            {
-                deserialized_component->bold = component["bold"].as<bool>();
-            }
-            if (component["button_ref"].IsDefined())
-            {
-                deserialized_component->button_ref = component["button_ref"].as<std::weak_ptr<Button>>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ExampleDynamicTextComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ExampleDynamicText::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ExampleDynamicText>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ExampleUIBarComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ExampleUIBar::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ExampleUIBar>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["value"].IsDefined())
-            {
-                deserialized_component->value = component["value"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FloaterComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Floater::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Floater>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["sink"].IsDefined())
-            {
-                deserialized_component->sink = component["sink"].as<float>();
-            }
-            if (component["side_floaters_offset"].IsDefined())
-            {
-                deserialized_component->side_floaters_offset = component["side_floaters_offset"].as<float>();
-            }
-            if (component["side_roation_strength"].IsDefined())
-            {
-                deserialized_component->side_roation_strength = component["side_roation_strength"].as<float>();
-            }
-            if (component["forward_rotation_strength"].IsDefined())
-            {
-                deserialized_component->forward_rotation_strength = component["forward_rotation_strength"].as<float>();
-            }
-            if (component["forward_floaters_offest"].IsDefined())
-            {
-                deserialized_component->forward_floaters_offest = component["forward_floaters_offest"].as<float>();
-            }
-            if (component["water"].IsDefined())
-            {
-                deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FloatersManagerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = FloatersManager::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class FloatersManager>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["big_boat_settings"].IsDefined())
-            {
-                deserialized_component->big_boat_settings = component["big_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["small_boat_settings"].IsDefined())
-            {
-                deserialized_component->small_boat_settings = component["small_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["medium_boat_settings"].IsDefined())
-            {
-                deserialized_component->medium_boat_settings = component["medium_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["tool_boat_settings"].IsDefined())
-            {
-                deserialized_component->tool_boat_settings = component["tool_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["pirate_boat_settings"].IsDefined())
-            {
-                deserialized_component->pirate_boat_settings = component["pirate_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["water"].IsDefined())
-            {
-                deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FloeButtonComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = FloeButton::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class FloeButton>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["floe_button_type"].IsDefined())
-            {
-                deserialized_component->floe_button_type = component["floe_button_type"].as<FloeButtonType>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "DirectionalLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = DirectionalLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class DirectionalLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["ambient"].IsDefined())
-            {
-                deserialized_component->ambient = component["ambient"].as<glm::vec3>();
-            }
-            if (component["diffuse"].IsDefined())
-            {
-                deserialized_component->diffuse = component["diffuse"].as<glm::vec3>();
-            }
-            if (component["specular"].IsDefined())
-            {
-                deserialized_component->specular = component["specular"].as<glm::vec3>();
-            }
-            if (component["m_near_plane"].IsDefined())
-            {
-                deserialized_component->m_near_plane = component["m_near_plane"].as<float>();
-            }
-            if (component["m_far_plane"].IsDefined())
-            {
-                deserialized_component->m_far_plane = component["m_far_plane"].as<float>();
-            }
-            if (component["m_blocker_search_num_samples"].IsDefined())
-            {
-                deserialized_component->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
-            }
-            if (component["m_pcf_num_samples"].IsDefined())
-            {
-                deserialized_component->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
-            }
-            if (component["m_light_world_size"].IsDefined())
-            {
-                deserialized_component->m_light_world_size = component["m_light_world_size"].as<float>();
-            }
-            if (component["m_light_frustum_width"].IsDefined())
-            {
-                deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PointLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = PointLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class PointLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["constant"].IsDefined())
-            {
-                deserialized_component->constant = component["constant"].as<float>();
-            }
-            if (component["linear"].IsDefined())
-            {
-                deserialized_component->linear = component["linear"].as<float>();
-            }
-            if (component["quadratic"].IsDefined())
-            {
-                deserialized_component->quadratic = component["quadratic"].as<float>();
-            }
-            if (component["ambient"].IsDefined())
-            {
-                deserialized_component->ambient = component["ambient"].as<glm::vec3>();
-            }
-            if (component["diffuse"].IsDefined())
-            {
-                deserialized_component->diffuse = component["diffuse"].as<glm::vec3>();
-            }
-            if (component["specular"].IsDefined())
-            {
-                deserialized_component->specular = component["specular"].as<glm::vec3>();
-            }
-            if (component["m_near_plane"].IsDefined())
-            {
-                deserialized_component->m_near_plane = component["m_near_plane"].as<float>();
-            }
-            if (component["m_far_plane"].IsDefined())
-            {
-                deserialized_component->m_far_plane = component["m_far_plane"].as<float>();
-            }
-            if (component["m_blocker_search_num_samples"].IsDefined())
-            {
-                deserialized_component->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
-            }
-            if (component["m_pcf_num_samples"].IsDefined())
-            {
-                deserialized_component->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
-            }
-            if (component["m_light_world_size"].IsDefined())
-            {
-                deserialized_component->m_light_world_size = component["m_light_world_size"].as<float>();
-            }
-            if (component["m_light_frustum_width"].IsDefined())
-            {
-                deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SpotLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = SpotLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class SpotLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["constant"].IsDefined())
-            {
-                deserialized_component->constant = component["constant"].as<float>();
-            }
-            if (component["linear"].IsDefined())
-            {
-                deserialized_component->linear = component["linear"].as<float>();
-            }
-            if (component["quadratic"].IsDefined())
-            {
-                deserialized_component->quadratic = component["quadratic"].as<float>();
-            }
-            if (component["scattering_factor"].IsDefined())
-            {
-                deserialized_component->scattering_factor = component["scattering_factor"].as<float>();
-            }
-            if (component["cut_off"].IsDefined())
-            {
-                deserialized_component->cut_off = component["cut_off"].as<float>();
-            }
-            if (component["outer_cut_off"].IsDefined())
-            {
-                deserialized_component->outer_cut_off = component["outer_cut_off"].as<float>();
-            }
-            if (component["ambient"].IsDefined())
-            {
-                deserialized_component->ambient = component["ambient"].as<glm::vec3>();
-            }
-            if (component["diffuse"].IsDefined())
-            {
-                deserialized_component->diffuse = component["diffuse"].as<glm::vec3>();
-            }
-            if (component["specular"].IsDefined())
-            {
-                deserialized_component->specular = component["specular"].as<glm::vec3>();
-            }
-            if (component["m_near_plane"].IsDefined())
-            {
-                deserialized_component->m_near_plane = component["m_near_plane"].as<float>();
-            }
-            if (component["m_far_plane"].IsDefined())
-            {
-                deserialized_component->m_far_plane = component["m_far_plane"].as<float>();
-            }
-            if (component["m_blocker_search_num_samples"].IsDefined())
-            {
-                deserialized_component->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
-            }
-            if (component["m_pcf_num_samples"].IsDefined())
-            {
-                deserialized_component->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
-            }
-            if (component["m_light_world_size"].IsDefined())
-            {
-                deserialized_component->m_light_world_size = component["m_light_world_size"].as<float>();
-            }
-            if (component["m_light_frustum_width"].IsDefined())
-            {
-                deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "NowPromptTriggerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = NowPromptTrigger::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class NowPromptTrigger>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ParticleSystemComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ParticleSystem::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ParticleSystem>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["particle_type"].IsDefined())
-            {
-                deserialized_component->particle_type = component["particle_type"].as<ParticleType>();
-            }
-            if (component["play_once"].IsDefined())
-            {
-                deserialized_component->play_once = component["play_once"].as<bool>();
-            }
-            if (component["rotate_particles"].IsDefined())
-            {
-                deserialized_component->rotate_particles = component["rotate_particles"].as<bool>();
-            }
-            if (component["spawn_instantly"].IsDefined())
-            {
-                deserialized_component->spawn_instantly = component["spawn_instantly"].as<bool>();
-            }
-            if (component["sprite_path"].IsDefined())
-            {
-                deserialized_component->sprite_path = component["sprite_path"].as<std::string>();
-            }
-            if (component["min_spawn_interval"].IsDefined())
-            {
-                deserialized_component->min_spawn_interval = component["min_spawn_interval"].as<float>();
-            }
-            if (component["max_spawn_interval"].IsDefined())
-            {
-                deserialized_component->max_spawn_interval = component["max_spawn_interval"].as<float>();
-            }
-            if (component["start_velocity_1"].IsDefined())
-            {
-                deserialized_component->start_velocity_1 = component["start_velocity_1"].as<glm::vec3>();
-            }
-            if (component["start_velocity_2"].IsDefined())
-            {
-                deserialized_component->start_velocity_2 = component["start_velocity_2"].as<glm::vec3>();
-            }
-            if (component["min_spawn_alpha"].IsDefined())
-            {
-                deserialized_component->min_spawn_alpha = component["min_spawn_alpha"].as<float>();
-            }
-            if (component["max_spawn_alpha"].IsDefined())
-            {
-                deserialized_component->max_spawn_alpha = component["max_spawn_alpha"].as<float>();
-            }
-            if (component["start_min_particle_size"].IsDefined())
-            {
-                deserialized_component->start_min_particle_size = component["start_min_particle_size"].as<glm::vec3>();
-            }
-            if (component["start_max_particle_size"].IsDefined())
-            {
-                deserialized_component->start_max_particle_size = component["start_max_particle_size"].as<glm::vec3>();
-            }
-            if (component["emitter_bounds"].IsDefined())
-            {
-                deserialized_component->emitter_bounds = component["emitter_bounds"].as<float>();
-            }
-            if (component["min_spawn_count"].IsDefined())
-            {
-                deserialized_component->min_spawn_count = component["min_spawn_count"].as<i32>();
-            }
-            if (component["max_spawn_count"].IsDefined())
-            {
-                deserialized_component->max_spawn_count = component["max_spawn_count"].as<i32>();
-            }
-            if (component["start_color_1"].IsDefined())
-            {
-                deserialized_component->start_color_1 = component["start_color_1"].as<glm::vec4>();
-            }
-            if (component["end_color_1"].IsDefined())
-            {
-                deserialized_component->end_color_1 = component["end_color_1"].as<glm::vec4>();
-            }
-            if (component["lifetime_1"].IsDefined())
-            {
-                deserialized_component->lifetime_1 = component["lifetime_1"].as<float>();
-            }
-            if (component["lifetime_2"].IsDefined())
-            {
-                deserialized_component->lifetime_2 = component["lifetime_2"].as<float>();
-            }
-            if (component["m_simulate_in_world_space"].IsDefined())
-            {
-                deserialized_component->m_simulate_in_world_space = component["m_simulate_in_world_space"].as<bool>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SoundComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Sound::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Sound>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["path"].IsDefined())
-            {
-                deserialized_component->path = component["path"].as<std::string>();
-            }
-            if (component["volume"].IsDefined())
-            {
-                deserialized_component->volume = component["volume"].as<float>();
-            }
-            if (component["play_on_awake"].IsDefined())
-            {
-                deserialized_component->play_on_awake = component["play_on_awake"].as<bool>();
-            }
-            if (component["is_positional"].IsDefined())
-            {
-                deserialized_component->is_positional = component["is_positional"].as<bool>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SoundListenerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = SoundListener::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class SoundListener>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ClockComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Clock::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Clock>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CreditsComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Credits::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Credits>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["back_to_menu_button"].IsDefined())
-            {
-                deserialized_component->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CustomerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Customer::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Customer>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["collider"].IsDefined())
-            {
-                deserialized_component->collider = component["collider"].as<std::weak_ptr<Collider2D>>();
-            }
-            if (component["left_hand"].IsDefined())
-            {
-                deserialized_component->left_hand = component["left_hand"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["right_hand"].IsDefined())
-            {
-                deserialized_component->right_hand = component["right_hand"].as<std::weak_ptr<Entity>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CustomerManagerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = CustomerManager::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class CustomerManager>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["destinations_after_feeding"].IsDefined())
-            {
-                deserialized_component->destinations_after_feeding =
-                    component["destinations_after_feeding"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            if (component["destination_curve"].IsDefined())
-            {
-                deserialized_component->destination_curve = component["destination_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["customer_prefab"].IsDefined())
-            {
-                deserialized_component->customer_prefab = component["customer_prefab"].as<std::string>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FactoryComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Factory::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Factory>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["type"].IsDefined())
-            {
-                deserialized_component->type = component["type"].as<FactoryType>();
-            }
-            if (component["lights"].IsDefined())
-            {
-                deserialized_component->lights = component["lights"].as<std::vector<std::weak_ptr<PointLight>>>();
-            }
-            if (component["factory_light"].IsDefined())
-            {
-                deserialized_component->factory_light = component["factory_light"].as<std::weak_ptr<PointLight>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "GameControllerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = GameController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class GameController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["current_scene"].IsDefined())
-            {
-                deserialized_component->current_scene = component["current_scene"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["next_scene"].IsDefined())
-            {
-                deserialized_component->next_scene = component["next_scene"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["dialog_manager"].IsDefined())
-            {
-                deserialized_component->dialog_manager = component["dialog_manager"].as<std::weak_ptr<DialoguePromptController>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "HovercraftWithoutKeeperComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = HovercraftWithoutKeeper::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class HovercraftWithoutKeeper>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "IceBoundComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = IceBound::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class IceBound>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "LevelControllerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = LevelController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class LevelController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["map_time"].IsDefined())
-            {
-                deserialized_component->map_time = component["map_time"].as<float>();
-            }
-            if (component["map_food"].IsDefined())
-            {
-                deserialized_component->map_food = component["map_food"].as<u32>();
-            }
-            if (component["maximum_lighthouse_level"].IsDefined())
-            {
-                deserialized_component->maximum_lighthouse_level = component["maximum_lighthouse_level"].as<i32>();
-            }
-            if (component["factories"].IsDefined())
-            {
-                deserialized_component->factories = component["factories"].as<std::vector<std::weak_ptr<Factory>>>();
-            }
-            if (component["port"].IsDefined())
-            {
-                deserialized_component->port = component["port"].as<std::weak_ptr<Port>>();
-            }
-            if (component["lighthouse"].IsDefined())
-            {
-                deserialized_component->lighthouse = component["lighthouse"].as<std::weak_ptr<Lighthouse>>();
-            }
-            if (component["customer_manager"].IsDefined())
-            {
-                deserialized_component->customer_manager = component["customer_manager"].as<std::weak_ptr<CustomerManager>>();
-            }
-            if (component["playfield_width"].IsDefined())
-            {
-                deserialized_component->playfield_width = component["playfield_width"].as<float>();
-            }
-            if (component["playfield_additional_width"].IsDefined())
-            {
-                deserialized_component->playfield_additional_width = component["playfield_additional_width"].as<float>();
-            }
-            if (component["playfield_height"].IsDefined())
-            {
-                deserialized_component->playfield_height = component["playfield_height"].as<float>();
-            }
-            if (component["playfield_y_shift"].IsDefined())
-            {
-                deserialized_component->playfield_y_shift = component["playfield_y_shift"].as<float>();
-            }
-            if (component["ships_limit_curve"].IsDefined())
-            {
-                deserialized_component->ships_limit_curve = component["ships_limit_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_limit"].IsDefined())
-            {
-                deserialized_component->ships_limit = component["ships_limit"].as<u32>();
-            }
-            if (component["ships_speed_curve"].IsDefined())
-            {
-                deserialized_component->ships_speed_curve = component["ships_speed_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_speed"].IsDefined())
-            {
-                deserialized_component->ships_speed = component["ships_speed"].as<float>();
-            }
-            if (component["ships_range_curve"].IsDefined())
-            {
-                deserialized_component->ships_range_curve = component["ships_range_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_turn_curve"].IsDefined())
-            {
-                deserialized_component->ships_turn_curve = component["ships_turn_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_additional_speed_curve"].IsDefined())
-            {
-                deserialized_component->ships_additional_speed_curve = component["ships_additional_speed_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["pirates_in_control_curve"].IsDefined())
-            {
-                deserialized_component->pirates_in_control_curve = component["pirates_in_control_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["is_tutorial"].IsDefined())
-            {
-                deserialized_component->is_tutorial = component["is_tutorial"].as<bool>();
-            }
-            if (component["starting_packages"].IsDefined())
-            {
-                deserialized_component->starting_packages = component["starting_packages"].as<u32>();
-            }
-            if (component["tutorial_level"].IsDefined())
-            {
-                deserialized_component->tutorial_level = component["tutorial_level"].as<u32>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "LighthouseComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Lighthouse::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Lighthouse>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["light"].IsDefined())
-            {
-                deserialized_component->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
-            }
-            if (component["water"].IsDefined())
-            {
-                deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
-            }
-            if (component["spawn_position"].IsDefined())
-            {
-                deserialized_component->spawn_position = component["spawn_position"].as<std::weak_ptr<Entity>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "LighthouseKeeperComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = LighthouseKeeper::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class LighthouseKeeper>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["maximum_speed"].IsDefined())
-            {
-                deserialized_component->maximum_speed = component["maximum_speed"].as<float>();
-            }
-            if (component["acceleration"].IsDefined())
-            {
-                deserialized_component->acceleration = component["acceleration"].as<float>();
-            }
-            if (component["deceleration"].IsDefined())
-            {
-                deserialized_component->deceleration = component["deceleration"].as<float>();
-            }
-            if (component["lighthouse"].IsDefined())
-            {
-                deserialized_component->lighthouse = component["lighthouse"].as<std::weak_ptr<Lighthouse>>();
-            }
-            if (component["port"].IsDefined())
-            {
-                deserialized_component->port = component["port"].as<std::weak_ptr<Port>>();
-            }
-            if (component["keeper_dust"].IsDefined())
-            {
-                deserialized_component->keeper_dust = component["keeper_dust"].as<std::weak_ptr<ParticleSystem>>();
-            }
-            if (component["keeper_splash"].IsDefined())
-            {
-                deserialized_component->keeper_splash = component["keeper_splash"].as<std::weak_ptr<ParticleSystem>>();
-            }
-            if (component["packages"].IsDefined())
-            {
-                deserialized_component->packages = component["packages"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "LighthouseLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = LighthouseLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class LighthouseLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["spotlight"].IsDefined())
-            {
-                deserialized_component->spotlight = component["spotlight"].as<std::weak_ptr<SpotLight>>();
-            }
-            if (component["spotlight_beam_width"].IsDefined())
-            {
-                deserialized_component->spotlight_beam_width = component["spotlight_beam_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PlayerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Player::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Player>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["packages_text"].IsDefined())
-            {
-                deserialized_component->packages_text = component["packages_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["flashes_text"].IsDefined())
-            {
-                deserialized_component->flashes_text = component["flashes_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["level_text"].IsDefined())
-            {
-                deserialized_component->level_text = component["level_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["clock_text"].IsDefined())
-            {
-                deserialized_component->clock_text = component["clock_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PopupComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Popup::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Popup>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "EndScreenComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = EndScreen::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class EndScreen>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["is_failed"].IsDefined())
-            {
-                deserialized_component->is_failed = component["is_failed"].as<bool>();
-            }
-            if (component["number_of_stars"].IsDefined())
-            {
-                deserialized_component->number_of_stars = component["number_of_stars"].as<u32>();
-            }
-            if (component["stars"].IsDefined())
-            {
-                deserialized_component->stars = component["stars"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            if (component["star_scale"].IsDefined())
-            {
-                deserialized_component->star_scale = component["star_scale"].as<glm::vec2>();
-            }
-            if (component["next_level_button"].IsDefined())
-            {
-                deserialized_component->next_level_button = component["next_level_button"].as<std::weak_ptr<Button>>();
-            }
-            if (component["restart_button"].IsDefined())
-            {
-                deserialized_component->restart_button = component["restart_button"].as<std::weak_ptr<Button>>();
-            }
-            if (component["menu_button"].IsDefined())
-            {
-                deserialized_component->menu_button = component["menu_button"].as<std::weak_ptr<Button>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PortComponent")
+void SceneSerializer::serialize_entity_binary(BinaryWriter& writer, std::shared_ptr<Entity> const& entity)
+{
+    std::string parent_guid = {};
+
+    if (entity->transform->has_parent())
+        parent_guid = entity->transform->get_parent()->entity.lock()->guid;
+
+    writer.begin_entity(entity->guid, entity->name, parent_guid, entity->transform->get_local_position(),
+                        entity->transform->get_euler_angles(), entity->transform->get_local_scale());
+
+    for (auto const& component : entity->components)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Port::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Port>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["lights"].IsDefined())
-            {
-                deserialized_component->lights = component["lights"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        auto_serialize_component_binary(writer, component);
     }
-    else if (component_name == "ShipComponent")
+}
+
+void SceneSerializer::serialize_entity_recursively_binary(BinaryWriter& writer, std::shared_ptr<Entity> const& entity)
+{
+    if (!entity->is_serialized)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Ship::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Ship>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["type"].IsDefined())
-            {
-                deserialized_component->type = component["type"].as<ShipType>();
-            }
-            if (component["light"].IsDefined())
-            {
-                deserialized_component->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
-            }
-            if (component["spawner"].IsDefined())
-            {
-                deserialized_component->spawner = component["spawner"].as<std::weak_ptr<ShipSpawner>>();
-            }
-            if (component["eyes"].IsDefined())
-            {
-                deserialized_component->eyes = component["eyes"].as<std::weak_ptr<ShipEyes>>();
-            }
-            if (component["my_light"].IsDefined())
-            {
-                deserialized_component->my_light = component["my_light"].as<std::weak_ptr<PointLight>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        return;
     }
-    else if (component_name == "ShipEyesComponent")
+
+    serialize_entity_binary(writer, entity);
+
+    for (auto const& child : entity->transform->children)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = ShipEyes::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ShipEyes>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        if (child->entity.expired())
+            continue;
+
+        serialize_entity_recursively_binary(writer, child->entity.lock());
     }
-    else if (component_name == "ShipSpawnerComponent")
+}
+
+void SceneSerializer::auto_deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity,
+                                                 bool const first_pass)
+{
+    auto const component_name = component["ComponentName"].as<std::string>();
+
+    switch (AK::fnv1a_hash(component_name))
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = ShipSpawner::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ShipSpawner>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["paths"].IsDefined())
-            {
-                deserialized_component->paths = component["paths"].as<std::vector<std::weak_ptr<Path>>>();
-            }
-            if (component["floaters_manager"].IsDefined())
-            {
-                deserialized_component->floaters_manager = component["floaters_manager"].as<std::weak_ptr<FloatersManager>>();
-            }
-            if (component["light"].IsDefined())
-            {
-                deserialized_component->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
-            }
-            if (component["last_chance_food_threshold"].IsDefined())
-            {
-                deserialized_component->last_chance_food_threshold = component["last_chance_food_threshold"].as<u32>();
-            }
-            if (component["last_chance_time_threshold"].IsDefined())
-            {
-                deserialized_component->last_chance_time_threshold = component["last_chance_time_threshold"].as<float>();
-            }
-            if (component["main_event_spawn"].IsDefined())
-            {
-                deserialized_component->main_event_spawn = component["main_event_spawn"].as<std::vector<SpawnEvent>>();
-            }
-            if (component["backup_spawn"].IsDefined())
-            {
-                deserialized_component->backup_spawn = component["backup_spawn"].as<std::vector<SpawnEvent>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+#define ENUMERATE_COMPONENT(type, ui_name)                                             \
+    case ComponentReflection<class type>::name_hash:                                   \
+        deserialize_component<class type>(component, deserialized_entity, first_pass); \
+        break;
+        ENUMERATE_COMPONENTS
+#undef ENUMERATE_COMPONENT
+    default:
+        std::cout << "Error. Deserialization of component " << component_name << " failed."
+                  << "\n";
+        break;
     }
-    else if (component_name == "ThanksComponent")
+}
+
+template<typename T>
+void SceneSerializer::deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity,
+                                            bool const first_pass)
+{
+    if (first_pass)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Thanks::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Thanks>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["back_to_menu_button"].IsDefined())
-            {
-                deserialized_component->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        auto const deserialized_component = T::create();
+        deserialized_component->guid = component["guid"].as<std::string>();
+        deserialized_component->custom_name = component["custom_name"].as<std::string>();
+        deserialized_pool.emplace_back(deserialized_component);
+        return;
     }
-    else if (component_name == "PlayerInputComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = PlayerInput::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class PlayerInput>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["player_speed"].IsDefined())
-            {
-                deserialized_component->player_speed = component["player_speed"].as<float>();
-            }
-            if (component["camera_speed"].IsDefined())
-            {
-                deserialized_component->camera_speed = component["camera_speed"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+
+    auto const deserialized_component = std::dynamic_pointer_cast<T>(get_from_pool(component["guid"].as<std::string>()));
+    read_yaml_fields(component, *deserialized_component);
+    deserialized_entity->add_component(deserialized_component);
+    deserialized_component->reprepare();
+}
+
+u32 SceneSerializer::get_binary_schema_hash()
+{
+    // # Auto binary schema hash start
+    return 0x8903cdb4;
+    // # Auto binary schema hash end
+}
+
+void SceneSerializer::auto_serialize_component_binary(BinaryWriter& writer, std::shared_ptr<Component> const& component)
+{
+#define ENUMERATE_COMPONENT(type, ui_name)                                          \
+    if (typeid(*component) == typeid(class type))                                   \
+    {                                                                               \
+        write_binary_component(writer, static_cast<class type const&>(*component)); \
+        return;                                                                     \
+    }
+    ENUMERATE_COMPONENTS
+#undef ENUMERATE_COMPONENT
+
+    // NOTE: This only returns unmangled name while using the MSVC compiler
+    std::string const name = typeid(*component).name();
+    std::cout << "Error. Binary serialization of component " << name.substr(6) << " failed."
+              << "\n";
+}
+
+std::shared_ptr<Component> SceneSerializer::auto_create_component_binary(u32 const type_hash)
+{
+    switch (type_hash)
+    {
+#define ENUMERATE_COMPONENT(type, ui_name)           \
+    case ComponentReflection<class type>::name_hash: \
+        return type::create();
+        ENUMERATE_COMPONENTS
+#undef ENUMERATE_COMPONENT
+    default:
+        return nullptr;
     }
-    else
+}
+
+void SceneSerializer::auto_deserialize_component_binary(BinaryReader& reader, u32 const type_hash, std::shared_ptr<Component> const& component)
+{
+    switch (type_hash)
     {
-        std::cout << "Error. Deserialization of component " << component_name << " failed."
-                  << "\n";
+#define ENUMERATE_COMPONENT(type, ui_name)                                   \
+    case ComponentReflection<class type>::name_hash:                         \
+        read_binary_component(reader, static_cast<class type&>(*component)); \
+        break;
+        ENUMERATE_COMPONENTS
+#undef ENUMERATE_COMPONENT
+    default:
+        break;
     }
-    // # Put new deserialization here
 }
 
 void SceneSerializer::deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity,
@@ -2494,14 +573,257 @@ std::shared_ptr<Entity> SceneSerializer::deserialize_entity_first_pass(YAML::Nod
 
     deserialize_components(entity, deserialized_entity, true);
 
-    return deserialized_entity;
-}
+    return deserialized_entity;
+}
+
+bool SceneSerializer::parse_scene(std::string_view const scene_text, std::string& scene_name, std::vector<YAML::Node>& entities)
+{
+    if (!m_parallel_parsing_enabled)
+    {
+        std::ispanstream stream(std::span<char const>(scene_text.data(), scene_text.size()));
+        YAML::Node const data = YAML::Load(stream);
+
+        if (!data["Scene"])
+            return false;
+
+        scene_name = data["Scene"].as<std::string>();
+
+        for (auto const entity : data["Entities"])
+        {
+            entities.emplace_back(entity);
+        }
+
+        return true;
+    }
+
+    // Every item of the top-level Entities sequence starts with a line like this. Lines inside entities are indented more.
+    std::string_view constexpr entity_start = "\n  - Entity:";
+
+    size_t offset = scene_text.find(entity_start);
+    std::string_view const header_text = scene_text.substr(0, offset == std::string_view::npos ? scene_text.size() : offset + 1);
+
+    std::vector<std::string_view> entity_texts = {};
+    while (offset != std::string_view::npos)
+    {
+        size_t const next_offset = scene_text.find(entity_start, offset + entity_start.size());
+        size_t const end = next_offset == std::string_view::npos ? scene_text.size() : next_offset + 1;
+        entity_texts.emplace_back(scene_text.substr(offset + 1, end - offset - 1));
+        offset = next_offset;
+    }
+
+    std::ispanstream header_stream(std::span<char const>(header_text.data(), header_text.size()));
+    YAML::Node const header = YAML::Load(header_stream);
+
+    if (!header["Scene"])
+        return false;
+
+    scene_name = header["Scene"].as<std::string>();
+
+    // Every entity is parsed as a one-item sequence on its own. Nodes don't share any memory, so they can be parsed in parallel
+    // and end up the same as the items of the whole Entities sequence.
+    std::atomic<bool> is_broken = false;
+    entities.resize(entity_texts.size());
+    std::transform(std::execution::par, entity_texts.begin(), entity_texts.end(), entities.begin(),
+                   [&is_broken](std::string_view const entity_text) -> YAML::Node {
+                       try
+                       {
+                           std::ispanstream stream(std::span<char const>(entity_text.data(), entity_text.size()));
+                           return YAML::Load(stream)[0];
+                       }
+                       catch (YAML::Exception const&)
+                       {
+                           is_broken = true;
+                           return {};
+                       }
+                   });
+
+    if (is_broken)
+    {
+        std::cout << "Deserialization of a scene failed. Broken entity YAML."
+                  << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+void SceneSerializer::deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity)
+{
+    deserialize_components(entity, deserialized_entity, false);
+
+    deserialized_entity->m_is_being_deserialized = false;
+}
+
+bool SceneSerializer::load_binary_file(std::string const& file_path, VirtualFile& binary_file, std::span<u8 const>& data,
+                                       bool const use_preloaded)
+{
+    if (!m_binary_enabled)
+        return false;
+
+    std::string const binary_path = get_binary_path(file_path);
+    std::error_code error = {};
+
+    if (!VirtualFileSystem::get_instance().exists(binary_path))
+        return false;
+
+    // YAML files are the editable source, so a binary file older than its YAML file is out of date.
+    // Packed files have no time, a loose YAML file next to a packed binary one is always newer.
+    if (std::filesystem::exists(file_path, error)
+        && std::filesystem::last_write_time(binary_path, error) < std::filesystem::last_write_time(file_path, error))
+    {
+        Debug::log("Binary scene file " + binary_path + " is older than its YAML file, loading the YAML one.", DebugType::Warning);
+        return false;
+    }
+
+    if (auto const preloaded_data = use_preloaded ? Engine::asset_preloader->get_binary_asset(binary_path) : std::nullopt)
+    {
+        data = preloaded_data.value();
+        return true;
+    }
+
+    if (!binary_file.open(binary_path))
+        return false;
+
+    data = binary_file.get_bytes();
+    return true;
+}
+
+void SceneSerializer::awake_deserialized_components() const
+{
+    if (m_is_awake_deferred || !MainScene::get_instance()->is_running)
+        return;
+
+    for (auto const& component : deserialized_pool)
+    {
+        component->awake();
+        component->has_been_awaken = true;
+
+        if (component->enabled())
+        {
+            component->on_enabled();
+        }
+    }
+}
+
+std::shared_ptr<Entity> SceneSerializer::instantiate_prefab(PrefabTemplate& prefab)
+{
+    BinaryReader& reader = prefab.reader;
+    ScopeGuard reset_reader = [&] { reader.reset(); };
+
+    // References share strings with the guids they point to, so replacing every guid once updates all references too
+    for (u32 const guid_index : prefab.guid_indices)
+        reader.replace_string(guid_index, AK::generate_guid());
+
+    DeserializationMode const previous_mode = m_deserialization_mode;
+    m_deserialization_mode = DeserializationMode::InjectFromFile;
+    ScopeGuard restore_mode = [&] { m_deserialization_mode = previous_mode; };
+
+    std::shared_ptr<Entity> first_entity = {};
+
+    if (!deserialize_binary(reader, first_entity))
+        return {};
+
+    return first_entity;
+}
+
+bool SceneSerializer::deserialize_binary(BinaryReader& reader, std::shared_ptr<Entity>& first_entity)
+{
+    auto const entity_records = reader.get_entities();
+    auto const component_records = reader.get_components();
+
+    std::vector<std::shared_ptr<Entity>> deserialized_entities = {};
+    deserialized_entities.reserve(entity_records.size());
+
+    // Indexed the same way as component_records. Unknown components stay nullptr.
+    std::vector<std::shared_ptr<Component>> deserialized_components(component_records.size());
+
+    deserialized_entities_pool.reserve(deserialized_entities_pool.size() + entity_records.size());
+    deserialized_pool.reserve(deserialized_pool.size() + component_records.size());
+
+    // First pass. Create all entities and components.
+    for (auto const& entity_record : entity_records)
+    {
+        auto const deserialized_entity =
+            Entity::create(std::string(reader.get_string(entity_record.guid)), std::string(reader.get_string(entity_record.name)));
+        deserialized_entity->m_is_being_deserialized = true;
+
+        deserialized_entity->transform->set_local_position(entity_record.position);
+        deserialized_entity->transform->set_euler_angles(entity_record.rotation);
+        deserialized_entity->transform->set_local_scale(entity_record.scale);
+        deserialized_entity->m_parent_guid = reader.get_string(entity_record.parent_guid);
+
+        for (u32 i = entity_record.first_component; i < entity_record.first_component + entity_record.component_count; ++i)
+        {
+            BinaryComponentRecord const& component_record = component_records[i];
+            auto const deserialized_component = auto_create_component_binary(component_record.type_hash);
+
+            if (deserialized_component == nullptr)
+            {
+                std::cout << "Error. Deserialization of component " << reader.get_string(component_record.type_name) << " failed."
+                          << "\n";
+                continue;
+            }
+
+            deserialized_component->guid = reader.get_string(component_record.guid);
+            deserialized_component->custom_name = reader.get_string(component_record.custom_name);
+            deserialized_pool.emplace_back(deserialized_component);
+            deserialized_components[i] = deserialized_component;
+            reader.register_component(component_record.guid, deserialized_component);
+        }
+
+        if (first_entity == nullptr)
+        {
+            first_entity = deserialized_entity;
+        }
+
+        reader.register_entity(entity_record.guid, deserialized_entity);
+        deserialized_entities_pool.emplace_back(deserialized_entity);
+        deserialized_entities.emplace_back(deserialized_entity);
+    }
+
+    // Second pass. Assign components' values including references to other components.
+    // Assign appropriate parent for each entity.
+    for (size_t i = 0; i < entity_records.size(); ++i)
+    {
+        BinaryEntityRecord const& entity_record = entity_records[i];
+        auto const& entity = deserialized_entities[i];
+
+        for (u32 j = entity_record.first_component; j < entity_record.first_component + entity_record.component_count; ++j)
+        {
+            auto const& component = deserialized_components[j];
+
+            if (component == nullptr)
+                continue;
+
+            reader.begin_component(component_records[j]);
+            auto_deserialize_component_binary(reader, component_records[j].type_hash, component);
+
+            if (reader.has_failed())
+            {
+                std::cout << "Deserialization of a scene failed. Broken component " << component->guid << "."
+                          << "\n";
+                return false;
+            }
+
+            entity->add_component(component);
+            component->reprepare();
+        }
+
+        entity->m_is_being_deserialized = false;
+
+        if (entity_record.parent_guid == binary_invalid_index)
+            continue;
+
+        // Parents are looked up only among the deserialized entities, the same as in the YAML path
+        if (auto const parent = reader.get_entity(entity_record.parent_guid); parent != nullptr)
+        {
+            entity->transform->set_parent(parent->transform);
+        }
+    }
 
-void SceneSerializer::deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity)
-{
-    deserialize_components(entity, deserialized_entity, false);
+    awake_deserialized_components();
 
-    deserialized_entity->m_is_being_deserialized = false;
+    return true;
 }
 
 // Serialize one entity (including its children) to a file.
@@ -2531,6 +853,8 @@ void SceneSerializer::serialize_this_entity(std::shared_ptr<Entity> const& entit
         create_directory(path.parent_path());
     }
 
+    auto const preload_again = unload_preloaded_while_saving(file_path);
+
     std::ofstream scene_file(file_path);
 
     if (!scene_file.is_open())
@@ -2541,37 +865,17 @@ void SceneSerializer::serialize_this_entity(std::shared_ptr<Entity> const& entit
 
     scene_file << out.c_str();
     scene_file.close();
+
+    // Prefabs edited in the editor are instantiated from the new file next time
+    get_prefab_templates().erase(file_path);
 }
 
 // Deserialize entity (might include its children) from a file.
 // Replaces all guids that are not present in the scene with newly generated ones.
-std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string const& file_path)
+std::string SceneSerializer::replace_included_guids(std::string_view const scene_text,
+                                                    std::unordered_map<std::string, std::string>& replaced_guids_map)
 {
-    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
-
-    std::stringstream stream;
-
-    if (!scene_data.has_value())
-    {
-        Debug::log("Preloading failed " + file_path);
-        std::ifstream scene_file(file_path);
-
-        if (!scene_file.is_open())
-        {
-            Debug::log("Could not open a scene file: " + file_path + "\n", DebugType::Error);
-            return {};
-        }
-
-        stream << scene_file.rdbuf();
-        scene_file.close();
-
-        scene_data = stream.str();
-    }
-    else
-    {
-        Debug::log("Preloading succ " + file_path);
-        stream = std::stringstream(scene_data.value());
-    }
+    std::ispanstream stream(std::span<char const>(scene_text.data(), scene_text.size()));
 
     std::unordered_set<std::string> included_guids = {};
     std::string line = {};
@@ -2629,33 +933,31 @@ std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string con
             continue;
         }
 
-        if (m_replaced_guids_map.contains(guid))
+        if (replaced_guids_map.contains(guid))
         {
-            line.replace(first_guid_char_offset, guid.size(), m_replaced_guids_map.at(guid));
+            line.replace(first_guid_char_offset, guid.size(), replaced_guids_map.at(guid));
         }
         else if (included_guids.contains(guid))
         {
             std::string new_guid = AK::generate_guid();
-            m_replaced_guids_map.emplace(guid, new_guid);
+            replaced_guids_map.emplace(guid, new_guid);
             line.replace(first_guid_char_offset, guid.size(), new_guid);
         }
 
         output << line << "\n";
     }
 
-    YAML::Node data = YAML::Load(output.str());
-
-    if (!data["Scene"])
-        return {};
+    return output.str();
+}
 
+std::shared_ptr<Entity> SceneSerializer::deserialize_injected_entities(std::vector<YAML::Node> const& entities)
+{
     DeserializationMode const previous_mode = m_deserialization_mode;
     m_deserialization_mode = DeserializationMode::InjectFromFile;
 
-    auto const scene_name = data["Scene"].as<std::string>();
-
     std::shared_ptr<Entity> first_entity = {};
 
-    if (auto const entities = data["Entities"])
+    if (!entities.empty())
     {
         std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
         deserialized_entities.reserve(entities.size());
@@ -2698,33 +1000,195 @@ std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string con
             }
         }
 
-        if (MainScene::get_instance()->is_running)
+        awake_deserialized_components();
+    }
+
+    m_deserialization_mode = previous_mode;
+
+    return first_entity;
+}
+
+std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string const& file_path)
+{
+    VirtualFile binary_file = {};
+
+    if (std::span<u8 const> binary_data = {}; load_binary_file(file_path, binary_file, binary_data))
+    {
+        BinaryReader reader = {};
+
+        if (reader.open(binary_data, get_binary_schema_hash()))
+        {
+            // Same replacement of guids as below. References share strings with the guids they point to,
+            // so replacing the guids of entities and components in the string table also updates all references.
+            auto const replace_guid = [&](u32 const guid_index) {
+                auto const guid = std::string(reader.get_string(guid_index));
+
+                if (!m_replaced_guids_map.contains(guid))
+                    m_replaced_guids_map.emplace(guid, AK::generate_guid());
+
+                reader.replace_string(guid_index, m_replaced_guids_map.at(guid));
+            };
+
+            for (auto const& entity_record : reader.get_entities())
+                replace_guid(entity_record.guid);
+
+            for (auto const& component_record : reader.get_components())
+                replace_guid(component_record.guid);
+
+            DeserializationMode const previous_mode = m_deserialization_mode;
+            m_deserialization_mode = DeserializationMode::InjectFromFile;
+            ScopeGuard restore_mode = [&] { m_deserialization_mode = previous_mode; };
+
+            std::shared_ptr<Entity> first_entity = {};
+
+            if (!deserialize_binary(reader, first_entity))
+                return {};
+
+            return first_entity;
+        }
+    }
+
+    VirtualFile scene_file = {};
+    std::optional<std::string_view> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+
+    if (!scene_data.has_value())
+    {
+        if (!scene_file.open(file_path))
+        {
+            Debug::log("Could not open a scene file: " + file_path + "\n", DebugType::Error);
+            return {};
+        }
+
+        scene_data = scene_file.get_text();
+    }
+
+    std::string const scene_text = replace_included_guids(scene_data.value(), m_replaced_guids_map);
+
+    std::string scene_name = {};
+    std::vector<YAML::Node> entities = {};
+
+    if (!parse_scene(scene_text, scene_name, entities))
+        return {};
+
+    return deserialize_injected_entities(entities);
+}
+
+void SceneSerializer::serialize(std::string const& file_path) const
+{
+    std::string scene_text = {};
+
+    // Running components modify themselves without marking their entities dirty
+    if (m_incremental_save_enabled && !m_scene->is_running)
+    {
+        scene_text = serialize_incrementally();
+    }
+    else
+    {
+        YAML::Emitter out;
+        out << YAML::BeginMap;
+        out << YAML::Key << "Scene" << YAML::Value << "Untitled";
+        out << YAML::Key << "Entities";
+        out << YAML::Value << YAML::BeginSeq;
+
+        for (auto const& entity : m_scene->entities)
+        {
+            if (!entity->is_serialized)
+            {
+                continue;
+            }
+
+            serialize_entity(out, entity);
+        }
+
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+
+        scene_text = out.c_str();
+    }
+
+    auto const preload_again = unload_preloaded_while_saving(file_path);
+
+    std::ofstream scene_file(file_path);
+
+    if (!scene_file.is_open())
+    {
+        std::cout << "Could not create a scene file: " << file_path << "\n";
+        return;
+    }
+
+    scene_file << scene_text;
+    scene_file.close();
+}
+
+// Produces the same text as emitting the whole scene at once in serialize(). Every entity is emitted separately
+// as an element of a sequence, then indented to its place under "Entities". Entities that weren't marked dirty,
+// and whose transform and components didn't change since the last save, keep the text emitted back then.
+std::string SceneSerializer::serialize_incrementally() const
+{
+    std::string scene_text = "Scene: Untitled\nEntities:";
+    bool has_entities = false;
+
+    for (auto const& entity : m_scene->entities)
+    {
+        if (!entity->is_serialized)
+        {
+            continue;
+        }
+
+        has_entities = true;
+
+        auto const [it, inserted] = m_scene->m_serialized_entities.try_emplace(entity->guid);
+        auto& serialized = it->second;
+
+        if (inserted || serialized.entity_version != entity->get_version()
+            || serialized.transform_version != entity->transform->get_version())
         {
-            for (auto const& component : deserialized_pool)
+            serialized.text.clear();
+            serialized.entity_version = entity->get_version();
+            serialized.transform_version = entity->transform->get_version();
+
+            YAML::Emitter out;
+            out << YAML::BeginSeq;
+            serialize_entity(out, entity);
+            out << YAML::EndSeq;
+
+            std::string_view const entity_text = out.c_str();
+
+            for (auto const line : std::views::split(entity_text, '\n'))
             {
-                component->awake();
-                component->has_been_awaken = true;
+                serialized.text += '\n';
 
-                if (component->enabled())
+                if (!line.empty())
                 {
-                    component->on_enabled();
+                    serialized.text += "  ";
+                    serialized.text.append(line.begin(), line.end());
+                }
+
+                // Every guid the entity refers to, so removing what it refers to emits it again
+                std::string_view const line_text(line.begin(), line.end());
+
+                if (size_t const guid_offset = line_text.find("guid: "); guid_offset != std::string_view::npos)
+                {
+                    std::string_view const guid = line_text.substr(guid_offset + 6);
+
+                    if (!guid.empty() && guid != "nullptr" && guid != "\"\"")
+                        m_scene->m_referrers[std::string(guid)].emplace(entity->guid);
                 }
             }
         }
+
+        scene_text += serialized.text;
     }
 
-    m_deserialization_mode = previous_mode;
+    if (!has_entities)
+        scene_text += "\n  []";
 
-    return first_entity;
+    return scene_text;
 }
 
-void SceneSerializer::serialize(std::string const& file_path) const
+void SceneSerializer::serialize_binary(std::string const& file_path) const
 {
-    YAML::Emitter out;
-    out << YAML::BeginMap;
-    out << YAML::Key << "Scene" << YAML::Value << "Untitled";
-    out << YAML::Key << "Entities";
-    out << YAML::Value << YAML::BeginSeq;
+    BinaryWriter writer = {};
 
     for (auto const& entity : m_scene->entities)
     {
@@ -2733,54 +1197,72 @@ void SceneSerializer::serialize(std::string const& file_path) const
             continue;
         }
 
-        serialize_entity(out, entity);
+        serialize_entity_binary(writer, entity);
     }
 
-    out << YAML::EndSeq;
-    out << YAML::EndMap;
+    auto const preload_again = unload_preloaded_while_saving(file_path);
 
-    std::ofstream scene_file(file_path);
+    writer.save(file_path, get_binary_schema_hash());
+}
 
-    if (!scene_file.is_open())
+void SceneSerializer::serialize_this_entity_binary(std::shared_ptr<Entity> const& entity, std::string const& file_path) const
+{
+    BinaryWriter writer = {};
+
+    serialize_entity_recursively_binary(writer, entity);
+
+    std::filesystem::path const path = file_path;
+
+    if (path.has_parent_path() && !std::filesystem::exists(path.parent_path()))
     {
-        std::cout << "Could not create a scene file: " << file_path << "\n";
-        return;
+        create_directory(path.parent_path());
     }
 
-    scene_file << out.c_str();
-    scene_file.close();
+    auto const preload_again = unload_preloaded_while_saving(file_path);
+
+    writer.save(file_path, get_binary_schema_hash());
 }
 
 bool SceneSerializer::deserialize(std::string const& file_path)
 {
-    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+    VirtualFile binary_file = {};
 
-    if (!scene_data.has_value())
+    if (std::span<u8 const> binary_data = {}; load_binary_file(file_path, binary_file, binary_data))
     {
-        std::ifstream scene_file(file_path);
+        BinaryReader reader = {};
+
+        if (reader.open(binary_data, get_binary_schema_hash()))
+        {
+            std::cout << "Deserializing binary scene " << get_binary_path(file_path) << "\n";
+
+            std::shared_ptr<Entity> first_entity = {};
+            return deserialize_binary(reader, first_entity);
+        }
+    }
 
-        if (!scene_file.is_open())
+    VirtualFile scene_file = {};
+    std::optional<std::string_view> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+
+    if (!scene_data.has_value())
+    {
+        if (!scene_file.open(file_path))
         {
             std::cout << "Could not open a scene file: " << file_path << "\n";
             return false;
         }
 
-        std::stringstream stream;
-        stream << scene_file.rdbuf();
-        scene_file.close();
-
-        scene_data = stream.str();
+        scene_data = scene_file.get_text();
     }
 
-    YAML::Node data = YAML::Load(scene_data.value());
+    std::string scene_name = {};
+    std::vector<YAML::Node> entities = {};
 
-    if (!data["Scene"])
+    if (!parse_scene(scene_data.value(), scene_name, entities))
         return false;
 
-    auto const scene_name = data["Scene"].as<std::string>();
     std::cout << "Deserializing scene " << scene_name << "\n";
 
-    if (auto const entities = data["Entities"])
+    if (!entities.empty())
     {
         std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
         deserialized_entities.reserve(entities.size());
@@ -2815,19 +1297,7 @@ bool SceneSerializer::deserialize(std::string const& file_path)
             }
         }
 
-        if (MainScene::get_instance()->is_running)
-        {
-            for (auto const& component : deserialized_pool)
-            {
-                component->awake();
-                component->has_been_awaken = true;
-
-                if (component->enabled())
-                {
-                    component->on_enabled();
-                }
-            }
-        }
+        awake_deserialized_components();
     }
 
     return true;
@@ -2850,7 +1320,185 @@ std::shared_ptr<Entity> SceneSerializer::load_prefab(std::string const& prefab_n
     scene_serializer->set_instance(scene_serializer);
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
 
-    std::shared_ptr<Entity> entity = scene_serializer->deserialize_this_entity(m_prefab_path + prefab_name + ".txt");
+    std::string const file_path = m_prefab_path + prefab_name + ".txt";
+
+    if (!m_prefab_cache_enabled)
+        return scene_serializer->deserialize_this_entity(file_path);
+
+    auto& prefab_templates = get_prefab_templates();
+
+    if (auto const it = prefab_templates.find(file_path); it != prefab_templates.end())
+        return scene_serializer->instantiate_prefab(*it->second);
+
+    auto prefab = std::make_unique<PrefabTemplate>();
+
+    VirtualFile binary_file = {};
+    std::span<u8 const> binary_data = {};
+
+    if (!load_binary_file(file_path, binary_file, binary_data))
+    {
+        // Without an up-to-date binary file the prefab is loaded from YAML once, and those objects are the first instance.
+        // The template is written before they are awoken, so it contains the same values as the file.
+        scene_serializer->m_is_awake_deferred = true;
+        std::shared_ptr<Entity> const entity = scene_serializer->deserialize_this_entity(file_path);
+        scene_serializer->m_is_awake_deferred = false;
+
+        if (entity == nullptr)
+            return {};
+
+        BinaryWriter writer = {};
+        serialize_entity_recursively_binary(writer, entity);
+        prefab->data = writer.finish(get_binary_schema_hash());
+
+        scene_serializer->awake_deserialized_components();
+
+        if (open_prefab_template(*prefab, get_binary_schema_hash()))
+            prefab_templates.emplace(file_path, std::move(prefab));
+
+        return entity;
+    }
+
+    // The file might be preloaded and unmapped later, so the template keeps its own copy
+    prefab->data.assign(binary_data.begin(), binary_data.end());
+
+    if (!open_prefab_template(*prefab, get_binary_schema_hash()))
+        return scene_serializer->deserialize_this_entity(file_path);
+
+    auto const& inserted_prefab = prefab_templates.emplace(file_path, std::move(prefab)).first->second;
+    return scene_serializer->instantiate_prefab(*inserted_prefab);
+}
+
+std::shared_ptr<ParsedPrefab> SceneSerializer::parse_prefab(std::string const& prefab_name)
+{
+    auto prefab = std::make_shared<ParsedPrefab>();
+    prefab->file_path = m_prefab_path + prefab_name + ".txt";
+
+    // AssetPreloader is only safe to use on the main thread, so files are mapped separately here
+    VirtualFile file = {};
+    std::span<u8 const> binary_data = {};
+
+    if (load_binary_file(prefab->file_path, file, binary_data, false))
+    {
+        auto prefab_template = std::make_unique<PrefabTemplate>();
+        prefab_template->data.assign(binary_data.begin(), binary_data.end());
+
+        if (open_prefab_template(*prefab_template, get_binary_schema_hash()))
+        {
+            for (u32 i = 0; i < prefab_template->reader.get_string_count(); ++i)
+            {
+                add_model_path(prefab_template->reader.get_string(i), prefab->model_paths);
+            }
+
+            prefab->binary_template = std::move(prefab_template);
+            return prefab;
+        }
+    }
+
+    if (!file.open(prefab->file_path))
+        return nullptr;
+
+    std::unordered_map<std::string, std::string> replaced_guids_map = {};
+    std::string const scene_text = replace_included_guids(file.get_text(), replaced_guids_map);
+
+    if (std::string scene_name = {}; !parse_scene(scene_text, scene_name, prefab->entities))
+        return nullptr;
+
+    for (auto const& entity : prefab->entities)
+    {
+        for (auto const component : entity["Components"])
+        {
+            for (auto const field : component)
+            {
+                if (field.second.IsScalar())
+                    add_model_path(field.second.Scalar(), prefab->model_paths);
+            }
+        }
+    }
+
+    return prefab;
+}
+
+std::shared_ptr<Entity> SceneSerializer::load_parsed_prefab(ParsedPrefab& prefab)
+{
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+
+    if (prefab.binary_template == nullptr)
+        return scene_serializer->deserialize_injected_entities(prefab.entities);
+
+    if (!m_prefab_cache_enabled)
+        return scene_serializer->instantiate_prefab(*prefab.binary_template);
+
+    // Later loads of the same prefab don't have to read it again
+    auto const [it, inserted] = get_prefab_templates().try_emplace(prefab.file_path, std::move(prefab.binary_template));
+    return scene_serializer->instantiate_prefab(*it->second);
+}
+
+void SceneSerializer::set_prefab_cache_enabled(bool const enabled)
+{
+    m_prefab_cache_enabled = enabled;
+}
+
+bool SceneSerializer::is_prefab_cache_enabled()
+{
+    return m_prefab_cache_enabled;
+}
+
+void SceneSerializer::clear_prefab_cache()
+{
+    get_prefab_templates().clear();
+}
+
+u32 SceneSerializer::clear_prefab_cache(std::vector<std::string> const& changed_paths)
+{
+    std::unordered_set<std::string> normalized_paths = {};
+
+    for (auto const& path : changed_paths)
+        normalized_paths.emplace(VirtualFileSystem::normalize_path(path));
+
+    return static_cast<u32>(std::erase_if(get_prefab_templates(), [&](auto const& item) {
+        return normalized_paths.contains(VirtualFileSystem::normalize_path(item.first))
+               || normalized_paths.contains(VirtualFileSystem::normalize_path(get_binary_path(item.first)));
+    }));
+}
+
+void SceneSerializer::set_parallel_parsing_enabled(bool const enabled)
+{
+    m_parallel_parsing_enabled = enabled;
+}
+
+bool SceneSerializer::is_parallel_parsing_enabled()
+{
+    return m_parallel_parsing_enabled;
+}
 
-    return entity;
+void SceneSerializer::set_incremental_save_enabled(bool const enabled)
+{
+    m_incremental_save_enabled = enabled;
+}
+
+bool SceneSerializer::is_incremental_save_enabled()
+{
+    return m_incremental_save_enabled;
+}
+
+std::vector<std::shared_ptr<Entity>> const& SceneSerializer::get_deserialized_entities() const
+{
+    return deserialized_entities_pool;
+}
+
+std::string SceneSerializer::get_binary_path(std::string const& file_path)
+{
+    return std::filesystem::path(file_path).replace_extension(".bin").string();
+}
+
+void SceneSerializer::set_binary_enabled(bool const enabled)
+{
+    m_binary_enabled = enabled;
+}
+
+bool SceneSerializer::is_binary_enabled()
+{
+    return m_binary_enabled;
 }
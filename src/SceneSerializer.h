@@ -1,6 +1,8 @@
 #pragma once
 
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <yaml-cpp/node/node.h>
 
@@ -12,6 +14,27 @@ namespace YAML
 class Emitter;
 }
 
+class BinaryReader;
+class VirtualFile;
+struct PrefabTemplate;
+
+// Prefab read and parsed by SceneSerializer::parse_prefab(), ready to be instantiated on the main thread.
+struct ParsedPrefab
+{
+    ParsedPrefab();
+    ~ParsedPrefab();
+
+    std::string file_path = {};
+
+    // Set when the prefab was read from an up-to-date binary file. Otherwise entities are parsed from YAML, with guids already replaced.
+    std::unique_ptr<PrefabTemplate> binary_template = {};
+    std::vector<YAML::Node> entities = {};
+
+    // Model files used by the prefab, so they can be read ahead of time
+    std::vector<std::string> model_paths = {};
+};
+class BinaryWriter;
+
 enum class DeserializationMode
 {
     Normal,
@@ -35,20 +58,80 @@ public:
     void serialize(std::string const& file_path) const;
     bool deserialize(std::string const& file_path);
 
+    // Binary versions of the scene files, see BinarySerialization.h. They are written next to the YAML files with a .bin extension.
+    void serialize_binary(std::string const& file_path) const;
+    void serialize_this_entity_binary(std::shared_ptr<Entity> const& entity, std::string const& file_path) const;
+
     static void save_prefab(std::shared_ptr<Entity> const& entity, std::string const& prefab_name);
+    // Prefabs are parsed once into a template, later loads create new instances from it.
     static std::shared_ptr<Entity> load_prefab(std::string const& prefab_name);
 
+    // load_prefab() split in two. Parsing doesn't create any objects, so it can be done on any thread.
+    [[nodiscard]] static std::shared_ptr<ParsedPrefab> parse_prefab(std::string const& prefab_name);
+    static std::shared_ptr<Entity> load_parsed_prefab(ParsedPrefab& prefab);
+
+    [[nodiscard]] std::vector<std::shared_ptr<Entity>> const& get_deserialized_entities() const;
+
+    [[nodiscard]] static std::string get_binary_path(std::string const& file_path);
+
+    // When enabled, deserialization reads the binary file instead of the YAML one if it exists and is not older.
+    static void set_binary_enabled(bool const enabled);
+    [[nodiscard]] static bool is_binary_enabled();
+
+    // When disabled, every load_prefab() parses the prefab file again.
+    static void set_prefab_cache_enabled(bool const enabled);
+    [[nodiscard]] static bool is_prefab_cache_enabled();
+    static void clear_prefab_cache();
+
+    // Forgets only the prefabs read from any of the files, YAML or binary. Returns how many were forgotten.
+    static u32 clear_prefab_cache(std::vector<std::string> const& changed_paths);
+
+    // When enabled, the YAML of every entity is parsed separately on multiple threads. Objects are still created
+    // on the calling thread, in the order of the file.
+    static void set_parallel_parsing_enabled(bool const enabled);
+    [[nodiscard]] static bool is_parallel_parsing_enabled();
+
+    // When enabled, serialize() reuses the YAML of entities that weren't marked dirty in the scene since the last save.
+    static void set_incremental_save_enabled(bool const enabled);
+    [[nodiscard]] static bool is_incremental_save_enabled();
+
 private:
     static void serialize_entity(YAML::Emitter& out, std::shared_ptr<Entity> const& entity);
     static void serialize_entity_recursively(YAML::Emitter& out, std::shared_ptr<Entity> const& entity);
+    [[nodiscard]] std::string serialize_incrementally() const;
     static void auto_serialize_component(YAML::Emitter& out, std::shared_ptr<Component> const& component);
     void auto_deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
+    template<typename T>
+    void deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
 
     void deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
 
+    // Parses the YAML of a scene into the nodes of its entities, in the order of the file.
+    [[nodiscard]] static bool parse_scene(std::string_view const scene_text, std::string& scene_name, std::vector<YAML::Node>& entities);
     [[nodiscard]] std::shared_ptr<Entity> deserialize_entity_first_pass(YAML::Node const& entity);
+    // Replaces the guids of all entities and components defined in the file, and references to them, with new ones.
+    [[nodiscard]] static std::string replace_included_guids(std::string_view const scene_text,
+                                                            std::unordered_map<std::string, std::string>& replaced_guids_map);
+    std::shared_ptr<Entity> deserialize_injected_entities(std::vector<YAML::Node> const& entities);
     void deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity);
 
+    [[nodiscard]] static u32 get_binary_schema_hash();
+    static void auto_serialize_component_binary(BinaryWriter& writer, std::shared_ptr<Component> const& component);
+    [[nodiscard]] static std::shared_ptr<Component> auto_create_component_binary(u32 const type_hash);
+    static void auto_deserialize_component_binary(BinaryReader& reader, u32 const type_hash, std::shared_ptr<Component> const& component);
+
+    static void serialize_entity_binary(BinaryWriter& writer, std::shared_ptr<Entity> const& entity);
+    static void serialize_entity_recursively_binary(BinaryWriter& writer, std::shared_ptr<Entity> const& entity);
+
+    // Points data at the binary version of a scene file, if there is an up-to-date one. Preloaded files are used directly,
+    // others are opened into binary_file, which has to outlive data.
+    [[nodiscard]] static bool load_binary_file(std::string const& file_path, VirtualFile& binary_file, std::span<u8 const>& data,
+                                               bool const use_preloaded = true);
+    bool deserialize_binary(BinaryReader& reader, std::shared_ptr<Entity>& first_entity);
+    std::shared_ptr<Entity> instantiate_prefab(PrefabTemplate& prefab);
+
+    void awake_deserialized_components() const;
+
     std::vector<std::shared_ptr<Component>> deserialized_pool = {};
     std::vector<std::shared_ptr<Entity>> deserialized_entities_pool = {};
     std::shared_ptr<Scene> m_scene;
@@ -56,9 +139,15 @@ private:
     std::unordered_map<std::string, std::string> m_replaced_guids_map = {};
 
     DeserializationMode m_deserialization_mode = DeserializationMode::Normal;
+    bool m_is_awake_deferred = false;
 
     // FIXME: Duplication of paths here and in Editor
     inline static std::string m_prefab_path = "./res/prefabs/";
 
     inline static std::shared_ptr<SceneSerializer> m_instance;
+
+    inline static bool m_binary_enabled = true;
+    inline static bool m_prefab_cache_enabled = true;
+    inline static bool m_parallel_parsing_enabled = true;
+    inline static bool m_incremental_save_enabled = true;
 };
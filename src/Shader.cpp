@@ -1,5 +1,10 @@
 #include "Shader.h"
 
+#include <algorithm>
+#include <array>
+
+#include "VirtualFileSystem.h"
+
 std::string Shader::get_vertex_path()
 {
     return m_vertex_path;
@@ -25,6 +30,17 @@ std::string Shader::get_tessellation_evaluation_path()
     return m_tessellation_evaluation_path;
 }
 
+bool Shader::depends_on(std::string const& path) const
+{
+    std::string const normalized_path = VirtualFileSystem::normalize_path(path);
+    std::array<std::string const*, 6> const stage_paths = {&m_compute_path, &m_vertex_path, &m_tessellation_control_path,
+                                                           &m_tessellation_evaluation_path, &m_fragment_path, &m_geometry_path};
+
+    return std::ranges::any_of(stage_paths, [&](std::string const* stage_path) {
+        return !stage_path->empty() && VirtualFileSystem::normalize_path(*stage_path) == normalized_path;
+    });
+}
+
 Shader::Shader(std::string const& compute_path) : m_compute_path(compute_path)
 {
 }
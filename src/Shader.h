@@ -26,6 +26,9 @@ public:
     void virtual set_mat4(std::string const& name, glm::mat4 const value) const = 0;
     void virtual load_shader() = 0;
 
+    // Whether the shader has to be loaded again when the file changes. Paths are compared after normalizing them.
+    [[nodiscard]] bool virtual depends_on(std::string const& path) const;
+
     std::string get_vertex_path();
     std::string get_fragment_path();
     std::string get_geometry_path();
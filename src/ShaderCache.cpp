@@ -0,0 +1,540 @@
+#include "ShaderCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include "AK/AK.h"
+#include "AK/MappedFile.h"
+#include "AK/ThreadPool.h"
+
+namespace
+{
+
+std::string normalize_path(std::string const& path)
+{
+    std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+
+    while (normalized.size() > 1 && normalized.back() == '/')
+        normalized.pop_back();
+
+    return normalized;
+}
+
+// Paths of every #include "file" and #include <file> directive, in the order they appear
+std::vector<std::string_view> find_includes(std::string_view const text)
+{
+    std::vector<std::string_view> includes = {};
+    size_t line_start = 0;
+
+    while (line_start < text.size())
+    {
+        size_t line_end = text.find('\n', line_start);
+
+        if (line_end == std::string_view::npos)
+            line_end = text.size();
+
+        std::string_view line = text.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        auto const skip_whitespace = [&] {
+            size_t const first = line.find_first_not_of(" \t");
+            line = first != std::string_view::npos ? line.substr(first) : std::string_view {};
+        };
+
+        skip_whitespace();
+
+        if (!line.starts_with('#'))
+            continue;
+
+        line.remove_prefix(1);
+        skip_whitespace();
+
+        if (!line.starts_with("include"))
+            continue;
+
+        line.remove_prefix(7);
+        skip_whitespace();
+
+        if (line.empty() || (line.front() != '"' && line.front() != '<'))
+            continue;
+
+        char const closing = line.front() == '"' ? '"' : '>';
+
+        if (size_t const end = line.find(closing, 1); end != std::string_view::npos)
+            includes.emplace_back(line.substr(1, end - 1));
+    }
+
+    return includes;
+}
+
+bool is_unchanged(ShaderDependency const& dependency)
+{
+    std::error_code error;
+    auto const write_time = std::filesystem::last_write_time(dependency.path, error);
+
+    // A file that didn't exist is still unchanged if it doesn't exist now
+    if (error)
+        return dependency.hash == 0;
+
+    u64 const size = std::filesystem::file_size(dependency.path, error);
+    return !error && dependency.hash != 0 && write_time.time_since_epoch().count() == dependency.write_time && size == dependency.size;
+}
+
+// Reads every value with bounds checks, a corrupted manifest is discarded as a whole
+class ManifestReader
+{
+public:
+    explicit ManifestReader(std::span<u8 const> const data) : m_data(data)
+    {
+    }
+
+    template<typename T>
+    bool read(T& value)
+    {
+        if (sizeof(T) > m_data.size() - m_position)
+            return false;
+
+        std::memcpy(&value, m_data.data() + m_position, sizeof(T));
+        m_position += sizeof(T);
+        return true;
+    }
+
+    bool read(std::string& value)
+    {
+        u32 length = 0;
+
+        if (!read(length) || length > m_data.size() - m_position)
+            return false;
+
+        value.assign(reinterpret_cast<char const*>(m_data.data() + m_position), length);
+        m_position += length;
+        return true;
+    }
+
+private:
+    std::span<u8 const> m_data = {};
+    size_t m_position = 0;
+};
+
+template<typename T>
+void write(std::string& data, T const& value)
+{
+    data.append(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+void write(std::string& data, std::string const& value)
+{
+    write(data, static_cast<u32>(value.size()));
+    data.append(value);
+}
+
+}
+
+ShaderCache::ShaderCache(std::string const& directory, ShaderCompiler compiler)
+    : m_directory(normalize_path(directory)), m_compiler(std::move(compiler))
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    load_manifest();
+}
+
+std::vector<u8> ShaderCache::get_bytecode(ShaderVariant const& variant)
+{
+    std::vector<u8> bytecode = {};
+
+    if (!update(variant, &bytecode))
+        return {};
+
+    return bytecode;
+}
+
+void ShaderCache::compile(std::vector<ShaderVariant> const& variants, u32 const thread_count)
+{
+    // Shaders often use the same file for several stages, but every variant is only brought up to date once
+    std::unordered_set<u64> keys = {};
+    AK::ThreadPool thread_pool(thread_count);
+
+    for (auto const& variant : variants)
+    {
+        if (keys.emplace(hash_variant(variant)).second)
+            thread_pool.enqueue([this, &variant] { static_cast<void>(update(variant, nullptr)); });
+    }
+
+    thread_pool.wait_idle();
+    save_manifest();
+}
+
+u32 ShaderCache::prune()
+{
+    u32 removed_count = 0;
+
+    {
+        std::lock_guard lock(m_mutex);
+        std::error_code error;
+
+        removed_count += static_cast<u32>(std::erase_if(m_entries, [&](auto const& item) {
+            return !std::filesystem::is_regular_file(item.second.variant.path, error);
+        }));
+
+        m_is_dirty = m_is_dirty || removed_count > 0;
+
+        std::unordered_set<std::string> referenced_paths = {get_manifest_path()};
+
+        for (auto const& [key, entry] : m_entries)
+            referenced_paths.emplace(get_compiled_path(entry.content_hash));
+
+        // Compiled files of variants that changed, and files written before the manifest existed
+        for (auto const& file : std::filesystem::directory_iterator(m_directory, error))
+        {
+            std::string const path = normalize_path(file.path().string());
+
+            if (file.is_regular_file(error) && !referenced_paths.contains(path) && std::filesystem::remove(path, error))
+                ++removed_count;
+        }
+    }
+
+    save_manifest();
+    return removed_count;
+}
+
+bool ShaderCache::save_manifest()
+{
+    std::lock_guard lock(m_mutex);
+
+    if (!m_is_dirty)
+        return true;
+
+    ShaderManifestHeader header = {};
+    header.entry_count = static_cast<u32>(m_entries.size());
+
+    std::string data = {};
+    write(data, header);
+
+    for (auto const& [key, entry] : m_entries)
+    {
+        write(data, entry.content_hash);
+        write(data, entry.variant.path);
+        write(data, entry.variant.entry_point);
+        write(data, entry.variant.target);
+        write(data, static_cast<u32>(entry.variant.defines.size()));
+
+        for (auto const& [name, value] : entry.variant.defines)
+        {
+            write(data, name);
+            write(data, value);
+        }
+
+        write(data, static_cast<u32>(entry.dependencies.size()));
+
+        for (auto const& dependency : entry.dependencies)
+        {
+            write(data, dependency.path);
+            write(data, dependency.write_time);
+            write(data, dependency.size);
+            write(data, dependency.hash);
+        }
+    }
+
+    std::string const manifest_path = get_manifest_path();
+    std::string const temporary_path = manifest_path + ".tmp";
+
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+        if (!file.good())
+        {
+            std::cout << "Error. Could not write a shader cache manifest: " << temporary_path << "\n";
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, manifest_path, error);
+
+    if (error)
+    {
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    m_is_dirty = false;
+    return true;
+}
+
+std::vector<ShaderVariant> ShaderCache::get_variants()
+{
+    std::lock_guard lock(m_mutex);
+    std::vector<ShaderVariant> variants = {};
+    variants.reserve(m_entries.size());
+
+    for (auto const& [key, entry] : m_entries)
+        variants.emplace_back(entry.variant);
+
+    return variants;
+}
+
+std::vector<ShaderDependency> ShaderCache::get_dependencies(ShaderVariant const& variant)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (auto const it = m_entries.find(hash_variant(variant)); it != m_entries.end())
+        return it->second.dependencies;
+
+    return {};
+}
+
+ShaderCacheStats ShaderCache::get_stats() const
+{
+    return {m_hit_count, m_compiled_count, m_failed_count, m_hashed_file_count};
+}
+
+void ShaderCache::reset_stats()
+{
+    m_hit_count = 0;
+    m_compiled_count = 0;
+    m_failed_count = 0;
+    m_hashed_file_count = 0;
+}
+
+u64 ShaderCache::hash_variant(ShaderVariant const& variant)
+{
+    u64 hash = AK::fnv1a_hash64(normalize_path(variant.path));
+    hash = AK::hash_combine(hash, AK::fnv1a_hash64(variant.entry_point));
+    hash = AK::hash_combine(hash, AK::fnv1a_hash64(variant.target));
+
+    for (auto const& [name, value] : variant.defines)
+    {
+        hash = AK::hash_combine(hash, AK::fnv1a_hash64(name));
+        hash = AK::hash_combine(hash, AK::fnv1a_hash64(value));
+    }
+
+    return hash;
+}
+
+bool ShaderCache::update(ShaderVariant const& variant, std::vector<u8>* bytecode)
+{
+    u64 const key = hash_variant(variant);
+    std::optional<Entry> cached_entry = {};
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (auto const it = m_entries.find(key); it != m_entries.end())
+            cached_entry = it->second;
+    }
+
+    auto const read_compiled = [&](u64 const content_hash) {
+        std::string const compiled_path = get_compiled_path(content_hash);
+        std::error_code error;
+
+        if (bytecode == nullptr)
+            return std::filesystem::is_regular_file(compiled_path, error);
+
+        AK::MappedFile file = {};
+
+        if (!file.open(compiled_path) || file.get_size() == 0)
+            return false;
+
+        bytecode->assign(file.get_bytes().begin(), file.get_bytes().end());
+        return true;
+    };
+
+    // Nothing is read when no file changed since the last time
+    if (cached_entry.has_value() && std::ranges::all_of(cached_entry->dependencies, is_unchanged)
+        && read_compiled(cached_entry->content_hash))
+    {
+        ++m_hit_count;
+        return true;
+    }
+
+    Entry entry = {};
+    entry.variant = variant;
+    entry.variant.path = normalize_path(variant.path);
+    scan_dependencies(entry.variant.path, entry.dependencies);
+
+    // Paths of the source and the includes are part of the hash, since __FILE__ and errors refer to them.
+    // So compiled files are only shared by variants of the same files, ex. after a file changed back.
+    entry.content_hash = AK::hash_combine(AK::fnv1a_hash64(variant.entry_point), AK::fnv1a_hash64(variant.target));
+
+    for (auto const& [name, value] : variant.defines)
+    {
+        entry.content_hash = AK::hash_combine(entry.content_hash, AK::fnv1a_hash64(name));
+        entry.content_hash = AK::hash_combine(entry.content_hash, AK::fnv1a_hash64(value));
+    }
+
+    for (auto const& dependency : entry.dependencies)
+    {
+        entry.content_hash = AK::hash_combine(entry.content_hash, AK::fnv1a_hash64(dependency.path));
+        entry.content_hash = AK::hash_combine(entry.content_hash, dependency.hash);
+    }
+
+    // Files were only touched, or changed back to content that was compiled before
+    if (read_compiled(entry.content_hash))
+    {
+        ++m_hit_count;
+    }
+    else
+    {
+        std::vector<u8> compiled = {};
+        std::string errors = {};
+
+        if (entry.dependencies.front().hash == 0 || !m_compiler(entry.variant, compiled, errors) || compiled.empty())
+        {
+            ++m_failed_count;
+            std::cout << "Error. Could not compile " << entry.variant.entry_point << " of shader " << entry.variant.path << ".\n"
+                      << errors << "\n";
+            return false;
+        }
+
+        // Two threads can compile variants with the same content at once
+        std::string const compiled_path = get_compiled_path(entry.content_hash);
+        std::string const temporary_path =
+            std::format("{}.{}.tmp", compiled_path, std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+        {
+            std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<char const*>(compiled.data()), static_cast<std::streamsize>(compiled.size()));
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary_path, compiled_path, error);
+
+        if (error)
+            std::filesystem::remove(temporary_path, error);
+
+        ++m_compiled_count;
+
+        if (bytecode != nullptr)
+            *bytecode = std::move(compiled);
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_entries.insert_or_assign(key, std::move(entry));
+    m_is_dirty = true;
+    return true;
+}
+
+void ShaderCache::scan_dependencies(std::string const& path, std::vector<ShaderDependency>& dependencies)
+{
+    if (std::ranges::any_of(dependencies, [&](ShaderDependency const& dependency) { return dependency.path == path; }))
+        return;
+
+    ShaderDependency dependency = {};
+    dependency.path = path;
+
+    // Written before the file is read, so a file changed while it's read is seen as changed the next time
+    std::error_code error;
+    auto const write_time = std::filesystem::last_write_time(path, error);
+    AK::MappedFile file = {};
+
+    if (error || !file.open(path))
+    {
+        dependencies.emplace_back(std::move(dependency));
+        return;
+    }
+
+    ++m_hashed_file_count;
+
+    std::span<u8 const> const bytes = file.get_bytes();
+    u64 const hash = AK::murmur_hash64(bytes.data(), bytes.size(), 0);
+
+    dependency.write_time = write_time.time_since_epoch().count();
+    dependency.size = bytes.size();
+    dependency.hash = hash != 0 ? hash : 1;
+    dependencies.emplace_back(std::move(dependency));
+
+    // Included files are looked for next to the file including them, like D3D_COMPILE_STANDARD_FILE_INCLUDE does
+    std::filesystem::path const directory = std::filesystem::path(path).parent_path();
+
+    for (auto const& include : find_includes(file.get_text()))
+        scan_dependencies(normalize_path((directory / include).string()), dependencies);
+}
+
+std::string ShaderCache::get_compiled_path(u64 const content_hash) const
+{
+    return std::format("{}/{:016x}.cso", m_directory, content_hash);
+}
+
+std::string ShaderCache::get_manifest_path() const
+{
+    return m_directory + "/manifest.bin";
+}
+
+void ShaderCache::load_manifest()
+{
+    AK::MappedFile file = {};
+
+    if (!file.open(get_manifest_path()))
+        return;
+
+    ManifestReader reader(file.get_bytes());
+    ShaderManifestHeader header = {};
+
+    if (!reader.read(header) || std::memcmp(header.magic, ShaderManifestHeader {}.magic, sizeof(header.magic)) != 0
+        || header.version != shader_manifest_version)
+    {
+        return;
+    }
+
+    std::unordered_map<u64, Entry> entries = {};
+
+    for (u32 i = 0; i < header.entry_count; ++i)
+    {
+        Entry entry = {};
+        u32 define_count = 0;
+        u32 dependency_count = 0;
+
+        if (!reader.read(entry.content_hash) || !reader.read(entry.variant.path) || !reader.read(entry.variant.entry_point)
+            || !reader.read(entry.variant.target) || !reader.read(define_count))
+        {
+            std::cout << "Error. Shader cache manifest is corrupted: " << get_manifest_path() << "\n";
+            return;
+        }
+
+        for (u32 j = 0; j < define_count; ++j)
+        {
+            auto& [name, value] = entry.variant.defines.emplace_back();
+
+            if (!reader.read(name) || !reader.read(value))
+            {
+                std::cout << "Error. Shader cache manifest is corrupted: " << get_manifest_path() << "\n";
+                return;
+            }
+        }
+
+        if (!reader.read(dependency_count))
+        {
+            std::cout << "Error. Shader cache manifest is corrupted: " << get_manifest_path() << "\n";
+            return;
+        }
+
+        for (u32 j = 0; j < dependency_count; ++j)
+        {
+            auto& dependency = entry.dependencies.emplace_back();
+
+            if (!reader.read(dependency.path) || !reader.read(dependency.write_time) || !reader.read(dependency.size)
+                || !reader.read(dependency.hash))
+            {
+                std::cout << "Error. Shader cache manifest is corrupted: " << get_manifest_path() << "\n";
+                return;
+            }
+        }
+
+        u64 const key = hash_variant(entry.variant);
+        entries.insert_or_assign(key, std::move(entry));
+    }
+
+    m_entries = std::move(entries);
+}
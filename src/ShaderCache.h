@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AK/Types.h"
+
+// Shader compiled from a single entry point of a source file, for a single target, with a single set of macros.
+struct ShaderVariant
+{
+    std::string path = {};
+    std::string entry_point = {};
+    std::string target = {};
+
+    // Name and value of every macro, in the order they are defined
+    std::vector<std::pair<std::string, std::string>> defines = {};
+};
+
+// Compiles a variant to bytecode, or fills errors. Called from worker threads, so it has to be thread-safe.
+using ShaderCompiler = std::function<bool(ShaderVariant const& variant, std::vector<u8>& bytecode, std::string& errors)>;
+
+// Source file or an included file a variant depends on. Files that don't exist have a hash of 0.
+struct ShaderDependency
+{
+    std::string path = {};
+    i64 write_time = 0;
+    u64 size = 0;
+    u64 hash = 0;
+};
+
+struct ShaderCacheStats
+{
+    u32 hit_count = 0;
+    u32 compiled_count = 0;
+    u32 failed_count = 0;
+
+    // Source and included files read to check whether their content changed
+    u32 hashed_file_count = 0;
+};
+
+// Persistent cache of compiled shaders, independent of the graphics API.
+// Compiled files are named after the hash of everything that goes into them: the path and content of the source and of every
+// file it includes, the entry point, the target and the macros. So a file changed back to what it was reuses its compiled file.
+// The manifest remembers every variant with the files it depends on, their write times, sizes and hashes.
+// Variants whose files have the same write times and sizes are used without reading any of them. Only when a file changed
+// its content is hashed again and its includes are followed, and the variant is compiled only if a hash differs.
+// Includes are found by looking for #include directives, including the ones in inactive #if blocks, so none is missed.
+// The directory belongs to the cache, files in it that aren't referenced by the manifest are removed when pruning.
+// Layout of the manifest, strings are a u32 length followed by the characters:
+//   ShaderManifestHeader
+//   Entries - for every variant: u64 content hash, path, entry point and target strings, u32 macro count,
+//             name and value strings of every macro, u32 dependency count, and for every dependency:
+//             path string, i64 write time, u64 size and u64 hash
+// Bump the version whenever the manifest is written differently, every variant is checked and hashed again then.
+
+u32 constexpr shader_manifest_version = 1;
+
+struct ShaderManifestHeader
+{
+    char magic[4] = {'E', 'S', 'H', 'M'};
+    u32 version = shader_manifest_version;
+    u32 entry_count = 0;
+    u32 padding = 0;
+};
+
+static_assert(sizeof(ShaderManifestHeader) == 16);
+
+class ShaderCache
+{
+public:
+    ShaderCache(std::string const& directory, ShaderCompiler compiler);
+
+    ShaderCache(ShaderCache const&) = delete;
+    ShaderCache& operator=(ShaderCache const&) = delete;
+
+    // Bytecode of the variant, compiled first if it isn't cached or is out of date. Empty if it can't be compiled.
+    [[nodiscard]] std::vector<u8> get_bytecode(ShaderVariant const& variant);
+
+    // Brings every variant up to date at once, compiling the ones that aren't cached or are out of date on worker threads.
+    // With 0 threads, one thread is used for every hardware thread except the main one.
+    void compile(std::vector<ShaderVariant> const& variants, u32 const thread_count = 0);
+
+    // Forgets variants whose source file no longer exists, removes every file of the directory the manifest doesn't
+    // reference and saves the manifest. Returns how many variants and files were removed.
+    u32 prune();
+
+    // Does nothing if the manifest didn't change since it was loaded or saved.
+    bool save_manifest();
+
+    // Every variant in the manifest, to bring up to date the ones used before, before they are needed.
+    [[nodiscard]] std::vector<ShaderVariant> get_variants();
+
+    // Files the variant depended on when it was last brought up to date, the source file first.
+    [[nodiscard]] std::vector<ShaderDependency> get_dependencies(ShaderVariant const& variant);
+
+    [[nodiscard]] ShaderCacheStats get_stats() const;
+    void reset_stats();
+
+    [[nodiscard]] static u64 hash_variant(ShaderVariant const& variant);
+
+private:
+    struct Entry
+    {
+        ShaderVariant variant = {};
+        u64 content_hash = 0;
+        std::vector<ShaderDependency> dependencies = {};
+    };
+
+    // Brings the variant up to date, filling bytecode if it's not nullptr. Safe to call from multiple threads.
+    bool update(ShaderVariant const& variant, std::vector<u8>* bytecode);
+
+    // Reads the file and every file it includes, recursively, each one once.
+    void scan_dependencies(std::string const& path, std::vector<ShaderDependency>& dependencies);
+
+    [[nodiscard]] std::string get_compiled_path(u64 const content_hash) const;
+    [[nodiscard]] std::string get_manifest_path() const;
+
+    void load_manifest();
+
+    std::string m_directory = {};
+    ShaderCompiler m_compiler = {};
+
+    std::mutex m_mutex = {};
+    std::unordered_map<u64, Entry> m_entries = {};
+    bool m_is_dirty = false;
+
+    std::atomic<u32> m_hit_count = 0;
+    std::atomic<u32> m_compiled_count = 0;
+    std::atomic<u32> m_failed_count = 0;
+    std::atomic<u32> m_hashed_file_count = 0;
+};
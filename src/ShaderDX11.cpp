@@ -1,8 +1,8 @@
 #include "ShaderDX11.h"
 
-#include "AK/AK.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
+#include "VirtualFileSystem.h"
 
 #include <d3dcommon.h>
 #include <d3dcompiler.h>
@@ -10,13 +10,59 @@
 
 #include <array>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <memory>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.inl>
 
+namespace
+{
+
+// Thread-safe, shaders are compiled from worker threads
+bool compile_with_d3d(ShaderVariant const& variant, std::vector<u8>& bytecode, std::string& errors)
+{
+    std::vector<D3D_SHADER_MACRO> macros = {};
+    macros.reserve(variant.defines.size() + 1);
+
+    for (auto const& [name, value] : variant.defines)
+        macros.emplace_back(D3D_SHADER_MACRO {name.c_str(), value.c_str()});
+
+    macros.emplace_back(D3D_SHADER_MACRO {nullptr, nullptr});
+
+    std::wstring const path = std::filesystem::path(variant.path).wstring();
+    ID3DBlob* bytecode_blob = nullptr;
+    ID3DBlob* errors_blob = nullptr;
+
+    HRESULT const hr = D3DCompileFromFile(path.c_str(), macros.data(), D3D_COMPILE_STANDARD_FILE_INCLUDE, variant.entry_point.c_str(),
+                                          variant.target.c_str(), 0, 0, &bytecode_blob, &errors_blob);
+
+    if (errors_blob != nullptr)
+    {
+        errors.assign(static_cast<char const*>(errors_blob->GetBufferPointer()), errors_blob->GetBufferSize());
+        errors_blob->Release();
+    }
+
+    if (FAILED(hr))
+    {
+        if (hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+            errors = "Shader file not found.";
+
+        if (bytecode_blob != nullptr)
+            bytecode_blob->Release();
+
+        return false;
+    }
+
+    auto const data = static_cast<u8 const*>(bytecode_blob->GetBufferPointer());
+    bytecode.assign(data, data + bytecode_blob->GetBufferSize());
+    bytecode_blob->Release();
+    return true;
+}
+
+}
+
 ShaderDX11::ShaderDX11(AK::Badge<ShaderFactory>, std::string const& compute_path) : Shader(compute_path)
 {
 }
@@ -41,146 +87,102 @@ ShaderDX11::ShaderDX11(AK::Badge<ShaderFactory>, std::string const& vertex_path,
 
 void ShaderDX11::load_shader()
 {
-    HRESULT hr;
-    // Load vertex shader
-    ID3DBlob* vs_blob;
-    {
-        ID3DBlob* shader_compile_errors_blob;
-
-        std::wstring const vertex_path_final = std::wstring(m_vertex_path.begin(), m_vertex_path.end());
-        size_t size = 0;
-        char const* shader_source = read_hlsl_shader_from_file(m_vertex_path, &size);
-        hr = D3DPreprocess(shader_source, size, m_vertex_path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, &vs_blob,
-                           &shader_compile_errors_blob);
-
-        delete[] shader_source;
-
-        if (FAILED(hr))
-        {
-            char const* error_string = nullptr;
-            if (hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
-            {
-                error_string = "Error. Vertex shader file not found.";
-            }
-            else if (shader_compile_errors_blob)
-            {
-                error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                shader_compile_errors_blob->Release();
-            }
+    ShaderCache& cache = get_shader_cache();
+    std::vector<u8> const vertex_bytecode = cache.get_bytecode(get_vertex_variant());
+    std::vector<u8> const pixel_bytecode = cache.get_bytecode(get_pixel_variant());
+    cache.save_manifest();
 
-            std::cout << error_string << "\n";
-            return;
-        }
+    // Keeps the shader that was loaded before if it doesn't compile anymore
+    if (vertex_bytecode.empty() || pixel_bytecode.empty())
+        return;
 
-        std::string const hash =
-            std::to_string(AK::murmur_hash(static_cast<u8*>(vs_blob->GetBufferPointer()), vs_blob->GetBufferSize(), 0));
+    release();
 
-        if (!read_file_to_blob(m_vertex_path + hash + "vs_main", &vs_blob))
-        {
-            hr = D3DCompile(vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), nullptr, nullptr, nullptr, "vs_main", "vs_5_0", 0, 0,
-                            &vs_blob, &shader_compile_errors_blob);
+    auto const device = RendererDX11::get_instance_dx11()->get_device();
+    HRESULT hr = device->CreateVertexShader(vertex_bytecode.data(), vertex_bytecode.size(), nullptr, &m_vertex_shader);
 
-            if (FAILED(hr))
-            {
-                auto const error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                std::cout << error_string << "\n";
-                return;
-            }
+    if (FAILED(hr))
+    {
+        std::cout << "Error. Vertex shader creation failed."
+                  << "\n";
+        return;
+    }
 
-            save_compiled_shader(m_vertex_path + hash + "vs_main", vs_blob);
-        }
+    hr = device->CreatePixelShader(pixel_bytecode.data(), pixel_bytecode.size(), nullptr, &m_pixel_shader);
 
-        hr = RendererDX11::get_instance_dx11()->get_device()->CreateVertexShader(vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(),
-                                                                                 nullptr, &m_vertex_shader);
-        if (FAILED(hr))
-        {
-            std::cout << "Error. Vertex shader creation failed."
-                      << "\n";
-            vs_blob->Release();
-            return;
-        }
+    if (FAILED(hr))
+    {
+        std::cout << "Error. Fragment shader creation failed."
+                  << "\n";
+        return;
     }
 
-    // Load pixel shader
-    ID3DBlob* ps_blob;
     {
-        ID3DBlob* shader_compile_errors_blob;
-
-        auto const pixel_path_final = std::wstring(m_fragment_path.begin(), m_fragment_path.end());
-        size_t size = 0;
-        auto const shader_source = read_hlsl_shader_from_file(m_fragment_path, &size);
-        hr = D3DPreprocess(shader_source, size, m_fragment_path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, &ps_blob,
-                           &shader_compile_errors_blob);
-
-        delete[] shader_source;
-
-        if (FAILED(hr))
+        // Compact vertices are decoded by the input assembler, so shaders see the same attributes for every format.
+        // Normals are snorm8 with an unused fourth component, texture coordinates are halves or unorm16 depending on their range.
+        for (u32 i = 0; i < m_input_layouts.size(); ++i)
         {
-            char const* error_string = nullptr;
+            auto const format = static_cast<VertexFormat>(i);
+
+            DXGI_FORMAT normal_format = DXGI_FORMAT_R32G32B32_FLOAT;
+            DXGI_FORMAT texture_coordinates_format = DXGI_FORMAT_R32G32_FLOAT;
 
-            if (hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+            if (format == VertexFormat::CompactHalfUV)
             {
-                error_string = "Error. Fragment shader file not found.";
+                normal_format = DXGI_FORMAT_R8G8B8A8_SNORM;
+                texture_coordinates_format = DXGI_FORMAT_R16G16_FLOAT;
             }
-            else if (shader_compile_errors_blob)
+            else if (format == VertexFormat::CompactUnitUV)
             {
-                error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                shader_compile_errors_blob->Release();
+                normal_format = DXGI_FORMAT_R8G8B8A8_SNORM;
+                texture_coordinates_format = DXGI_FORMAT_R16G16_UNORM;
             }
 
-            std::cout << error_string << "\n";
-            return;
-        }
-
-        std::string const hash =
-            std::to_string(AK::murmur_hash(static_cast<u8*>(ps_blob->GetBufferPointer()), ps_blob->GetBufferSize(), 0));
-
-        if (!read_file_to_blob(m_fragment_path + hash + "ps_main", &ps_blob))
-        {
-            hr = D3DCompile(ps_blob->GetBufferPointer(), ps_blob->GetBufferSize(), nullptr, nullptr, nullptr, "ps_main", "ps_5_0", 0, 0,
-                            &ps_blob, &shader_compile_errors_blob);
-
-            if (FAILED(hr))
-            {
-                auto const error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                std::cout << error_string << "\n";
-                return;
-            }
+            std::array<D3D11_INPUT_ELEMENT_DESC, 3> const input_element_desc = {
+                {{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+                 {"NORMAL", 0, normal_format, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+                 {"TEXCOORD", 0, texture_coordinates_format, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
 
-            save_compiled_shader(m_vertex_path + hash + "ps_main", ps_blob);
+            hr = device->CreateInputLayout(input_element_desc.data(), input_element_desc.size(), vertex_bytecode.data(),
+                                           vertex_bytecode.size(), &m_input_layouts[i]);
+            assert(SUCCEEDED(hr));
         }
+    }
+}
 
-        hr = RendererDX11::get_instance_dx11()->get_device()->CreatePixelShader(ps_blob->GetBufferPointer(), ps_blob->GetBufferSize(),
-                                                                                nullptr, &m_pixel_shader);
+bool ShaderDX11::depends_on(std::string const& path) const
+{
+    if (Shader::depends_on(path))
+        return true;
 
-        if (FAILED(hr))
+    std::string const normalized_path = VirtualFileSystem::normalize_path(path);
+    ShaderCache& cache = get_shader_cache();
+
+    for (auto const& variant : {get_vertex_variant(), get_pixel_variant()})
+    {
+        for (auto const& dependency : cache.get_dependencies(variant))
         {
-            std::cout << "Error. Fragment shader creation failed."
-                      << "\n";
-            ps_blob->Release();
-            return;
+            if (VirtualFileSystem::normalize_path(dependency.path) == normalized_path)
+                return true;
         }
     }
 
-    {
-        std::array<D3D11_INPUT_ELEMENT_DESC, 3> constexpr input_element_desc = {
-            {{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
-
-        HRESULT const hr = RendererDX11::get_instance_dx11()->get_device()->CreateInputLayout(
-            input_element_desc.data(), input_element_desc.size(), vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), &m_input_layout);
-        assert(SUCCEEDED(hr));
-        vs_blob->Release();
-    }
+    return false;
 }
 
 void ShaderDX11::use() const
 {
     auto const instance = RendererDX11::get_instance_dx11();
-    instance->get_device_context()->IASetInputLayout(m_input_layout);
+    instance->get_device_context()->IASetInputLayout(m_input_layouts[static_cast<size_t>(VertexFormat::Full)]);
     instance->get_device_context()->VSSetShader(m_vertex_shader, nullptr, 0);
     instance->get_device_context()->PSSetShader(m_pixel_shader, nullptr, 0);
+
+    m_bound_shader = this;
+}
+
+ID3D11InputLayout* ShaderDX11::get_input_layout(VertexFormat const format) const
+{
+    return m_input_layouts[static_cast<size_t>(format)];
 }
 
 void ShaderDX11::set_bool(std::string const& name, bool const value) const
@@ -212,116 +214,80 @@ i32 ShaderDX11::attach(char const* path, i32 type) const
     return 0;
 }
 
-char* ShaderDX11::read_hlsl_shader_from_file(std::string const& path, size_t* p_size)
+void ShaderDX11::compile_shaders(std::vector<std::shared_ptr<Shader>> const& shaders)
 {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<ShaderVariant> variants = {};
+    variants.reserve(shaders.size() * 2);
 
-    if (!file.is_open())
+    for (auto const& shader : shaders)
     {
-        *p_size = 0;
-        return nullptr;
-    }
-
-    std::streamsize const file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
+        auto const shader_dx11 = std::dynamic_pointer_cast<ShaderDX11>(shader);
 
-    auto const buffer = new char[file_size + 1];
-
-    if (file.read(buffer, file_size))
-    {
-        buffer[file_size] = '\0'; // Null-terminate the string
-        *p_size = static_cast<size_t>(file_size);
-        return buffer;
+        // Only shaders with vertex and pixel stages are loaded
+        if (shader_dx11 != nullptr && !shader_dx11->m_fragment_path.empty())
+        {
+            variants.emplace_back(shader_dx11->get_vertex_variant());
+            variants.emplace_back(shader_dx11->get_pixel_variant());
+        }
     }
 
-    delete[] buffer;
-    *p_size = 0;
-    return nullptr;
+    get_shader_cache().compile(variants);
 }
 
-bool ShaderDX11::save_compiled_shader(std::string const& path, ID3DBlob* p_blob)
+void ShaderDX11::prune_shader_cache()
 {
-    size_t const last_slash_pos = path.find_last_of('/');
-    std::string const filename = path.substr(last_slash_pos + 1);
-    std::string const full_path = m_compiled_path + filename;
-
-    std::filesystem::path const directory = m_compiled_path;
-
-    if (!std::filesystem::exists(directory))
-    {
-        std::filesystem::create_directories(directory);
-    }
-
-    if (!p_blob)
-    {
-        std::cerr << "Invalid ID3DBlob pointer." << std::endl;
-        return false;
-    }
-
-    std::ofstream file(full_path, std::ios::binary);
-
-    if (!file.is_open())
-    {
-        std::cerr << "Failed to open file: " << full_path << std::endl;
-        return false;
-    }
-
-    file.write(static_cast<char const*>(p_blob->GetBufferPointer()), p_blob->GetBufferSize());
-
-    if (!file)
-    {
-        std::cerr << "Failed to write to file: " << full_path << std::endl;
-        return false;
-    }
-
-    file.close();
+    get_shader_cache().prune();
+}
 
-    return true;
+void ShaderDX11::warm_up_shader_cache()
+{
+    // Creating the cache compiles them
+    static_cast<void>(get_shader_cache());
 }
 
-bool ShaderDX11::read_file_to_blob(std::string const& path, ID3DBlob** pp_blob)
+ShaderVariant ShaderDX11::get_vertex_variant() const
 {
-    size_t const last_slash_pos = path.find_last_of('/');
-    std::string const filename = path.substr(last_slash_pos + 1);
-    std::string const full_path = m_compiled_path + filename;
+    return {m_vertex_path, "vs_main", "vs_5_0"};
+}
 
-    std::filesystem::path const directory = m_compiled_path;
+ShaderVariant ShaderDX11::get_pixel_variant() const
+{
+    return {m_fragment_path, "ps_main", "ps_5_0"};
+}
 
-    if (!std::filesystem::exists(directory))
+void ShaderDX11::release()
+{
+    for (auto& input_layout : m_input_layouts)
     {
-        std::filesystem::create_directories(directory);
+        if (input_layout != nullptr)
+        {
+            input_layout->Release();
+            input_layout = nullptr;
+        }
     }
 
-    if (!pp_blob)
+    if (m_vertex_shader != nullptr)
     {
-        return false;
+        m_vertex_shader->Release();
+        m_vertex_shader = nullptr;
     }
 
-    std::ifstream file(full_path, std::ios::binary | std::ios::ate);
-
-    if (!file.is_open())
+    if (m_pixel_shader != nullptr)
     {
-        return false;
+        m_pixel_shader->Release();
+        m_pixel_shader = nullptr;
     }
+}
 
-    std::streamsize const file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    HRESULT const hr = D3DCreateBlob(file_size, pp_blob);
-
-    if (FAILED(hr))
-    {
-        std::cerr << "Failed to create blob." << std::endl;
-        return false;
-    }
+ShaderCache& ShaderDX11::get_shader_cache()
+{
+    static std::unique_ptr<ShaderCache> const cache = [] {
+        auto cache = std::make_unique<ShaderCache>(m_compiled_path, compile_with_d3d);
 
-    if (!file.read(static_cast<char*>((*pp_blob)->GetBufferPointer()), file_size))
-    {
-        std::cerr << "Failed to read file: " << full_path << std::endl;
-        (*pp_blob)->Release();
-        *pp_blob = nullptr;
-        return false;
-    }
+        // Shaders used by the previous run are brought up to date at once, before the first one is loaded
+        cache->compile(cache->get_variants());
+        return cache;
+    }();
 
-    return true;
+    return *cache;
 }
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <array>
 #include <d3d11.h>
+#include <memory>
+#include <vector>
 
 #include "AK/Badge.h"
 #include "Shader.h"
+#include "ShaderCache.h"
+#include "Vertex.h"
 
 class ShaderFactory;
 
@@ -26,18 +31,44 @@ public:
     void virtual set_mat4(std::string const& name, glm::mat4 const value) const override;
     void virtual load_shader() override;
 
+    // Also depends on every file its stages include, directly or not, as the shader cache found them when it was last loaded.
+    [[nodiscard]] bool virtual depends_on(std::string const& path) const override;
+
+    [[nodiscard]] ID3D11InputLayout* get_input_layout(VertexFormat const format) const;
+
+    // Compiles the shaders that aren't cached or are out of date on worker threads, so loading them afterwards only reads bytecode.
+    static void compile_shaders(std::vector<std::shared_ptr<Shader>> const& shaders);
+
+    // Removes compiled shaders that are no longer used by any variant in the cache manifest.
+    static void prune_shader_cache();
+
+    // Compiles the shaders used by the previous run. Can be called from any thread before the first shader is loaded,
+    // loading shaders meanwhile waits for it.
+    static void warm_up_shader_cache();
+
+    // Shader that was used last. Meshes with compact vertices switch to its input layout for their format while drawing.
+    [[nodiscard]] static ShaderDX11 const* get_bound_shader()
+    {
+        return m_bound_shader;
+    }
+
 private:
     i32 virtual attach(char const* path, i32 type) const override;
 
-    static char* read_hlsl_shader_from_file(std::string const& path, size_t* p_size);
-    static bool save_compiled_shader(std::string const& path, ID3DBlob* blob);
-    static bool read_file_to_blob(std::string const& path, ID3DBlob** pp_blob);
+    [[nodiscard]] ShaderVariant get_vertex_variant() const;
+    [[nodiscard]] ShaderVariant get_pixel_variant() const;
+
+    void release();
 
-    ID3D11InputLayout* m_input_layout = nullptr;
+    [[nodiscard]] static ShaderCache& get_shader_cache();
+
+    std::array<ID3D11InputLayout*, static_cast<size_t>(VertexFormat::Count)> m_input_layouts = {};
     ID3D11VertexShader* m_vertex_shader = nullptr;
     ID3D11PixelShader* m_pixel_shader = nullptr;
 
     // NOTE: Do not use constexpr here! The string will not live until runtime because of that.
     //       https://developercommunity.visualstudio.com/t/c20-constexpr-stdstring-with-static-is-not-working/1441363
     inline static std::string m_compiled_path = "./res/shaders/compiled/";
+
+    inline static ShaderDX11 const* m_bound_shader = nullptr;
 };
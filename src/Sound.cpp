@@ -2,6 +2,7 @@
 
 #include "Engine.h"
 #include "Entity.h"
+#include "EntityPool.h"
 
 #if EDITOR
 #include <imgui_stdlib.h>
@@ -44,34 +45,52 @@ std::shared_ptr<Sound> Sound::create(std::string const& path, glm::vec3 const di
     return sound;
 }
 
+// Temporary sounds are pooled per file, so that finished ones can be played again without decoding the file again
 std::shared_ptr<Sound> Sound::play_sound(std::string const& path, bool const loop)
 {
-    auto sound = create(path);
+    auto const e = EntityPool::get_instance().acquire("TemporarySound_" + path, [&path] {
+        auto const sound_entity = Entity::create("TemporarySound");
+        sound_entity->add_component<Sound>(create(path));
+        return sound_entity;
+    });
+
+    auto sound = e->get_component<Sound>();
     ma_sound_start(&sound->m_internal_sound);
     ma_sound_set_looping(&sound->m_internal_sound, loop);
 
-    auto const e = Entity::create("TemporarySound");
-    e->add_component<Sound>(sound);
-
     return sound;
 }
 
 std::shared_ptr<Sound> Sound::play_sound_at_location(std::string const& path, glm::vec3 const position, glm::vec3 const direction,
                                                      float const rolloff, ma_attenuation_model const attenuation, bool const loop)
 {
-    auto sound = create(path, direction, rolloff, attenuation);
+    auto const e = EntityPool::get_instance().acquire("TemporarySoundPositional_" + path, [&] {
+        auto const sound_entity = Entity::create("TemporarySound");
+        sound_entity->add_component<Sound>(create(path, direction, rolloff, attenuation));
+        return sound_entity;
+    });
+
+    auto sound = e->get_component<Sound>();
+
+    // Reused sound might have been created with different settings
+    ma_sound_set_attenuation_model(&sound->m_internal_sound, attenuation);
+    ma_sound_set_direction(&sound->m_internal_sound, direction.x, direction.y, direction.z);
+    ma_sound_set_rolloff(&sound->m_internal_sound, rolloff);
 
+    e->transform->set_local_position(position);
     ma_sound_set_position(&sound->m_internal_sound, position.x, position.y, position.z);
     ma_sound_start(&sound->m_internal_sound);
     ma_sound_set_looping(&sound->m_internal_sound, loop);
 
-    auto const e = Entity::create("TemporarySound");
-    e->transform->set_local_position(position);
-    e->add_component<Sound>(sound);
-
     return sound;
 }
 
+void Sound::on_recycled()
+{
+    // Only temporary sounds are pooled and these always start at full volume
+    set_volume(1.0f);
+}
+
 void Sound::awake()
 {
     if (play_on_awake)
@@ -177,8 +196,12 @@ void Sound::update()
     // Cleanup if the sound has ended. Note that for looping sounds atEnd is never true.
     if (m_internal_sound.atEnd)
     {
-        ma_sound_uninit(&m_internal_sound);
+        // Pooled sounds will be played again, so we keep them initialized
+        if (entity->is_pooled())
+            ma_sound_stop(&m_internal_sound);
+        else
+            ma_sound_uninit(&m_internal_sound);
 
-        entity->destroy_immediate();
+        entity->release_to_pool();
     }
 }
@@ -14,6 +14,8 @@ public:
     static std::shared_ptr<Sound> create(std::string const& path);
     static std::shared_ptr<Sound> create(std::string const& path, glm::vec3 const direction, float const rolloff = 0.5f,
                                          ma_attenuation_model const attenuation = ma_attenuation_model_inverse);
+    // NOTE: Sounds played this way are pooled. Once a returned sound has finished, it can be reused by the next play
+    //       of the same file, so it shouldn't be controlled anymore.
     static std::shared_ptr<Sound> play_sound(std::string const& path, bool const loop = false);
     static std::shared_ptr<Sound> play_sound_at_location(std::string const& path, glm::vec3 const position, glm::vec3 direction,
                                                          float rolloff = 0.5f,
@@ -25,6 +27,7 @@ public:
     }
 
     virtual void awake() override;
+    virtual void on_recycled() override;
 
 #if EDITOR
     virtual void draw_editor() override;
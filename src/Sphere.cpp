@@ -1,5 +1,6 @@
 #include "Sphere.h"
 
+#include <algorithm>
 #include <glm/ext/scalar_constants.hpp>
 #include <sstream>
 #include <utility>
@@ -7,6 +8,7 @@
 #include "Entity.h"
 #include "Globals.h"
 #include "MeshFactory.h"
+#include "MeshSimplifier.h"
 #include "Model.h"
 #include "ResourceManager.h"
 #include "Vertex.h"
@@ -118,27 +120,62 @@ std::shared_ptr<Mesh> Sphere::create_sphere() const
         }
     }
 
-    bool odd_row = false;
-    for (u32 y = 0; y < sector_count; ++y)
-    {
-        if (!odd_row)
+    // Levels of detail skip rows and columns of the same vertices, every level is one strip
+    auto const append_strip = [&](u32 const step) {
+        auto const get_lines = [step](u32 const count) {
+            std::vector<u32> lines = {};
+
+            for (u32 i = 0; i < count; i += step)
+                lines.push_back(i);
+
+            lines.push_back(count);
+            return lines;
+        };
+
+        std::vector<u32> const rows = get_lines(sector_count);
+        std::vector<u32> const columns = get_lines(stack_count);
+
+        bool odd_row = false;
+        for (u32 y = 0; y + 1 < rows.size(); ++y)
         {
-            for (u32 x = 0; x <= stack_count; ++x)
+            if (!odd_row)
             {
-                indices.push_back(y * (stack_count + 1) + x);
-                indices.push_back((y + 1) * (stack_count + 1) + x);
+                for (u32 const x : columns)
+                {
+                    indices.push_back(rows[y] * (stack_count + 1) + x);
+                    indices.push_back(rows[y + 1] * (stack_count + 1) + x);
+                }
             }
-        }
-        else
-        {
-            for (i32 x = stack_count; x >= 0; --x)
+            else
             {
-                indices.push_back((y + 1) * (stack_count + 1) + x);
-                indices.push_back(y * (stack_count + 1) + x);
+                for (auto x = columns.rbegin(); x != columns.rend(); ++x)
+                {
+                    indices.push_back(rows[y + 1] * (stack_count + 1) + *x);
+                    indices.push_back(rows[y] * (stack_count + 1) + *x);
+                }
             }
+
+            odd_row = !odd_row;
         }
+    };
+
+    append_strip(1);
+
+    std::vector<MeshLod> lods = {{0, static_cast<u32>(indices.size()), 0.0f}};
+
+    for (u32 step = 2; lods.size() < MeshSimplifier::max_lod_count && stack_count / step >= 4 && sector_count / step >= 2; step *= 2)
+    {
+        // Largest distance between the sphere and a flat face, relative to the diagonal of the bounds of the sphere
+        float const angle = std::max(2.0f * PI * static_cast<float>(step) / static_cast<float>(stack_count),
+                                     PI * static_cast<float>(step) / static_cast<float>(sector_count));
+        float const error = (1.0f - glm::cos(angle * 0.5f)) / (2.0f * glm::sqrt(3.0f));
+
+        if (error > MeshSimplifier::max_lod_error)
+            break;
 
-        odd_row = !odd_row;
+        auto const first_index = static_cast<u32>(indices.size());
+        append_strip(step);
+        lods.push_back({first_index, static_cast<u32>(indices.size()) - first_index, error});
     }
 
     if (!texture_path.empty())
@@ -149,5 +186,6 @@ std::shared_ptr<Mesh> Sphere::create_sphere() const
 
     std::stringstream stream;
     stream << std::to_string(stack_count) << "|" << std::to_string(sector_count) << "SPHERE";
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), stream.str(), vertices, indices, textures, m_draw_type, material);
+    return ResourceManager::get_instance().load_mesh(m_meshes.size(), stream.str(), vertices, indices, textures, m_draw_type, material,
+                                                     DrawFunctionType::Indexed, false, lods);
 }
@@ -71,6 +71,7 @@ std::shared_ptr<Mesh> Sprite::create_sprite() const
     TextureSettings texture_settings = {};
     texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+    texture_settings.compress = false;
 
     if (!diffuse_texture_path.empty())
         diffuse_maps.emplace_back(
@@ -34,9 +34,11 @@ void Terrain::draw() const
     }
     else
     {
+        size_t const index_size = m_meshes[0]->get_index_size();
+
         for (u32 strip = 0; strip < m_strips_count; ++strip)
         {
-            m_meshes[0]->draw(m_vertices_per_strip, (void*)(sizeof(u32) * m_vertices_per_strip * strip));
+            m_meshes[0]->draw(m_vertices_per_strip, (void*)(index_size * m_vertices_per_strip * strip));
         }
     }
 }
@@ -140,8 +142,6 @@ std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map_gpu() const
 
 std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map()
 {
-    stbi_set_flip_vertically_on_load(true);
-
     i32 width, height, number_of_components;
     unsigned char* data = stbi_load(m_height_map_path.c_str(), &width, &height, &number_of_components, 0);
 
@@ -162,7 +162,8 @@ std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map()
     {
         for (u32 k = 0; k < width; ++k)
         {
-            unsigned char const* texel = data + (k + width * i) * number_of_components;
+            // Rows are read bottom to top, stbi_set_flip_vertically_on_load() is global and would race with other threads
+            unsigned char const* texel = data + (k + width * (height - 1 - i)) * number_of_components;
 
             unsigned char const y = texel[0];
 
@@ -27,6 +27,17 @@ enum class TextureFiltering
     Linear,
 };
 
+// Formats of texels on the GPU, every one of them is sampled as sRGB.
+// Block-compressed formats store every 4x4 texels in a single block.
+enum class TextureFormat : u8
+{
+    RGBA8,
+    // 8 bytes per block, colors without alpha
+    BC1,
+    // 16 bytes per block, colors and alpha
+    BC3,
+};
+
 struct TextureSettings
 {
     TextureWrapMode wrap_mode_x = TextureWrapMode::Repeat;
@@ -37,6 +48,8 @@ struct TextureSettings
     TextureFiltering filtering_mipmap = TextureFiltering::Linear;
     bool generate_mipmaps = true;
     bool flip_vertically = true;
+    // Cooked textures are block compressed unless they are disabled, like UI drawn texel by texel
+    bool compress = true;
 };
 
 struct ID3D11Texture2D;
@@ -52,6 +65,11 @@ struct Texture
     u32 height = 0;
     u32 number_of_components = 0;
     TextureType type = TextureType::None;
+    TextureFormat format = TextureFormat::RGBA8;
+    u32 mip_level_count = 1;
+
+    // Size on the GPU, 0 if it's not known
+    u64 memory_size = 0;
 
     // Only valid in DX11
     ID3D11Texture2D* texture_2d = nullptr;
@@ -59,4 +77,7 @@ struct Texture
     ID3D11SamplerState* image_sampler_state = nullptr;
 
     std::string path = {};
+
+    // Settings the texture was loaded with, so it can be loaded again the same way when its file changes
+    TextureSettings settings = {};
 };
@@ -0,0 +1,618 @@
+#include "TextureCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+
+using Color = std::array<float, 3>;
+
+float srgb_to_linear(u8 const value)
+{
+    static std::array<float, 256> const table = [] {
+        std::array<float, 256> result = {};
+
+        for (u32 i = 0; i < result.size(); ++i)
+        {
+            float const srgb = static_cast<float>(i) / 255.0f;
+            result[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+        }
+
+        return result;
+    }();
+
+    return table[value];
+}
+
+u8 linear_to_srgb(float const value)
+{
+    float const linear = std::clamp(value, 0.0f, 1.0f);
+    float const srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+    return static_cast<u8>(std::round(srgb * 255.0f));
+}
+
+u16 pack_565(Color const& color)
+{
+    // Values are expanded back to 8 bits by repeating their high bits, so rounding doesn't always give the closest one
+    auto const quantize = [](float const value, u32 const bits) {
+        u32 const max = (1u << bits) - 1;
+        float const clamped = std::clamp(value, 0.0f, 255.0f);
+        u32 const rounded = static_cast<u32>(std::round(clamped * static_cast<float>(max) / 255.0f));
+
+        auto const get_error = [&](u32 const quantized) {
+            u32 const expanded = quantized << (8 - bits) | quantized >> (2 * bits - 8);
+            return std::abs(static_cast<float>(expanded) - clamped);
+        };
+
+        u32 best = rounded;
+
+        for (u32 const candidate : {rounded - 1, rounded + 1})
+        {
+            if (candidate <= max && get_error(candidate) < get_error(best))
+                best = candidate;
+        }
+
+        return static_cast<u16>(best);
+    };
+
+    return static_cast<u16>(quantize(color[0], 5) << 11 | quantize(color[1], 6) << 5 | quantize(color[2], 5));
+}
+
+std::array<u8, 3> unpack_565(u16 const color)
+{
+    u8 const r = (color >> 11) & 0x1F;
+    u8 const g = (color >> 5) & 0x3F;
+    u8 const b = color & 0x1F;
+    return {static_cast<u8>(r << 3 | r >> 2), static_cast<u8>(g << 2 | g >> 4), static_cast<u8>(b << 3 | b >> 2)};
+}
+
+// Colors of the indices of a color block, in the order of the indices
+std::array<std::array<u8, 4>, 4> get_color_palette(u16 const color0, u16 const color1, bool const is_four_color)
+{
+    auto const [r0, g0, b0] = unpack_565(color0);
+    auto const [r1, g1, b1] = unpack_565(color1);
+
+    auto const mix = [](u8 const a, u8 const b, u32 const weight_a, u32 const weight_b) {
+        return static_cast<u8>((a * weight_a + b * weight_b) / (weight_a + weight_b));
+    };
+
+    std::array<std::array<u8, 4>, 4> palette = {};
+    palette[0] = {r0, g0, b0, 255};
+    palette[1] = {r1, g1, b1, 255};
+
+    if (is_four_color)
+    {
+        palette[2] = {mix(r0, r1, 2, 1), mix(g0, g1, 2, 1), mix(b0, b1, 2, 1), 255};
+        palette[3] = {mix(r0, r1, 1, 2), mix(g0, g1, 1, 2), mix(b0, b1, 1, 2), 255};
+    }
+    else
+    {
+        palette[2] = {mix(r0, r1, 1, 1), mix(g0, g1, 1, 1), mix(b0, b1, 1, 1), 255};
+        palette[3] = {0, 0, 0, 0};
+    }
+
+    return palette;
+}
+
+// Picks the closest color of the palette for every texel, returns the squared error of the block
+u32 find_color_indices(u8 const* texels, u16 const color0, u16 const color1, std::array<u8, 16>& indices)
+{
+    auto const palette = get_color_palette(color0, color1, true);
+    u32 total_error = 0;
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+        u32 best_error = std::numeric_limits<u32>::max();
+
+        for (u8 k = 0; k < palette.size(); ++k)
+        {
+            u32 error = 0;
+
+            for (u32 c = 0; c < 3; ++c)
+            {
+                i32 const difference = static_cast<i32>(texels[i * 4 + c]) - palette[k][c];
+                error += static_cast<u32>(difference * difference);
+            }
+
+            if (error < best_error)
+            {
+                best_error = error;
+                indices[i] = k;
+            }
+        }
+
+        total_error += best_error;
+    }
+
+    return total_error;
+}
+
+// Endpoints are fit to the indices by least squares, every index stands for a fixed blend of both endpoints
+bool fit_endpoints(u8 const* texels, std::array<u8, 16> const& indices, Color& endpoint0, Color& endpoint1)
+{
+    std::array<float, 4> constexpr weights = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+    float aa = 0.0f;
+    float bb = 0.0f;
+    float ab = 0.0f;
+    Color ax = {};
+    Color bx = {};
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+        float const b = weights[indices[i]];
+        float const a = 1.0f - b;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+
+        for (u32 c = 0; c < 3; ++c)
+        {
+            ax[c] += a * texels[i * 4 + c];
+            bx[c] += b * texels[i * 4 + c];
+        }
+    }
+
+    float const determinant = aa * bb - ab * ab;
+
+    if (std::abs(determinant) < 1e-6f)
+        return false;
+
+    for (u32 c = 0; c < 3; ++c)
+    {
+        endpoint0[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+        endpoint1[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+    }
+
+    return true;
+}
+
+void write_color_block(u16 color0, u16 color1, std::array<u8, 16> indices, u8* block)
+{
+    // Four color mode needs the first endpoint to be larger, swapping them swaps 0 with 1 and 2 with 3
+    if (color0 < color1)
+    {
+        std::swap(color0, color1);
+
+        for (auto& index : indices)
+            index ^= 1;
+    }
+    else if (color0 == color1)
+    {
+        indices.fill(0);
+    }
+
+    u32 bits = 0;
+
+    for (u32 i = 0; i < 16; ++i)
+        bits |= static_cast<u32>(indices[i]) << (i * 2);
+
+    std::memcpy(block, &color0, sizeof(color0));
+    std::memcpy(block + 2, &color1, sizeof(color1));
+    std::memcpy(block + 4, &bits, sizeof(bits));
+}
+
+void encode_color_block(u8 const* texels, u8* block)
+{
+    Color mean = {};
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+        for (u32 c = 0; c < 3; ++c)
+            mean[c] += static_cast<float>(texels[i * 4 + c]) / 16.0f;
+    }
+
+    std::array<float, 6> covariance = {};
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+        float const r = texels[i * 4] - mean[0];
+        float const g = texels[i * 4 + 1] - mean[1];
+        float const b = texels[i * 4 + 2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    // Colors of a block mostly lie along a line, found as the principal axis by power iteration
+    Color axis = {1.0f, 1.0f, 1.0f};
+
+    for (u32 iteration = 0; iteration < 8; ++iteration)
+    {
+        Color const next = {covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]};
+        float const length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+
+        if (length < 1e-6f)
+            break;
+
+        axis = {next[0] / length, next[1] / length, next[2] / length};
+    }
+
+    float min_projection = std::numeric_limits<float>::max();
+    float max_projection = std::numeric_limits<float>::lowest();
+    u32 min_texel = 0;
+    u32 max_texel = 0;
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+        float const projection = texels[i * 4] * axis[0] + texels[i * 4 + 1] * axis[1] + texels[i * 4 + 2] * axis[2];
+
+        if (projection < min_projection)
+        {
+            min_projection = projection;
+            min_texel = i;
+        }
+
+        if (projection > max_projection)
+        {
+            max_projection = projection;
+            max_texel = i;
+        }
+    }
+
+    auto const get_texel = [texels](u32 const i) {
+        return Color {static_cast<float>(texels[i * 4]), static_cast<float>(texels[i * 4 + 1]), static_cast<float>(texels[i * 4 + 2])};
+    };
+
+    u16 color0 = pack_565(get_texel(max_texel));
+    u16 color1 = pack_565(get_texel(min_texel));
+    std::array<u8, 16> indices = {};
+    u32 error = find_color_indices(texels, color0, color1, indices);
+
+    // Extremes along the axis are usually a bit too far apart, refitting them to the chosen indices brings them closer
+    Color endpoint0 = {};
+    Color endpoint1 = {};
+
+    if (error > 0 && fit_endpoints(texels, indices, endpoint0, endpoint1))
+    {
+        u16 const fitted_color0 = pack_565(endpoint0);
+        u16 const fitted_color1 = pack_565(endpoint1);
+        std::array<u8, 16> fitted_indices = {};
+
+        if (u32 const fitted_error = find_color_indices(texels, fitted_color0, fitted_color1, fitted_indices); fitted_error < error)
+        {
+            color0 = fitted_color0;
+            color1 = fitted_color1;
+            indices = fitted_indices;
+        }
+    }
+
+    write_color_block(color0, color1, indices, block);
+}
+
+void decode_color_block(u8 const* block, u8* texels, bool const is_bc1)
+{
+    u16 color0 = 0;
+    u16 color1 = 0;
+    u32 bits = 0;
+    std::memcpy(&color0, block, sizeof(color0));
+    std::memcpy(&color1, block + 2, sizeof(color1));
+    std::memcpy(&bits, block + 4, sizeof(bits));
+
+    // Color blocks of BC3 always have four colors
+    auto const palette = get_color_palette(color0, color1, !is_bc1 || color0 > color1);
+
+    for (u32 i = 0; i < 16; ++i)
+        std::memcpy(texels + i * 4, palette[(bits >> (i * 2)) & 0x3].data(), 4);
+}
+
+void encode_alpha_block(u8 const* texels, u8* block)
+{
+    u8 min_alpha = 255;
+    u8 max_alpha = 0;
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+        min_alpha = std::min(min_alpha, texels[i * 4 + 3]);
+        max_alpha = std::max(max_alpha, texels[i * 4 + 3]);
+    }
+
+    // With the first endpoint larger, the other six values are evenly spaced between them
+    std::array<u8, 8> palette = {max_alpha, min_alpha};
+
+    for (u32 k = 1; k < 7; ++k)
+        palette[k + 1] = static_cast<u8>(((7 - k) * max_alpha + k * min_alpha) / 7);
+
+    u64 bits = 0;
+
+    for (u32 i = 0; i < 16 && min_alpha != max_alpha; ++i)
+    {
+        u8 const alpha = texels[i * 4 + 3];
+        u64 best_index = 0;
+
+        for (u64 k = 1; k < palette.size(); ++k)
+        {
+            if (std::abs(alpha - palette[k]) < std::abs(alpha - palette[best_index]))
+                best_index = k;
+        }
+
+        bits |= best_index << (i * 3);
+    }
+
+    block[0] = max_alpha;
+    block[1] = min_alpha;
+    std::memcpy(block + 2, &bits, 6);
+}
+
+void decode_alpha_block(u8 const* block, u8* texels)
+{
+    u8 const alpha0 = block[0];
+    u8 const alpha1 = block[1];
+    u64 bits = 0;
+    std::memcpy(&bits, block + 2, 6);
+
+    std::array<u8, 8> palette = {alpha0, alpha1};
+
+    if (alpha0 > alpha1)
+    {
+        for (u32 k = 1; k < 7; ++k)
+            palette[k + 1] = static_cast<u8>(((7 - k) * alpha0 + k * alpha1) / 7);
+    }
+    else
+    {
+        for (u32 k = 1; k < 5; ++k)
+            palette[k + 1] = static_cast<u8>(((5 - k) * alpha0 + k * alpha1) / 5);
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (u32 i = 0; i < 16; ++i)
+        texels[i * 4 + 3] = palette[(bits >> (i * 3)) & 0x7];
+}
+
+u32 get_block_bytes(TextureFormat const format)
+{
+    return format == TextureFormat::BC1 ? 8 : 16;
+}
+
+}
+
+TextureFormat TextureCompression::choose_format(TextureType const type, TextureSettings const& settings, std::span<u8 const> const pixels,
+                                                u32 const width, u32 const height)
+{
+    if (!settings.compress || type == TextureType::Heightmap || width < min_compressed_size || height < min_compressed_size
+        || width % block_size != 0 || height % block_size != 0)
+        return TextureFormat::RGBA8;
+
+    for (size_t i = 3; i < pixels.size(); i += 4)
+    {
+        if (pixels[i] != 255)
+            return TextureFormat::BC3;
+    }
+
+    return TextureFormat::BC1;
+}
+
+u32 TextureCompression::get_level_count(u32 const width, u32 const height)
+{
+    u32 level_count = 1;
+
+    for (u32 size = std::max(width, height); size > 1; size /= 2)
+        level_count += 1;
+
+    return level_count;
+}
+
+u32 TextureCompression::get_level_dimension(u32 const dimension, u32 const level)
+{
+    return std::max(dimension >> level, 1u);
+}
+
+u32 TextureCompression::get_row_pitch(TextureFormat const format, u32 const width)
+{
+    if (format == TextureFormat::RGBA8)
+        return width * 4;
+
+    // Rows of blocks
+    return (width + block_size - 1) / block_size * get_block_bytes(format);
+}
+
+u64 TextureCompression::get_level_size(TextureFormat const format, u32 const width, u32 const height)
+{
+    u32 const row_count = format == TextureFormat::RGBA8 ? height : (height + block_size - 1) / block_size;
+    return static_cast<u64>(get_row_pitch(format, width)) * row_count;
+}
+
+u64 TextureCompression::get_image_size(TextureFormat const format, u32 const width, u32 const height, u32 const level_count)
+{
+    u64 size = 0;
+
+    for (u32 level = 0; level < level_count; ++level)
+        size += get_level_size(format, get_level_dimension(width, level), get_level_dimension(height, level));
+
+    return size;
+}
+
+std::vector<u8> TextureCompression::generate_mipmaps(std::span<u8 const> const pixels, u32 const width, u32 const height,
+                                                     u32 const level_count)
+{
+    std::vector<u8> levels(get_image_size(TextureFormat::RGBA8, width, height, level_count));
+    std::memcpy(levels.data(), pixels.data(), get_level_size(TextureFormat::RGBA8, width, height));
+
+    // Every level is filtered from the linear colors of the previous one, so rounding doesn't add up
+    std::vector<float> source(static_cast<size_t>(width) * height * 4);
+
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = i % 4 == 3 ? static_cast<float>(pixels[i]) / 255.0f : srgb_to_linear(pixels[i]);
+
+    std::vector<float> destination = {};
+    size_t offset = get_level_size(TextureFormat::RGBA8, width, height);
+    u32 source_width = width;
+    u32 source_height = height;
+
+    for (u32 level = 1; level < level_count; ++level)
+    {
+        u32 const level_width = get_level_dimension(width, level);
+        u32 const level_height = get_level_dimension(height, level);
+        destination.assign(static_cast<size_t>(level_width) * level_height * 4, 0.0f);
+
+        for (u32 y = 0; y < level_height; ++y)
+        {
+            // Odd dimensions are covered by footprints of two and three texels
+            u32 const y0 = y * source_height / level_height;
+            u32 const y1 = std::max((y + 1) * source_height / level_height, y0 + 1);
+
+            for (u32 x = 0; x < level_width; ++x)
+            {
+                u32 const x0 = x * source_width / level_width;
+                u32 const x1 = std::max((x + 1) * source_width / level_width, x0 + 1);
+
+                std::array<float, 4> sum = {};
+                u32 count = 0;
+
+                for (u32 sy = y0; sy < y1; ++sy)
+                {
+                    for (u32 sx = x0; sx < x1; ++sx)
+                    {
+                        float const* texel = &source[(static_cast<size_t>(sy) * source_width + sx) * 4];
+                        float const alpha = texel[3];
+
+                        // Weighted by alpha, so colors of transparent texels don't bleed into the visible ones
+                        for (u32 c = 0; c < 3; ++c)
+                            sum[c] += texel[c] * alpha;
+
+                        sum[3] += alpha;
+                        count += 1;
+                    }
+                }
+
+                float* texel = &destination[(static_cast<size_t>(y) * level_width + x) * 4];
+
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    if (sum[3] > 0.0f)
+                        texel[c] = sum[c] / sum[3];
+                }
+
+                texel[3] = sum[3] / static_cast<float>(count);
+            }
+        }
+
+        for (size_t i = 0; i < destination.size(); ++i)
+        {
+            levels[offset + i] =
+                i % 4 == 3 ? static_cast<u8>(std::round(std::clamp(destination[i], 0.0f, 1.0f) * 255.0f)) : linear_to_srgb(destination[i]);
+        }
+
+        offset += destination.size();
+        source.swap(destination);
+        source_width = level_width;
+        source_height = level_height;
+    }
+
+    return levels;
+}
+
+std::vector<u8> TextureCompression::compress(std::span<u8 const> const levels, u32 const width, u32 const height, u32 const level_count,
+                                             TextureFormat const format)
+{
+    if (format == TextureFormat::RGBA8)
+        return {levels.begin(), levels.end()};
+
+    std::vector<u8> blocks(get_image_size(format, width, height, level_count));
+    u32 const block_bytes = get_block_bytes(format);
+    size_t source_offset = 0;
+    size_t block_offset = 0;
+
+    for (u32 level = 0; level < level_count; ++level)
+    {
+        u32 const level_width = get_level_dimension(width, level);
+        u32 const level_height = get_level_dimension(height, level);
+        u8 const* source = levels.data() + source_offset;
+
+        for (u32 block_y = 0; block_y < level_height; block_y += block_size)
+        {
+            for (u32 block_x = 0; block_x < level_width; block_x += block_size)
+            {
+                std::array<u8, 64> texels = {};
+
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    u32 const x = std::min(block_x + i % block_size, level_width - 1);
+                    u32 const y = std::min(block_y + i / block_size, level_height - 1);
+                    std::memcpy(&texels[i * 4], source + (static_cast<size_t>(y) * level_width + x) * 4, 4);
+                }
+
+                if (format == TextureFormat::BC1)
+                    encode_bc1_block(texels.data(), blocks.data() + block_offset);
+                else
+                    encode_bc3_block(texels.data(), blocks.data() + block_offset);
+
+                block_offset += block_bytes;
+            }
+        }
+
+        source_offset += get_level_size(TextureFormat::RGBA8, level_width, level_height);
+    }
+
+    return blocks;
+}
+
+std::vector<u8> TextureCompression::decompress(std::span<u8 const> const blocks, u32 const width, u32 const height,
+                                               TextureFormat const format)
+{
+    if (format == TextureFormat::RGBA8)
+        return {blocks.begin(), blocks.end()};
+
+    std::vector<u8> pixels(get_level_size(TextureFormat::RGBA8, width, height));
+    u32 const block_bytes = get_block_bytes(format);
+    size_t block_offset = 0;
+
+    for (u32 block_y = 0; block_y < height; block_y += block_size)
+    {
+        for (u32 block_x = 0; block_x < width; block_x += block_size)
+        {
+            std::array<u8, 64> texels = {};
+
+            if (format == TextureFormat::BC1)
+                decode_bc1_block(blocks.data() + block_offset, texels.data());
+            else
+                decode_bc3_block(blocks.data() + block_offset, texels.data());
+
+            block_offset += block_bytes;
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                u32 const x = block_x + i % block_size;
+                u32 const y = block_y + i / block_size;
+
+                if (x < width && y < height)
+                    std::memcpy(&pixels[(static_cast<size_t>(y) * width + x) * 4], &texels[i * 4], 4);
+            }
+        }
+    }
+
+    return pixels;
+}
+
+void TextureCompression::encode_bc1_block(u8 const* texels, u8* block)
+{
+    encode_color_block(texels, block);
+}
+
+void TextureCompression::encode_bc3_block(u8 const* texels, u8* block)
+{
+    encode_alpha_block(texels, block);
+    encode_color_block(texels, block + 8);
+}
+
+void TextureCompression::decode_bc1_block(u8 const* block, u8* texels)
+{
+    decode_color_block(block, texels, true);
+}
+
+void TextureCompression::decode_bc3_block(u8 const* block, u8* texels)
+{
+    decode_color_block(block + 8, texels, false);
+    decode_alpha_block(block, texels);
+}
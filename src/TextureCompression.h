@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+#include "Texture.h"
+
+// Builds mipmaps of RGBA8 images and encodes them to block-compressed formats, on the CPU.
+// Images hold every level one after another, from the largest one, and every level is tightly packed.
+class TextureCompression
+{
+public:
+    static u32 constexpr block_size = 4;
+
+    // Smaller images are mostly color palettes, which blocks can't keep apart, and compressing them would save next to nothing.
+    static u32 constexpr min_compressed_size = 64;
+
+    // Chooses BC1 for opaque colors and BC3 for colors with alpha.
+    // Heightmaps are displaced by their texels and images that aren't made of whole blocks can't be compressed, they stay RGBA8.
+    [[nodiscard]] static TextureFormat choose_format(TextureType const type, TextureSettings const& settings,
+                                                     std::span<u8 const> const pixels, u32 const width, u32 const height);
+
+    // Including the largest level, down to 1x1.
+    [[nodiscard]] static u32 get_level_count(u32 const width, u32 const height);
+
+    [[nodiscard]] static u32 get_level_dimension(u32 const dimension, u32 const level);
+    [[nodiscard]] static u32 get_row_pitch(TextureFormat const format, u32 const width);
+    [[nodiscard]] static u64 get_level_size(TextureFormat const format, u32 const width, u32 const height);
+    [[nodiscard]] static u64 get_image_size(TextureFormat const format, u32 const width, u32 const height, u32 const level_count);
+
+    // Box filters every level from the previous one. Colors are averaged in linear space, since textures are sampled as sRGB,
+    // and weighted by alpha. Returns every level including the first one.
+    [[nodiscard]] static std::vector<u8> generate_mipmaps(std::span<u8 const> const pixels, u32 const width, u32 const height,
+                                                          u32 const level_count);
+
+    // Texels past the edges of levels that aren't made of whole blocks repeat the last row and column.
+    [[nodiscard]] static std::vector<u8> compress(std::span<u8 const> const levels, u32 const width, u32 const height,
+                                                  u32 const level_count, TextureFormat const format);
+
+    // Decompresses a single level to RGBA8.
+    [[nodiscard]] static std::vector<u8> decompress(std::span<u8 const> const blocks, u32 const width, u32 const height,
+                                                    TextureFormat const format);
+
+    // Blocks are read from and written to 16 RGBA8 texels, row by row.
+    static void encode_bc1_block(u8 const* texels, u8* block);
+    static void encode_bc3_block(u8 const* texels, u8* block);
+    static void decode_bc1_block(u8 const* block, u8* texels);
+    static void decode_bc3_block(u8 const* block, u8* texels);
+};
@@ -1,13 +1,19 @@
 #include "TextureLoader.h"
 
 #include <cassert>
+#include <cstring>
+#include <span>
+#include <stb_image.h>
+#include <vector>
+
+#include "AK/AK.h"
+#include "CookedTexture.h"
+#include "TextureCompression.h"
+#include "VirtualFileSystem.h"
 
 std::shared_ptr<Texture> TextureLoader::load_texture(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
-    auto const [id, width, height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
-        texture_from_file(path, settings);
-    return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
-                                     path);
+    return create_texture(texture_from_file(path, type, settings), type, path);
 }
 
 std::shared_ptr<Texture> TextureLoader::load_cubemap(std::vector<std::string> const& paths, TextureType const type,
@@ -15,16 +21,126 @@ std::shared_ptr<Texture> TextureLoader::load_cubemap(std::vector<std::string> co
 {
     assert(paths.size() > 0);
 
-    auto const [id, width, height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
-        cubemap_from_files(paths, settings);
-    return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
-                                     paths[0]);
+    return create_texture(cubemap_from_files(paths, settings), type, paths[0]);
 }
 
 std::shared_ptr<Texture> TextureLoader::load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
-    auto const [id, width, height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
-        cubemap_from_file(path, settings);
-    return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
-                                     path);
+    return create_texture(cubemap_from_file(path, settings), type, path);
+}
+
+std::shared_ptr<Texture> TextureLoader::create_texture(TextureData const& data, TextureType const type, std::string const& path)
+{
+    // Textures are shared between meshes, so they are released with the last reference to them
+    return std::shared_ptr<Texture>(new Texture {data.id, data.width, data.height, data.number_of_components, type, data.format,
+                                                 data.mip_level_count, data.memory_size, data.texture_2d, data.shader_resource_view,
+                                                 data.image_sampler_state, path},
+                                    [](Texture const* texture) {
+                                        if (m_instance != nullptr)
+                                            m_instance->release_texture(*texture);
+
+                                        delete texture;
+                                    });
+}
+
+DecodedImage TextureLoader::decode_image(std::string const& path, bool const flip_vertically)
+{
+    i32 constexpr image_desired_channels = 4;
+
+    VirtualFile file = {};
+
+    if (!file.open(path))
+        return {};
+
+    DecodedImage image = {};
+    i32 image_channels = 0;
+    std::span<u8 const> const bytes = file.get_bytes();
+    u8* image_data = stbi_load_from_memory(bytes.data(), static_cast<i32>(bytes.size()), &image.width, &image.height, &image_channels,
+                                           image_desired_channels);
+
+    if (image_data == nullptr)
+        return {};
+
+    image.pixels = std::shared_ptr<u8>(image_data, [](u8* data) { stbi_image_free(data); });
+
+    // stbi_set_flip_vertically_on_load() is global, so flipping is done here instead
+    if (flip_vertically)
+    {
+        size_t const pitch = static_cast<size_t>(image.width) * image_desired_channels;
+        std::vector<u8> row(pitch);
+
+        for (i32 y = 0; y < image.height / 2; ++y)
+        {
+            u8* top = image_data + static_cast<size_t>(y) * pitch;
+            u8* bottom = image_data + static_cast<size_t>(image.height - 1 - y) * pitch;
+            std::memcpy(row.data(), top, pitch);
+            std::memcpy(top, bottom, pitch);
+            std::memcpy(bottom, row.data(), pitch);
+        }
+    }
+
+    image.is_flipped = flip_vertically;
+    return image;
+}
+
+DecodedImage TextureLoader::read_image(std::string const& path, TextureType const type, TextureSettings const& settings)
+{
+    // Images loaded with different settings are cooked separately
+    u32 const variant = static_cast<u32>(type) << 3 | (settings.generate_mipmaps ? 1 : 0) | (settings.flip_vertically ? 2 : 0)
+                      | (settings.compress ? 4 : 0);
+
+    if (m_texture_cooking_enabled)
+    {
+        if (DecodedImage image = CookedTexture::load(path, variant); image.pixels != nullptr)
+        {
+            image.is_flipped = settings.flip_vertically;
+            return image;
+        }
+    }
+
+    DecodedImage image = decode_image(path, settings.flip_vertically);
+
+    if (image.pixels == nullptr || (!settings.generate_mipmaps && !m_texture_cooking_enabled))
+        return image;
+
+    auto const width = static_cast<u32>(image.width);
+    auto const height = static_cast<u32>(image.height);
+    u32 const level_count = settings.generate_mipmaps ? TextureCompression::get_level_count(width, height) : 1;
+    std::span const pixels(image.pixels.get(), TextureCompression::get_level_size(TextureFormat::RGBA8, width, height));
+
+    // Without cooking, mipmaps are still built, only compressing them is left to the cook since it takes much longer
+    TextureFormat const format =
+        m_texture_cooking_enabled ? TextureCompression::choose_format(type, settings, pixels, width, height) : TextureFormat::RGBA8;
+
+    auto levels = std::make_shared<std::vector<u8>>(TextureCompression::generate_mipmaps(pixels, width, height, level_count));
+
+    if (format != TextureFormat::RGBA8)
+        *levels = TextureCompression::compress(*levels, width, height, level_count, format);
+
+    image.pixels = std::shared_ptr<u8 const>(levels, levels->data());
+    image.format = format;
+    image.level_count = level_count;
+
+    if (m_texture_cooking_enabled)
+        CookedTexture::save(path, image, variant);
+
+    return image;
+}
+
+void TextureLoader::stage_image(std::string const& path, DecodedImage image)
+{
+    m_staged_images.insert_or_assign(path, std::move(image));
+}
+
+void TextureLoader::unstage_image(std::string const& path)
+{
+    m_staged_images.erase(path);
+}
+
+DecodedImage TextureLoader::get_image(std::string const& path, TextureType const type, TextureSettings const& settings)
+{
+    if (auto const it = m_staged_images.find(path); it != m_staged_images.end() && it->second.is_flipped == settings.flip_vertically)
+        return it->second;
+
+    return read_image(path, type, settings);
 }
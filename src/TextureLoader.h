@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Texture.h"
@@ -17,6 +18,21 @@ struct TextureData
     ID3D11Texture2D* texture_2d = nullptr;
     ID3D11ShaderResourceView* shader_resource_view = nullptr;
     ID3D11SamplerState* image_sampler_state = nullptr;
+    TextureFormat format = TextureFormat::RGBA8;
+    u32 mip_level_count = 1;
+    u64 memory_size = 0;
+};
+
+// Image read on the CPU, before it's uploaded to the GPU.
+// Pixels hold every mipmap level one after another, from the largest one, see TextureCompression.
+struct DecodedImage
+{
+    i32 width = 0;
+    i32 height = 0;
+    bool is_flipped = false;
+    std::shared_ptr<u8 const> pixels = {};
+    TextureFormat format = TextureFormat::RGBA8;
+    u32 level_count = 1;
 };
 
 class TextureLoader
@@ -29,6 +45,29 @@ public:
         return m_instance;
     }
 
+    // Doesn't touch any global state, so images can be decoded on any thread.
+    [[nodiscard]] static DecodedImage decode_image(std::string const& path, bool const flip_vertically);
+
+    // Reads the cooked file of the image, or decodes the image, builds its mipmaps and compresses it, cooking it if enabled.
+    // Can be called on any thread, like decode_image().
+    [[nodiscard]] static DecodedImage read_image(std::string const& path, TextureType const type, TextureSettings const& settings);
+
+    // Images decoded ahead of time are used instead of reading the file again, when loading a texture with the same path.
+    // Only call these from the main thread.
+    static void stage_image(std::string const& path, DecodedImage image);
+    static void unstage_image(std::string const& path);
+
+    // Only set it before loading textures, worker threads read it.
+    static void set_texture_cooking_enabled(bool const enabled)
+    {
+        m_texture_cooking_enabled = enabled;
+    }
+
+    [[nodiscard]] static bool is_texture_cooking_enabled()
+    {
+        return m_texture_cooking_enabled;
+    }
+
 protected:
     static void set_instance(std::shared_ptr<TextureLoader> const& texture_loader)
     {
@@ -37,6 +76,8 @@ protected:
 
 private:
     inline static std::shared_ptr<TextureLoader> m_instance;
+    inline static std::unordered_map<std::string, DecodedImage> m_staged_images = {};
+    inline static bool m_texture_cooking_enabled = true;
 
     [[nodiscard]] std::shared_ptr<Texture> load_texture(std::string const& path, TextureType const type,
                                                         TextureSettings const& settings = {});
@@ -45,9 +86,15 @@ private:
     [[nodiscard]] std::shared_ptr<Texture> load_cubemap(std::string const& path, TextureType const type,
                                                         TextureSettings const& settings = {});
 
-    TextureData virtual texture_from_file(std::string const& path, TextureSettings const settings) = 0;
+    TextureData virtual texture_from_file(std::string const& path, TextureType const type, TextureSettings const settings) = 0;
     TextureData virtual cubemap_from_files(std::vector<std::string> const& paths, TextureSettings const settings) = 0;
     TextureData virtual cubemap_from_file(std::string const& path, TextureSettings const settings) = 0;
+    virtual void release_texture(Texture const& texture) = 0;
+
+    [[nodiscard]] static std::shared_ptr<Texture> create_texture(TextureData const& data, TextureType const type, std::string const& path);
 
     friend class ResourceManager;
+
+protected:
+    [[nodiscard]] static DecodedImage get_image(std::string const& path, TextureType const type, TextureSettings const& settings);
 };
@@ -3,9 +3,11 @@
 #include <DDSTextureLoader11.h>
 #include <codecvt>
 #include <d3d11.h>
-#include <stb_image.h>
+#include <vector>
 
+#include "CookedTexture.h"
 #include "RendererDX11.h"
+#include "TextureCompression.h"
 
 std::shared_ptr<TextureLoaderDX11> TextureLoaderDX11::create()
 {
@@ -14,44 +16,50 @@ std::shared_ptr<TextureLoaderDX11> TextureLoaderDX11::create()
     return texture_loader;
 }
 
-TextureData TextureLoaderDX11::texture_from_file(std::string const& path, TextureSettings const settings)
+TextureData TextureLoaderDX11::texture_from_file(std::string const& path, TextureType const type, TextureSettings const settings)
 {
     auto const device = RendererDX11::get_instance_dx11()->get_device();
-    stbi_set_flip_vertically_on_load(settings.flip_vertically);
 
-    i32 image_width;
-    i32 image_height;
-    i32 image_channels;
+    // Read ahead of time if the texture was streamed in
+    DecodedImage const image = get_image(path, type, settings);
     i32 constexpr image_desired_channels = 4;
-    u8* image_data = stbi_load(path.c_str(), &image_width, &image_height, &image_channels, image_desired_channels);
 
-    assert(image_data);
+    assert(image.pixels);
 
-    // Originally it was ImageWidth * 4, but if I understand it correctly, it's image width * number of channels
-    // "SysMemPitch: The distance (in bytes) from the beginning of one line of a texture to the next line" - via microsoft
-    i32 const image_pitch = image_width * image_desired_channels;
+    auto const image_width = static_cast<u32>(image.width);
+    auto const image_height = static_cast<u32>(image.height);
 
     D3D11_TEXTURE2D_DESC image_texture_desc = {};
     image_texture_desc.Width = image_width;
     image_texture_desc.Height = image_height;
-    image_texture_desc.MipLevels = 1;
+    image_texture_desc.MipLevels = image.level_count;
     image_texture_desc.ArraySize = 1;
-    image_texture_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+    image_texture_desc.Format = static_cast<DXGI_FORMAT>(CookedTexture::get_dxgi_format(image.format));
     image_texture_desc.SampleDesc.Count = 1;
     image_texture_desc.SampleDesc.Quality = 0;
     image_texture_desc.Usage = D3D11_USAGE_IMMUTABLE;
     image_texture_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
-    D3D11_SUBRESOURCE_DATA image_subresource_data = {};
-    image_subresource_data.pSysMem = image_data;
-    image_subresource_data.SysMemPitch = image_pitch;
+    // "SysMemPitch: The distance (in bytes) from the beginning of one line of a texture to the next line" - via microsoft
+    // Lines of block-compressed levels are rows of blocks
+    std::vector<D3D11_SUBRESOURCE_DATA> image_subresource_data(image.level_count);
+    u64 level_offset = 0;
+
+    for (u32 level = 0; level < image.level_count; ++level)
+    {
+        u32 const level_width = TextureCompression::get_level_dimension(image_width, level);
+        u32 const level_height = TextureCompression::get_level_dimension(image_height, level);
+
+        image_subresource_data[level].pSysMem = image.pixels.get() + level_offset;
+        image_subresource_data[level].SysMemPitch = TextureCompression::get_row_pitch(image.format, level_width);
+        level_offset += TextureCompression::get_level_size(image.format, level_width, level_height);
+    }
 
     ID3D11Texture2D* image_texture = nullptr;
-    HRESULT hr = device->CreateTexture2D(&image_texture_desc, &image_subresource_data, &image_texture);
+    HRESULT hr = device->CreateTexture2D(&image_texture_desc, image_subresource_data.data(), &image_texture);
 
     assert(SUCCEEDED(hr));
 
-    free(image_data);
     ID3D11ShaderResourceView* texture_resource = nullptr;
     hr = device->CreateShaderResourceView(image_texture, nullptr, &texture_resource);
 
@@ -86,6 +94,9 @@ TextureData TextureLoaderDX11::texture_from_file(std::string const& path, Textur
     texture_data.height = image_height;
     texture_data.width = image_width;
     texture_data.number_of_components = image_desired_channels;
+    texture_data.format = image.format;
+    texture_data.mip_level_count = image.level_count;
+    texture_data.memory_size = level_offset;
     return texture_data;
 }
 
@@ -138,6 +149,24 @@ TextureData TextureLoaderDX11::cubemap_from_file(std::string const& path, Textur
     return texture_data;
 }
 
+void TextureLoaderDX11::release_texture(Texture const& texture)
+{
+    if (texture.image_sampler_state)
+    {
+        texture.image_sampler_state->Release();
+    }
+
+    if (texture.shader_resource_view)
+    {
+        texture.shader_resource_view->Release();
+    }
+
+    if (texture.texture_2d)
+    {
+        texture.texture_2d->Release();
+    }
+}
+
 D3D11_TEXTURE_ADDRESS_MODE TextureLoaderDX11::convert_wrap_mode(TextureWrapMode const wrap_mode)
 {
     switch (wrap_mode)
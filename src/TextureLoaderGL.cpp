@@ -10,7 +10,7 @@ std::shared_ptr<TextureLoaderGL> TextureLoaderGL::create()
     return texture_loader;
 }
 
-TextureData TextureLoaderGL::texture_from_file(std::string const& path, TextureSettings const settings)
+TextureData TextureLoaderGL::texture_from_file(std::string const& path, TextureType const type, TextureSettings const settings)
 {
     u32 texture_id;
     glGenTextures(1, &texture_id);
@@ -119,6 +119,11 @@ TextureData TextureLoaderGL::cubemap_from_file(std::string const& path, TextureS
     return {};
 }
 
+void TextureLoaderGL::release_texture(Texture const& texture)
+{
+    glDeleteTextures(1, &texture.id);
+}
+
 GLint TextureLoaderGL::convert_wrap_mode(TextureWrapMode const wrap_mode)
 {
     switch (wrap_mode)
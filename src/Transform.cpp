@@ -10,19 +10,40 @@
 
 Transform::Transform(std::shared_ptr<Entity> const& entity) : entity(entity)
 {
+    m_handle = AK::HandleRegistry<Transform>::get_instance().add(this);
+}
+
+Transform::~Transform()
+{
+    AK::HandleRegistry<Transform>::get_instance().remove(m_handle);
+}
+
+AK::Handle<Transform> Transform::get_handle() const
+{
+    return m_handle;
+}
+
+Transform* Transform::get_parent() const
+{
+    return AK::resolve(m_parent);
+}
+
+bool Transform::has_parent() const
+{
+    return get_parent() != nullptr;
 }
 
 void Transform::set_position(glm::vec3 const& position)
 {
-    if (parent.expired())
+    if (!has_parent())
     {
         m_local_position = position;
     }
     else
     {
-        glm::vec3 const parent_global_position = parent.lock()->get_position();
+        glm::vec3 const parent_global_position = get_parent()->get_position();
         glm::vec3 new_local_position = position - parent_global_position;
-        new_local_position = glm::inverse(parent.lock()->get_rotation()) * new_local_position;
+        new_local_position = glm::inverse(get_parent()->get_rotation()) * new_local_position;
 
         auto const is_position_modified = glm::epsilonNotEqual(new_local_position, m_local_position, 0.0001f);
         if (!is_position_modified.x && !is_position_modified.y && !is_position_modified.z)
@@ -46,7 +67,7 @@ glm::vec3 Transform::get_position()
 void Transform::set_rotation(glm::vec3 const& euler_angles)
 {
     // this was null when adding individual particle component AGAIN?
-    if (parent.expired())
+    if (!has_parent())
     {
         m_local_rotation = glm::quat(glm::radians(euler_angles));
         m_euler_angles = euler_angles;
@@ -57,7 +78,7 @@ void Transform::set_rotation(glm::vec3 const& euler_angles)
         glm::quat const global_rotation = glm::quat(glm::radians(euler_angles));
 
         // Get the parent's global rotation
-        glm::quat const parent_global_rotation = parent.lock()->get_rotation();
+        glm::quat const parent_global_rotation = get_parent()->get_rotation();
 
         // Calculate the new local rotation by inverse of parent's rotation
         m_local_rotation = glm::inverse(parent_global_rotation) * global_rotation;
@@ -78,13 +99,13 @@ glm::quat Transform::get_rotation()
 
 void Transform::set_scale(glm::vec3 const& scale)
 {
-    if (parent.expired()) // If there's no parent, global scale is the same as local scale
+    if (!has_parent()) // If there's no parent, global scale is the same as local scale
     {
         m_local_scale = scale;
     }
     else
     {
-        glm::vec3 const parent_global_scale = parent.lock()->get_scale();
+        glm::vec3 const parent_global_scale = get_parent()->get_scale();
         glm::vec3 const new_local_scale = scale / parent_global_scale;
 
         auto const is_scale_modified = glm::epsilonNotEqual(new_local_scale, m_local_scale, 0.0001f);
@@ -209,7 +230,7 @@ glm::mat4 const& Transform::get_model_matrix()
 // Version for no parent
 void Transform::compute_model_matrix()
 {
-    assert(parent.expired());
+    assert(!has_parent());
 
     assert(m_local_dirty || m_parent_dirty);
 
@@ -238,14 +259,14 @@ void Transform::set_model_matrix(glm::mat4 const& matrix)
 {
     m_model_matrix = matrix;
 
-    if (parent.expired())
+    if (!has_parent())
     {
         glm::decompose(m_model_matrix, m_local_scale, m_local_rotation, m_local_position, m_skew, m_perpective);
         m_euler_angles = glm::degrees(glm::eulerAngles(m_local_rotation));
     }
     else
     {
-        glm::decompose(glm::inverse(parent.lock()->get_model_matrix()) * m_model_matrix, m_local_scale, m_local_rotation, m_local_position,
+        glm::decompose(glm::inverse(get_parent()->get_model_matrix()) * m_model_matrix, m_local_scale, m_local_rotation, m_local_position,
                        m_skew, m_perpective);
         m_euler_angles = glm::degrees(glm::eulerAngles(m_local_rotation));
     }
@@ -266,10 +287,10 @@ void Transform::recompute_model_matrix_if_needed()
 {
     if (m_local_dirty || m_parent_dirty)
     {
-        if (parent.expired())
+        if (Transform* const parent = get_parent(); parent == nullptr)
             compute_model_matrix();
         else
-            compute_model_matrix(parent.lock()->get_model_matrix());
+            compute_model_matrix(parent->get_model_matrix());
 
         glm::decompose(m_model_matrix, m_scale, m_rotation, m_position, m_skew, m_perpective);
     }
@@ -295,12 +316,12 @@ void Transform::recompute_forward_right_up_if_needed()
 void Transform::add_child(std::shared_ptr<Transform> const& transform)
 {
     children.emplace_back(transform);
-    transform->parent = shared_from_this();
+    transform->m_parent = m_handle;
 }
 
 void Transform::remove_child(std::shared_ptr<Transform> const& transform)
 {
-    assert(transform->parent.lock() == shared_from_this());
+    assert(transform->get_parent() == this);
 
     auto const it = std::ranges::find(children, transform);
 
@@ -309,7 +330,7 @@ void Transform::remove_child(std::shared_ptr<Transform> const& transform)
 
     children.erase(it);
 
-    transform->parent.reset();
+    transform->m_parent.reset();
 }
 
 void Transform::set_dirty()
@@ -324,6 +345,7 @@ void Transform::set_dirty()
 
     m_local_dirty = true;
     needs_bounding_box_adjusting = true;
+    m_version += 1;
 }
 
 void Transform::set_parent_dirty()
@@ -344,21 +366,28 @@ void Transform::set_parent(std::shared_ptr<Transform> const& new_parent)
 {
     if (new_parent == nullptr)
     {
-        if (parent.expired())
+        if (!has_parent())
             return;
 
-        parent.lock()->remove_child(shared_from_this());
+        get_parent()->remove_child(shared_from_this());
         m_local_dirty = true;
         needs_bounding_box_adjusting = true;
+        m_version += 1;
         return;
     }
 
-    if (!parent.expired())
+    if (has_parent())
     {
-        parent.lock()->remove_child(shared_from_this());
+        get_parent()->remove_child(shared_from_this());
     }
 
     new_parent->add_child(shared_from_this());
     m_local_dirty = true;
     needs_bounding_box_adjusting = true;
+    m_version += 1;
+}
+
+u32 Transform::get_version() const
+{
+    return m_version;
 }
@@ -7,6 +7,8 @@
 #include <memory>
 #include <vector>
 
+#include "AK/Handle.h"
+
 class Entity;
 
 // TODO: Make transform a component
@@ -14,6 +16,16 @@ class Transform : public std::enable_shared_from_this<Transform>
 {
 public:
     explicit Transform(std::shared_ptr<Entity> const& entity);
+    ~Transform();
+
+    Transform(Transform const&) = delete;
+    Transform& operator=(Transform const&) = delete;
+
+    [[nodiscard]] AK::Handle<Transform> get_handle() const;
+
+    // Parent is held by a handle, so getting it doesn't touch any reference counts. Don't store the returned pointer.
+    [[nodiscard]] Transform* get_parent() const;
+    [[nodiscard]] bool has_parent() const;
 
     void set_position(glm::vec3 const& position);
     [[nodiscard]] glm::vec3 get_position();
@@ -52,8 +64,10 @@ public:
 
     void set_parent(std::shared_ptr<Transform> const& new_parent);
 
+    // Changes whenever anything saved with the transform changes, its local position, rotation, scale or parent.
+    [[nodiscard]] u32 get_version() const;
+
     std::vector<std::shared_ptr<Transform>> children;
-    std::weak_ptr<Transform> parent = {};
     std::weak_ptr<Entity> entity = {};
 
     bool needs_bounding_box_adjusting = true;
@@ -91,6 +105,10 @@ private:
     void set_dirty();
     void set_parent_dirty();
 
+    AK::Handle<Transform> m_handle = {};
+    AK::Handle<Transform> m_parent = {};
+    u32 m_version = 0;
+
     glm::vec3 m_world_up = glm::vec3(0.0f, 1.0f, 0.0f);
     glm::vec3 m_euler_angles_when_caching = glm::vec3(std::nanf("0"), std::nanf("0"), std::nanf("0"));
 };
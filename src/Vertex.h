@@ -3,9 +3,36 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include "AK/Types.h"
+
 struct Vertex
 {
     glm::vec3 position;
     glm::vec3 normal;
     glm::vec2 texture_coordinates;
 };
+
+// Layout of the vertices in the vertex buffer of a mesh, chosen by VertexCompression when the mesh is created.
+enum class VertexFormat : u8
+{
+    // Vertex as it is
+    Full,
+    // CompactVertex with texture coordinates as 16-bit floats
+    CompactHalfUV,
+    // CompactVertex with texture coordinates as 16-bit normalized integers, for coordinates in [0, 1]
+    CompactUnitUV,
+
+    Count,
+};
+
+// Normals and texture coordinates are converted back to floats by the input assembler, so shaders read it like Vertex.
+struct CompactVertex
+{
+    glm::vec3 position;
+    // Signed normalized 8-bit integers, w is always 0
+    i8 normal[4];
+    u16 texture_coordinates[2];
+};
+
+static_assert(sizeof(Vertex) == 32);
+static_assert(sizeof(CompactVertex) == 20);
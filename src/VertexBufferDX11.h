@@ -9,6 +9,7 @@ class VertexBufferDX11
 {
 public:
     VertexBufferDX11(ID3D11Device* device, Vertex const* data, u32 const vertices_count);
+    VertexBufferDX11(ID3D11Device* device, void const* data, u32 const vertices_count, u32 const stride);
     VertexBufferDX11(VertexBufferDX11 const& rhs) = delete;
     VertexBufferDX11& operator=(VertexBufferDX11 const& rhs) = delete;
 
@@ -0,0 +1,180 @@
+#include "VertexCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/geometric.hpp>
+
+namespace
+{
+
+i8 encode_snorm8(float const value)
+{
+    return static_cast<i8>(std::round(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+
+float decode_snorm8(i8 const value)
+{
+    return std::max(static_cast<float>(value) / 127.0f, -1.0f);
+}
+
+u16 encode_unorm16(float const value)
+{
+    return static_cast<u16>(std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+float decode_unorm16(u16 const value)
+{
+    return static_cast<float>(value) / 65535.0f;
+}
+
+}
+
+VertexFormat VertexCompression::choose_format(std::span<Vertex const> const vertices)
+{
+    if (vertices.empty())
+        return VertexFormat::Full;
+
+    bool is_in_unit_range = true;
+    bool fits_half = true;
+
+    for (auto const& vertex : vertices)
+    {
+        // Normals of any other length, ex. scaled on purpose or left at zero, would come back different from snorm8
+        if (std::abs(glm::length(vertex.normal) - 1.0f) > max_normal_length_error)
+            return VertexFormat::Full;
+
+        for (float const coordinate : {vertex.texture_coordinates.x, vertex.texture_coordinates.y})
+        {
+            is_in_unit_range = is_in_unit_range && coordinate >= 0.0f && coordinate <= 1.0f;
+            fits_half = fits_half && std::abs(half_to_float(float_to_half(coordinate)) - coordinate) <= max_texture_coordinate_error;
+        }
+    }
+
+    if (is_in_unit_range)
+        return VertexFormat::CompactUnitUV;
+
+    if (fits_half)
+        return VertexFormat::CompactHalfUV;
+
+    return VertexFormat::Full;
+}
+
+std::vector<CompactVertex> VertexCompression::compress(std::span<Vertex const> const vertices, VertexFormat const format)
+{
+    std::vector<CompactVertex> compact_vertices(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        Vertex const& vertex = vertices[i];
+        CompactVertex& compact_vertex = compact_vertices[i];
+
+        compact_vertex.position = vertex.position;
+        compact_vertex.normal[0] = encode_snorm8(vertex.normal.x);
+        compact_vertex.normal[1] = encode_snorm8(vertex.normal.y);
+        compact_vertex.normal[2] = encode_snorm8(vertex.normal.z);
+        compact_vertex.normal[3] = 0;
+
+        for (u32 k = 0; k < 2; ++k)
+        {
+            float const coordinate = vertex.texture_coordinates[k];
+            compact_vertex.texture_coordinates[k] =
+                format == VertexFormat::CompactUnitUV ? encode_unorm16(coordinate) : float_to_half(coordinate);
+        }
+    }
+
+    return compact_vertices;
+}
+
+Vertex VertexCompression::decompress(CompactVertex const& vertex, VertexFormat const format)
+{
+    Vertex result = {};
+    result.position = vertex.position;
+    result.normal = glm::vec3(decode_snorm8(vertex.normal[0]), decode_snorm8(vertex.normal[1]), decode_snorm8(vertex.normal[2]));
+
+    for (u32 k = 0; k < 2; ++k)
+    {
+        u16 const coordinate = vertex.texture_coordinates[k];
+        result.texture_coordinates[k] = format == VertexFormat::CompactUnitUV ? decode_unorm16(coordinate) : half_to_float(coordinate);
+    }
+
+    return result;
+}
+
+u32 VertexCompression::get_vertex_size(VertexFormat const format)
+{
+    return format == VertexFormat::Full ? sizeof(Vertex) : sizeof(CompactVertex);
+}
+
+u16 VertexCompression::float_to_half(float const value)
+{
+    u32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    u32 const sign = (bits >> 16) & 0x8000;
+    u32 const float_exponent = (bits >> 23) & 0xFF;
+    u32 mantissa = bits & 0x7FFFFF;
+
+    // Infinity and NaN
+    if (float_exponent == 0xFF)
+        return static_cast<u16>(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+
+    i32 const exponent = static_cast<i32>(float_exponent) - 127 + 15;
+
+    // Too large, becomes infinity
+    if (exponent >= 31)
+        return static_cast<u16>(sign | 0x7C00);
+
+    // Too small for a normal half, becomes a denormal or zero
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+            return static_cast<u16>(sign);
+
+        mantissa |= 0x800000;
+        u32 const shift = static_cast<u32>(14 - exponent);
+        u32 half_mantissa = mantissa >> shift;
+        u32 const remainder = mantissa & ((1u << shift) - 1);
+        u32 const halfway = 1u << (shift - 1);
+
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1) != 0))
+            half_mantissa += 1;
+
+        return static_cast<u16>(sign | half_mantissa);
+    }
+
+    u32 half = sign | static_cast<u32>(exponent) << 10 | mantissa >> 13;
+    u32 const remainder = mantissa & 0x1FFF;
+
+    // Rounds to nearest even, a carry out of the mantissa correctly increments the exponent
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0))
+        half += 1;
+
+    return static_cast<u16>(half);
+}
+
+float VertexCompression::half_to_float(u16 const value)
+{
+    u32 const sign = static_cast<u32>(value & 0x8000) << 16;
+    u32 const exponent = (value >> 10) & 0x1F;
+    u32 const mantissa = value & 0x3FF;
+
+    float result = 0.0f;
+
+    if (exponent == 0)
+    {
+        result = std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    else if (exponent == 31)
+    {
+        u32 const bits = 0x7F800000 | mantissa << 13;
+        std::memcpy(&result, &bits, sizeof(result));
+    }
+    else
+    {
+        u32 const bits = (exponent - 15 + 127) << 23 | mantissa << 13;
+        std::memcpy(&result, &bits, sizeof(result));
+    }
+
+    return sign != 0 ? -result : result;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+#include "Vertex.h"
+
+// Converts vertices to the smaller formats of VertexFormat.
+class VertexCompression
+{
+public:
+    // Largest error of a texture coordinate for it to be stored as a 16-bit float, half a texel of a 1024x1024 texture.
+    static float constexpr max_texture_coordinate_error = 1.0f / 2048.0f;
+
+    // Largest difference of the length of a normal from 1 for it to be stored as snorm8, a bit over what exporters round off.
+    static float constexpr max_normal_length_error = 0.01f;
+
+    // Picks the smallest format that keeps texture coordinates within max_texture_coordinate_error.
+    // Meshes with normals that aren't normalized within max_normal_length_error keep the full format.
+    [[nodiscard]] static VertexFormat choose_format(std::span<Vertex const> const vertices);
+
+    [[nodiscard]] static std::vector<CompactVertex> compress(std::span<Vertex const> const vertices, VertexFormat const format);
+    [[nodiscard]] static Vertex decompress(CompactVertex const& vertex, VertexFormat const format);
+
+    [[nodiscard]] static u32 get_vertex_size(VertexFormat const format);
+
+    [[nodiscard]] static u16 float_to_half(float const value);
+    [[nodiscard]] static float half_to_float(u16 const value);
+};
@@ -0,0 +1,356 @@
+#include "VirtualFileSystem.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "AK/Lz4.h"
+
+namespace
+{
+
+std::string join_path(std::string_view const directory, std::string_view const path)
+{
+    if (directory.empty())
+        return std::string(path);
+
+    if (path.empty())
+        return std::string(directory);
+
+    std::string joined = {};
+    joined.reserve(directory.size() + 1 + path.size());
+    joined.append(directory).append("/").append(path);
+    return joined;
+}
+
+// Path relative to the mount point, if the path is under it
+std::optional<std::string_view> get_relative_path(std::string_view const path, std::string_view const mount_point)
+{
+    if (mount_point.empty())
+        return path;
+
+    if (!path.starts_with(mount_point))
+        return {};
+
+    if (path.size() == mount_point.size())
+        return std::string_view {};
+
+    if (path[mount_point.size()] != '/')
+        return {};
+
+    return path.substr(mount_point.size() + 1);
+}
+
+}
+
+bool VirtualFile::open(std::string const& file_path)
+{
+    return VirtualFileSystem::get_instance().open(file_path, *this);
+}
+
+void VirtualFile::close()
+{
+    m_file.close();
+    m_archive = nullptr;
+    m_entry = nullptr;
+    m_decompressed = {};
+    m_bytes = {};
+    m_is_open = false;
+}
+
+void VirtualFile::prefetch() const
+{
+    if (m_archive == nullptr)
+    {
+        m_file.prefetch();
+        return;
+    }
+
+    // Decompressed files are already in memory
+    if (m_entry->compression == PackCompression::None)
+        m_archive->prefetch(*m_entry);
+}
+
+void VirtualFile::copy_to_memory()
+{
+    if (!m_is_open || m_archive != nullptr)
+        return;
+
+    m_decompressed.assign(m_bytes.begin(), m_bytes.end());
+    m_bytes = m_decompressed;
+    m_file.close();
+}
+
+bool VirtualFile::is_open() const
+{
+    return m_is_open;
+}
+
+bool VirtualFile::is_packed() const
+{
+    return m_archive != nullptr;
+}
+
+size_t VirtualFile::get_size() const
+{
+    return m_bytes.size();
+}
+
+std::span<u8 const> VirtualFile::get_bytes() const
+{
+    return m_bytes;
+}
+
+std::string_view VirtualFile::get_text() const
+{
+    return {reinterpret_cast<char const*>(m_bytes.data()), m_bytes.size()};
+}
+
+VirtualFileSystem& VirtualFileSystem::get_instance()
+{
+    static VirtualFileSystem instance;
+    return instance;
+}
+
+void VirtualFileSystem::mount_directory(std::string const& mount_point, std::string const& directory)
+{
+    Mount mount = {};
+    mount.mount_point = normalize_path(mount_point);
+    mount.directory = normalize_path(directory);
+
+    std::unique_lock lock(m_mounts_mutex);
+    m_mounts.emplace_back(std::move(mount));
+
+    // Longer mount points are more specific, mounts with the same one are searched in the order they were mounted
+    std::ranges::stable_sort(m_mounts, [](Mount const& a, Mount const& b) { return a.mount_point.size() > b.mount_point.size(); });
+}
+
+bool VirtualFileSystem::mount_archive(std::string const& mount_point, std::string const& archive_path)
+{
+    auto archive = std::make_shared<PackArchive>();
+    ++m_disk_open_count;
+
+    if (!archive->open(archive_path))
+        return false;
+
+    Mount mount = {};
+    mount.mount_point = normalize_path(mount_point);
+    mount.archive = std::move(archive);
+
+    // The archive is read before locking, so loading assets only waits for the mount points to be updated
+    std::unique_lock lock(m_mounts_mutex);
+    m_mounts.emplace_back(std::move(mount));
+
+    std::ranges::stable_sort(m_mounts, [](Mount const& a, Mount const& b) { return a.mount_point.size() > b.mount_point.size(); });
+    return true;
+}
+
+void VirtualFileSystem::unmount(std::string const& mount_point)
+{
+    std::string const normalized_mount_point = normalize_path(mount_point);
+
+    std::unique_lock lock(m_mounts_mutex);
+    std::erase_if(m_mounts, [&](Mount const& mount) { return mount.mount_point == normalized_mount_point; });
+}
+
+bool VirtualFileSystem::open(std::string const& file_path, VirtualFile& file)
+{
+    file.close();
+
+    for (auto const& location : get_locations(normalize_path(file_path)))
+    {
+        if (location.archive == nullptr)
+        {
+            ++m_disk_open_count;
+
+            if (!file.m_file.open(location.disk_path))
+                continue;
+
+            file.m_bytes = file.m_file.get_bytes();
+            file.m_is_open = true;
+            return true;
+        }
+
+        PackEntry const* entry = location.archive->find(location.archive_path);
+
+        if (entry == nullptr)
+            continue;
+
+        file.m_archive = location.archive;
+        file.m_entry = entry;
+
+        std::span<u8 const> const stored_bytes = location.archive->get_stored_bytes(*entry);
+
+        if (entry->compression == PackCompression::LZ4)
+        {
+            file.m_decompressed.resize(entry->size);
+
+            if (!AK::Lz4::decompress(stored_bytes, file.m_decompressed))
+            {
+                std::cout << "Error. Packed file is corrupted: " << file_path << "\n";
+                file.close();
+                return false;
+            }
+
+            file.m_bytes = file.m_decompressed;
+        }
+        else
+        {
+            file.m_bytes = stored_bytes;
+        }
+
+        file.m_is_open = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool VirtualFileSystem::exists(std::string const& file_path)
+{
+    for (auto const& location : get_locations(normalize_path(file_path)))
+    {
+        std::error_code error;
+
+        if (location.archive == nullptr ? std::filesystem::is_regular_file(location.disk_path, error)
+                                        : location.archive->find(location.archive_path) != nullptr)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<std::string> VirtualFileSystem::list_files(std::string const& directory)
+{
+    std::string const path = normalize_path(directory);
+    std::vector<std::string> files = {};
+
+    for (auto const& location : get_locations(path))
+    {
+        if (location.archive == nullptr)
+        {
+            std::error_code error;
+
+            // Relative paths can normalize to nothing, which is the working directory
+            std::string const disk_directory = !location.disk_path.empty() ? location.disk_path : ".";
+
+            for (auto const& entry : std::filesystem::directory_iterator(disk_directory, error))
+            {
+                if (entry.is_regular_file(error))
+                    files.emplace_back(join_path(path, entry.path().filename().string()));
+            }
+
+            continue;
+        }
+
+        // Archives have no directories, only paths, so every one of them is checked
+        for (auto const& entry : location.archive->get_entries())
+        {
+            std::optional<std::string_view> const file_name = get_relative_path(location.archive->get_path(entry), location.archive_path);
+
+            if (file_name.has_value() && !file_name->empty() && file_name->find('/') == std::string_view::npos)
+                files.emplace_back(join_path(path, file_name.value()));
+        }
+    }
+
+    std::ranges::sort(files);
+    auto const duplicates = std::ranges::unique(files);
+    files.erase(duplicates.begin(), duplicates.end());
+    return files;
+}
+
+std::string VirtualFileSystem::normalize_path(std::string_view const path)
+{
+    std::string normalized = {};
+    normalized.reserve(path.size());
+
+    // Absolute paths stay absolute
+    if (!path.empty() && (path.front() == '/' || path.front() == '\\'))
+        normalized += '/';
+
+    size_t segment_start = 0;
+
+    while (segment_start <= path.size())
+    {
+        size_t segment_end = path.find_first_of("/\\", segment_start);
+
+        if (segment_end == std::string_view::npos)
+            segment_end = path.size();
+
+        std::string_view const segment = path.substr(segment_start, segment_end - segment_start);
+
+        if (!segment.empty() && segment != ".")
+        {
+            if (!normalized.empty() && normalized.back() != '/')
+                normalized += '/';
+
+            normalized += segment;
+        }
+
+        segment_start = segment_end + 1;
+    }
+
+    return normalized;
+}
+
+void VirtualFileSystem::set_loose_files_enabled(bool const enabled)
+{
+    std::unique_lock lock(m_mounts_mutex);
+    m_loose_files_enabled = enabled;
+}
+
+bool VirtualFileSystem::are_loose_files_enabled() const
+{
+    std::shared_lock lock(m_mounts_mutex);
+    return m_loose_files_enabled;
+}
+
+u64 VirtualFileSystem::get_disk_open_count() const
+{
+    return m_disk_open_count;
+}
+
+void VirtualFileSystem::reset_disk_open_count()
+{
+    m_disk_open_count = 0;
+}
+
+std::vector<VirtualFileSystem::Location> VirtualFileSystem::get_locations(std::string const& path) const
+{
+    std::vector<Location> locations = {};
+    bool is_packed = false;
+
+    // Locations hold their own references to archives, files keep reading from them if they are unmounted meanwhile
+    std::shared_lock lock(m_mounts_mutex);
+
+    if (m_loose_files_enabled)
+        locations.emplace_back(Location {path});
+
+    for (auto const& mount : m_mounts)
+    {
+        std::optional<std::string_view> const relative_path = get_relative_path(path, mount.mount_point);
+
+        if (!relative_path.has_value())
+            continue;
+
+        if (mount.archive != nullptr)
+        {
+            locations.emplace_back(Location {{}, mount.archive, std::string(relative_path.value())});
+            is_packed = true;
+        }
+        else
+        {
+            locations.emplace_back(Location {join_path(mount.directory, relative_path.value())});
+        }
+    }
+
+    if (!m_loose_files_enabled && !is_packed)
+        locations.emplace_back(Location {path});
+
+    return locations;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AK/MappedFile.h"
+#include "AK/Types.h"
+#include "PackArchive.h"
+
+// File opened through VirtualFileSystem, read the same way as AK::MappedFile.
+// Loose files and files stored in archives are read straight from the mapped files, compressed files are decompressed
+// into memory owned by the file. Views returned by get_bytes() and get_text() are valid as long as the file stays open.
+class VirtualFile
+{
+public:
+    // Opens the file through VirtualFileSystem::get_instance().
+    bool open(std::string const& file_path);
+    void close();
+
+    // Asks the OS to start reading the file in the background, so the first access doesn't wait for the disk.
+    void prefetch() const;
+
+    // Copies a file read from the disk into memory and closes it, so other programs can change it while the copy is used.
+    // Packed files are left as they are.
+    void copy_to_memory();
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] bool is_packed() const;
+    [[nodiscard]] size_t get_size() const;
+    [[nodiscard]] std::span<u8 const> get_bytes() const;
+    [[nodiscard]] std::string_view get_text() const;
+
+private:
+    friend class VirtualFileSystem;
+
+    AK::MappedFile m_file = {};
+
+    // Keeps the archive mapped even if it's unmounted while the file is open
+    std::shared_ptr<PackArchive const> m_archive = {};
+    PackEntry const* m_entry = nullptr;
+    // Decompressed packed files, and files copied into memory
+    std::vector<u8> m_decompressed = {};
+
+    std::span<u8 const> m_bytes = {};
+    bool m_is_open = false;
+};
+
+// Reads assets by the paths they have on disk, from loose files or from mounted archives, so code loading them
+// doesn't need to know where they are. Paths are normalized first, "./res/models/ship.gltf" and "res\models\ship.gltf"
+// are the same file. Then they are looked up under every mount point they start with, the longest mount points first.
+// Loose files win over archives while they are enabled, so assets can be edited without packing them again.
+// Paths that aren't under any archive are always read from the disk.
+// Files can be opened from any thread. Mounting and unmounting can happen while assets are loaded, ex. when the editor packs
+// them again. Files already opened keep reading from where they were found.
+class VirtualFileSystem
+{
+public:
+    static VirtualFileSystem& get_instance();
+
+    // Files under the mount point are also looked for in the directory.
+    void mount_directory(std::string const& mount_point, std::string const& directory);
+
+    // Files under the mount point are read from the archive, if there are no loose files for them.
+    bool mount_archive(std::string const& mount_point, std::string const& archive_path);
+
+    // Files that are still open keep reading from unmounted archives.
+    void unmount(std::string const& mount_point);
+
+    bool open(std::string const& file_path, VirtualFile& file);
+    [[nodiscard]] bool exists(std::string const& file_path);
+
+    // Normalized paths of the files directly in the directory, sorted. Files that are both loose and packed are listed once.
+    [[nodiscard]] std::vector<std::string> list_files(std::string const& directory);
+
+    // Turns backslashes into forward slashes and removes "." and empty segments.
+    [[nodiscard]] static std::string normalize_path(std::string_view const path);
+
+    // Enabled by default. Shipped builds disable them, so files in archives don't try the disk first.
+    void set_loose_files_enabled(bool const enabled);
+    [[nodiscard]] bool are_loose_files_enabled() const;
+
+    // Files opened from the disk, including archives and files that didn't exist.
+    [[nodiscard]] u64 get_disk_open_count() const;
+    void reset_disk_open_count();
+
+private:
+    struct Mount
+    {
+        std::string mount_point = {};
+        std::string directory = {};
+        std::shared_ptr<PackArchive const> archive = {};
+    };
+
+    // Where a file can be, in the order it's looked for. Either a path on the disk or a path in an archive.
+    struct Location
+    {
+        std::string disk_path = {};
+        std::shared_ptr<PackArchive const> archive = {};
+        std::string archive_path = {};
+    };
+
+    [[nodiscard]] std::vector<Location> get_locations(std::string const& path) const;
+
+    // Shared while files are looked up, exclusive while mount points change. Guards m_loose_files_enabled as well.
+    mutable std::shared_mutex m_mounts_mutex = {};
+    std::vector<Mount> m_mounts = {};
+    std::atomic<u64> m_disk_open_count = 0;
+    bool m_loose_files_enabled = true;
+};
@@ -9,6 +9,7 @@
 #include "TextureLoader.h"
 
 #include <GLFW/glfw3.h>
+#include <format>
 
 #if EDITOR
 #include <imgui.h>
@@ -134,8 +135,9 @@ void Water::prepare()
 
     std::vector<std::shared_ptr<Texture>> diffuse_maps = {};
 
-    m_meshes.push_back(
-        ResourceManager::get_instance().load_mesh(m_meshes.size(), "WATER", vertices, indices, diffuse_maps, m_draw_type, material));
+    // Meshes of previous tesselation levels are unloaded by ResourceManager once no water uses them
+    m_meshes.push_back(ResourceManager::get_instance().load_mesh(m_meshes.size(), std::format("WATER_{}", tesselation_level), vertices,
+                                                                 indices, diffuse_maps, m_draw_type, material));
 }
 
 void Water::reprepare()
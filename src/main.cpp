@@ -1,3 +1,6 @@
+#include <string_view>
+
+#include "Benchmark.h"
 #include "Engine.h"
 
 #define FORCE_DEDICATED_GPU 1
@@ -17,13 +20,23 @@ extern "C"
 }
 #endif
 
-i32 main(i32, char**)
+i32 main(i32 argc, char** argv)
 {
     if (auto const result = Engine::initialize(); result != 0)
         return result;
 
     Engine::create_game();
 
+    // Runs the checks on the loaded scene and exits instead of starting the game
+    if (argc > 1 && std::string_view(argv[1]) == "--run-checks")
+    {
+        bool const is_passed = Benchmark::run_checks();
+
+        Engine::clean_up();
+
+        return is_passed ? 0 : 1;
+    }
+
     Engine::run();
 
     Engine::clean_up();